@@ -104,6 +104,7 @@
 #include <app/ui/widgets/system_widgets.hpp>
 
 #include <serdes/state_cereal.hpp>
+#include <serdes/state_file.hpp>
 
 #include <util/file_loader.hpp>
 #include <util/math.hpp>
@@ -120,9 +121,6 @@
 
 #include <imgui.h>
 
-#include <cereal/archives/binary.hpp>
-#include <cereal/archives/portable_binary.hpp>
-
 #include <cmrc/cmrc.hpp>
 
 #include <stb_image.h>
@@ -134,8 +132,10 @@
 #include <RtMidi.h>
 
 #include <clocale>
+#include <cstring>
 #include <mutex>
 #include <numbers>
+#include <optional>
 #include <span>
 #include <thread>
 #include <unordered_map>
@@ -383,6 +383,8 @@ int App::Run(const CommandLineOptions &options) {
 
     m_context.EnqueueEvent(events::emu::LoadInternalBackupMemory());
 
+    const size_t rewindBufferSize = m_context.settings.general.rewindBufferSize;
+    m_context.rewindBuffer.SetMemoryBudget(rewindBufferSize * 1024 * 1024);
     EnableRewindBuffer(m_context.settings.general.enableRewindBuffer);
 
     // TODO: allow overriding configuration from CommandLineOptions without modifying the underlying values
@@ -759,6 +761,9 @@ void App::RunEmulator() {
         {&m_context, [](uint32 *fb, uint32 width, uint32 height, void *ctx) {
              auto &sharedCtx = *static_cast<SharedContext *>(ctx);
              auto &screen = sharedCtx.screen;
+             if (screen.skipFrames) {
+                 return;
+             }
              if (width != screen.width || height != screen.height) {
                  screen.SetResolution(width, height);
              }
@@ -810,25 +815,41 @@ void App::RunEmulator() {
     m_context.saturn.instance->VDP.SetVDP1DrawCallback({&m_context, [](void *ctx) {
                                                             auto &sharedCtx = *static_cast<SharedContext *>(ctx);
                                                             auto &screen = sharedCtx.screen;
-                                                            ++screen.VDP1DrawCalls;
+                                                            if (!screen.skipFrames) {
+                                                                ++screen.VDP1DrawCalls;
+                                                            }
                                                         }});
 
     m_context.saturn.instance->VDP.SetVDP1FramebufferSwapCallback({&m_context, [](void *ctx) {
                                                                        auto &sharedCtx =
                                                                            *static_cast<SharedContext *>(ctx);
                                                                        auto &screen = sharedCtx.screen;
-                                                                       ++screen.VDP1Frames;
+                                                                       if (!screen.skipFrames) {
+                                                                           ++screen.VDP1Frames;
+                                                                       }
                                                                    }});
 
     // ---------------------------------
     // Initialize audio system
 
-    static constexpr int kSampleRate = 44100;
     static constexpr SDL_AudioFormat kSampleFormat = SDL_AUDIO_S16;
     static constexpr int kChannels = 2;
     static constexpr uint32 kBufferSize = 512; // TODO: make this configurable
 
-    if (!m_context.audioSystem.Init(kSampleRate, kSampleFormat, kChannels, kBufferSize)) {
+    // Open the stream at the device's native sample rate and let the emulator core resample its output to match,
+    // avoiding an extra conversion step in SDL
+    int targetSampleRate = scsp::kAudioFreq;
+    {
+        SDL_AudioSpec deviceSpec{};
+        if (SDL_GetAudioDeviceFormat(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &deviceSpec, nullptr) &&
+            deviceSpec.freq >= (int)scsp::Resampler::kMinSampleRate &&
+            deviceSpec.freq <= (int)scsp::Resampler::kMaxSampleRate) {
+            targetSampleRate = deviceSpec.freq;
+        }
+    }
+    m_context.saturn.instance->configuration.audio.outputSampleRate = targetSampleRate;
+
+    if (!m_context.audioSystem.Init(targetSampleRate, kSampleFormat, kChannels, kBufferSize)) {
         ShowStartupFailure("Failed to create audio stream: {}", SDL_GetError());
         return;
     }
@@ -840,6 +861,8 @@ void App::RunEmulator() {
 
     m_context.settings.audio.stepGranularity.ObserveAndNotify(
         [&](uint32 granularity) { m_context.EnqueueEvent(events::emu::SetSCSPStepGranularity(granularity)); });
+    m_context.settings.audio.sampleBatchSize.ObserveAndNotify(
+        [&](uint32 batchSize) { m_context.EnqueueEvent(events::emu::SetSCSPSampleBatchSize(batchSize)); });
 
     if (m_context.audioSystem.Start()) {
         int sampleRate;
@@ -865,7 +888,7 @@ void App::RunEmulator() {
 
         devlog::info<grp::base>("Audio stream opened: {} Hz, {} channel{}, {} format", sampleRate, channels,
                                 (channels == 1 ? "" : "s"), formatName());
-        if (sampleRate != kSampleRate || channels != kChannels || audioFormat != kSampleFormat) {
+        if (sampleRate != targetSampleRate || channels != kChannels || audioFormat != kSampleFormat) {
             // Hopefully this never happens
             ShowStartupFailure("Audio format mismatch");
             return;
@@ -875,9 +898,14 @@ void App::RunEmulator() {
         return;
     }
 
-    m_context.saturn.instance->SCSP.SetSampleCallback(
+    static_assert(sizeof(Sample) == sizeof(scsp::OutputFrame) && alignof(Sample) == alignof(scsp::OutputFrame));
+    m_context.saturn.instance->SCSP.SetSampleBatchCallback(
         {&m_context.audioSystem,
-         [](sint16 left, sint16 right, void *ctx) { static_cast<AudioSystem *>(ctx)->ReceiveSample(left, right); }});
+         [](std::span<const scsp::OutputFrame> frames, void *ctx) {
+             static_cast<AudioSystem *>(ctx)->ReceiveSamples(
+                 {reinterpret_cast<const Sample *>(frames.data()), frames.size()});
+         }},
+        m_context.settings.audio.sampleBatchSize.Get());
 
     m_context.saturn.instance->SCSP.SetSendMidiOutputCallback(
         {&m_context.midi.midiOutput, [](std::span<uint8> payload, void *ctx) {
@@ -1582,6 +1610,18 @@ void App::RunEmulator() {
         }
     }};
 
+    // Start save state writer thread
+    m_saveStateThreadRunning = true;
+    m_saveStateThread = std::thread([&] { SaveStateThread(); });
+    ScopeGuard sgStopSaveStateThread{[&] {
+        // The thread writes any pending save states before exiting
+        m_saveStateThreadRunning = false;
+        m_writeSaveStateEvent.Set();
+        if (m_saveStateThread.joinable()) {
+            m_saveStateThread.join();
+        }
+    }};
+
     SDL_ShowWindow(screen.window);
 
     // Load gamepad database
@@ -2350,6 +2390,16 @@ void App::RunEmulator() {
 
                     ImGui::Separator();
 
+                    if (m_context.recordingMovie) {
+                        if (ImGui::MenuItem("Stop recording input movie")) {
+                            m_context.EnqueueEvent(events::emu::StopMovieRecording());
+                        }
+                    } else if (ImGui::MenuItem("Record input movie...")) {
+                        OpenRecordMovieDialog();
+                    }
+
+                    ImGui::Separator();
+
                     if (ImGui::MenuItem("Open profile directory")) {
                         SDL_OpenURL(fmt::format("file:///{}", m_context.profile.GetPath(ProfilePath::Root)).c_str());
                     }
@@ -2852,9 +2902,9 @@ void App::RunEmulator() {
                 const double t = (delta - kOpaqueTime) / kFadeTime;
                 const double alpha = std::clamp(1.0 - t, 0.0, 1.0);
 
-                ui::widgets::RewindBar(m_context, alpha);
-
-                // TODO: add mouse interactions
+                if (auto seekPosition = ui::widgets::RewindBar(m_context, alpha)) {
+                    m_context.EnqueueEvent(events::emu::SeekRewindBuffer(*seekPosition));
+                }
             }
 
             // Draw pause/fast forward/rewind indicators on top-right of viewport
@@ -3311,9 +3361,15 @@ void App::EmulatorThread() {
 
     std::array<EmuEvent, 64> evts{};
 
+    // Records an event into the input movie, replacing its opposite event if both happen before the same frame
+    auto recordMovieEvent = [&](uint8 event, uint8 oppositeEvent) {
+        m_movieRecording.events = (m_movieRecording.events & ~oppositeEvent) | event;
+    };
+
     while (true) {
         const bool paused = m_context.paused;
         StepAction stepAction = paused ? StepAction::Noop : StepAction::RunFrame;
+        std::optional<size_t> seekPosition{};
 
         // Process all pending events
         const size_t evtCount = paused ? m_context.eventQueues.emulator.wait_dequeue_bulk(evts.begin(), evts.size())
@@ -3322,10 +3378,29 @@ void App::EmulatorThread() {
             EmuEvent &evt = evts[i];
             using enum EmuEvent::Type;
             switch (evt.type) {
-            case FactoryReset: m_context.saturn.instance->FactoryReset(); break;
-            case HardReset: m_context.saturn.instance->Reset(true); break;
-            case SoftReset: m_context.saturn.instance->Reset(false); break;
-            case SetResetButton: m_context.saturn.instance->SMPC.SetResetButtonState(std::get<bool>(evt.value)); break;
+            case FactoryReset:
+                m_context.saturn.instance->FactoryReset();
+                m_movieRecording.resync = true;
+                break;
+            case HardReset:
+                m_context.saturn.instance->Reset(true);
+                recordMovieEvent(ymir::movie::event::kHardReset, 0);
+                break;
+            case SoftReset:
+                m_context.saturn.instance->Reset(false);
+                recordMovieEvent(ymir::movie::event::kSoftReset, 0);
+                break;
+            case SetResetButton: //
+            {
+                const bool pressed = std::get<bool>(evt.value);
+                m_context.saturn.instance->SMPC.SetResetButtonState(pressed);
+                if (pressed) {
+                    recordMovieEvent(ymir::movie::event::kPressResetButton, ymir::movie::event::kReleaseResetButton);
+                } else {
+                    recordMovieEvent(ymir::movie::event::kReleaseResetButton, ymir::movie::event::kPressResetButton);
+                }
+                break;
+            }
 
             case SetPaused: //
             {
@@ -3350,7 +3425,13 @@ void App::EmulatorThread() {
                 m_context.rewinding = true;
                 m_context.audioSystem.SetSilent(false);
                 break;
+            case SeekRewindBuffer:
+                stepAction = StepAction::FrameStep;
+                m_context.paused = true;
+                seekPosition = std::get<size_t>(evt.value);
+                break;
             case StepMSH2:
+                EndMovieRecording("single-stepping");
                 stepAction = StepAction::StepMSH2;
                 if (!m_context.paused) {
                     m_context.paused = true;
@@ -3359,6 +3440,7 @@ void App::EmulatorThread() {
                 m_context.audioSystem.SetSilent(true);
                 break;
             case StepSSH2:
+                EndMovieRecording("single-stepping");
                 stepAction = StepAction::StepSSH2;
                 if (!m_context.paused) {
                     m_context.paused = true;
@@ -3370,14 +3452,17 @@ void App::EmulatorThread() {
             case OpenCloseTray:
                 if (m_context.saturn.instance->IsTrayOpen()) {
                     m_context.saturn.instance->CloseTray();
+                    recordMovieEvent(ymir::movie::event::kCloseTray, ymir::movie::event::kOpenTray);
                     m_context.DisplayMessage("Disc tray closed");
                 } else {
                     m_context.saturn.instance->OpenTray();
+                    recordMovieEvent(ymir::movie::event::kOpenTray, ymir::movie::event::kCloseTray);
                     m_context.DisplayMessage("Disc tray opened");
                 }
                 break;
             case LoadDisc: //
             {
+                EndMovieRecording("disc changed");
                 auto path = std::get<std::filesystem::path>(evt.value);
                 // LoadDiscImage locks the disc mutex
                 if (LoadDiscImage(path)) {
@@ -3397,6 +3482,7 @@ void App::EmulatorThread() {
             }
             case EjectDisc: //
             {
+                EndMovieRecording("disc ejected");
                 std::unique_lock lock{m_context.locks.disc};
                 m_context.saturn.instance->EjectDisc();
                 m_context.state.loadedDiscImagePath.clear();
@@ -3408,6 +3494,7 @@ void App::EmulatorThread() {
             }
             case RemoveCartridge: //
             {
+                EndMovieRecording("cartridge removed");
                 std::unique_lock lock{m_context.locks.cart};
                 m_context.saturn.instance->RemoveCartridge();
                 break;
@@ -3418,6 +3505,7 @@ void App::EmulatorThread() {
                 std::unique_lock lock{m_context.locks.backupRAM};
                 m_context.saturn.instance->mem.GetInternalBackupRAM().CopyFrom(
                     std::get<ymir::bup::BackupMemory>(evt.value));
+                m_movieRecording.resync = true;
                 break;
             }
             case ReplaceExternalBackupMemory:
@@ -3427,7 +3515,19 @@ void App::EmulatorThread() {
                 }
                 break;
 
-            case RunFunction: std::get<std::function<void(SharedContext &)>>(evt.value)(m_context); break;
+            case StartMovieRecording:
+                EndMovieRecording({});
+                m_movieRecording.pendingPath = std::get<std::filesystem::path>(evt.value);
+                m_context.recordingMovie = true;
+                break;
+            case StopMovieRecording: EndMovieRecording({}); break;
+
+            case RunFunction:
+                std::get<std::function<void(SharedContext &)>>(evt.value)(m_context);
+                // Functions can change the system state in arbitrary ways, such as loading save states or writing to
+                // memory, which can only be captured with a full keyframe
+                m_movieRecording.resync = true;
+                break;
 
             case ReceiveMidiInput:
                 m_context.saturn.instance->SCSP.ReceiveMidiInput(std::get<ymir::scsp::MidiMessage>(evt.value));
@@ -3438,6 +3538,10 @@ void App::EmulatorThread() {
             case Shutdown: return;
             }
         }
+        if (evtCount > 0) {
+            // Events may change the system state in ways that preemptive run-ahead must not roll back
+            ResetRunAhead(false);
+        }
 
         // Emulate one frame
         switch (stepAction) {
@@ -3453,9 +3557,17 @@ void App::EmulatorThread() {
 
             const bool rewindEnabled = m_context.rewindBuffer.IsRunning();
             bool doRunFrame = true;
-            if (rewindEnabled && m_context.rewinding) {
-                if (m_context.rewindBuffer.PopState()) {
+            const bool seeking = rewindEnabled && seekPosition.has_value();
+            if (m_movieRecording.IsActive() && (seeking || (rewindEnabled && m_context.rewinding))) {
+                EndMovieRecording("rewinding");
+            }
+            if (seeking || (rewindEnabled && m_context.rewinding)) {
+                const bool restored = seeking ? m_context.rewindBuffer.SeekState(*seekPosition)
+                                              : m_context.rewindBuffer.PopState();
+                if (restored) {
                     if (!m_context.saturn.instance->LoadState(m_context.rewindBuffer.NextState)) {
+                        // The rewind buffer state no longer matches the emulator; resync on the next save
+                        m_context.saturn.instance->InvalidateIncrementalState();
                         doRunFrame = false;
                     }
                 } else {
@@ -3463,13 +3575,41 @@ void App::EmulatorThread() {
                 }
             }
 
-            if (doRunFrame) [[likely]] {
-                m_context.saturn.instance->RunFrame();
+            // Movie frames are recorded right before running them, after all pending events have been applied
+            if (doRunFrame && m_movieRecording.IsActive()) {
+                RecordMovieFrame();
             }
 
-            if (rewindEnabled && !m_context.rewinding) {
-                m_context.saturn.instance->SaveState(m_context.rewindBuffer.NextState);
-                m_context.rewindBuffer.ProcessState();
+            // The frame following a seek is only run to display the restored state, so don't record it
+            const bool recordRewind = rewindEnabled && !m_context.rewinding && !seeking;
+
+            // Run-ahead only applies to regular emulation and is suspended while recording input movies
+            const auto &generalSettings = m_context.settings.general;
+            const uint32 runAheadFrames = std::clamp(generalSettings.runAheadFrames, 0, kMaxRunAheadFrames);
+            const bool runAhead = doRunFrame && runAheadFrames > 0 && stepAction == StepAction::RunFrame &&
+                                  !m_context.rewinding && !seeking && !m_movieRecording.IsActive() &&
+                                  !m_context.saturn.instance->IsDebugTracingEnabled();
+            if (!runAhead || !generalSettings.preemptiveRunAhead) {
+                ResetRunAhead(runAheadFrames == 0);
+            }
+
+            if (runAhead && !generalSettings.preemptiveRunAhead) {
+                // Also records the rewind frame
+                RunFrameAhead(runAheadFrames, recordRewind);
+            } else {
+                if (doRunFrame) [[likely]] {
+                    if (runAhead) {
+                        RunFramePreemptive(runAheadFrames);
+                    } else {
+                        m_context.saturn.instance->RunFrame();
+                    }
+                }
+
+                if (recordRewind) {
+                    m_context.rewindBuffer.BeginState();
+                    SaveStateIncremental(m_context.rewindBuffer.NextState, m_context.rewindBuffer.NextDirtyPages);
+                    m_context.rewindBuffer.ProcessState();
+                }
             }
 
             if (stepAction == StepAction::FrameStep) {
@@ -3555,6 +3695,54 @@ void App::ScreenshotThread() {
     }
 }
 
+void App::SaveStateThread() {
+    util::SetCurrentThreadName("Save state writer thread");
+
+    while (true) {
+        m_writeSaveStateEvent.Wait();
+        m_writeSaveStateEvent.Reset();
+
+        for (size_t slot = 0; slot < m_pendingSaveStates.size(); slot++) {
+            // Take the pending state with the files lock held so that ClearSaveStates() cannot remove the files
+            // between the state being taken and written
+            std::unique_lock lock{m_saveStateFilesMtx};
+            PendingSaveState pending{};
+            {
+                std::unique_lock pendingLock{m_pendingSaveStatesMtx};
+                std::swap(pending, m_pendingSaveStates[slot]);
+            }
+            if (!pending.state) {
+                continue;
+            }
+
+            try {
+                WriteSaveStateMeta(pending.state->cdblock.discHash);
+            } catch (const std::exception &e) {
+                devlog::warn<grp::base>("Could not write save state metadata: {}", e.what());
+            }
+
+            // Create directory for this game's save states
+            auto basePath = m_context.profile.GetPath(ProfilePath::SaveStates);
+            auto gameStatesPath = basePath / ymir::ToString(pending.state->cdblock.discHash);
+            std::error_code error{};
+            std::filesystem::create_directories(gameStatesPath, error);
+
+            // Write save state
+            auto statePath = gameStatesPath / fmt::format("{}.savestate", slot);
+            if (error || !ymir::state::WriteStateFile(statePath, *pending.state, pending.compress, error)) {
+                devlog::error<grp::base>("Could not write save state to {}: {}", statePath, error.message());
+                m_context.DisplayMessage(fmt::format("Could not write save state {} to disk: {}", slot + 1,
+                                                     error.message()));
+            }
+        }
+
+        // Pending save states are flushed before exiting
+        if (!m_saveStateThreadRunning) {
+            break;
+        }
+    }
+}
+
 void App::OpenWelcomeModal(bool scanIPLROMs) {
     bool activeScanning = scanIPLROMs;
 
@@ -3940,7 +4128,19 @@ void App::CheckDebuggerStateDirty() {
 
 template <int port>
 void App::ReadPeripheral(ymir::peripheral::PeripheralReport &report) {
-    // TODO: this is the appropriate location to capture inputs for a movie recording
+    // Movie recordings latch the inputs before every frame so that the recorded reports match what the system reads
+    if (m_movieRecording.writer.IsOpen()) {
+        const auto &input = m_movieRecording.inputs[port - 1];
+        if (input.type == report.type) {
+            report.report = input.report;
+            return;
+        }
+    }
+    ReadLivePeripheral<port>(report);
+}
+
+template <int port>
+void App::ReadLivePeripheral(ymir::peripheral::PeripheralReport &report) {
     switch (report.type) {
     case ymir::peripheral::PeripheralType::ControlPad:
         report.report.controlPad.buttons = m_context.controlPadInputs[port - 1].buttons;
@@ -3983,6 +4183,17 @@ void App::ReadPeripheral(ymir::peripheral::PeripheralReport &report) {
     }
 }
 
+std::array<ymir::peripheral::PeripheralReport, 2> App::ReadPeripheralInputs() {
+    // Value-initialized so that the unused parts of the reports are zero and can be compared
+    std::array<ymir::peripheral::PeripheralReport, 2> reports{};
+    auto &smpc = m_context.saturn.instance->SMPC;
+    reports[0].type = smpc.GetPeripheralPort1().GetPeripheral().GetType();
+    reports[1].type = smpc.GetPeripheralPort2().GetPeripheral().GetType();
+    ReadLivePeripheral<1>(reports[0]);
+    ReadLivePeripheral<2>(reports[1]);
+    return reports;
+}
+
 void App::ReloadSDLGameControllerDatabase() {
     std::filesystem::path gcdbPath = m_context.profile.GetPath(ProfilePath::Root) / "gamecontrollerdb.txt";
     if (std::filesystem::is_regular_file(gcdbPath)) {
@@ -4209,7 +4420,10 @@ void App::ApplyGameSpecificConfiguration() {
 }
 
 void App::LoadSaveStates() {
-    WriteSaveStateMeta();
+    {
+        std::unique_lock lock{m_saveStateFilesMtx};
+        WriteSaveStateMeta(m_context.saturn.instance->GetDiscHash());
+    }
 
     auto basePath = m_context.profile.GetPath(ProfilePath::SaveStates);
     auto gameStatesPath = basePath / ymir::ToString(m_context.saturn.instance->GetDiscHash());
@@ -4217,13 +4431,12 @@ void App::LoadSaveStates() {
     for (uint32 slot = 0; slot < m_context.saveStates.size(); slot++) {
         std::unique_lock lock{m_context.locks.saveStates[slot]};
         auto statePath = gameStatesPath / fmt::format("{}.savestate", slot);
-        std::ifstream in{statePath, std::ios::binary};
         auto &saveStateSlot = m_context.saveStates[slot];
-        if (in) {
-            cereal::PortableBinaryInputArchive archive{in};
+        std::error_code error{};
+        if (std::filesystem::is_regular_file(statePath, error)) {
             try {
                 auto state = std::make_unique<ymir::state::State>();
-                archive(*state);
+                ymir::state::ReadStateFile(statePath, *state);
                 saveStateSlot.state.swap(state);
 
                 SDL_PathInfo pathInfo{};
@@ -4252,6 +4465,15 @@ void App::ClearSaveStates() {
     auto basePath = m_context.profile.GetPath(ProfilePath::SaveStates);
     auto gameStatesPath = basePath / ymir::ToString(m_context.saturn.instance->GetDiscHash());
 
+    // Wait for the save state being written, if any, and drop those that haven't been written yet
+    std::unique_lock filesLock{m_saveStateFilesMtx};
+    {
+        std::unique_lock lock{m_pendingSaveStatesMtx};
+        for (auto &pending : m_pendingSaveStates) {
+            pending = {};
+        }
+    }
+
     for (uint32 slot = 0; slot < m_context.saveStates.size(); slot++) {
         std::unique_lock lock{m_context.locks.saveStates[slot]};
         auto statePath = gameStatesPath / fmt::format("{}.savestate", slot);
@@ -4285,28 +4507,24 @@ void App::PersistSaveState(size_t slot) {
 
     std::unique_lock lock{m_context.locks.saveStates[slot]};
     if (m_context.saveStates[slot].state) {
-        auto &state = *m_context.saveStates[slot].state;
-
-        // Create directory for this game's save states
-        auto basePath = m_context.profile.GetPath(ProfilePath::SaveStates);
-        auto gameStatesPath = basePath / ymir::ToString(state.cdblock.discHash);
-        std::filesystem::create_directories(gameStatesPath);
-
-        // Write save state
-        auto statePath = gameStatesPath / fmt::format("{}.savestate", slot);
-        std::ofstream out{statePath, std::ios::binary};
-        cereal::PortableBinaryOutputArchive archive{out};
-        archive(state);
-
-        WriteSaveStateMeta();
+        // Hand a copy of the state over to the save state writer thread, replacing any older state pending for this
+        // slot. Serialization, compression and file I/O all happen in the background.
+        auto state = std::make_unique<ymir::state::State>(*m_context.saveStates[slot].state);
+        lock.unlock();
+        {
+            std::unique_lock pendingLock{m_pendingSaveStatesMtx};
+            m_pendingSaveStates[slot].state = std::move(state);
+            m_pendingSaveStates[slot].compress = m_context.settings.general.compressSaveStates;
+        }
+        m_writeSaveStateEvent.Set();
 
         m_context.DisplayMessage(fmt::format("State {} saved", slot + 1));
     }
 }
 
-void App::WriteSaveStateMeta() {
+void App::WriteSaveStateMeta(ymir::XXH128Hash discHash) {
     auto basePath = m_context.profile.GetPath(ProfilePath::SaveStates);
-    auto gameStatesPath = basePath / ymir::ToString(m_context.saturn.instance->GetDiscHash());
+    auto gameStatesPath = basePath / ymir::ToString(discHash);
     auto gameMetaPath = gameStatesPath / "meta.txt";
 
     // No need to write the meta file if it exists and is recent enough
@@ -4318,10 +4536,17 @@ void App::WriteSaveStateMeta() {
         }
     }
 
+    std::unique_lock lock{m_context.locks.disc};
+
+    // The metadata describes the loaded disc. If the state belongs to a disc that has since been replaced, leave the
+    // meta file to be written the next time that disc is loaded.
+    if (m_context.saturn.instance->GetDiscHash() != discHash) {
+        return;
+    }
+
     std::filesystem::create_directories(gameStatesPath);
     std::ofstream out{gameMetaPath};
     if (out) {
-        std::unique_lock lock{m_context.locks.disc};
         const auto &disc = m_context.saturn.instance->CDBlock.GetDisc();
 
         auto iter = std::ostream_iterator<char>(out);
@@ -4381,9 +4606,251 @@ void App::ToggleRewindBuffer() {
     EnableRewindBuffer(m_context.settings.general.enableRewindBuffer);
 }
 
+void App::SaveStateIncremental(ymir::state::State &state, ymir::state::DirtyPages &dirty) {
+    // Incremental saves only copy the pages modified since the previous incremental save, so switching to another
+    // state object requires a full copy
+    if (m_incrementalSaveTarget != &state) {
+        m_context.saturn.instance->InvalidateIncrementalState();
+        m_incrementalSaveTarget = &state;
+    }
+    m_context.saturn.instance->SaveStateIncremental(state, dirty);
+}
+
+void App::RunFrameAhead(uint32 frames, bool recordRewind) {
+    auto &saturn = *m_context.saturn.instance;
+    auto &screen = m_context.screen;
+    auto &audioSystem = m_context.audioSystem;
+
+    // Run the actual frame with sound, but don't show it
+    screen.skipFrames = true;
+    saturn.RunFrame();
+
+    // Take a snapshot of the actual frame. The rewind buffer's state doubles as the snapshot when recording, so that
+    // both share a single incremental save.
+    ymir::state::State *snapshot;
+    if (recordRewind) {
+        m_context.rewindBuffer.BeginState();
+        SaveStateIncremental(m_context.rewindBuffer.NextState, m_context.rewindBuffer.NextDirtyPages);
+        m_context.rewindBuffer.ProcessState();
+        snapshot = &m_context.rewindBuffer.NextState;
+    } else {
+        if (!m_runAhead.state) {
+            m_runAhead.state = std::make_unique<ymir::state::State>();
+        }
+        SaveStateIncremental(*m_runAhead.state, m_runAhead.dirtyPages);
+        snapshot = m_runAhead.state.get();
+    }
+
+    // Run ahead silently and show the last frame. Samples from the actual frame still pending in the batch must be
+    // delivered before muting the output, and the resampler must resume from where the actual frame left off.
+    saturn.SCSP.FlushSampleBatch();
+    saturn.SCSP.SaveOutputStreamState(m_runAhead.resamplerState);
+    audioSystem.SetDiscardSamples(true);
+    for (uint32 i = 1; i <= frames; ++i) {
+        screen.skipFrames = i < frames;
+        saturn.RunFrame();
+    }
+    screen.skipFrames = false;
+    audioSystem.SetDiscardSamples(false);
+
+    // Go back to the actual frame. The snapshot matches the system state after loading it, so the next incremental
+    // save only copies the pages modified from here on.
+    if (!saturn.LoadStateIncremental(*snapshot)) {
+        devlog::warn<grp::base>("Failed to restore run-ahead snapshot");
+        saturn.InvalidateIncrementalState();
+    }
+    saturn.SCSP.DiscardSampleBatch();
+    saturn.SCSP.LoadOutputStreamState(m_runAhead.resamplerState);
+}
+
+void App::RunFramePreemptive(uint32 frames) {
+    auto &saturn = *m_context.saturn.instance;
+    auto &screen = m_context.screen;
+    auto &audioSystem = m_context.audioSystem;
+    auto &runAhead = m_runAhead;
+
+    if (runAhead.history.size() != frames) {
+        runAhead.history.resize(frames);
+        for (auto &state : runAhead.history) {
+            if (!state) {
+                state = std::make_unique<ymir::state::State>();
+            }
+        }
+        runAhead.historyStart = 0;
+        runAhead.historyCount = 0;
+    }
+
+    // When the inputs change, replay the latest frames with the new inputs as if they had been applied that many
+    // frames earlier. The frames were already seen and heard with the previous inputs, so they are replayed silently.
+    const auto inputs = ReadPeripheralInputs();
+    const bool inputsChanged = std::memcmp(&inputs, &runAhead.lastInputs, sizeof(inputs)) != 0;
+    runAhead.lastInputs = inputs;
+    if (inputsChanged && runAhead.historyCount == frames) {
+        // Deliver the samples already heard and keep the resampler going from there once the replay is done
+        saturn.SCSP.FlushSampleBatch();
+        saturn.SCSP.SaveOutputStreamState(runAhead.resamplerState);
+        if (saturn.LoadState(*runAhead.history[runAhead.historyStart])) {
+            screen.skipFrames = true;
+            audioSystem.SetDiscardSamples(true);
+            for (size_t i = 0; i < frames; ++i) {
+                // The oldest state was just loaded and is still valid; the rest must be saved again
+                if (i > 0) {
+                    saturn.SaveState(*runAhead.history[(runAhead.historyStart + i) % frames]);
+                }
+                saturn.RunFrame();
+            }
+            screen.skipFrames = false;
+            audioSystem.SetDiscardSamples(false);
+            saturn.SCSP.DiscardSampleBatch();
+            saturn.SCSP.LoadOutputStreamState(runAhead.resamplerState);
+        } else {
+            devlog::warn<grp::base>("Failed to restore preemptive run-ahead state");
+            runAhead.historyCount = 0;
+        }
+    }
+
+    // Save the state before the frame, replacing the oldest one if the history is full
+    const size_t index = (runAhead.historyStart + runAhead.historyCount) % frames;
+    if (runAhead.historyCount < frames) {
+        ++runAhead.historyCount;
+    } else {
+        runAhead.historyStart = (runAhead.historyStart + 1) % frames;
+    }
+    saturn.SaveState(*runAhead.history[index]);
+    saturn.RunFrame();
+}
+
+void App::ResetRunAhead(bool releaseMemory) {
+    m_runAhead.historyStart = 0;
+    m_runAhead.historyCount = 0;
+    if (releaseMemory) {
+        m_runAhead.history.clear();
+        if (m_runAhead.state) {
+            if (m_incrementalSaveTarget == m_runAhead.state.get()) {
+                m_incrementalSaveTarget = nullptr;
+            }
+            m_runAhead.state.reset();
+        }
+    }
+}
+
+void App::OpenRecordMovieDialog() {
+    static constexpr SDL_DialogFileFilter kFileFilters[] = {
+        {.name = "Ymir input movies (*.ymv)", .pattern = "ymv"},
+        {.name = "All files (*.*)", .pattern = "*"},
+    };
+
+    const auto localNow = util::to_local_time(std::chrono::system_clock::now());
+    const auto defaultPath =
+        m_context.profile.GetPath(ProfilePath::Movies) /
+        fmt::format("{}-{:%Y%m%d}T{:%H%M%S}.ymv", m_context.GetGameFileName(), localNow, localNow);
+
+    InvokeFileDialog(SDL_FILEDIALOG_SAVEFILE, "Record input movie", (void *)kFileFilters, std::size(kFileFilters),
+                     false, fmt::format("{}", defaultPath).c_str(), this,
+                     [](void *userdata, const char *const *filelist, int filter) {
+                         static_cast<App *>(userdata)->ProcessRecordMovieDialogSelection(filelist, filter);
+                     });
+}
+
+void App::ProcessRecordMovieDialogSelection(const char *const *filelist, int filter) {
+    if (filelist == nullptr) {
+        devlog::error<grp::base>("Failed to open file dialog: {}", SDL_GetError());
+    } else if (*filelist == nullptr) {
+        devlog::info<grp::base>("File dialog cancelled");
+    } else {
+        // Only one file should be selected
+        const char *file = *filelist;
+        std::string fileStr = file;
+        const std::u8string u8File{fileStr.begin(), fileStr.end()};
+        m_context.EnqueueEvent(events::emu::StartMovieRecording(u8File));
+    }
+}
+
+void App::RecordMovieFrame() {
+    auto &saturn = *m_context.saturn.instance;
+    auto &recording = m_movieRecording;
+
+    auto readBackupRAM = [&] {
+        std::unique_lock lock{m_context.locks.backupRAM};
+        return saturn.mem.GetInternalBackupRAM().ReadAll();
+    };
+
+    if (!recording.keyframeState) {
+        recording.keyframeState = std::make_unique<ymir::state::State>();
+    }
+
+    bool success = true;
+    if (!recording.pendingPath.empty()) {
+        // Start the movie with the current state, which includes all events processed so far
+        auto path = std::move(recording.pendingPath);
+        recording.pendingPath.clear();
+        recording.events = 0;
+        recording.resync = false;
+
+        saturn.SaveState(*recording.keyframeState);
+        std::error_code error{};
+        // The initial keyframe also stores the state as a save state archive so that the movie can still be played
+        // from the start by builds with a different binary state layout
+        const auto persistentState = ymir::state::WriteStateArchive(*recording.keyframeState);
+        if (!recording.writer.Open(path, ymir::movie::CaptureMovieInfo(saturn), *recording.keyframeState,
+                                   readBackupRAM(), persistentState, error)) {
+            devlog::error<grp::base>("Could not create movie file {}: {}", path, error.message());
+            m_context.DisplayMessage(fmt::format("Could not create movie file: {}", error.message()));
+            recording.keyframeState.reset();
+            m_context.recordingMovie = false;
+            return;
+        }
+        if (saturn.configuration.rtc.mode == ymir::core::config::rtc::Mode::Host) {
+            m_context.DisplayMessage("Recording input movie; the RTC follows the host clock, playback may desync");
+        } else {
+            m_context.DisplayMessage("Recording input movie");
+        }
+    } else if (recording.resync || recording.writer.IsKeyframeDue()) {
+        saturn.SaveState(*recording.keyframeState);
+        success = recording.writer.WriteKeyframe(*recording.keyframeState, readBackupRAM(), recording.resync);
+        recording.resync = false;
+    }
+
+    // Latch the inputs for the frame; ReadPeripheral returns them while the frame runs
+    recording.inputs = ReadPeripheralInputs();
+    success = success && recording.writer.WriteFrame({.inputs = recording.inputs, .events = recording.events});
+    recording.events = 0;
+
+    if (!success) {
+        EndMovieRecording("could not write to the movie file");
+    }
+}
+
+void App::EndMovieRecording(std::string_view reason) {
+    auto &recording = m_movieRecording;
+    if (!recording.IsActive()) {
+        return;
+    }
+
+    const bool started = recording.writer.IsOpen();
+    const uint64 frameCount = recording.writer.GetFrameCount();
+    recording.writer.Close();
+    recording.pendingPath.clear();
+    recording.keyframeState.reset();
+    recording.events = 0;
+    recording.resync = false;
+    m_context.recordingMovie = false;
+
+    if (!started) {
+        return;
+    }
+    if (reason.empty()) {
+        m_context.DisplayMessage(fmt::format("Input movie recording stopped after {} frames", frameCount));
+    } else {
+        m_context.DisplayMessage(
+            fmt::format("Input movie recording stopped after {} frames: {}", frameCount, reason));
+    }
+}
+
 void App::OpenLoadDiscDialog() {
     static constexpr SDL_DialogFileFilter kCartFileFilters[] = {
-        {.name = "All supported formats (*.ccd, *.chd, *.cue, *.iso, *.mds)", .pattern = "ccd;chd;cue;iso;mds"},
+        {.name = "All supported formats (*.ccd, *.chd, *.cue, *.iso, *.mds, *.ycd)",
+         .pattern = "ccd;chd;cue;iso;mds;ycd"},
         {.name = "All files (*.*)", .pattern = "*"},
     };
 
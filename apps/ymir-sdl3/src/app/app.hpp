@@ -19,6 +19,7 @@
 #include "ui/windows/debug/vdp_window_set.hpp"
 
 #include <ymir/hw/smpc/peripheral/peripheral_report.hpp>
+#include <ymir/movie/movie.hpp>
 
 #include <util/ipl_rom_loader.hpp>
 
@@ -29,8 +30,11 @@
 
 #include <imgui.h>
 
+#include <array>
 #include <chrono>
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <string_view>
 #include <thread>
 #include <vector>
@@ -68,10 +72,66 @@ private:
     std::mutex m_screenshotQueueMtx;
     bool m_screenshotThreadRunning;
 
+    struct PendingSaveState {
+        std::unique_ptr<ymir::state::State> state;
+        bool compress;
+    };
+
+    std::thread m_saveStateThread;
+    util::Event m_writeSaveStateEvent;
+    // Save states waiting to be written to disk, by slot
+    std::array<PendingSaveState, std::tuple_size_v<decltype(SharedContext::saveStates)>> m_pendingSaveStates;
+    std::mutex m_pendingSaveStatesMtx;
+    std::mutex m_saveStateFilesMtx; // Held while writing to or removing save state files; taken before the mutex above
+    bool m_saveStateThreadRunning;
+
+    // Run-ahead state, owned by the emulator thread
+    struct RunAhead {
+        // Snapshot of the latest actual frame, updated with incremental saves.
+        // Only used when the rewind buffer is disabled; the rewind buffer's state is used otherwise.
+        std::unique_ptr<ymir::state::State> state;
+        ymir::state::DirtyPages dirtyPages;
+
+        // Preemptive mode: states saved before each of the latest frames, oldest first starting at historyStart
+        std::vector<std::unique_ptr<ymir::state::State>> history;
+        size_t historyStart = 0;
+        size_t historyCount = 0;
+
+        // Preemptive mode: peripheral inputs as of the previous frame
+        std::array<ymir::peripheral::PeripheralReport, 2> lastInputs{};
+
+        // Audio resampler stream state as of the latest audible sample, restored after running hidden frames
+        ymir::scsp::Resampler::StreamState resamplerState;
+    } m_runAhead;
+
+    // State object targeted by the latest incremental save
+    const ymir::state::State *m_incrementalSaveTarget = nullptr;
+
+    // Input movie recording state, owned by the emulator thread
+    struct MovieRecording {
+        ymir::movie::MovieWriter writer;
+
+        // Movie file to be created before the next frame, once all pending events have been processed
+        std::filesystem::path pendingPath;
+
+        std::unique_ptr<ymir::state::State> keyframeState;
+
+        // Peripheral inputs latched for the current frame
+        std::array<ymir::peripheral::PeripheralReport, 2> inputs{};
+
+        uint8 events = 0;    // ymir::movie::event flags applied since the last recorded frame
+        bool resync = false; // Write a resync keyframe before the next frame
+
+        bool IsActive() const {
+            return writer.IsOpen() || !pendingPath.empty();
+        }
+    } m_movieRecording;
+
     void RunEmulator();
 
     void EmulatorThread();
     void ScreenshotThread();
+    void SaveStateThread();
 
     void OpenWelcomeModal(bool scanIPLROMS);
 
@@ -89,6 +149,9 @@ private:
 
     template <int port>
     void ReadPeripheral(ymir::peripheral::PeripheralReport &report);
+    template <int port>
+    void ReadLivePeripheral(ymir::peripheral::PeripheralReport &report);
+    std::array<ymir::peripheral::PeripheralReport, 2> ReadPeripheralInputs();
 
     void ReloadSDLGameControllerDatabase();
 
@@ -107,11 +170,21 @@ private:
     void SaveSaveStateSlot(size_t slot);
     void SelectSaveStateSlot(size_t slot);
     void PersistSaveState(size_t slot);
-    void WriteSaveStateMeta();
+    void WriteSaveStateMeta(ymir::XXH128Hash discHash);
 
     void EnableRewindBuffer(bool enable);
     void ToggleRewindBuffer();
 
+    void SaveStateIncremental(ymir::state::State &state, ymir::state::DirtyPages &dirty);
+    void RunFrameAhead(uint32 frames, bool recordRewind);
+    void RunFramePreemptive(uint32 frames);
+    void ResetRunAhead(bool releaseMemory);
+
+    void OpenRecordMovieDialog();
+    void ProcessRecordMovieDialogSelection(const char *const *filelist, int filter);
+    void RecordMovieFrame();
+    void EndMovieRecording(std::string_view reason);
+
     void OpenLoadDiscDialog();
     void ProcessOpenDiscImageFileDialogSelection(const char *const *filelist, int filter);
     bool LoadDiscImage(std::filesystem::path path);
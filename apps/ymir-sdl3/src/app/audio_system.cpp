@@ -3,6 +3,7 @@
 #include <SDL3/SDL_hints.h>
 #include <SDL3/SDL_log.h>
 
+#include <algorithm>
 #include <string>
 
 namespace app {
@@ -72,6 +73,10 @@ bool AudioSystem::GetAudioStreamFormat(int *sampleRate, SDL_AudioFormat *format,
 }
 
 void AudioSystem::ReceiveSample(sint16 left, sint16 right) {
+    if (m_discardSamples) {
+        return;
+    }
+
     // If we're doing audio sync, wait until the buffer is no longer full.
     // Otherwise, simply overrun the buffer.
     if (m_sync) {
@@ -86,6 +91,33 @@ void AudioSystem::ReceiveSample(sint16 left, sint16 right) {
     }
 }
 
+void AudioSystem::ReceiveSamples(std::span<const Sample> samples) {
+    if (m_discardSamples) {
+        return;
+    }
+
+    while (!samples.empty()) {
+        // If we're doing audio sync, wait until the buffer is no longer full.
+        // Otherwise, simply overrun the buffer.
+        if (m_sync) {
+            m_bufferNotFullEvent.Wait();
+        }
+
+        // Copy as many samples as possible in one go, stopping at the read position (when syncing) or at the end of
+        // the buffer, whichever comes first
+        const uint32 readPos = m_readPos.load(std::memory_order_acquire);
+        const uint32 limit = m_sync && readPos > m_writePos ? readPos : m_buffer.size();
+        const uint32 count = std::min<uint32>(limit - m_writePos, samples.size());
+        std::copy_n(samples.begin(), count, m_buffer.begin() + m_writePos);
+        samples = samples.subspan(count);
+
+        m_writePos = (m_writePos + count) % m_buffer.size();
+        if (m_writePos == readPos) {
+            m_bufferNotFullEvent.Reset();
+        }
+    }
+}
+
 void AudioSystem::UpdateGain() {
     SDL_SetAudioStreamGain(m_audioStream, m_mute ? 0.0f : m_gain);
 }
@@ -28,6 +28,7 @@ public:
     bool GetAudioStreamFormat(int *sampleRate, SDL_AudioFormat *format, int *channels);
 
     void ReceiveSample(sint16 left, sint16 right);
+    void ReceiveSamples(std::span<const Sample> samples);
 
     void Snapshot(std::span<Sample, 2048> out) const {
         const uint32 readPos = m_readPos;
@@ -69,6 +70,16 @@ public:
         return m_silent;
     }
 
+    // Drops all received samples without waiting for room in the buffer.
+    // Used to run frames that should not be heard, such as run-ahead frames.
+    void SetDiscardSamples(bool discard) {
+        m_discardSamples = discard;
+    }
+
+    bool IsDiscardSamples() const {
+        return m_discardSamples;
+    }
+
     uint32 GetBufferCount() const {
         uint32 total = m_writePos - m_readPos + m_buffer.size();
         if (total > m_buffer.size()) {
@@ -92,6 +103,7 @@ private:
 
     bool m_sync = true;
     bool m_silent = false;
+    bool m_discardSamples = false;
 
     float m_gain = 0.8f;
     bool m_mute = false;
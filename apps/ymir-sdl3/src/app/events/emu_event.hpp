@@ -22,6 +22,7 @@ struct EmuEvent {
         SetPaused,
         ForwardFrameStep,
         ReverseFrameStep,
+        SeekRewindBuffer,
         StepMSH2,
         StepSSH2,
 
@@ -34,6 +35,9 @@ struct EmuEvent {
         ReplaceInternalBackupMemory,
         ReplaceExternalBackupMemory,
 
+        StartMovieRecording,
+        StopMovieRecording,
+
         RunFunction,
 
         ReceiveMidiInput,
@@ -45,7 +49,7 @@ struct EmuEvent {
 
     Type type;
 
-    std::variant<std::monostate, ymir::scsp::MidiMessage, bool, std::string, std::filesystem::path,
+    std::variant<std::monostate, ymir::scsp::MidiMessage, bool, size_t, std::string, std::filesystem::path,
                  ymir::bup::BackupMemory, std::function<void(SharedContext &)>>
         value;
 };
@@ -497,6 +497,10 @@ EmuEvent SetSCSPStepGranularity(uint32 granularity) {
     return RunFunction([=](SharedContext &ctx) { ctx.saturn.instance->SCSP.SetStepGranularity(granularity); });
 }
 
+EmuEvent SetSCSPSampleBatchSize(uint32 batchSize) {
+    return RunFunction([=](SharedContext &ctx) { ctx.saturn.instance->SCSP.SetSampleBatchSize(batchSize); });
+}
+
 EmuEvent LoadState(uint32 slot) {
     return RunFunction([=](SharedContext &ctx) {
         if (slot < ctx.saveStates.size() && ctx.saveStates[slot].state) {
@@ -39,6 +39,10 @@ inline EmuEvent ReverseFrameStep() {
     return {.type = EmuEvent::Type::ReverseFrameStep};
 }
 
+inline EmuEvent SeekRewindBuffer(size_t position) {
+    return {.type = EmuEvent::Type::SeekRewindBuffer, .value = position};
+}
+
 inline EmuEvent StepMSH2() {
     return {.type = EmuEvent::Type::StepMSH2};
 }
@@ -71,6 +75,14 @@ inline EmuEvent ReplaceExternalBackupMemory(ymir::bup::BackupMemory &&bupMem) {
     return {.type = EmuEvent::Type::ReplaceExternalBackupMemory, .value = std::move(bupMem)};
 }
 
+inline EmuEvent StartMovieRecording(std::filesystem::path path) {
+    return {.type = EmuEvent::Type::StartMovieRecording, .value = path};
+}
+
+inline EmuEvent StopMovieRecording() {
+    return {.type = EmuEvent::Type::StopMovieRecording};
+}
+
 inline EmuEvent RunFunction(std::function<void(SharedContext &)> &&fn) {
     return {.type = EmuEvent::Type::RunFunction, .value = std::move(fn)};
 }
@@ -122,6 +134,7 @@ EmuEvent IncludeVDP1InVDPRenderThread(bool enable);
 
 EmuEvent EnableThreadedSCSP(bool enable);
 EmuEvent SetSCSPStepGranularity(uint32 granularity);
+EmuEvent SetSCSPSampleBatchSize(uint32 batchSize);
 
 EmuEvent LoadState(uint32 slot);
 EmuEvent SaveState(uint32 slot);
@@ -17,6 +17,7 @@ const std::filesystem::path kPathSuffixes[] = {
     "savestates",                                 // SaveStates
     "dumps",                                      // Dumps
     "screenshots",                                // Screenshots
+    "movies",                                     // Movies
 };
 
 Profile::Profile() {
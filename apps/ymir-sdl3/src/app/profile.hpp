@@ -15,6 +15,7 @@ enum class ProfilePath {
     SaveStates,      // Save states            <profile>/savestates/
     Dumps,           // Memory dumps           <profile>/dumps/
     Screenshots,     // Screenshots            <profile>/screenshots/
+    Movies,          // Input movies           <profile>/movies/
 
     _Count,
 };
@@ -1,17 +1,105 @@
 #include "rewind_buffer.hpp"
 
+#include <ymir/state/state_binary.hpp>
+
 #include <ymir/util/data_ops.hpp>
 #include <ymir/util/thread_name.hpp>
 
-#include <cereal/cereal.hpp>
-
-#include <serdes/cereal_archive_vector.hpp>
-#include <serdes/state_cereal.hpp>
-
 #include <lz4.h>
+#include <lz4hc.h>
+
+#include <algorithm>
+#include <span>
 
 namespace app {
 
+// Size of the region and page index preceding each page delta
+static constexpr size_t kPageHeaderSize = sizeof(uint8) + sizeof(uint16);
+
+// LZ4HC compression level used for frames in the history tier
+static constexpr int kHistoryCompressionLevel = LZ4HC_CLEVEL_DEFAULT;
+
+// Returns the size of the pages of the specified memory region.
+static size_t GetPageSize(ymir::state::MemoryRegion region) {
+    return region == ymir::state::MemoryRegion::CDBlockBuffers
+               ? sizeof(ymir::state::CDBlockState::BufferState::data)
+               : ymir::state::kMemoryPageSize;
+}
+
+// Decompresses a frame record into the output buffer.
+static void DecompressRecord(const char *src, uint32 size, uint32 rawSize, std::vector<char> &out) {
+    out.resize(rawSize);
+    [[maybe_unused]] int result = LZ4_decompress_safe(src, out.data(), size, rawSize);
+    assert(result == static_cast<int>(rawSize));
+}
+
+// Merges two consecutive delta records into a single record that converts between the frame preceding the first and
+// the frame of the second.
+static void MergeDeltas(const std::vector<char> &first, const std::vector<char> &second, std::vector<char> &out) {
+    // XOR binary state deltas, treating the shorter one as if padded with zeros
+    const size_t firstStateSize = util::ReadNE<uint32>(&first[0]);
+    const size_t secondStateSize = util::ReadNE<uint32>(&second[0]);
+    const size_t stateSize = std::max(firstStateSize, secondStateSize);
+    out.resize(sizeof(uint32) + stateSize);
+    util::WriteNE<uint32>(&out[0], stateSize);
+    for (size_t i = 0; i < stateSize; i++) {
+        const char a = i < firstStateSize ? first[sizeof(uint32) + i] : 0;
+        const char b = i < secondStateSize ? second[sizeof(uint32) + i] : 0;
+        out[sizeof(uint32) + i] = a ^ b;
+    }
+
+    // Merge page deltas; both lists are sorted by region and page index
+    auto pageKey = [](const std::vector<char> &record, size_t pos) {
+        return (static_cast<uint32>(static_cast<uint8>(record[pos])) << 16u) | util::ReadNE<uint16>(&record[pos + 1]);
+    };
+    auto copyPage = [&](const std::vector<char> &record, size_t &pos) {
+        const auto region = static_cast<ymir::state::MemoryRegion>(record[pos]);
+        const size_t entrySize = kPageHeaderSize + GetPageSize(region);
+        out.insert(out.end(), &record[pos], &record[pos] + entrySize);
+        pos += entrySize;
+    };
+
+    size_t firstPos = sizeof(uint32) + firstStateSize;
+    size_t secondPos = sizeof(uint32) + secondStateSize;
+    while (firstPos < first.size() && secondPos < second.size()) {
+        const uint32 firstKey = pageKey(first, firstPos);
+        const uint32 secondKey = pageKey(second, secondPos);
+        if (firstKey < secondKey) {
+            copyPage(first, firstPos);
+        } else if (secondKey < firstKey) {
+            copyPage(second, secondPos);
+        } else {
+            // Both records modify the page; drop it if the changes cancel out
+            const auto region = static_cast<ymir::state::MemoryRegion>(first[firstPos]);
+            const size_t pageSize = GetPageSize(region);
+            const size_t entryPos = out.size();
+            out.resize(entryPos + kPageHeaderSize + pageSize);
+            std::copy_n(&first[firstPos], kPageHeaderSize, &out[entryPos]);
+
+            const char *a = &first[firstPos + kPageHeaderSize];
+            const char *b = &second[secondPos + kPageHeaderSize];
+            char *dst = &out[entryPos + kPageHeaderSize];
+            uint64 changed = 0;
+            for (size_t i = 0; i < pageSize; i += sizeof(uint64)) {
+                const uint64 delta = util::ReadNE<uint64>(&a[i]) ^ util::ReadNE<uint64>(&b[i]);
+                util::WriteNE<uint64>(&dst[i], delta);
+                changed |= delta;
+            }
+            if (changed == 0) {
+                out.resize(entryPos);
+            }
+            firstPos += kPageHeaderSize + pageSize;
+            secondPos += kPageHeaderSize + pageSize;
+        }
+    }
+    while (firstPos < first.size()) {
+        copyPage(first, firstPos);
+    }
+    while (secondPos < second.size()) {
+        copyPage(second, secondPos);
+    }
+}
+
 RewindBuffer::RewindBuffer() {
     Reset();
 }
@@ -21,6 +109,9 @@ RewindBuffer::~RewindBuffer() {
     if (m_procThread.joinable()) {
         m_procThread.join();
     }
+    if (m_compactThread.joinable()) {
+        m_compactThread.join();
+    }
 }
 
 void RewindBuffer::Reset() {
@@ -31,13 +122,15 @@ void RewindBuffer::Reset() {
         buffer.shrink_to_fit();
     }
     m_deltaBuffer.clear();
+    m_keyframeBuffer.clear();
+
+    ClearFrames();
 
-    for (auto &delta : m_deltas) {
-        delta.clear();
-        delta.shrink_to_fit();
+    // Release the arenas if the buffer is not in use
+    if (!m_running) {
+        m_recent.Release();
+        m_history.Release();
     }
-    m_deltaCount = 0;
-    m_totalDeltaCount = 0;
 }
 
 void RewindBuffer::Start() {
@@ -45,8 +138,12 @@ void RewindBuffer::Start() {
         if (m_procThread.joinable()) {
             m_procThread.join();
         }
+        if (m_compactThread.joinable()) {
+            m_compactThread.join();
+        }
         m_running = true;
         m_procThread = std::thread([&] { ProcThread(); });
+        m_compactThread = std::thread([&] { CompactThread(); });
     }
 }
 
@@ -55,55 +152,130 @@ void RewindBuffer::Stop() {
         m_running = false;
         m_nextStateEvent.Set();
         m_stateProcessedEvent.Set();
+        m_compactEvent.Set();
     }
 }
 
+void RewindBuffer::SetMemoryBudget(size_t bytes) {
+    std::unique_lock lock{m_lock};
+
+    bytes = std::max(bytes, kMinMemoryBudget);
+    if (bytes == m_memoryBudget) {
+        return;
+    }
+    m_memoryBudget = bytes;
+
+    // Arenas are reallocated with the new sizes on demand
+    ClearFrames();
+    m_recent.Release();
+    m_history.Release();
+}
+
 bool RewindBuffer::PopState() {
+    // Make sure the processor thread is done with the last state before replacing it
+    m_stateProcessedEvent.Wait();
+
     std::unique_lock lock{m_lock};
 
-    // Bail out if there are no delta frames
-    if (m_deltaCount == 0) {
+    DiscardFramesAfterCursor();
+
+    // Bail out if there are no frames
+    const size_t count = GetEntryCount();
+    if (count == 0) {
         return false;
     }
 
-    // Remove delta from ring buffer
-    --m_deltaCount;
-    --m_totalDeltaCount;
-    if (m_deltaWritePos == 0) {
-        m_deltaWritePos = m_deltas.size() - 1;
-    } else {
-        --m_deltaWritePos;
-    }
+    // Step the working state back by one frame
+    const Frame &frame = GetEntry(count - 1);
+    DecompressRecord(GetEntryData(count - 1), frame.deltaSize, frame.deltaRawSize, m_deltaBuffer);
+    ApplyRecord(&NextState);
 
-    // Determine buffer size
-    const size_t maxSize = std::max(m_buffers[0].size(), m_buffers[1].size());
+    PopNewestFrame();
+    m_cursor = count > 1 ? count - 2 : 0;
+    ++m_generation;
+    UpdateStats();
 
-    // Decompress last delta frame into the "next" buffer, but don't flip buffers
-    const std::vector<char> &lastDelta = m_deltas[m_deltaWritePos];
-    const size_t size = lastDelta.size();
-    std::vector<char> &buffer = m_buffers[m_bufferFlip];
-    buffer.resize(maxSize);
-    [[maybe_unused]] int result = LZ4_decompress_safe(&lastDelta[0], &buffer[0], size, maxSize);
-    assert(result == maxSize);
+    RestoreNextState();
+    return true;
+}
 
-    // Use pointers to allow for vectorization
-    char *out = &m_buffers[m_bufferFlip ^ 1][0];
-    char *b0 = m_buffers[0].empty() ? nullptr : &m_buffers[0][0];
-    char *b1 = m_buffers[1].empty() ? nullptr : &m_buffers[1][0];
+bool RewindBuffer::SeekState(size_t position) {
+    // Make sure the processor thread is done with the last state before replacing it
+    m_stateProcessedEvent.Wait();
 
-    // Apply XOR delta
-    size_t i = 0;
-    for (; i + sizeof(uint64) < maxSize; i += sizeof(uint64)) {
-        util::WriteNE<uint64>(&out[i], util::ReadNE<uint64>(&b0[i]) ^ util::ReadNE<uint64>(&b1[i]));
+    std::unique_lock lock{m_lock};
+
+    const size_t count = GetEntryCount();
+    if (count == 0) {
+        return false;
     }
-    for (; i < maxSize; i++) {
-        out[i] = b0[i] ^ b1[i];
+    const size_t firstNumber = GetEntry(0).number;
+    const size_t targetNumber = firstNumber + position;
+    if (targetNumber > GetEntry(count - 1).number) {
+        return false;
     }
 
-    // Deserialize state
-    cereal::BinaryVectorInputArchive archive{m_buffers[m_bufferFlip ^ 1]};
-    archive(NextState);
+    // Find the newest stored frame at or before the target
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        const size_t mid = (low + high) / 2;
+        if (GetEntry(mid).number <= targetNumber) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    const size_t target = low - 1;
+
+    // Start from the working state or the nearest keyframe, whichever is closest to the target
+    size_t start = m_cursor;
+    size_t distance = start > target ? start - target : target - start;
+    bool useKeyframe = false;
+    for (size_t i = 0; i < distance; i++) {
+        if (target >= i && GetEntry(target - i).keyframeSize != 0) {
+            start = target - i;
+            useKeyframe = true;
+            break;
+        }
+        if (target + i < count && GetEntry(target + i).keyframeSize != 0) {
+            start = target + i;
+            useKeyframe = true;
+            break;
+        }
+    }
+    if (useKeyframe) {
+        LoadKeyframe(start);
+    }
+
+    // Walk deltas towards the target. Each delta converts between its frame and the previous one in either direction.
+    while (start < target) {
+        ++start;
+        const Frame &frame = GetEntry(start);
+        DecompressRecord(GetEntryData(start), frame.deltaSize, frame.deltaRawSize, m_deltaBuffer);
+        ApplyRecord(nullptr);
+    }
+    while (start > target) {
+        const Frame &frame = GetEntry(start);
+        DecompressRecord(GetEntryData(start), frame.deltaSize, frame.deltaRawSize, m_deltaBuffer);
+        ApplyRecord(nullptr);
+        --start;
+    }
+    m_cursor = target;
+    ++m_generation;
+    UpdateStats();
+
+    // Restore all tracked memory, since any page could have been touched along the way
+    for (size_t regionIndex = 0; regionIndex < ymir::state::kNumMemoryRegions; regionIndex++) {
+        const auto region = static_cast<ymir::state::MemoryRegion>(regionIndex);
+        const size_t pageCount = ymir::state::GetMemoryPageCount(region);
+        for (size_t page = 0; page < pageCount; page++) {
+            std::ranges::copy(ymir::state::GetMemoryPage(m_shadowState, region, page),
+                              ymir::state::GetMemoryPage(NextState, region, page).begin());
+        }
+    }
 
+    RestoreNextState();
     return true;
 }
 
@@ -119,21 +291,109 @@ FLATTEN void RewindBuffer::ProcThread() {
 
         std::unique_lock lock{m_lock};
 
-        // Serialize state to next buffer
-        std::vector<char> &buffer = GetBuffer();
-        cereal::BinaryVectorOutputArchive archive{buffer};
-        archive(NextState);
+        // Write state to next buffer, excluding tracked memory regions which are stored as page deltas instead
+        ymir::state::WriteBinaryState(NextState, GetBuffer(), true);
+
+        // Diff modified memory pages against the previous frame
+        CollectPageDeltas();
         m_stateProcessedEvent.Set();
 
         // Process frame from next buffer
         ProcessFrame();
+        if (NeedsCompaction()) {
+            m_compactEvent.Set();
+        }
     }
+}
+
+void RewindBuffer::CompactThread() {
+    util::SetCurrentThreadName("Rewind buffer compactor");
 
-    // TODO: rewrite ring buffer to reduce number of allocations
-    // TODO: implement keyframes to allow fast jumps to arbitrary points in the timeline
+    while (m_running) {
+        m_compactEvent.Wait();
+        m_compactEvent.Reset();
+
+        while (m_running) {
+            {
+                std::unique_lock lock{m_lock};
+                if (!NeedsCompaction() || !PrepareMigration(m_asyncMigration)) {
+                    break;
+                }
+            }
+
+            // Recompress without holding the lock so that the emulator can keep pushing frames
+            CompressMigration(m_asyncMigration, true);
+
+            std::unique_lock lock{m_lock};
+            if (m_asyncMigration.generation == m_generation) {
+                CommitMigration(m_asyncMigration);
+                UpdateStats();
+            }
+        }
+    }
 }
 
-std::vector<char> &RewindBuffer::GetBuffer() {
+void RewindBuffer::CollectPageDeltas() {
+    m_pageDeltas.clear();
+
+    for (size_t regionIndex = 0; regionIndex < ymir::state::kNumMemoryRegions; regionIndex++) {
+        const auto region = static_cast<ymir::state::MemoryRegion>(regionIndex);
+        for (const uint16 page : NextDirtyPages.pages[regionIndex]) {
+            const std::span<uint8> currPage = ymir::state::GetMemoryPage(NextState, region, page);
+            const std::span<uint8> shadowPage = ymir::state::GetMemoryPage(m_shadowState, region, page);
+
+            // Compute XOR delta directly into the output, then drop it if the page didn't actually change
+            const size_t entryPos = m_pageDeltas.size();
+            m_pageDeltas.resize(entryPos + kPageHeaderSize + currPage.size());
+            char *out = &m_pageDeltas[entryPos + kPageHeaderSize];
+            uint64 changed = 0;
+            for (size_t i = 0; i < currPage.size(); i += sizeof(uint64)) {
+                const uint64 delta = util::ReadNE<uint64>(&currPage[i]) ^ util::ReadNE<uint64>(&shadowPage[i]);
+                util::WriteNE<uint64>(&out[i], delta);
+                changed |= delta;
+            }
+            if (changed == 0) {
+                m_pageDeltas.resize(entryPos);
+                continue;
+            }
+
+            m_pageDeltas[entryPos] = static_cast<char>(region);
+            util::WriteNE<uint16>(&m_pageDeltas[entryPos + 1], page);
+            std::ranges::copy(currPage, shadowPage.begin());
+        }
+    }
+}
+
+void RewindBuffer::BuildKeyframe() {
+    const std::vector<uint8> &state = m_buffers[m_bufferFlip ^ 1];
+    m_keyframeBuffer.resize(sizeof(uint32) + state.size());
+    util::WriteNE<uint32>(&m_keyframeBuffer[0], state.size());
+    std::ranges::copy(state, &m_keyframeBuffer[sizeof(uint32)]);
+
+    // Store all nonzero pages of the working state
+    for (size_t regionIndex = 0; regionIndex < ymir::state::kNumMemoryRegions; regionIndex++) {
+        const auto region = static_cast<ymir::state::MemoryRegion>(regionIndex);
+        const size_t pageCount = ymir::state::GetMemoryPageCount(region);
+        for (size_t page = 0; page < pageCount; page++) {
+            const std::span<uint8> shadowPage = ymir::state::GetMemoryPage(m_shadowState, region, page);
+            uint64 nonzero = 0;
+            for (size_t i = 0; i < shadowPage.size(); i += sizeof(uint64)) {
+                nonzero |= util::ReadNE<uint64>(&shadowPage[i]);
+            }
+            if (nonzero == 0) {
+                continue;
+            }
+
+            const size_t entryPos = m_keyframeBuffer.size();
+            m_keyframeBuffer.resize(entryPos + kPageHeaderSize + shadowPage.size());
+            m_keyframeBuffer[entryPos] = static_cast<char>(region);
+            util::WriteNE<uint16>(&m_keyframeBuffer[entryPos + 1], page);
+            std::ranges::copy(shadowPage, &m_keyframeBuffer[entryPos + kPageHeaderSize]);
+        }
+    }
+}
+
+std::vector<uint8> &RewindBuffer::GetBuffer() {
     auto &buffer = m_buffers[m_bufferFlip];
     m_bufferFlip ^= true;
     buffer.clear();
@@ -141,17 +401,19 @@ std::vector<char> &RewindBuffer::GetBuffer() {
 }
 
 void RewindBuffer::ProcessFrame() {
-    // Resize delta buffer if needed
+    // The new frame continues from the working state, replacing any frames that followed it
+    DiscardFramesAfterCursor();
+
+    // Lay out the frame: state delta size, state delta, page deltas
     const size_t maxSize = std::max(m_buffers[0].size(), m_buffers[1].size());
     const size_t minSize = std::min(m_buffers[0].size(), m_buffers[1].size());
-    if (m_deltaBuffer.size() < maxSize) [[unlikely]] {
-        m_deltaBuffer.resize(maxSize);
-    }
+    m_deltaBuffer.resize(sizeof(uint32) + maxSize + m_pageDeltas.size());
+    util::WriteNE<uint32>(&m_deltaBuffer[0], maxSize);
 
     // Use pointers to allow for vectorization
-    char *out = &m_deltaBuffer[0];
-    char *b0 = m_buffers[0].empty() ? nullptr : &m_buffers[0][0];
-    char *b1 = m_buffers[1].empty() ? nullptr : &m_buffers[1][0];
+    char *out = &m_deltaBuffer[sizeof(uint32)];
+    uint8 *b0 = m_buffers[0].empty() ? nullptr : &m_buffers[0][0];
+    uint8 *b1 = m_buffers[1].empty() ? nullptr : &m_buffers[1][0];
 
     // Compute XOR delta
     size_t i = 0;
@@ -172,23 +434,334 @@ void RewindBuffer::ProcessFrame() {
         }
     }
 
-    // Compute sizes
-    const size_t srcSize = m_deltaBuffer.size();
-    const size_t dstSize = LZ4_compressBound(srcSize);
+    std::ranges::copy(m_pageDeltas, &out[maxSize]);
+
+    // Take a full snapshot periodically
+    const bool keyframe = m_totalFrameCount % kKeyframeInterval == 0;
+    if (keyframe) {
+        BuildKeyframe();
+    }
+
+    // Compress the delta and the keyframe directly into the arena
+    const size_t deltaBound = LZ4_compressBound(m_deltaBuffer.size());
+    const size_t keyframeBound = keyframe ? LZ4_compressBound(m_keyframeBuffer.size()) : 0;
+    const size_t offset = AllocateRecentFrame(deltaBound + keyframeBound);
+    char *arena = m_recent.arena.get();
+
+    Frame frame{};
+    frame.offset = offset;
+    frame.number = m_totalFrameCount;
+    frame.deltaRawSize = m_deltaBuffer.size();
+    frame.deltaSize =
+        LZ4_compress_fast(m_deltaBuffer.data(), &arena[offset], m_deltaBuffer.size(), deltaBound, LZ4Accel);
+    if (keyframe) {
+        frame.keyframeRawSize = m_keyframeBuffer.size();
+        frame.keyframeSize = LZ4_compress_fast(m_keyframeBuffer.data(), &arena[offset + frame.deltaSize],
+                                               m_keyframeBuffer.size(), keyframeBound, LZ4Accel);
+    }
+
+    m_recent.PushBack(frame);
+    ++m_totalFrameCount;
+    m_cursor = GetEntryCount() - 1;
+    UpdateStats();
+}
+
+void RewindBuffer::Tier::Allocate(size_t size) {
+    if (!arena) [[unlikely]] {
+        arena = std::make_unique_for_overwrite<char[]>(size);
+        arenaSize = size;
+        frames.resize(maxFrames);
+        Clear();
+    }
+}
+
+void RewindBuffer::Tier::Release() {
+    arena.reset();
+    arenaSize = 0;
+    frames.clear();
+    frames.shrink_to_fit();
+    Clear();
+}
+
+void RewindBuffer::Tier::Clear() {
+    head = 0;
+    usage = 0;
+    start = 0;
+    count = 0;
+}
 
-    // Compress state into frame data buffer
-    auto &outBuffer = m_deltas[m_deltaWritePos];
-    m_deltaWritePos = (m_deltaWritePos + 1) % m_deltas.size();
-    if (m_deltaCount < m_deltas.size()) {
-        ++m_deltaCount;
+std::optional<size_t> RewindBuffer::Tier::FindSpace(size_t size) {
+    assert(size <= arenaSize);
+
+    if (count == 0) {
+        return 0;
+    }
+    if (count == maxFrames) {
+        return std::nullopt;
+    }
+
+    const size_t tail = (*this)[0].offset;
+    if (head > tail) {
+        // Free space is at the end and at the start of the arena
+        if (head + size <= arenaSize) {
+            return head;
+        }
+        if (size < tail) {
+            return 0;
+        }
+    } else if (head + size < tail) {
+        // Free space is between the head and the tail
+        return head;
+    }
+    return std::nullopt;
+}
+
+void RewindBuffer::Tier::PushBack(const Frame &frame) {
+    (*this)[count] = frame;
+    ++count;
+    head = frame.End();
+    usage += frame.End() - frame.offset;
+}
+
+void RewindBuffer::Tier::PopFront() {
+    const Frame &frame = (*this)[0];
+    usage -= frame.End() - frame.offset;
+    start = (start + 1) % maxFrames;
+    --count;
+}
+
+void RewindBuffer::Tier::PopBack() {
+    const Frame &frame = (*this)[count - 1];
+    usage -= frame.End() - frame.offset;
+    head = frame.offset;
+    --count;
+}
+
+size_t RewindBuffer::AllocateRecentFrame(size_t size) {
+    m_recent.Allocate(m_memoryBudget / 4);
+    while (true) {
+        if (const auto offset = m_recent.FindSpace(size)) {
+            return *offset;
+        }
+
+        // The compactor fell behind; migrate the oldest frames right away, favoring speed over compression ratio
+        PrepareMigration(m_syncMigration);
+        CompressMigration(m_syncMigration, false);
+        CommitMigration(m_syncMigration);
+        ++m_generation;
+    }
+}
+
+bool RewindBuffer::NeedsCompaction() const {
+    // Don't move frames while the cursor is away from the newest frame, since they may be discarded soon
+    if (m_recent.count <= 1 || m_cursor + 1 != GetEntryCount()) {
+        return false;
+    }
+    return m_recent.count > kRecentFramesTarget || m_recent.usage > m_recent.arenaSize / 2;
+}
+
+bool RewindBuffer::PrepareMigration(Migration &migration) {
+    if (m_recent.count == 0) {
+        return false;
+    }
+
+    // Group frames up to the next one kept in the history tier
+    size_t frameCount = 0;
+    while (frameCount < m_recent.count) {
+        const Frame &frame = m_recent[frameCount++];
+        if (frame.number % kHistoryFrameInterval == 0) {
+            break;
+        }
+        if (frameCount < m_recent.count && m_recent[frameCount].number != frame.number + 1) {
+            break;
+        }
+    }
+
+    // Merge the deltas of the group into one
+    const char *arena = m_recent.arena.get();
+    for (size_t i = 0; i < frameCount; i++) {
+        const Frame &frame = m_recent[i];
+        if (i == 0) {
+            DecompressRecord(&arena[frame.offset], frame.deltaSize, frame.deltaRawSize, migration.record);
+        } else {
+            DecompressRecord(&arena[frame.offset], frame.deltaSize, frame.deltaRawSize, migration.scratch);
+            MergeDeltas(migration.record, migration.scratch, migration.merged);
+            std::swap(migration.record, migration.merged);
+        }
+    }
+
+    // Keep only some of the keyframes
+    const Frame &last = m_recent[frameCount - 1];
+    if (last.keyframeSize != 0 && last.number % kHistoryKeyframeInterval == 0) {
+        DecompressRecord(&arena[last.offset + last.deltaSize], last.keyframeSize, last.keyframeRawSize,
+                         migration.keyframe);
+    } else {
+        migration.keyframe.clear();
+    }
+
+    migration.frameCount = frameCount;
+    migration.number = last.number;
+    migration.generation = m_generation;
+    return true;
+}
+
+void RewindBuffer::CompressMigration(Migration &migration, bool strong) const {
+    const size_t deltaBound = LZ4_compressBound(migration.record.size());
+    const size_t keyframeBound = migration.keyframe.empty() ? 0 : LZ4_compressBound(migration.keyframe.size());
+    migration.compressed.resize(deltaBound + keyframeBound);
+
+    auto compress = [&](const std::vector<char> &src, char *dst, size_t bound) -> uint32 {
+        if (strong) {
+            return LZ4_compress_HC(src.data(), dst, src.size(), bound, kHistoryCompressionLevel);
+        } else {
+            return LZ4_compress_fast(src.data(), dst, src.size(), bound, LZ4Accel);
+        }
+    };
+
+    migration.deltaSize = compress(migration.record, &migration.compressed[0], deltaBound);
+    migration.keyframeSize = 0;
+    if (!migration.keyframe.empty()) {
+        migration.keyframeSize =
+            compress(migration.keyframe, &migration.compressed[migration.deltaSize], keyframeBound);
+    }
+}
+
+void RewindBuffer::CommitMigration(const Migration &migration) {
+    const size_t size = migration.deltaSize + migration.keyframeSize;
+    m_history.Allocate(m_memoryBudget - m_memoryBudget / 4);
+    std::optional<size_t> offset;
+    while (!(offset = m_history.FindSpace(size))) {
+        m_history.PopFront();
+        if (m_cursor > 0) {
+            --m_cursor;
+        }
+    }
+    std::copy_n(migration.compressed.begin(), size, &m_history.arena[*offset]);
+
+    Frame frame{};
+    frame.offset = *offset;
+    frame.number = migration.number;
+    frame.deltaSize = migration.deltaSize;
+    frame.deltaRawSize = migration.record.size();
+    frame.keyframeSize = migration.keyframeSize;
+    frame.keyframeRawSize = migration.keyframe.size();
+    m_history.PushBack(frame);
+
+    // Replace the group in the recent tier. The cursor is never inside the group except at its last frame.
+    for (size_t i = 0; i < migration.frameCount; i++) {
+        m_recent.PopFront();
+    }
+    m_cursor -= migration.frameCount - 1;
+}
+
+void RewindBuffer::ClearFrames() {
+    m_recent.Clear();
+    m_history.Clear();
+    m_totalFrameCount = 0;
+    m_cursor = 0;
+    ++m_generation;
+    UpdateStats();
+}
+
+void RewindBuffer::DiscardFramesAfterCursor() {
+    const size_t count = GetEntryCount();
+    if (count == 0 || m_cursor == count - 1) {
+        return;
+    }
+    while (GetEntryCount() > m_cursor + 1) {
+        PopNewestFrame();
+    }
+    ++m_generation;
+}
+
+void RewindBuffer::PopNewestFrame() {
+    const size_t number = GetEntry(GetEntryCount() - 1).number;
+    if (m_recent.count > 0) {
+        m_recent.PopBack();
+    } else {
+        m_history.PopBack();
+    }
+
+    // The next frame follows the newest remaining frame, or takes the place of the removed one if there are none
+    const size_t count = GetEntryCount();
+    m_totalFrameCount = count > 0 ? GetEntry(count - 1).number + 1 : number;
+}
+
+void RewindBuffer::ApplyRecord(ymir::state::State *mirror) {
+    // Apply XOR delta to the binary state in the "current" buffer; don't flip buffers
+    const size_t stateSize = util::ReadNE<uint32>(&m_deltaBuffer[0]);
+    const char *delta = &m_deltaBuffer[sizeof(uint32)];
+    std::vector<uint8> &buffer = m_buffers[m_bufferFlip ^ 1];
+    if (buffer.size() < stateSize) {
+        // Serialized states may differ in size; the shorter one is XORed as if padded with zeros
+        buffer.resize(stateSize);
+    }
+    uint8 *out = buffer.data();
+
+    // Use pointers to allow for vectorization
+    size_t i = 0;
+    for (; i + sizeof(uint64) < stateSize; i += sizeof(uint64)) {
+        util::WriteNE<uint64>(&out[i], util::ReadNE<uint64>(&out[i]) ^ util::ReadNE<uint64>(&delta[i]));
+    }
+    for (; i < stateSize; i++) {
+        out[i] ^= delta[i];
+    }
+
+    // Apply page deltas to the shadow state
+    const size_t rawSize = m_deltaBuffer.size();
+    size_t pos = sizeof(uint32) + stateSize;
+    while (pos < rawSize) {
+        const auto region = static_cast<ymir::state::MemoryRegion>(m_deltaBuffer[pos]);
+        const uint16 page = util::ReadNE<uint16>(&m_deltaBuffer[pos + 1]);
+        pos += kPageHeaderSize;
+
+        const std::span<uint8> shadowPage = ymir::state::GetMemoryPage(m_shadowState, region, page);
+        const char *pageDelta = &m_deltaBuffer[pos];
+        for (size_t j = 0; j < shadowPage.size(); j += sizeof(uint64)) {
+            util::WriteNE<uint64>(&shadowPage[j],
+                                  util::ReadNE<uint64>(&shadowPage[j]) ^ util::ReadNE<uint64>(&pageDelta[j]));
+        }
+        if (mirror != nullptr) {
+            std::ranges::copy(shadowPage, ymir::state::GetMemoryPage(*mirror, region, page).begin());
+        }
+        pos += shadowPage.size();
+    }
+}
+
+void RewindBuffer::LoadKeyframe(size_t index) {
+    // Keyframes are deltas against an all-zero state
+    m_buffers[m_bufferFlip ^ 1].clear();
+    for (size_t regionIndex = 0; regionIndex < ymir::state::kNumMemoryRegions; regionIndex++) {
+        const auto region = static_cast<ymir::state::MemoryRegion>(regionIndex);
+        const size_t pageCount = ymir::state::GetMemoryPageCount(region);
+        for (size_t page = 0; page < pageCount; page++) {
+            std::ranges::fill(ymir::state::GetMemoryPage(m_shadowState, region, page), 0);
+        }
+    }
+
+    const Frame &frame = GetEntry(index);
+    DecompressRecord(GetEntryData(index) + frame.deltaSize, frame.keyframeSize, frame.keyframeRawSize, m_deltaBuffer);
+    ApplyRecord(nullptr);
+}
+
+void RewindBuffer::RestoreNextState() {
+    // Trailing zero padding left over from larger states is ignored
+    ymir::state::ReadBinaryState(m_buffers[m_bufferFlip ^ 1], NextState);
+}
+
+void RewindBuffer::UpdateStats() {
+    const size_t count = GetEntryCount();
+    const size_t firstNumber = count > 0 ? GetEntry(0).number : 0;
+    m_bufferSize = count > 0 ? GetEntry(count - 1).number - firstNumber + 1 : 0;
+    m_cursorPosition = count > 0 ? GetEntry(m_cursor).number - firstNumber : 0;
+    m_memoryUsage = m_recent.usage + m_history.usage;
+
+    // Extrapolate from the average size of the frames stored so far
+    if (m_memoryUsage > 0) {
+        m_bufferCapacity = std::max(m_bufferSize, m_bufferSize * m_memoryBudget / m_memoryUsage);
+    } else {
+        m_bufferCapacity = kMaxRecentFrames;
     }
-    ++m_totalDeltaCount;
-    outBuffer.resize(dstSize);
-    const char *const src = m_deltaBuffer.data();
-    char *const dst = outBuffer.data();
-    int compSize = LZ4_compress_fast(src, dst, srcSize, dstSize, LZ4Accel);
-    outBuffer.resize(compSize);
-    outBuffer.shrink_to_fit();
 }
 
 } // namespace app
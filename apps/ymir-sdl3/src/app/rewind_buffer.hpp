@@ -7,14 +7,69 @@
 #include <ymir/core/types.hpp>
 
 #include <array>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <vector>
 
 namespace app {
 
+// Records the emulator state of every frame as compressed XOR deltas against the previous frame.
+//
+// The emulator thread fills in NextState and NextDirtyPages with ymir::Saturn::SaveStateIncremental, which only copies
+// memory pages modified since the previous frame. The processor thread writes everything except the tracked memory
+// regions in the raw binary state format (see ymir/state/state_binary.hpp) and XORs the modified pages against a shadow
+// copy of the previous frame's memory, discarding pages that didn't actually change.
+//
+// The shadow copy and the last binary state form the working state, which normally holds the newest frame. Deltas
+// are XORs, so they can be applied to the working state to step one frame backward or forward. Every
+// kKeyframeInterval frames a full keyframe is stored along with the delta, which allows reconstructing any frame by
+// loading the nearest keyframe (or starting from the working state, if closer) and applying a bounded number of deltas
+// in either direction.
+//
+// Frames are stored in two tiers, each backed by a single arena used as a ring buffer, which together are sized by a
+// memory budget:
+// - The recent tier holds every frame compressed with fast LZ4. It receives a quarter of the budget.
+// - The history tier holds every kHistoryFrameInterval-th frame. The compactor thread moves the oldest recent frames
+//   there in the background by merging the deltas of each group of frames into one and recompressing them with LZ4HC.
+//   Only keyframes every kHistoryKeyframeInterval frames are kept. The oldest frames in the history tier are evicted
+//   when it fills up.
+//
+// Uncompressed frame records (both deltas and keyframes) are laid out as follows:
+//   uint32    size of the binary state
+//   uint8[]   binary state (excluding tracked memory regions), XORed with the previous frame for deltas
+//   Pages (until the end of the record), sorted by region and page index:
+//     uint8     memory region
+//     uint16    page index
+//     uint8[]   page contents, XORed with the previous frame for deltas; zero-filled pages are omitted from keyframes
 class RewindBuffer {
 public:
+    // Maximum number of frames stored in the recent tier.
+    static constexpr size_t kMaxRecentFrames = 60 * 60;
+
+    // Number of frames in the recent tier above which the compactor starts moving frames to the history tier.
+    static constexpr size_t kRecentFramesTarget = 60 * 20;
+
+    // Number of frames between keyframes.
+    static constexpr size_t kKeyframeInterval = 120;
+
+    // Number of frames between frames kept in the history tier.
+    static constexpr size_t kHistoryFrameInterval = 4;
+
+    // Number of frames between keyframes kept in the history tier.
+    static constexpr size_t kHistoryKeyframeInterval = kKeyframeInterval * 4;
+
+    // Maximum number of frames stored in the history tier (two hours of gameplay).
+    static constexpr size_t kMaxHistoryFrames = 2 * 60 * 60 * 60 / kHistoryFrameInterval;
+
+    // Default and minimum memory budgets for compressed frames.
+    static constexpr size_t kDefaultMemoryBudget = 256 * 1024 * 1024;
+    static constexpr size_t kMinMemoryBudget = 64 * 1024 * 1024;
+
+    static_assert(kKeyframeInterval % kHistoryFrameInterval == 0);
+    static_assert(kHistoryKeyframeInterval % kKeyframeInterval == 0);
+
     RewindBuffer();
     ~RewindBuffer();
 
@@ -27,37 +82,75 @@ public:
         return m_running;
     }
 
-    // Gets the number of frames currently stored in the buffer.
+    // Sets the amount of memory used to store compressed frames. Clears the buffer if the budget changes.
+    void SetMemoryBudget(size_t bytes);
+
+    // Gets the amount of memory used to store compressed frames.
+    size_t GetMemoryBudget() const {
+        return m_memoryBudget;
+    }
+
+    // Gets the number of frames spanned by the buffer, from the oldest to the newest frame.
+    // Frames in the history tier are thinned out, so not all of them can be restored.
     size_t GetBufferSize() const {
-        return m_deltaCount;
+        return m_bufferSize;
     }
 
-    // Gets the maximum number of frames that can be stored in the buffer.
+    // Gets the estimated number of frames that fit in the memory budget, based on the current memory usage.
     size_t GetBufferCapacity() const {
-        return m_deltas.size();
+        return m_bufferCapacity;
     }
 
     // Gets the total number of frames written to the buffer.
     // Successfully pushing and popping states will respectively increase and reduce this count.
     size_t GetTotalFrames() const {
-        return m_totalDeltaCount;
+        return m_totalFrameCount;
+    }
+
+    // Gets the position of the frame held in the working state, from 0 (oldest frame) to GetBufferSize() - 1 (newest
+    // frame). Only differs from the newest frame after seeking.
+    size_t GetCursorPosition() const {
+        return m_cursorPosition;
+    }
+
+    // Gets the number of bytes of the arenas used by compressed frames.
+    size_t GetMemoryUsage() const {
+        return m_memoryUsage;
+    }
+
+    // Waits until the rewind buffer processor thread is done reading the previous state.
+    // Should be invoked by the emulator thread before saving a state to NextState.
+    void BeginState() {
+        m_stateProcessedEvent.Wait();
     }
 
     // Tells the rewind buffer processor thread that the next state is ready to be processed.
     // Should be invoked by the emulator thread after saving a state to NextState.
+    // Frames after the cursor are discarded before the new frame is added.
     void ProcessState() {
-        m_stateProcessedEvent.Wait();
         m_stateProcessedEvent.Reset();
         m_nextStateEvent.Set();
     }
 
-    // Restores the previous state if available and stores it in NextState.
+    // Restores the frame preceding the cursor if available and stores it in NextState.
+    // Discards all frames from the cursor onwards.
     // Returns true if a state has been popped, false otherwise.
     bool PopState();
 
-    // Next state to be processed. Should be filled in by the emulator before invoking ProcessState()
+    // Reconstructs the frame at the specified position (see GetCursorPosition()) and stores it in NextState.
+    // If the frame was thinned out of the history tier, the nearest preceding frame is restored instead.
+    // Moves the cursor to that frame without discarding any frames, so it's possible to seek back and forth freely until
+    // the next state is processed.
+    // Returns true if the frame has been restored, false if the position is out of range.
+    bool SeekState(size_t position);
+
+    // Next state to be processed. Should be filled in by the emulator before invoking ProcessState().
+    // Must only be modified by incremental saves.
     ymir::state::State NextState;
 
+    // Memory pages modified in NextState since the previous frame. Filled in along with NextState.
+    ymir::state::DirtyPages NextDirtyPages;
+
     int LZ4Accel = 64; // LZ4 acceleration factor (1 to 65537)
 
 private:
@@ -67,23 +160,177 @@ private:
     util::Event m_nextStateEvent{false};     // Raised by emulator to ask rewind buffer to process next state
     util::Event m_stateProcessedEvent{true}; // Raised by rewind buffer to tell emulator it's done processing
 
+    std::thread m_compactThread;
+    util::Event m_compactEvent{false}; // Raised by processor thread when the recent tier needs compaction
+
     std::mutex m_lock;
 
-    std::array<std::vector<char>, 2> m_buffers; // Buffers for serialized states (current and next)
-    bool m_bufferFlip = false;                  // Which buffer is which
-    std::vector<char> m_deltaBuffer;            // XOR delta buffer
+    std::array<std::vector<uint8>, 2> m_buffers; // Buffers for binary states (current and next)
+    bool m_bufferFlip = false;                   // Which buffer is which
+    std::vector<char> m_deltaBuffer;             // Uncompressed delta frame record
+    std::vector<char> m_keyframeBuffer;          // Uncompressed keyframe record
+    std::vector<char> m_pageDeltas;              // XOR deltas of modified memory pages
+
+    ymir::state::State m_shadowState{}; // Tracked memory regions of the working state
+
+    // A frame stored in a tier. The keyframe, if present, is stored immediately after the delta.
+    struct Frame {
+        size_t offset;          // Arena offset of the compressed delta
+        size_t number;          // Frame number, counting from the first frame written to the buffer
+        uint32 deltaSize;       // Compressed delta size
+        uint32 deltaRawSize;    // Uncompressed delta size
+        uint32 keyframeSize;    // Compressed keyframe size; 0 if the frame has no keyframe
+        uint32 keyframeRawSize; // Uncompressed keyframe size
+
+        size_t End() const {
+            return offset + deltaSize + keyframeSize;
+        }
+    };
+
+    // A ring buffer of frames compressed into an arena. Frames are written to the arena sequentially, so the oldest
+    // frames are always the ones immediately ahead of the head.
+    struct Tier {
+        explicit Tier(size_t maxFrames)
+            : maxFrames(maxFrames) {}
+
+        const size_t maxFrames;
+
+        std::unique_ptr<char[]> arena; // Compressed frame storage, allocated on demand
+        size_t arenaSize = 0;          // Size of the arena
+        size_t head = 0;               // Arena offset where the next frame will be written
+        size_t usage = 0;              // Number of bytes used by stored frames
+
+        std::vector<Frame> frames; // Ring buffer of frames, allocated along with the arena
+        size_t start = 0;          // Index of the oldest frame in the ring buffer
+        size_t count = 0;          // Current amount of valid frames
+
+        Frame &operator[](size_t position) {
+            return frames[(start + position) % maxFrames];
+        }
+
+        // Allocates the arena and frame table if needed.
+        void Allocate(size_t size);
 
-    std::array<std::vector<char>, 60 * 60> m_deltas; // Ring buffer of delta frames
-    size_t m_deltaWritePos = 0;                      // Current delta ring buffer write position
-    size_t m_deltaCount = 0;                         // Current amount of valid delta frames
-    size_t m_totalDeltaCount = 0;                    // Total number of frames written so far
+        // Releases the arena and frame table.
+        void Release();
+
+        // Removes all frames.
+        void Clear();
+
+        // Finds a contiguous free region of the arena of the specified size.
+        // Returns the offset of the region, or std::nullopt if the oldest frames must be removed to make room.
+        std::optional<size_t> FindSpace(size_t size);
+
+        void PushBack(const Frame &frame);
+        void PopFront();
+        void PopBack();
+    };
+
+    Tier m_recent{kMaxRecentFrames};   // Every frame, fast compression
+    Tier m_history{kMaxHistoryFrames}; // Thinned out frames, strong compression
+
+    // A group of frames being moved from the recent tier to the history tier.
+    struct Migration {
+        std::vector<char> record;     // Merged delta record
+        std::vector<char> scratch;    // Decompressed record of a frame in the group
+        std::vector<char> merged;     // Output of a delta merge
+        std::vector<char> keyframe;   // Keyframe record of the last frame in the group; empty if not kept
+        std::vector<char> compressed; // Compressed delta followed by the compressed keyframe
+
+        size_t frameCount;   // Number of frames in the group
+        size_t number;       // Number of the last frame in the group
+        uint32 deltaSize;    // Compressed delta size
+        uint32 keyframeSize; // Compressed keyframe size
+        uint64 generation;   // Value of m_generation when the group was collected
+    };
+
+    Migration m_syncMigration;  // Used by the processor thread when the compactor falls behind
+    Migration m_asyncMigration; // Used by the compactor thread
+
+    // Incremented whenever frames are removed or the cursor moves other than by writing new frames. Used to detect
+    // stale migrations prepared by the compactor thread.
+    uint64 m_generation = 0;
+
+    size_t m_memoryBudget = kDefaultMemoryBudget;
+
+    size_t m_totalFrameCount = 0; // Total number of frames written so far
+    size_t m_cursor = 0;          // Index of the entry in the working state (see GetEntry())
+
+    // Statistics for the UI, updated with UpdateStats()
+    size_t m_bufferSize = 0;
+    size_t m_bufferCapacity = 0;
+    size_t m_cursorPosition = 0;
+    size_t m_memoryUsage = 0;
 
     void ProcThread();
+    void CompactThread();
 
     // Gets and clears the next buffer and flips the buffer pointer.
-    std::vector<char> &GetBuffer();
+    std::vector<uint8> &GetBuffer();
+
+    // Computes the XOR deltas of the pages listed in NextDirtyPages and updates the shadow state.
+    void CollectPageDeltas();
+
+    // Builds the keyframe record for the working state into the keyframe buffer.
+    void BuildKeyframe();
 
     void ProcessFrame();
+
+    // Gets the total number of frames stored in both tiers.
+    size_t GetEntryCount() const {
+        return m_history.count + m_recent.count;
+    }
+
+    // Retrieves the stored frame at the specified index, where 0 is the oldest frame in the history tier.
+    Frame &GetEntry(size_t index) {
+        return index < m_history.count ? m_history[index] : m_recent[index - m_history.count];
+    }
+
+    // Retrieves the compressed data of the stored frame at the specified index.
+    const char *GetEntryData(size_t index) {
+        const Tier &tier = index < m_history.count ? m_history : m_recent;
+        return &tier.arena[GetEntry(index).offset];
+    }
+
+    // Reserves a contiguous region of the recent tier arena of the specified size, moving the oldest frames to the
+    // history tier as needed.
+    // Returns the offset of the region.
+    size_t AllocateRecentFrame(size_t size);
+
+    // Determines if the recent tier has grown enough to move frames to the history tier.
+    bool NeedsCompaction() const;
+
+    // Collects and merges the oldest group of frames of the recent tier.
+    // Returns false if there are no frames to migrate.
+    bool PrepareMigration(Migration &migration);
+
+    // Compresses the merged records of the migration, with LZ4HC if strong is true or fast LZ4 otherwise.
+    void CompressMigration(Migration &migration, bool strong) const;
+
+    // Moves the compressed migration into the history tier, replacing its frames in the recent tier.
+    void CommitMigration(const Migration &migration);
+
+    // Removes all frames.
+    void ClearFrames();
+
+    // Removes all frames after the cursor.
+    void DiscardFramesAfterCursor();
+
+    // Removes the newest frame.
+    void PopNewestFrame();
+
+    // Applies the uncompressed record in the delta buffer to the working state by XORing its contents.
+    // If mirror is not null, modified pages are also copied into it.
+    void ApplyRecord(ymir::state::State *mirror);
+
+    // Clears the working state and loads the keyframe of the stored frame at the specified index into it.
+    void LoadKeyframe(size_t index);
+
+    // Reads the working state into NextState. Tracked memory pages must be up to date in NextState.
+    void RestoreNextState();
+
+    // Updates the statistics exposed to the UI.
+    void UpdateStats();
 };
 
 } // namespace app
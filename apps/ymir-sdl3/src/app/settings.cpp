@@ -654,9 +654,15 @@ void Settings::ResetToDefaults() {
     general.boostProcessPriority = true;
     general.screenshotScale = 2;
 
+    general.compressSaveStates = true;
+
     general.enableRewindBuffer = false;
+    general.rewindBufferSize = 256;
     general.rewindCompressionLevel = 12;
 
+    general.runAheadFrames = 0;
+    general.preemptiveRunAhead = false;
+
     general.mainSpeedFactor = 1.0;
     general.altSpeedFactor = 0.5;
     general.useAltSpeed = false;
@@ -744,6 +750,10 @@ void Settings::ResetToDefaults() {
 
     audio.stepGranularity = 0;
 
+    audio.sampleBatchSize = 64;
+
+    audio.cddaBufferLatency = 4;
+
     audio.midiInputPort = Settings::Audio::MidiPort{.id = {}, .type = Settings::Audio::MidiPort::Type::None};
     audio.midiOutputPort = Settings::Audio::MidiPort{.id = {}, .type = Settings::Audio::MidiPort::Type::None};
 
@@ -772,6 +782,7 @@ void Settings::BindConfiguration(ymir::core::Configuration &config) {
 
     audio.interpolation.Observe([&](auto value) { config.audio.interpolation = value; });
     audio.threadedSCSP.Observe([&](auto value) { config.audio.threadedSCSP = value; });
+    audio.cddaBufferLatency.Observe([&](auto value) { config.audio.cddaBufferLatency = value; });
 
     cdblock.readSpeedFactor.Observe([&](auto value) { config.cdblock.readSpeedFactor = value; });
 }
@@ -820,13 +831,18 @@ SettingsLoadResult Settings::Load(const std::filesystem::path &path) {
         Parse(tblGeneral, "BoostProcessPriority", general.boostProcessPriority);
         Parse(tblGeneral, "EnableRewindBuffer", general.enableRewindBuffer);
         Parse(tblGeneral, "ScreenshotScale", general.screenshotScale);
+        Parse(tblGeneral, "CompressSaveStates", general.compressSaveStates);
+        Parse(tblGeneral, "RewindBufferSize", general.rewindBufferSize);
         Parse(tblGeneral, "RewindCompressionLevel", general.rewindCompressionLevel);
+        Parse(tblGeneral, "RunAheadFrames", general.runAheadFrames);
+        Parse(tblGeneral, "PreemptiveRunAhead", general.preemptiveRunAhead);
         Parse(tblGeneral, "MainSpeedFactor", general.mainSpeedFactor);
         Parse(tblGeneral, "AltSpeedFactor", general.altSpeedFactor);
         Parse(tblGeneral, "UseAltSpeed", general.useAltSpeed);
         Parse(tblGeneral, "PauseWhenUnfocused", general.pauseWhenUnfocused);
 
         general.screenshotScale = std::clamp(general.screenshotScale, 1, 4);
+        general.runAheadFrames = std::clamp(general.runAheadFrames, 0, kMaxRunAheadFrames);
 
         // Rounds to the nearest multiple of 5% and clamps to 10%..500% range.
         auto adjustSpeed = [](double value) { return std::clamp(util::RoundToMultiple(value, 0.05), 0.1, 5.0); };
@@ -848,6 +864,7 @@ SettingsLoadResult Settings::Load(const std::filesystem::path &path) {
             parse("SaveStates", ProfilePath::SaveStates);
             parse("Dumps", ProfilePath::Dumps);
             parse("Screenshots", ProfilePath::Screenshots);
+            parse("Movies", ProfilePath::Movies);
         }
     }
 
@@ -1127,11 +1144,15 @@ SettingsLoadResult Settings::Load(const std::filesystem::path &path) {
         auto inputPort = audio.midiInputPort.Get();
         auto outputPort = audio.midiOutputPort.Get();
         auto stepGranularity = audio.stepGranularity.Get();
+        auto sampleBatchSize = audio.sampleBatchSize.Get();
+        auto cddaBufferLatency = audio.cddaBufferLatency.Get();
 
         Parse(tblAudio, "Volume", audio.volume);
         Parse(tblAudio, "Mute", audio.mute);
 
         Parse(tblAudio, "StepGranularity", stepGranularity);
+        Parse(tblAudio, "SampleBatchSize", sampleBatchSize);
+        Parse(tblAudio, "CDDABufferLatency", cddaBufferLatency);
 
         Parse(tblAudio, "MidiInputPortId", inputPort.id);
         Parse(tblAudio, "MidiOutputPortId", outputPort.id);
@@ -1141,6 +1162,8 @@ SettingsLoadResult Settings::Load(const std::filesystem::path &path) {
         Parse(tblAudio, "ThreadedSCSP", audio.threadedSCSP);
 
         audio.stepGranularity = std::min(stepGranularity, 5u);
+        audio.sampleBatchSize = std::clamp<uint32>(sampleBatchSize, 1u, ymir::scsp::kMaxOutputBatchSize);
+        audio.cddaBufferLatency = std::clamp<uint8>(cddaBufferLatency, 2u, 8u);
 
         audio.midiInputPort = inputPort;
         audio.midiOutputPort = outputPort;
@@ -1187,7 +1210,11 @@ SettingsSaveResult Settings::Save() {
             {"BoostProcessPriority", general.boostProcessPriority},
             {"EnableRewindBuffer", general.enableRewindBuffer},
             {"ScreenshotScale", general.screenshotScale},
+            {"CompressSaveStates", general.compressSaveStates},
+            {"RewindBufferSize", general.rewindBufferSize},
             {"RewindCompressionLevel", general.rewindCompressionLevel},
+            {"RunAheadFrames", general.runAheadFrames},
+            {"PreemptiveRunAhead", general.preemptiveRunAhead},
             {"MainSpeedFactor", general.mainSpeedFactor.Get()},
             {"AltSpeedFactor", general.altSpeedFactor.Get()},
             {"UseAltSpeed", general.useAltSpeed.Get()},
@@ -1202,6 +1229,7 @@ SettingsSaveResult Settings::Save() {
                 {"SaveStates", m_context.profile.GetPathOverride(ProfilePath::SaveStates).native()},
                 {"Dumps", m_context.profile.GetPathOverride(ProfilePath::Dumps).native()},
                 {"Screenshots", m_context.profile.GetPathOverride(ProfilePath::Screenshots).native()},
+                {"Movies", m_context.profile.GetPathOverride(ProfilePath::Movies).native()},
             }}},
         }}},
 
@@ -1534,6 +1562,8 @@ SettingsSaveResult Settings::Save() {
             {"Volume", audio.volume.Get()},
             {"Mute", audio.mute.Get()},
             {"StepGranularity", audio.stepGranularity.Get()},
+            {"SampleBatchSize", audio.sampleBatchSize.Get()},
+            {"CDDABufferLatency", audio.cddaBufferLatency.Get()},
             {"MidiInputPortId", audio.midiInputPort.Get().id},
             {"MidiOutputPortId", audio.midiOutputPort.Get().id},
             {"MidiInputPortType", ToTOML(audio.midiInputPort.Get().type)},
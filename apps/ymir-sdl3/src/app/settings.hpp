@@ -34,6 +34,9 @@ namespace app {
 
 inline constexpr std::string_view kSettingsFile = "Ymir.toml";
 
+// Maximum number of frames the emulator can run ahead of the displayed frame
+inline constexpr int kMaxRunAheadFrames = 6;
+
 struct SettingsLoadResult {
     enum class Type { Success, TOMLParseError, UnsupportedConfigVersion };
 
@@ -141,10 +144,15 @@ struct Settings {
 
         int screenshotScale;
 
+        bool compressSaveStates;
+
         bool enableRewindBuffer;
-        // TODO: rewind buffer size
+        int rewindBufferSize; // in MiB
         int rewindCompressionLevel;
 
+        int runAheadFrames; // 0 = disabled
+        bool preemptiveRunAhead;
+
         util::Observable<double> mainSpeedFactor;
         util::Observable<double> altSpeedFactor;
         util::Observable<bool> useAltSpeed;
@@ -422,6 +430,12 @@ struct Settings {
 
         util::Observable<uint32> stepGranularity;
 
+        // Number of frames accumulated by the SCSP before sending them to the audio system
+        util::Observable<uint32> sampleBatchSize;
+
+        // Number of CD audio sectors buffered by the SCSP before playback starts
+        util::Observable<uint8> cddaBufferLatency;
+
         util::Observable<MidiPort> midiInputPort;
         util::Observable<MidiPort> midiOutputPort;
     } audio;
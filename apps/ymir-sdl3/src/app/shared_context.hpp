@@ -213,6 +213,10 @@ struct SharedContext {
         std::mutex mtxFramebuffer;
         bool updated = false;
 
+        // Frames rendered while set are discarded: they are not presented, paced or counted.
+        // Used by the emulator thread to run frames that should not be seen, such as run-ahead frames.
+        bool skipFrames = false;
+
         // Video sync
         bool videoSync = false;
         bool expectFrame = false;
@@ -454,6 +458,9 @@ struct SharedContext {
     RewindBuffer rewindBuffer;
     bool rewinding = false;
 
+    // Set while an input movie is being recorded
+    bool recordingMovie = false;
+
     struct Midi {
         std::unique_ptr<RtMidiIn> midiInput;
         std::unique_ptr<RtMidiOut> midiOutput;
@@ -140,11 +140,35 @@ void AudioSettingsView::Display() {
 
     // -----------------------------------------------------------------------------------------------------------------
 
-    if constexpr (false) { // NOTE: disabled because it is unimplemented
-        ImGui::PushFont(m_context.fonts.sansSerif.bold, m_context.fontSizes.large);
-        ImGui::SeparatorText("Performance");
-        ImGui::PopFont();
+    ImGui::PushFont(m_context.fonts.sansSerif.bold, m_context.fontSizes.large);
+    ImGui::SeparatorText("Performance");
+    ImGui::PopFont();
 
+    static constexpr uint32 kMinBatchSize = 1;
+    static constexpr uint32 kMaxBatchSize = scsp::kMaxOutputBatchSize;
+    uint32 sampleBatchSize = settings.sampleBatchSize;
+    if (MakeDirty(ImGui::SliderScalar("Sample batch size", ImGuiDataType_U32, &sampleBatchSize, &kMinBatchSize,
+                                      &kMaxBatchSize, "%u", ImGuiSliderFlags_AlwaysClamp))) {
+        settings.sampleBatchSize = sampleBatchSize;
+    }
+    widgets::ExplanationTooltip("Number of samples accumulated by the SCSP before they are sent to the audio system.\n\n"
+                                "Larger batches reduce emulation overhead at the cost of slightly higher audio latency.\n"
+                                "At 44100 Hz, 64 samples add about 1.5 ms of latency.",
+                                m_context.displayScale);
+
+    static constexpr uint8 kMinCDDALatency = 2;
+    static constexpr uint8 kMaxCDDALatency = 8;
+    uint8 cddaBufferLatency = settings.cddaBufferLatency;
+    if (MakeDirty(ImGui::SliderScalar("CD audio buffer", ImGuiDataType_U8, &cddaBufferLatency, &kMinCDDALatency,
+                                      &kMaxCDDALatency, "%u sectors", ImGuiSliderFlags_AlwaysClamp))) {
+        settings.cddaBufferLatency = cddaBufferLatency;
+    }
+    widgets::ExplanationTooltip("Amount of CD audio buffered before playback starts.\n\n"
+                                "Larger buffers reduce the risk of CD audio dropouts at the cost of latency.\n"
+                                "Each sector holds 1/75 of a second of audio (about 13.3 ms).",
+                                m_context.displayScale);
+
+    if constexpr (false) { // NOTE: disabled because it is unimplemented
         bool threadedSCSP = settings.threadedSCSP;
         if (MakeDirty(ImGui::Checkbox("Threaded SCSP and sound CPU", &threadedSCSP))) {
             m_context.EnqueueEvent(events::emu::EnableThreadedSCSP(threadedSCSP));
@@ -49,7 +49,8 @@ void GeneralSettingsView::Display() {
 
     MakeDirty(ImGui::Checkbox("Preload disc images to RAM", &settings.preloadDiscImagesToRAM));
     widgets::ExplanationTooltip(
-        "Preloads the entire disc image to memory.\n"
+        "Preloads the entire disc image to memory in the background.\n"
+        "The game starts immediately while the image is being loaded.\n"
         "May help reduce stuttering if you're loading images from a slow disk or from the network.",
         m_context.displayScale);
 
@@ -148,6 +149,18 @@ void GeneralSettingsView::Display() {
 
     // -----------------------------------------------------------------------------------------------------------------
 
+    ImGui::PushFont(m_context.fonts.sansSerif.bold, m_context.fontSizes.large);
+    ImGui::SeparatorText("Save states");
+    ImGui::PopFont();
+
+    MakeDirty(ImGui::Checkbox("Compress save state files", &settings.compressSaveStates));
+    widgets::ExplanationTooltip("Compresses save states written to disk, reducing their size considerably.\n"
+                                "Save state files are written in the background and either format can be loaded "
+                                "regardless of this setting.",
+                                m_context.displayScale);
+
+    // -----------------------------------------------------------------------------------------------------------------
+
     ImGui::PushFont(m_context.fonts.sansSerif.bold, m_context.fontSizes.large);
     ImGui::SeparatorText("Rewind buffer");
     ImGui::PopFont();
@@ -159,7 +172,15 @@ void GeneralSettingsView::Display() {
                                 "Increases memory usage and slightly reduces performance.",
                                 m_context.displayScale);
 
-    // TODO: rewind buffer size
+    if (MakeDirty(ImGui::SliderInt("Buffer size", &settings.rewindBufferSize, 64, 4096, "%d MiB",
+                                   ImGuiSliderFlags_AlwaysClamp | ImGuiSliderFlags_Logarithmic))) {
+        m_context.rewindBuffer.SetMemoryBudget(static_cast<size_t>(settings.rewindBufferSize) * 1024 * 1024);
+    }
+    widgets::ExplanationTooltip("Amount of memory used to store rewind frames.\n"
+                                "The most recent frames are kept in full. Older frames are thinned out and compressed "
+                                "further in the background to make room for a longer history.\n"
+                                "Changing this setting clears the rewind buffer.",
+                                m_context.displayScale);
 
     if (MakeDirty(ImGui::SliderInt("Compression level", &settings.rewindCompressionLevel, 0, 16, "%d",
                                    ImGuiSliderFlags_AlwaysClamp))) {
@@ -172,6 +193,32 @@ void GeneralSettingsView::Display() {
 
     // -----------------------------------------------------------------------------------------------------------------
 
+    ImGui::PushFont(m_context.fonts.sansSerif.bold, m_context.fontSizes.large);
+    ImGui::SeparatorText("Run-ahead");
+    ImGui::PopFont();
+
+    MakeDirty(ImGui::SliderInt("Frames to run ahead", &settings.runAheadFrames, 0, kMaxRunAheadFrames,
+                               settings.runAheadFrames == 0 ? "Disabled" : "%d", ImGuiSliderFlags_AlwaysClamp));
+    widgets::ExplanationTooltip("Reduces input latency by running the emulator ahead of the displayed frame.\n"
+                                "Each frame is emulated once more for every frame of run-ahead, then rolled back, so "
+                                "this requires a faster computer. Set this to the number of frames of input lag of the "
+                                "game; higher values may cause visual glitches as frames are shown before the game "
+                                "reacts to inputs.\n"
+                                "Run-ahead is suspended while paused, rewinding or tracing for the debugger.",
+                                m_context.displayScale);
+
+    ImGui::Indent();
+    MakeDirty(ImGui::Checkbox("Preemptive mode", &settings.preemptiveRunAhead));
+    widgets::ExplanationTooltip("Only rolls back and replays frames when the inputs change, which is much faster when "
+                                "inputs are held steady.\n"
+                                "Instead of running frames ahead, the emulator keeps saving the system state of the "
+                                "latest frames and replays them from the oldest one whenever an input changes, as if "
+                                "it had been pressed earlier.",
+                                m_context.displayScale);
+    ImGui::Unindent();
+
+    // -----------------------------------------------------------------------------------------------------------------
+
     ImGui::PushFont(m_context.fonts.sansSerif.bold, m_context.fontSizes.large);
     ImGui::SeparatorText("Profile paths");
     ImGui::PopFont();
@@ -233,6 +280,7 @@ void GeneralSettingsView::Display() {
         drawRow("Save states", ProfilePath::SaveStates);
         drawRow("Dumps", ProfilePath::Dumps);
         drawRow("Screenshots", ProfilePath::Screenshots);
+        drawRow("Input movies", ProfilePath::Movies);
 
         ImGui::EndTable();
     }
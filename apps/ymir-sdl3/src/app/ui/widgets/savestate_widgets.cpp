@@ -6,10 +6,10 @@
 
 namespace app::ui::widgets {
 
-void RewindBar(SharedContext &context, float alpha, const RewindBarStyle &style) {
+std::optional<size_t> RewindBar(SharedContext &context, float alpha, const RewindBarStyle &style) {
     alpha = std::clamp(alpha, 0.0f, 1.0f);
     if (alpha == 0.0f) {
-        return;
+        return std::nullopt;
     }
 
     const ImGuiViewport *viewport = ImGui::GetMainViewport();
@@ -18,7 +18,6 @@ void RewindBar(SharedContext &context, float alpha, const RewindBarStyle &style)
 
     // TODO: custom size and position
     // - remove height from style
-    // TODO: mouse interaction
 
     const ImVec2 windowPos{
         (workPos.x + workSize.x) * 0.5f,
@@ -33,12 +32,14 @@ void RewindBar(SharedContext &context, float alpha, const RewindBarStyle &style)
                                          ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings |
                                          ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav |
                                          ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoBackground;
+    std::optional<size_t> seekPosition{};
     if (ImGui::Begin("Rewind buffer bar", nullptr, windowFlags)) {
         const ImVec2 pos = ImGui::GetCursorScreenPos();
         const ImVec2 avail = ImGui::GetContentRegionAvail();
 
         const size_t cap = context.rewindBuffer.GetBufferCapacity();
         const size_t curr = context.rewindBuffer.GetBufferSize();
+        const size_t cursor = context.rewindBuffer.GetCursorPosition();
         const size_t endOffset = context.rewindBuffer.GetTotalFrames();
         const size_t startOffset = endOffset - curr;
         const float pct = (float)curr / cap;
@@ -62,6 +63,7 @@ void RewindBar(SharedContext &context, float alpha, const RewindBarStyle &style)
         const ImU32 borderColor = ImGui::ColorConvertFloat4ToU32(applyAlpha(style.colors.border));
         const ImU32 barColor = ImGui::ColorConvertFloat4ToU32(applyAlpha(style.colors.bar));
         const ImU32 secondsMarkerColor = ImGui::ColorConvertFloat4ToU32(applyAlpha(style.colors.secondsMarker));
+        const ImU32 cursorColor = ImGui::ColorConvertFloat4ToU32(applyAlpha(style.colors.cursor));
         const ImU32 textColor = ImGui::ColorConvertFloat4ToU32(applyAlpha(style.colors.text));
         const ImU32 textOutlineColor = ImGui::ColorConvertFloat4ToU32(ImVec4(0.0f, 0.0f, 0.0f, alpha * 0.8f));
 
@@ -118,12 +120,32 @@ void RewindBar(SharedContext &context, float alpha, const RewindBarStyle &style)
             secondOffset -= 60;
         }
 
+        // Cursor, only shown after seeking into the buffer
+        if (curr > 0 && cursor < curr - 1) {
+            const float x = pos.x + avail.x * (cursor + 1) / cap;
+            drawList->AddLine(ImVec2(x, pos.y + lineHeight), ImVec2(x, pos.y + avail.y), cursorColor,
+                              style.cursorThickness * context.displayScale);
+        }
+
         // Border
         drawList->AddRect(rectTopLeft, ImVec2(pos.x + avail.x, pos.y + avail.y), borderColor,
                           style.rounding * context.displayScale, ImDrawFlags_RoundCornersAll,
                           style.borderThickness * context.displayScale);
+
+        // Seek by clicking or dragging over the bar
+        ImGui::SetCursorScreenPos(rectTopLeft);
+        ImGui::InvisibleButton("##rewind_bar_seek", ImVec2(avail.x, std::max(avail.y - lineHeight, 1.0f)));
+        if (ImGui::IsItemActive() && curr > 0) {
+            const float mousePct = (ImGui::GetIO().MousePos.x - pos.x) / avail.x;
+            const size_t target = std::min(static_cast<size_t>(std::max(mousePct, 0.0f) * cap), curr - 1);
+            if (target != cursor) {
+                seekPosition = target;
+            }
+        }
     }
     ImGui::End();
+
+    return seekPosition;
 }
 
 } // namespace app::ui::widgets
@@ -2,6 +2,8 @@
 
 #include <app/shared_context.hpp>
 
+#include <optional>
+
 namespace app::ui::widgets {
 
 struct RewindBarStyle {
@@ -10,6 +12,7 @@ struct RewindBarStyle {
         ImVec4 border;
         ImVec4 bar;
         ImVec4 secondsMarker;
+        ImVec4 cursor;
         ImVec4 text;
     } colors;
 
@@ -18,6 +21,7 @@ struct RewindBarStyle {
     float rounding = 2.0f;
     float borderThickness = 2.0f;
     float secondsMarkerThickness = 1.5f;
+    float cursorThickness = 2.0f;
 };
 
 #define C(r, g, b, a) (r / 255.0f), (g / 255.0f), (b / 255.0f), a
@@ -29,12 +33,15 @@ inline RewindBarStyle g_defaultRewindBarStyle = {
             .border{C(87, 149, 255, 0.85f)},
             .bar{C(34, 115, 255, 0.75f)},
             .secondsMarker{C(15, 63, 145, 0.75f)},
+            .cursor{C(255, 255, 255, 0.90f)},
             .text{C(191, 215, 255, 1.00f)},
         },
 };
 
 #undef C
 
-void RewindBar(SharedContext &context, float alpha = 1.0f, const RewindBarStyle &style = g_defaultRewindBarStyle);
+// Draws the rewind buffer bar.
+// Returns the position of the frame to seek to if the user clicked or dragged over the bar.
+std::optional<size_t> RewindBar(SharedContext &context, float alpha = 1.0f, const RewindBarStyle &style = g_defaultRewindBarStyle);
 
 } // namespace app::ui::widgets
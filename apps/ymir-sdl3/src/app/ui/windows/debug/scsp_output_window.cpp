@@ -16,6 +16,10 @@ void SCSPOutputWindow::PrepareWindow() {
 }
 
 void SCSPOutputWindow::DrawContents() {
+    const auto &probe = m_scsp.GetProbe();
+    ImGui::Text("CD audio buffer: %u sectors, %llu underruns", probe.GetCDDABufferedSectors(),
+                static_cast<unsigned long long>(probe.GetCDDAUnderruns()));
+
     m_outputView.Display(ImGui::GetContentRegionAvail());
 }
 
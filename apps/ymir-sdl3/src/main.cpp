@@ -1,19 +1,150 @@
 #include "app/app.hpp"
 
+#include <serdes/state_file.hpp>
+
+#include <util/ipl_rom_loader.hpp>
 #include <util/os_exception_handler.hpp>
 
+#include <ymir/media/loader/loader.hpp>
+#include <ymir/media/loader/loader_ycd.hpp>
+#include <ymir/movie/movie.hpp>
+#include <ymir/sys/saturn.hpp>
+
 #include <cxxopts.hpp>
 #include <fmt/format.h>
+#include <fmt/std.h>
 
+#include <chrono>
+#include <filesystem>
 #include <memory>
+#include <vector>
+
+// Converts the specified disc images into a single YCD file.
+static int ConvertDiscImages(const std::vector<std::filesystem::path> &discPaths, const std::filesystem::path &ycdPath,
+                             bool deduplicate) {
+    if (discPaths.empty()) {
+        fmt::println("No disc images to convert");
+        return 1;
+    }
+
+    std::vector<ymir::media::Disc> discs{};
+    discs.reserve(discPaths.size());
+    for (const auto &path : discPaths) {
+        fmt::println("Loading {}", path);
+        if (!ymir::media::LoadDisc(path, discs.emplace_back(), false)) {
+            fmt::println("Failed to load disc image {}", path);
+            return 1;
+        }
+    }
+
+    std::vector<const ymir::media::Disc *> discPtrs{};
+    for (const auto &disc : discs) {
+        discPtrs.push_back(&disc);
+    }
+
+    fmt::println("Writing {}", ycdPath);
+    ymir::media::loader::ycd::WriteOptions writeOptions{};
+    writeOptions.deduplicate = deduplicate;
+    ymir::media::loader::ycd::WriteStats stats{};
+    if (!ymir::media::loader::ycd::Write(ycdPath, discPtrs, writeOptions, &stats)) {
+        fmt::println("Failed to write {}", ycdPath);
+        return 1;
+    }
+
+    fmt::println("{} sectors, {} unique", stats.totalSectors, stats.uniqueSectors);
+    fmt::println("{} bytes of sector data compressed to {} bytes ({:.1f}%)", stats.uncompressedSize,
+                 stats.compressedSize,
+                 stats.uncompressedSize > 0 ? 100.0 * stats.compressedSize / stats.uncompressedSize : 0.0);
+    return 0;
+}
+
+// Plays back an input movie without a window at maximum speed.
+static int PlayMovie(const std::filesystem::path &moviePath, const std::filesystem::path &discPath,
+                     const std::filesystem::path &iplPath, uint64 startFrame) {
+    ymir::movie::MovieReader movie{};
+    std::error_code error{};
+    if (!movie.Open(moviePath, error)) {
+        fmt::println("Failed to open movie {}: {}", moviePath, error.message());
+        return 1;
+    }
+    const auto &info = movie.GetInfo();
+    fmt::println("Movie has {} frames and {} keyframes", movie.GetFrameCount(), movie.GetKeyframes().size());
+    if (info.externalBackupMemory) {
+        fmt::println("Warning: the movie was recorded with a backup memory cartridge, which is not supported here");
+    }
+
+    auto saturn = std::make_unique<ymir::Saturn>();
+    saturn->configuration.video.threadedVDP = false;
+    ymir::movie::ApplyMovieInfo(info, saturn->configuration);
+    saturn->VDP.SetRenderingEnabled(false);
+
+    if (auto result = util::LoadIPLROM(iplPath, *saturn); !result.succeeded) {
+        fmt::println("Failed to load IPL ROM {}: {}", iplPath, result.errorMessage);
+        return 1;
+    }
+    if (saturn->GetIPLHash() != info.iplHash) {
+        fmt::println("Warning: IPL ROM does not match the one used to record the movie");
+    }
+
+    if (!discPath.empty()) {
+        ymir::media::Disc disc{};
+        if (!ymir::media::LoadDisc(discPath, disc, false)) {
+            fmt::println("Failed to load disc image {}", discPath);
+            return 1;
+        }
+        saturn->LoadDisc(std::move(disc));
+    }
+    if (saturn->GetDiscHash() != info.discHash) {
+        fmt::println("Warning: disc does not match the one used to record the movie");
+    }
+
+    ymir::movie::MoviePlayer player{*saturn, movie};
+    player.SetPersistentStateLoader(ymir::state::ReadStateArchive);
+    const auto t0 = std::chrono::steady_clock::now();
+    bool success = player.Seek(startFrame);
+    const auto t1 = std::chrono::steady_clock::now();
+    while (success && !player.IsFinished()) {
+        success = player.RunFrame();
+    }
+    const auto t2 = std::chrono::steady_clock::now();
+
+    if (!success) {
+        fmt::println("Failed to restore keyframe near frame {}", player.GetCurrentFrame());
+    } else {
+        const double seekSecs = std::chrono::duration<double>(t1 - t0).count();
+        const double playSecs = std::chrono::duration<double>(t2 - t1).count();
+        const uint64 playedFrames = movie.GetFrameCount() - std::min(startFrame, movie.GetFrameCount());
+        fmt::println("Seeked to frame {} in {:.3f} s", std::min(startFrame, movie.GetFrameCount()), seekSecs);
+        fmt::println("Played {} frames in {:.3f} s ({:.1f} fps)", playedFrames, playSecs,
+                     playSecs > 0.0 ? playedFrames / playSecs : 0.0);
+
+        // Fingerprint of the final state of the main memories, useful to check playback determinism
+        auto state = std::make_unique<ymir::state::State>();
+        saturn->SaveState(*state);
+        std::vector<uint8> memory{};
+        memory.insert(memory.end(), state->system.WRAMLow.begin(), state->system.WRAMLow.end());
+        memory.insert(memory.end(), state->system.WRAMHigh.begin(), state->system.WRAMHigh.end());
+        memory.insert(memory.end(), state->vdp.VRAM1.begin(), state->vdp.VRAM1.end());
+        memory.insert(memory.end(), state->vdp.VRAM2.begin(), state->vdp.VRAM2.end());
+        fmt::println("Final memory hash: {}", ymir::ToString(ymir::CalcHash128(memory.data(), memory.size())));
+    }
+
+    return success ? 0 : 1;
+}
 
 int main(int argc, char **argv) {
     bool showHelp = false;
     bool enableAllExceptions = false;
+    std::filesystem::path convertPath{};
+    std::vector<std::filesystem::path> extraDiscPaths{};
+    bool noDedup = false;
+    std::filesystem::path moviePath{};
+    std::filesystem::path iplPath{};
+    uint64 movieStartFrame = 0;
 
     app::CommandLineOptions progOpts{};
     cxxopts::Options options("Ymir", "Ymir - Sega Saturn emulator");
-    options.add_options()("d,disc", "Path to Saturn disc image (.ccd, .chd, .cue, .iso, .mds)",
+    options.add_options()("d,disc", "Path to Saturn disc image (.ccd, .chd, .cue, .iso, .mds, .ycd)",
                           cxxopts::value(progOpts.gameDiscPath));
     options.add_options()("p,profile", "Path to profile directory", cxxopts::value(progOpts.profilePath));
     options.add_options()("u,user", "Force user profile",
@@ -24,7 +155,19 @@ int main(int argc, char **argv) {
     options.add_options()("P,paused", "Start paused", cxxopts::value(progOpts.startPaused)->default_value("false"));
     options.add_options()("E,exceptions", "Capture all unhandled exceptions",
                           cxxopts::value(enableAllExceptions)->default_value("false"));
-    options.parse_positional({"disc"});
+    options.add_options()("c,convert", "Convert the disc image and any extra discs into a YCD file and exit",
+                          cxxopts::value(convertPath));
+    options.add_options()("extra-discs",
+                          "Additional disc images to store in the converted YCD file; requires --convert",
+                          cxxopts::value(extraDiscPaths));
+    options.add_options()("no-dedup", "Don't deduplicate identical sectors when converting disc images",
+                          cxxopts::value(noDedup)->default_value("false"));
+    options.add_options()("play-movie", "Play back the input movie without a window at maximum speed and exit",
+                          cxxopts::value(moviePath));
+    options.add_options()("ipl", "Path to the IPL ROM used to play back movies", cxxopts::value(iplPath));
+    options.add_options()("movie-start", "Frame to seek to before playing back the movie",
+                          cxxopts::value(movieStartFrame)->default_value("0"));
+    options.parse_positional({"disc", "extra-discs"});
 
     try {
         auto result = options.parse(argc, argv);
@@ -33,6 +176,28 @@ int main(int argc, char **argv) {
             return 0;
         }
 
+        // Additional positional arguments are only meaningful when converting disc images
+        if (!extraDiscPaths.empty() && convertPath.empty()) {
+            std::string msg = fmt::format("Unexpected argument: {}. Extra disc images require --convert",
+                                          extraDiscPaths.front());
+            fmt::println("{}", msg);
+            util::ShowFatalErrorDialog(msg.c_str());
+            return -1;
+        }
+
+        if (!convertPath.empty()) {
+            std::vector<std::filesystem::path> discPaths{};
+            if (!progOpts.gameDiscPath.empty()) {
+                discPaths.push_back(progOpts.gameDiscPath);
+            }
+            discPaths.insert(discPaths.end(), extraDiscPaths.begin(), extraDiscPaths.end());
+            return ConvertDiscImages(discPaths, convertPath, !noDedup);
+        }
+
+        if (!moviePath.empty()) {
+            return PlayMovie(moviePath, progOpts.gameDiscPath, iplPath, movieStartFrame);
+        }
+
         util::RegisterExceptionHandler(enableAllExceptions);
 
         auto app = std::make_unique<app::App>();
@@ -183,7 +183,7 @@ void serialize(Archive &ar, SCUState &s, const uint32 version) {
         switch (s.cartType) {
         case SCUState::CartType::DRAM8Mbit: s.cartData.resize(1_MiB); break;
         case SCUState::CartType::DRAM32Mbit: s.cartData.resize(4_MiB); break;
-        case SCUState::CartType::ROM: s.cartData.resize(2_MiB);
+        case SCUState::CartType::ROM: s.cartData.resize(2_MiB); break;
         default: s.cartData.clear(); break;
         }
     } else {
@@ -320,6 +320,8 @@ void serialize(Archive &ar, VDPState &s, const uint32 version) {
     // v9:
     // - New fields
     //   - enum VDPState::VerticalPhase: added VCounterSkip (= 5)
+    // - Changed fields
+    //   - regs2.VCNT: now stores the value read by software instead of the internal counter
     // v7:
     // - New fields
     //   - VDP1TimingPenalty = 0
@@ -369,6 +371,24 @@ void serialize(Archive &ar, VDPState &s, const uint32 version) {
             s.VPhase = VDPState::VerticalPhase::VCounterSkip;
         }
 
+        // VCNT was stored as the internal counter. Convert it to the value read by software, which includes the
+        // counter skip and the double-density interlace shift.
+        const uint16 interlaceMode = (s.regs2.TVMD >> 6u) & 3;
+        uint16 VCNTSkip = 0;
+        switch (s.VPhase) {
+        case VDPState::VerticalPhase::VCounterSkip: [[fallthrough]];
+        case VDPState::VerticalPhase::TopBorder: [[fallthrough]];
+        case VDPState::VerticalPhase::LastLine: //
+        {
+            const uint16 baseSkip = (s.regs2.TVSTAT & 1) ? 313 : 263;
+            const uint16 fieldSkip = (interlaceMode != 0 && (s.regs2.TVSTAT & 2) == 0) ? 1 : 0;
+            VCNTSkip = 0x200 - baseSkip + fieldSkip;
+            break;
+        }
+        default: break;
+        }
+        s.regs2.VCNT = (s.regs2.VCNT << (interlaceMode == 3 ? 1 : 0)) + VCNTSkip;
+
         // Replace obsolete horizontal phases
         switch (static_cast<uint8>(s.HPhase)) {
         case 3 /*VBlankOut*/: s.HPhase = VDPState::HorizontalPhase::Sync; break;
@@ -960,6 +980,42 @@ void serialize(Archive &ar, SCSPTimer &s) {
     ar(s.counter);
 }
 
+// Converts the pre-v9 CD block buffer layout into the buffer pool layout.
+//
+// Old layout: partition buffers stored sequentially in partition order, followed by the scratch buffers starting at
+// the first unused position. There are no reserved buffers in this layout.
+// New layout: buffers linked into partitions; scratch buffer at the end of the array.
+inline void LinkSequentialCDBlockBuffers(CDBlockState &s) {
+    s.partitionFirstBuffers.fill(0xFF);
+    s.reservedFirstBuffer = 0xFF;
+
+    std::array<uint8, cdblock::kNumPartitions> lastBuffers{};
+    lastBuffers.fill(0xFF);
+    uint32 usedBuffers = 0;
+    for (uint32 i = 0; i < cdblock::kNumBuffers; ++i) {
+        auto &buffer = s.buffers[i];
+        buffer.next = 0xFF;
+        if (buffer.partitionIndex >= cdblock::kNumPartitions) {
+            continue;
+        }
+        if (lastBuffers[buffer.partitionIndex] == 0xFF) {
+            s.partitionFirstBuffers[buffer.partitionIndex] = i;
+        } else {
+            s.buffers[lastBuffers[buffer.partitionIndex]].next = i;
+        }
+        lastBuffers[buffer.partitionIndex] = i;
+        ++usedBuffers;
+    }
+
+    // The drive read into the first scratch buffer, which was stored right after the partition buffers
+    s.buffers[cdblock::kNumBuffers] = s.buffers[usedBuffers];
+    s.buffers[cdblock::kNumBuffers].partitionIndex = 0xFF;
+    s.buffers[cdblock::kNumBuffers].next = 0xFF;
+    for (uint32 i = usedBuffers; i < cdblock::kNumBuffers; ++i) {
+        s.buffers[i].partitionIndex = 0xFF;
+    }
+}
+
 template <class Archive>
 void serialize(Archive &ar, CDBlockState &s, const uint32 version) {
     // v9:
@@ -970,6 +1026,11 @@ void serialize(Archive &ar, CDBlockState &s, const uint32 version) {
     //   - xferDelCount = (xferLength + getSectorLength - 1) / getSectorLength if xferType == GetThenDeleteSector,
     //     otherwise 0
     //   - reservedBuffers = 0
+    //   - partitionFirstBuffers, reservedFirstBuffer: derived from the buffer layout (see below)
+    // - Changed fields
+    //   - buffers are stored at their buffer pool index and linked into partitions. Previously, partition buffers were
+    //     stored sequentially, followed by the scratch buffers used by Put Sector Data transfers. The reserved buffers
+    //     now hold the Put Sector Data contents and the scratch buffer is stored at the end of the array.
     // v8:
     // - New fields
     //   - fs
@@ -1036,8 +1097,10 @@ void serialize(Archive &ar, CDBlockState &s, const uint32 version) {
     }
     if (version >= 9) {
         ar(s.reservedBuffers);
+        ar(s.partitionFirstBuffers, s.reservedFirstBuffer);
     } else {
         s.reservedBuffers = 0;
+        LinkSequentialCDBlockBuffers(s);
     }
     ar(s.filters);
     ar(s.cdDeviceConnection, s.lastCDWritePartition);
@@ -1077,10 +1140,19 @@ void serialize(Archive &ar, CDBlockState::StatusState &s, const uint32 version)
 
 template <class Archive>
 void serialize(Archive &ar, CDBlockState::BufferState &s, const uint32 version) {
+    // v9:
+    // - New fields
+    //   - next: derived from the buffer layout (see CDBlockState)
+
     ar(s.data, s.size);
     ar(s.frameAddress);
     ar(s.fileNum, s.chanNum, s.submode, s.codingInfo);
     ar(s.partitionIndex);
+    if (version >= 9) {
+        ar(s.next);
+    } else {
+        s.next = 0xFF;
+    }
 }
 
 template <class Archive>
@@ -0,0 +1,136 @@
+#include <serdes/state_file.hpp>
+
+#include <serdes/state_cereal.hpp>
+
+#include <ymir/util/data_ops.hpp>
+
+#include <util/file_loader.hpp>
+
+#include <cereal/archives/portable_binary.hpp>
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace ymir::state {
+
+static constexpr char kCompressedMagic[4] = {'Y', 'M', 'S', 'Z'};
+static constexpr uint8 kCompressionLZ4 = 1;
+static constexpr size_t kCompressedHeaderSize = 16;
+
+static std::string SerializeState(const State &state) {
+    std::ostringstream archiveStream{std::ios::binary};
+    {
+        cereal::PortableBinaryOutputArchive archive{archiveStream};
+        archive(state);
+    }
+    return std::move(archiveStream).str();
+}
+
+bool WriteStateFile(const std::filesystem::path &path, const State &state, bool compress, std::error_code &error) {
+    std::string archiveData = SerializeState(state);
+
+    std::string fileData{};
+    if (compress && archiveData.size() <= LZ4_MAX_INPUT_SIZE) {
+        const int bound = LZ4_compressBound(static_cast<int>(archiveData.size()));
+        fileData.resize(kCompressedHeaderSize + bound);
+        std::copy_n(kCompressedMagic, sizeof(kCompressedMagic), fileData.begin());
+        fileData[4] = static_cast<char>(kCompressionLZ4);
+        util::WriteLE<uint64>(&fileData[8], archiveData.size());
+        const int compressedSize =
+            LZ4_compress_HC(archiveData.data(), &fileData[kCompressedHeaderSize], static_cast<int>(archiveData.size()),
+                            bound, LZ4HC_CLEVEL_DEFAULT);
+        if (compressedSize > 0) {
+            fileData.resize(kCompressedHeaderSize + compressedSize);
+        } else {
+            fileData = std::move(archiveData);
+        }
+    } else {
+        fileData = std::move(archiveData);
+    }
+
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream out{tempPath, std::ios::binary | std::ios::trunc};
+        if (!out) {
+            error.assign(errno, std::generic_category());
+            return false;
+        }
+        out.write(fileData.data(), fileData.size());
+        out.flush();
+        if (!out) {
+            error = std::make_error_code(std::errc::io_error);
+            out.close();
+            std::error_code removeError{};
+            std::filesystem::remove(tempPath, removeError);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::error_code removeError{};
+        std::filesystem::remove(tempPath, removeError);
+        return false;
+    }
+    return true;
+}
+
+void ReadStateFile(const std::filesystem::path &path, State &state) {
+    std::error_code error{};
+    std::vector<uint8> fileData = util::LoadFile(path, error);
+    if (error) {
+        throw std::system_error(error);
+    }
+
+    std::string archiveData{};
+    if (fileData.size() >= kCompressedHeaderSize && std::equal(std::begin(kCompressedMagic), std::end(kCompressedMagic),
+                                                               reinterpret_cast<const char *>(fileData.data()))) {
+        if (fileData[4] != kCompressionLZ4) {
+            throw std::runtime_error("unsupported compression method");
+        }
+        const uint64 archiveSize = util::ReadLE<uint64>(&fileData[8]);
+        const size_t compressedSize = fileData.size() - kCompressedHeaderSize;
+        if (archiveSize > LZ4_MAX_INPUT_SIZE || compressedSize > LZ4_MAX_INPUT_SIZE) {
+            throw std::runtime_error("compressed data is too large");
+        }
+        archiveData.resize(archiveSize);
+        const char *compressedData = reinterpret_cast<const char *>(&fileData[kCompressedHeaderSize]);
+        const int decompressedSize = LZ4_decompress_safe(compressedData, archiveData.data(),
+                                                         static_cast<int>(compressedSize), static_cast<int>(archiveSize));
+        if (decompressedSize < 0 || static_cast<uint64>(decompressedSize) != archiveSize) {
+            throw std::runtime_error("corrupted compressed data");
+        }
+    } else {
+        archiveData.assign(fileData.begin(), fileData.end());
+    }
+    fileData = {};
+
+    std::istringstream archiveStream{std::move(archiveData), std::ios::binary};
+    cereal::PortableBinaryInputArchive archive{archiveStream};
+    archive(state);
+}
+
+std::vector<uint8> WriteStateArchive(const State &state) {
+    const std::string archiveData = SerializeState(state);
+    return {archiveData.begin(), archiveData.end()};
+}
+
+bool ReadStateArchive(std::span<const uint8> data, State &state) {
+    std::istringstream archiveStream{std::string(data.begin(), data.end()), std::ios::binary};
+    try {
+        cereal::PortableBinaryInputArchive archive{archiveStream};
+        archive(state);
+    } catch (const std::exception &) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace ymir::state
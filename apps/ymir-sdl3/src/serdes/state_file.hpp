@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ymir/state/state.hpp>
+
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace ymir::state {
+
+// Save state files contain a cereal portable binary archive of the State, either as is or compressed with LZ4.
+//
+// Compressed files start with this header, followed by the compressed archive:
+//   char[4]   "YMSZ"
+//   uint8     compression method (1 = LZ4)
+//   uint8[3]  reserved, zero
+//   uint64    uncompressed archive size (little-endian)
+//
+// Uncompressed archives start with cereal's endianness flag (0 or 1), so the two formats are told apart by the first
+// byte. Files written by previous versions are therefore still readable.
+
+// Writes the state to the specified file, optionally compressing it.
+// The data is written to a temporary file in the same directory which is then renamed over the target file, so that the
+// target is never left partially written.
+// Returns false and sets error if the file could not be written.
+bool WriteStateFile(const std::filesystem::path &path, const State &state, bool compress, std::error_code &error);
+
+// Reads a state from the specified file, which may be compressed or not.
+// Throws an exception if the file could not be read or is invalid.
+void ReadStateFile(const std::filesystem::path &path, State &state);
+
+// Serializes the state into an uncompressed cereal portable binary archive, the same format used by save state files.
+std::vector<uint8> WriteStateArchive(const State &state);
+
+// Deserializes a state from an uncompressed cereal portable binary archive.
+// Returns false if the archive is invalid.
+bool ReadStateArchive(std::span<const uint8> data, State &state);
+
+} // namespace ymir::state
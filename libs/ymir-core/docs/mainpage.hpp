@@ -38,7 +38,7 @@ You can configure several parameters of the emulator core through `ymir::Saturn:
 
 Use `ymir::Saturn::LoadIPL` to copy an IPL ROM image into the emulator. By default, the emulator will use a simple
 do-nothing image that puts the master SH-2 into an infinite loop and immediately returns from all exceptions. The IPL
-ROM is accessible through the `ymir::Saturn::mem` member, in `ymir::sys::SystemMemory::IPL`.
+ROM is accessible through the `ymir::Saturn::mem` member with `ymir::sys::SystemMemory::GetIPL`.
 
 To load discs, you will need to use the media loader library included with the emulator core in media/loader/loader.hpp.
 The header is automatically included with ymir.hpp. Use `ymir::media::LoadDisc` to load a disc into an
@@ -146,6 +146,26 @@ You'll probably want to accumulate those samples into a ring buffer before sendi
 
 Use `ymir::scsp::SCSP::SetSampleCallback` to bind this callback.
 
+Alternatively, the SCSP can accumulate samples into an internal buffer and deliver them in bulk, which greatly reduces
+the per-sample call and synchronization overhead. The batched callback signature is:
+
+```cpp
+void SCSPSampleBatchCallback(std::span<const ymir::scsp::OutputFrame> frames, void *userContext)
+```
+
+where `frames` contains interleaved left/right samples. The callback is invoked whenever the configured number of
+frames (between 1 and `ymir::scsp::kMaxOutputBatchSize`) has been accumulated, or when
+`ymir::scsp::SCSP::FlushSampleBatch` is called.
+
+Use `ymir::scsp::SCSP::SetSampleBatchCallback` to bind this callback and `ymir::scsp::SCSP::SetSampleBatchSize` to
+change the batch size. Binding one callback disables the other.
+
+By default, samples are delivered at the SCSP's native rate of 44100 Hz. Set `audio.outputSampleRate` in the core
+configuration to have the core resample its output to another rate (for example, the audio device's native rate) with a
+high-quality polyphase filter. `ymir::scsp::SCSP::GetOutputSampleRate` returns the rate currently in use. To keep your
+audio buffer at a stable level when synchronizing emulation to video, fine-tune the conversion ratio from within the
+sample callbacks with `ymir::scsp::SCSP::SetOutputRateAdjustment`.
+
 You can run the emulator core without providing video and audio callbacks (headless mode). It will work fine, but you
 won't receive video frames or audio samples.
 
@@ -203,6 +223,29 @@ persistent data path so that any further changes are automatically saved to that
 these functions only once to configure the persistent path for SMPC settings for the lifetime of the `ymir::Saturn`
 instance.
 
+`ymir::bup::BackupMemory` can also load a copy of an image from memory with `LoadFrom(std::span<const uint8>)`. Such
+backup memories are not bound to any file and are discarded along with the object.
+
+
+
+@subsection forking Forking
+
+`ymir::Saturn::Fork` creates an independent copy of a system in its current state, which is useful to explore several
+branches of execution from a common starting point:
+
+```cpp
+ymir::Saturn &saturn = ...;
+std::unique_ptr<ymir::Saturn> branch = saturn.Fork();
+if (branch) {
+    // Set up peripherals and callbacks, then run the branch
+    branch->RunFrame();
+}
+```
+
+The copy shares the disc image with the original system and uses the same configuration. Backup memories are copied
+into memory and SMPC persistent data is not bound to any file, so running the copy never modifies the files used by the
+original system. Peripherals, callbacks and debug tracing must be set up again on the copy.
+
 
 
 @subsection debugging Debugging
@@ -262,11 +305,53 @@ the callback. The callback function is called from the emulator thread.
 
 @subsection thread_safety Thread safety
 
-The emulator core is *not* thread-safe and *will never be*. Make sure to provide your own synchronization mechanisms if
-you plan to run it in a dedicated thread.
+The emulator core is *not* thread-safe and *will never be*. Each `ymir::Saturn` instance must only be used by one
+thread at a time. Make sure to provide your own synchronization mechanisms if you plan to run it in a dedicated thread.
 
 As noted above, the input, video and audio callbacks as well as debug tracers are invoked from the emulator thread.
 Provide proper synchronization between the emulator thread and the main/GUI thread when handling these events.
 
 The VDP renderer may optionally run in its own thread. It is thread-safe within the core.
+
+
+
+@subsection multiple_instances Running multiple instances
+
+Any number of `ymir::Saturn` instances can exist in the same process, and separate instances can run concurrently on
+different threads without any synchronization between them. Every instance owns all of its mutable state: memory,
+registers, schedulers, peripherals, cartridges, callbacks and the VDP renderer thread. Callbacks are registered per
+instance and are invoked on the thread running that instance.
+
+The only state shared between instances is read-only or internally synchronized:
+- The SH-2 and M68K instruction decode and disassembly tables are built during static initialization and never modified
+  afterwards.
+- IPL ROM images (`ymir::sys::IPLImage`) and ROM cartridge images (`ymir::cart::ROMImage`) are immutable once created.
+  ROM cartridges make a private copy of the image before their contents are modified through the debugger.
+- Disc copies made with `ymir::media::Disc::Clone` share the binary readers and sector caches of the original disc.
+  Binary readers support concurrent reads, including the CHD hunk cache and its decompression threads.
+- Preloading disc images to RAM is throttled process-wide so that only one image is read from storage at a time.
+
+The settings in `ymir::core::Configuration` are per instance. Setting the same files for the internal backup memory,
+backup memory cartridges or SMPC persistent data on multiple instances results in concurrent writes to those files;
+give each instance its own files or in-memory backup memories instead.
+
+Use `ymir::sys::AssetRegistry` to load a single copy of each asset and share it among instances:
+
+```cpp
+ymir::sys::AssetRegistry assets{};
+std::vector<std::unique_ptr<ymir::Saturn>> instances = ...;
+for (auto &saturn : instances) {
+    saturn->LoadIPL(assets.GetIPL(iplData));
+
+    ymir::media::Disc disc{};
+    if (assets.LoadDisc(discPath, disc, false)) {
+        saturn->LoadDisc(std::move(disc));
+    }
+}
+// Run each instance on its own thread
+```
+
+The registry is thread-safe and holds on to the assets until `ymir::sys::AssetRegistry::ReleaseUnused` or
+`ymir::sys::AssetRegistry::Clear` is called. Instances keep their assets alive regardless. `ymir::Saturn::Fork` shares
+the same assets as the original system without going through the registry.
 */
@@ -95,6 +95,34 @@ struct Configuration {
 
         /// @brief Runs the SCSP and MC68EC000 CPU in a dedicated thread.
         util::Observable<bool> threadedSCSP = false;
+
+        /// @brief Records slot outputs and send levels throughout the sample cycle and mixes all slots at once with
+        /// vector instructions at the end of each sample.
+        ///
+        /// The output is bit-identical to slot-by-slot mixing. Changes take effect at the next sample boundary.
+        ///
+        /// This value is thread-safe.
+        util::Observable<bool> vectorizedMixing = true;
+
+        /// @brief Sample rate of the audio delivered to the SCSP output callbacks, in Hz.
+        ///
+        /// The SCSP natively outputs audio at 44100 Hz. Any other value enables the core resampler, a polyphase
+        /// windowed-sinc filter with a fixed latency of 16 samples at 44100 Hz, so that the host audio device can be
+        /// fed directly at its native rate. Accepted values range from 8000 to 192000.
+        ///
+        /// Changes take effect at the next sample.
+        ///
+        /// This value is thread-safe.
+        util::Observable<uint32> outputSampleRate = 44100;
+
+        /// @brief Amount of CD audio buffered by the SCSP before playback starts, in sectors of 1/75 of a second.
+        ///
+        /// While playing audio tracks, the CD drive is paced to keep between 1 and 5 sectors more than this amount in
+        /// the buffer. Higher values make CD audio more resilient to uneven sector delivery at the cost of latency.
+        /// Accepted values range from 2 to 8.
+        ///
+        /// This value is thread-safe.
+        util::Observable<uint8> cddaBufferLatency = 4;
     } audio;
 
     /// @brief CD Block configuration.
@@ -106,12 +134,27 @@ struct Configuration {
         ///
         /// This value is thread-safe.
         util::Observable<uint8> readSpeedFactor = 2;
+
+        /// @brief Reads disc sectors ahead of the emulated drive head on a worker thread.
+        ///
+        /// Hides disc image access latency (CHD hunk decompression, cold file caches, slow network filesystems) from
+        /// the emulator thread during sequential reads. Changes take effect on the next playback request.
+        ///
+        /// This value is thread-safe.
+        util::Observable<bool> sectorPrefetch = true;
     } cdblock;
 
     /// @brief Notifies all observers registered with all observables.
     ///
     /// This is useful if you wish to apply the default values instead of replacing them with a configuration system.
     void NotifyObservers();
+
+    /// @brief Copies all values from another configuration into this one, notifying observers of each value.
+    ///
+    /// Observers registered with the other configuration are not copied.
+    ///
+    /// @param[in] other the configuration to copy values from
+    void CopyFrom(const Configuration &other);
 };
 
 } // namespace ymir::core
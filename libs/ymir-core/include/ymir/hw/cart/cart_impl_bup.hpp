@@ -51,6 +51,9 @@ public:
     bup::IBackupMemory &GetBackupMemory() {
         return m_backupRAM;
     }
+    const bup::IBackupMemory &GetBackupMemory() const {
+        return m_backupRAM;
+    }
 
     void CopyBackupMemoryFrom(const bup::IBackupMemory &backupRAM);
 
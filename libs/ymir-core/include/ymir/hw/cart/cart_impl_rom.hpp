@@ -6,12 +6,27 @@
 
 #include <ymir/util/data_ops.hpp>
 
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <span>
+
 namespace ymir::cart {
 
+// The contents of a ROM cartridge.
+// Images are immutable once loaded, so a single image can be shared by any number of cartridges, including those of
+// systems running concurrently on different threads.
+struct ROMImage {
+    alignas(16) std::array<uint8, kROMCartSize> data{};
+};
+
 class ROMCartridge final : public BaseCartridge {
 public:
     ROMCartridge()
-        : BaseCartridge(0xFFu, CartType::ROM) {}
+        : BaseCartridge(0xFFu, CartType::ROM) {
+        static const auto kEmptyImage = std::make_shared<const ROMImage>();
+        LoadROM(kEmptyImage);
+    }
 
     uint8 ReadByte(uint32 address) const override {
         if (util::AddressInRange<0x200'0000, 0x3FF'FFFF>(address)) {
@@ -48,26 +63,62 @@ public:
 
     void PokeByte(uint32 address, uint8 value) override {
         if (util::AddressInRange<0x200'0000, 0x3FF'FFFF>(address)) {
-            m_rom[address & (kROMCartSize - 1)] = value;
+            MutableROM()[address & (kROMCartSize - 1)] = value;
         }
     }
     void PokeWord(uint32 address, uint16 value) override {
         if (util::AddressInRange<0x200'0000, 0x3FF'FFFF>(address)) {
-            util::WriteBE<uint16>(&m_rom[address & (kROMCartSize - 1) & ~1], value);
+            util::WriteBE<uint16>(&MutableROM()[address & (kROMCartSize - 1) & ~1], value);
+        }
+    }
+
+    // Loads a copy of the given ROM contents. Images smaller than the cartridge are padded with zeros.
+    // Keeps the current image if its contents already match the given image.
+    void LoadROM(std::span<const uint8> rom) {
+        const size_t size = std::min(rom.size(), kROMCartSize);
+        if (std::equal(rom.begin(), rom.begin() + size, m_rom) &&
+            std::all_of(m_rom + size, m_rom + kROMCartSize, [](uint8 value) { return value == 0; })) {
+            return;
         }
+        auto image = std::make_shared<ROMImage>();
+        std::copy_n(rom.begin(), size, image->data.begin());
+        m_image = image;
+        m_rom = image->data.data();
+        m_ownsImage = true;
     }
 
-    void LoadROM(std::span<const uint8> out) {
-        const size_t size = std::min(out.size(), kROMCartSize);
-        std::copy_n(out.begin(), size, m_rom.begin());
+    // Loads the given shared ROM image, which must not be nullptr.
+    // The image is not copied unless the cartridge contents are modified through the Poke* methods.
+    void LoadROM(std::shared_ptr<const ROMImage> image) {
+        m_image = std::move(image);
+        m_rom = m_image->data.data();
+        m_ownsImage = false;
     }
 
     void DumpROM(std::span<uint8, kROMCartSize> out) const {
-        std::copy(m_rom.begin(), m_rom.end(), out.begin());
+        std::copy_n(m_rom, kROMCartSize, out.begin());
+    }
+
+    const std::shared_ptr<const ROMImage> &GetImage() const {
+        return m_image;
     }
 
-protected:
-    std::array<uint8, kROMCartSize> m_rom;
+private:
+    std::shared_ptr<const ROMImage> m_image;
+    const uint8 *m_rom; // Points to the contents of m_image
+    bool m_ownsImage;   // Whether m_image is a private copy that can be modified
+
+    // Returns a pointer to the contents of a private copy of the image, making one first if the image is shared.
+    uint8 *MutableROM() {
+        if (!m_ownsImage) {
+            auto image = std::make_shared<ROMImage>(*m_image);
+            m_image = image;
+            m_rom = image->data.data();
+            m_ownsImage = true;
+        }
+        // Private images are allocated as mutable objects
+        return const_cast<uint8 *>(m_rom);
+    }
 };
 
 } // namespace ymir::cart
@@ -4,6 +4,8 @@
 
 #include "cdblock_buffer.hpp"
 #include "cdblock_filter.hpp"
+#include "cdblock_partition_manager.hpp"
+#include "cdblock_prefetcher.hpp"
 
 #include <ymir/core/configuration.hpp>
 #include <ymir/core/scheduler.hpp>
@@ -17,6 +19,7 @@
 #include <ymir/sys/system_internal_callbacks.hpp>
 
 #include <ymir/state/state_cdblock.hpp>
+#include <ymir/state/state_dirty_pages.hpp>
 
 #include <ymir/hw/hw_defs.hpp>
 
@@ -25,8 +28,9 @@
 
 #include <ymir/core/hash.hpp>
 
+#include <ymir/util/dirty_pages.hpp>
+
 #include <array>
-#include <deque>
 
 namespace ymir::cdblock {
 
@@ -36,9 +40,11 @@ public:
 
     void Reset(bool hard);
 
-    void MapCallbacks(CBTriggerExternalInterrupt0 cbTriggerExtIntr0, CBCDDASector cbCDDASector) {
+    void MapCallbacks(CBTriggerExternalInterrupt0 cbTriggerExtIntr0, CBCDDASector cbCDDASector,
+                      CBCDDAPlaybackStart cbCDDAPlaybackStart) {
         m_cbTriggerExternalInterrupt0 = cbTriggerExtIntr0;
         m_cbCDDASector = cbCDDASector;
+        m_cbCDDAPlaybackStart = cbCDDAPlaybackStart;
     }
 
     void MapMemory(sys::Bus &bus);
@@ -46,6 +52,9 @@ public:
     void UpdateClockRatios(const sys::ClockRatios &clockRatios);
 
     void LoadDisc(media::Disc &&disc);
+    // Loads a clone of the disc in another CD block, reusing its file system structure instead of reading it again.
+    // Does not update the drive status; meant to be followed by loading a save state from the other CD block.
+    void LoadDiscFrom(const CDBlock &other);
     void EjectDisc();
     void OpenTray();
     void CloseTray();
@@ -60,12 +69,28 @@ public:
     // Save states
 
     void SaveState(state::CDBlockState &state) const;
+    void SaveStateIncremental(state::CDBlockState &state, state::DirtyPages &dirty);
     [[nodiscard]] bool ValidateState(const state::CDBlockState &state) const;
     void LoadState(const state::CDBlockState &state);
 
+    // Marks all sector buffers as modified so that the next incremental save copies them.
+    void InvalidateIncrementalState() {
+        m_partitionManager.InvalidateIncrementalState();
+    }
+
+    // Marks all sector buffers as unmodified.
+    // Only valid when the state object used for incremental saves matches the current buffer contents.
+    void ClearDirtyPages() {
+        m_partitionManager.ClearDirtyPages();
+    }
+
 private:
+    template <bool incremental>
+    void SaveStateImpl(state::CDBlockState &state, state::DirtyPages *dirty) const;
+
     CBTriggerExternalInterrupt0 m_cbTriggerExternalInterrupt0;
     CBCDDASector m_cbCDDASector;
+    CBCDDAPlaybackStart m_cbCDDAPlaybackStart;
 
     core::Scheduler &m_scheduler;
     core::EventID m_driveStateUpdateEvent;
@@ -80,6 +105,14 @@ private:
     media::Disc m_disc;
     media::fs::Filesystem m_fs;
 
+    // Reads sectors ahead of the drive head on a worker thread.
+    // Must be declared after m_disc so that the worker thread is stopped before the disc is destroyed.
+    SectorPrefetcher m_prefetcher{m_disc};
+    bool m_sectorPrefetch = false; // Sector prefetch configuration, applied on the next playback request
+
+    // Starts prefetching sectors for the given play range, enabling or disabling the worker thread as configured.
+    void StartPrefetch(uint32 startFrameAddress, uint32 endFrameAddress);
+
     // -------------------------------------------------------------------------
     // Memory accessors (SCU-facing bus)
     // 16-bit reads, 8- or 16-bit writes
@@ -98,6 +131,11 @@ private:
     template <mem_primitive T>
     void PokeReg(uint32 address, T value);
 
+    // Block reads from the data transfer register, used by DMA transfers.
+    // Returns false if the address is not the data transfer register or the transfer cannot be read in bulk.
+    template <mem_primitive T>
+    bool ReadRegBlock(uint32 address, T *out, uint32 count);
+
     // -------------------------------------------------------------------------
     // Disc/drive state
 
@@ -221,9 +259,10 @@ private:
     void ReadSector();
 
     uint16 DoReadTransfer();
+    bool DoReadTransferBlock(uint16 *out, uint32 count);
     void DoWriteTransfer(uint16 value);
 
-    void AdvanceTransfer();
+    void AdvanceTransfer(uint32 count = 1);
 
     void EndTransfer();
 
@@ -272,47 +311,11 @@ private:
     //
     // Disconnected filter output connectors will result in dropping the data.
 
-    class PartitionManager {
-    public:
-        PartitionManager();
-
-        void Reset();
-
-        uint8 GetBufferCount(uint8 partitionIndex) const;
-        uint32 GetFreeBufferCount() const;
-        bool ReserveBuffers(uint16 count);
-        bool UseReservedBuffers(uint16 count);
-        void ReleaseReservedBuffers();
-
-        void InsertHead(uint8 partitionIndex, const Buffer &buffer);
-        Buffer *GetTail(uint8 partitionIndex, uint8 offset);
-        bool RemoveTail(uint8 partitionIndex, uint8 offset);
-
-        uint32 DeleteSectors(uint8 partitionIndex, uint16 sectorPos, uint16 sectorCount);
-
-        void Clear(uint8 partitionIndex);
-
-        uint32 CalculateSize(uint8 partitionIndex, uint32 start, uint32 end) const;
-
-        // -------------------------------------------------------------------------
-        // Save states
-
-        void SaveState(state::CDBlockState &state) const;
-        [[nodiscard]] bool ValidateState(const state::CDBlockState &state) const;
-        void LoadState(const state::CDBlockState &state);
-
-    private:
-        std::array<std::deque<Buffer>, kNumPartitions> m_partitions;
-
-        uint32 m_freeBuffers;
-        uint32 m_reservedBuffers;
-    };
-
     PartitionManager m_partitionManager;
     std::array<Filter, kNumFilters> m_filters;
 
-    std::array<Buffer, kNumBuffers + 1> m_scratchBuffers;
-    uint32 m_scratchBufferPutIndex;
+    Buffer m_scratchBuffer;         // Sector read from the drive, before it is routed through the filters
+    uint32 m_scratchBufferPutIndex; // Index of the reserved buffer being written by a Put Sector Data transfer
 
     uint8 m_cdDeviceConnection;
     uint8 m_lastCDWritePartition;
@@ -328,6 +331,11 @@ private:
 
     void DisconnectFilterInput(uint8 filterNumber);
 
+    // Tests the sector against the given filter, following fail outputs until a filter passes it.
+    // Returns the buffer partition connected to the pass output of that filter, or Filter::kDisconnected if the sector
+    // is discarded.
+    uint8 RouteSector(uint8 filterNumber, const Buffer &buffer) const;
+
     // -------------------------------------------------------------------------
     // Commands
 
@@ -459,6 +467,10 @@ public:
         const media::fs::FilesystemEntry *GetFileAtFrameAddress(uint32 fad) const;
         std::string GetPathAtFrameAddress(uint32 fad) const;
 
+        // Index of all file extents on the current disc, sorted by frame address.
+        std::span<const media::fs::FileExtent> GetFileExtents() const;
+        const media::fs::FileExtent *FindFileExtent(uint32 fad) const;
+
         std::span<const Filter, kNumFilters> GetFilters() const;
 
     private:
@@ -14,9 +14,13 @@ namespace ymir::cdblock {
 /// @brief Invoked when the CD Block raises an interrupt.
 using CBTriggerExternalInterrupt0 = util::RequiredCallback<void()>;
 
-/// @brief Invoked when the CD Block reads a CDDA sector.
+/// @brief Invoked when the CD Block reads a CDDA sector, passing little-endian 16-bit stereo samples.
 ///
-/// The callback should return how many thirds of the audio buffer are full.
+/// The callback should return a pacing hint for the drive: 0 if the audio buffer is below its target level, 2 if it is
+/// well above it, or 1 otherwise.
 using CBCDDASector = util::RequiredCallback<uint32(std::span<uint8, 2352> data)>;
 
+/// @brief Invoked when the CD Block starts a new playback request, before any sectors from it are read.
+using CBCDDAPlaybackStart = util::RequiredCallback<void()>;
+
 } // namespace ymir::cdblock
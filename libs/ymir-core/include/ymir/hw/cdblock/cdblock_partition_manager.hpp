@@ -0,0 +1,119 @@
+#pragma once
+
+#include "cdblock_buffer.hpp"
+#include "cdblock_defs.hpp"
+
+#include <ymir/state/state_cdblock.hpp>
+#include <ymir/state/state_dirty_pages.hpp>
+
+#include <ymir/util/dirty_pages.hpp>
+
+#include <ymir/core/types.hpp>
+
+#include <array>
+
+namespace ymir::cdblock {
+
+// The partition manager owns the pool of 200 buffers. Partitions are intrusive doubly-linked lists of buffer
+// indices, so inserting, moving and deleting sectors only relinks buffers without copying any sector data.
+// Unused buffers are kept in a free list. Buffers reserved for sector writes from the host are moved from the free
+// list into a separate reserved list until they are committed to a partition.
+class PartitionManager {
+public:
+    PartitionManager();
+
+    void Reset();
+
+    uint8 GetBufferCount(uint8 partitionIndex) const;
+    uint32 GetFreeBufferCount() const;
+    bool ReserveBuffers(uint16 count);
+    Buffer *GetReservedBuffer(uint16 index);
+    bool UseReservedBuffers(uint8 partitionIndex, uint16 count);
+    void ReleaseReservedBuffers();
+
+    void InsertHead(uint8 partitionIndex, const Buffer &buffer);
+    Buffer *GetTail(uint8 partitionIndex, uint8 offset);
+    bool RemoveTail(uint8 partitionIndex, uint8 offset);
+
+    // Counts the sectors in the given range of the partition, as used by MoveSectors and CopySectors.
+    // A sector position of 0xFFFF selects the last sector and a sector count of 0xFFFF selects all sectors through
+    // the end of the partition. Ranges past the end of the partition are clamped.
+    uint32 CountSectors(uint8 partitionIndex, uint16 sectorPos, uint16 sectorCount) const;
+
+    uint32 DeleteSectors(uint8 partitionIndex, uint16 sectorPos, uint16 sectorCount);
+    uint32 MoveSectors(uint8 dstPartitionIndex, uint8 srcPartitionIndex, uint16 sectorPos, uint16 sectorCount);
+    uint32 CopySectors(uint8 dstPartitionIndex, uint8 srcPartitionIndex, uint16 sectorPos, uint16 sectorCount);
+
+    void Clear(uint8 partitionIndex);
+
+    uint32 CalculateSize(uint8 partitionIndex, uint32 start, uint32 end) const;
+
+    // -------------------------------------------------------------------------
+    // Save states
+
+    template <bool incremental>
+    void SaveState(state::CDBlockState &state, state::DirtyPages *dirty) const;
+    [[nodiscard]] bool ValidateState(const state::CDBlockState &state) const;
+    void LoadState(const state::CDBlockState &state);
+
+    // Determines if the contents of the buffer have changed since the last incremental save.
+    // Buffers moved into or out of the free list count as changed since free buffers are saved as zeros.
+    bool IsBufferDirty(uint8 bufferIndex) const {
+        return m_dirty.IsDirty(bufferIndex);
+    }
+
+    void InvalidateIncrementalState() {
+        m_dirty.MarkAll();
+    }
+
+    void ClearDirtyPages() {
+        m_dirty.ClearAll();
+    }
+
+private:
+    static constexpr uint8 kNoBuffer = 0xFF;
+
+    // List indices for the free and reserved buffer lists; partitions use indices 0 to kNumPartitions-1
+    static constexpr uint8 kReservedList = kNumPartitions;
+    static constexpr uint8 kFreeList = kNumPartitions + 1;
+
+    struct List {
+        uint8 first; // Oldest buffer, or kNoBuffer if empty
+        uint8 last;  // Newest buffer, or kNoBuffer if empty
+        uint8 count;
+    };
+
+    std::array<Buffer, kNumBuffers> m_buffers;
+    std::array<uint8, kNumBuffers> m_prev;
+    std::array<uint8, kNumBuffers> m_next;
+
+    // Buffers modified since the last incremental save, one page per buffer.
+    // Mutable since it's cleared while saving the state.
+    mutable util::DirtyPageTracker<kNumBuffers, 1> m_dirty;
+
+    // Partitions followed by the reserved and free lists
+    std::array<List, kNumPartitions + 2> m_lists;
+
+    // Caches the last buffer lookup to speed up sequential accesses to the same list
+    mutable uint8 m_cursorList;
+    mutable uint8 m_cursorOffset;
+    mutable uint8 m_cursorBuffer;
+
+    void InvalidateCursor(uint8 listIndex);
+
+    // Resolves a sector range of the list as described in CountSectors.
+    // Returns the number of sectors in the range and writes the offset of the first sector to start, or returns 0
+    // if the range is empty.
+    uint32 ResolveSectorRange(uint8 listIndex, uint16 sectorPos, uint16 sectorCount, uint8 &start) const;
+
+    // Finds the buffer at the given offset from the start of the list, or kNoBuffer if out of range.
+    uint8 FindBuffer(uint8 listIndex, uint8 offset) const;
+
+    void Append(uint8 listIndex, uint8 bufferIndex);
+    void Unlink(uint8 listIndex, uint8 bufferIndex);
+
+    // Moves count buffers starting from bufferIndex from one list to the end of another.
+    void Splice(uint8 dstListIndex, uint8 srcListIndex, uint8 bufferIndex, uint8 count);
+};
+
+} // namespace ymir::cdblock
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <ymir/core/types.hpp>
+
+#include <ymir/media/disc.hpp>
+#include <ymir/media/subheader.hpp>
+
+#include <ymir/util/event.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <thread>
+
+namespace ymir::cdblock {
+
+// Reads sectors ahead of the emulated drive head on a worker thread.
+//
+// The CD block announces the sequential range it is about to play with Start(). The worker thread then reads and
+// decodes sectors from that range into a bounded single-producer/single-consumer ring, staying up to kRingSize sectors
+// ahead of the consumer. ReadSector() consumes sectors from the ring without blocking; on a miss (the sector is not in
+// the ring yet, or playback moved elsewhere), it falls back to a synchronous read.
+//
+// Disc image readers are not thread-safe, so all disc accesses made by the worker and by synchronous reads are
+// serialized through an internal mutex. Any modification to the disc must be done while holding the lock returned by
+// LockDisc().
+class SectorPrefetcher {
+public:
+    // Number of sectors buffered ahead of the drive head
+    static constexpr uint32 kRingSize = 64;
+
+    explicit SectorPrefetcher(const media::Disc &disc);
+    ~SectorPrefetcher();
+
+    SectorPrefetcher(const SectorPrefetcher &) = delete;
+    SectorPrefetcher &operator=(const SectorPrefetcher &) = delete;
+
+    // Starts or stops the worker thread.
+    // When disabled, all reads are performed synchronously.
+    void SetEnabled(bool enabled);
+
+    [[nodiscard]] bool IsEnabled() const noexcept {
+        return m_enabled;
+    }
+
+    // Begins prefetching sectors from startFrameAddress to endFrameAddress (inclusive).
+    // Discards any previously prefetched sectors.
+    void Start(uint32 startFrameAddress, uint32 endFrameAddress);
+
+    // Stops prefetching and discards all prefetched sectors.
+    void Stop();
+
+    // Cancels prefetching and acquires exclusive access to the disc.
+    // Hold the returned lock while modifying the disc.
+    [[nodiscard]] std::unique_lock<std::mutex> LockDisc();
+
+    // Reads a raw sector and its subheader from the given track, using the prefetched data if available.
+    // Returns true if the sector was read successfully.
+    bool ReadSector(const media::Track &track, uint32 frameAddress, std::span<uint8, 2352> outBuf,
+                    media::Subheader &outSubheader);
+
+    // Number of reads served from the prefetch ring.
+    [[nodiscard]] uint64 GetHitCount() const noexcept {
+        return m_hits;
+    }
+
+    // Number of reads that fell back to synchronous reads.
+    [[nodiscard]] uint64 GetMissCount() const noexcept {
+        return m_misses;
+    }
+
+private:
+    struct Entry {
+        uint32 generation;
+        uint32 frameAddress;
+        bool valid;
+        media::Subheader subheader;
+        alignas(16) std::array<uint8, 2352> data;
+    };
+
+    const media::Disc &m_disc;
+    std::mutex m_discMutex;
+
+    bool m_enabled = false;
+    std::thread m_thread;
+    std::atomic_bool m_running = false;
+
+    // Ring buffer of prefetched sectors.
+    // The worker thread writes to m_ringTail, the emulator thread reads from m_ringHead.
+    std::array<Entry, kRingSize> m_ring;
+    std::atomic<uint32> m_ringHead = 0;
+    std::atomic<uint32> m_ringTail = 0;
+
+    // Current prefetch request.
+    // The generation is incremented on every new request; the worker abandons its current range and the consumer
+    // discards stale entries whenever it changes.
+    std::mutex m_requestMutex;
+    std::atomic<uint32> m_generation = 0;
+    uint32 m_requestStart = 0;
+    uint32 m_requestEnd = 0;
+    bool m_requestActive = false;
+
+    util::Event m_requestEvent{false}; // Signaled when a new request is made or the worker is shut down
+    util::Event m_ringNotFullEvent{true};
+
+    uint64 m_hits = 0;
+    uint64 m_misses = 0;
+
+    void WorkerThread();
+
+    static bool ReadSectorDirect(const media::Track &track, uint32 frameAddress, std::span<uint8, 2352> outBuf,
+                                 media::Subheader &outSubheader);
+};
+
+} // namespace ymir::cdblock
@@ -3,6 +3,7 @@
 #include "scsp_defs.hpp"
 #include "scsp_dsp.hpp"
 #include "scsp_midi_defs.hpp"
+#include "scsp_resampler.hpp"
 #include "scsp_slot.hpp"
 #include "scsp_timer.hpp"
 
@@ -14,6 +15,7 @@
 #include <ymir/sys/bus.hpp>
 #include <ymir/sys/clocks.hpp>
 
+#include <ymir/state/state_dirty_pages.hpp>
 #include <ymir/state/state_scsp.hpp>
 
 #include <ymir/hw/hw_defs.hpp>
@@ -28,6 +30,7 @@
 
 #include <ymir/util/data_ops.hpp>
 #include <ymir/util/dev_log.hpp>
+#include <ymir/util/dirty_pages.hpp>
 #include <ymir/util/inline.hpp>
 
 #include <array>
@@ -119,8 +122,60 @@ public:
         m_cbSendMidiOutputMessage = callback;
     }
 
-    void SetSampleCallback(CBOutputSample callback) {
-        m_cbOutputSample = callback;
+    // Sets the per-sample output callback and disables batched sample output.
+    void SetSampleCallback(CBOutputSample callback);
+
+    // Sets the batched sample output callback and disables per-sample output.
+    // Samples are accumulated into an internal buffer of `batchSize` frames and delivered in bulk once it fills up.
+    // The batch size is clamped between 1 and kMaxOutputBatchSize.
+    void SetSampleBatchCallback(CBOutputSampleBatch callback, uint32 batchSize);
+
+    // Changes the number of frames accumulated before invoking the batched sample output callback.
+    // The batch size is clamped between 1 and kMaxOutputBatchSize.
+    // Pending samples are delivered immediately if they already fill the new batch size.
+    void SetSampleBatchSize(uint32 batchSize);
+
+    [[nodiscard]] uint32 GetSampleBatchSize() const noexcept {
+        return m_outputBatchSize;
+    }
+
+    // Delivers all pending samples to the batched sample output callback.
+    void FlushSampleBatch();
+
+    // Drops all pending samples without delivering them.
+    // Loading a state does not affect pending samples; use this to drop samples produced by frames that are about to be
+    // undone, such as run-ahead frames.
+    void DiscardSampleBatch() {
+        m_outputBatchCount = 0;
+    }
+
+    // Returns the sample rate of the audio delivered to the output callbacks.
+    // This is the native SCSP rate (kAudioFreq) unless a different output rate is configured, in which case the output
+    // is converted by the core resampler.
+    [[nodiscard]] uint32 GetOutputSampleRate() const noexcept {
+        return m_resamplerEnabled ? m_resampler.GetOutputRate() : kAudioFreq;
+    }
+
+    // Fine-tunes the resampler conversion ratio for dynamic rate control.
+    // The factor scales the effective output rate and is clamped to 1 +- Resampler::kMaxRateAdjustment.
+    // Has no effect when the output is not being resampled.
+    // Must be called from the emulator thread, e.g. from the sample output callbacks.
+    void SetOutputRateAdjustment(double factor) {
+        m_resampler.SetRateAdjustment(factor);
+    }
+
+    [[nodiscard]] double GetOutputRateAdjustment() const noexcept {
+        return m_resampler.GetRateAdjustment();
+    }
+
+    // Saves or restores the phase and sample history of the output resampler, which are not part of save states.
+    // Restoring the stream state after undoing frames keeps their samples from bleeding into the audible output.
+    void SaveOutputStreamState(Resampler::StreamState &state) const {
+        m_resampler.SaveStreamState(state);
+    }
+
+    void LoadOutputStreamState(const Resampler::StreamState &state) {
+        m_resampler.LoadStreamState(state);
     }
 
     void MapCallbacks(CBTriggerSoundRequestInterrupt callback) {
@@ -149,9 +204,17 @@ public:
         return m_debugTracing;
     }
 
-    // Feeds CDDA data into the buffer and returns how many thirds of the buffer are used
+    // Feeds a sector of little-endian CDDA samples into the buffer and returns a pacing hint for the CD drive based on
+    // the buffer latency target:
+    //   0 = below target, deliver sectors faster
+    //   1 = on target
+    //   2 = above target, deliver sectors slower
     uint32 ReceiveCDDA(std::span<uint8, 2352> data);
 
+    // Clears the underrun tracking when the CD drive starts a new playback request. The buffer running dry between
+    // separate playbacks is not an underrun.
+    void BeginCDDAPlayback();
+
     // push scheduled message onto MIDI input queue
     void ReceiveMidiInput(MidiMessage &msg);
 
@@ -173,9 +236,21 @@ public:
     // Save states
 
     void SaveState(state::SCSPState &state) const;
+    void SaveStateIncremental(state::SCSPState &state, state::DirtyPages &dirty);
     [[nodiscard]] bool ValidateState(const state::SCSPState &state) const;
     void LoadState(const state::SCSPState &state);
 
+    // Marks all WRAM pages as modified so that the next incremental save copies them.
+    void InvalidateIncrementalState() {
+        m_WRAMDirty.MarkAll();
+    }
+
+    // Marks all WRAM pages as unmodified.
+    // Only valid when the state object used for incremental saves matches the current WRAM contents.
+    void ClearDirtyPages() {
+        m_WRAMDirty.ClearAll();
+    }
+
 private:
     struct QueuedMidiMessage {
         uint64 scheduleTime;
@@ -188,12 +263,30 @@ private:
 
     alignas(16) std::array<uint8, m68k::kM68KWRAMSize> m_WRAM;
 
-    alignas(16) std::array<uint8, 2352 * 15> m_cddaBuffer;
+    // Pages of WRAM modified since the last incremental save.
+    // Mutable since it's cleared while saving the state.
+    mutable util::DirtyPageTracker<m68k::kM68KWRAMSize> m_WRAMDirty;
+
+    template <bool incremental>
+    void SaveStateImpl(state::SCSPState &state, state::DirtyPages *dirty) const;
+
+    static constexpr uint32 kCDDABufferSectors = 15;
+    alignas(16) std::array<uint8, 2352 * kCDDABufferSectors> m_cddaBuffer;
     uint32 m_cddaReadPos;
     uint32 m_cddaWritePos;
     // set to true when there's enough audio data to be read by the SCSP
     // set to false when the CDDA buffer is empty
     bool m_cddaReady;
+    // set to true when the CDDA buffer runs dry during playback
+    // set to false when the next sector arrives, counting an underrun
+    bool m_cddaStarved;
+    uint64 m_cddaUnderruns;
+    uint8 m_cddaLatency = 4; // in sectors
+
+    // Returns the amount of CDDA data in the buffer in bytes.
+    uint32 GetCDDABufferLength() const {
+        return (m_cddaWritePos + m_cddaBuffer.size() - m_cddaReadPos) % m_cddaBuffer.size();
+    }
 
     m68k::MC68EC000 m_m68k;
     uint64 m_m68kSpilloverCycles;
@@ -247,9 +340,33 @@ private:
     bool m_debugTracing = false;
 
     CBOutputSample m_cbOutputSample;
+    CBOutputSampleBatch m_cbOutputSampleBatch;
     CBTriggerSoundRequestInterrupt m_cbTriggerSoundRequestInterrupt;
     CBSendMidiOutputMessage m_cbSendMidiOutputMessage;
 
+    // Batched sample output.
+    // When enabled, samples are accumulated into m_outputBatch and delivered through m_cbOutputSampleBatch once
+    // m_outputBatchSize frames have been collected, instead of being sent one by one through m_cbOutputSample.
+    alignas(16) std::array<OutputFrame, kMaxOutputBatchSize> m_outputBatch;
+    uint32 m_outputBatchSize = 1;
+    uint32 m_outputBatchCount = 0;
+    bool m_outputBatchEnabled = false;
+
+    // Output sample rate conversion.
+    // Enabled when the configured output sample rate differs from the native rate.
+    Resampler m_resampler;
+    bool m_resamplerEnabled = false;
+    uint32 m_outputSampleRateRequested = kAudioFreq; // Configured output sample rate, applied at the next sample
+
+    // Reconfigures the resampler to match the requested output sample rate.
+    void UpdateOutputSampleRate();
+
+    // Sends a sample to the resampler, if enabled, or directly to EmitSample.
+    void OutputSample(sint16 left, sint16 right);
+
+    // Sends a sample to the output callback or appends it to the output batch.
+    void EmitSample(sint16 left, sint16 right);
+
     std::queue<QueuedMidiMessage> m_midiInputQueue;
     uint64 m_nextMidiTime;
 
@@ -283,6 +400,7 @@ private:
         static_assert(!std::is_same_v<T, uint32>, "Invalid SCSP WRAM write size");
         // TODO: handle memory size bit
         util::WriteBE<T>(&m_WRAM[address & 0x7FFFF], value);
+        m_WRAMDirty.Mark(address & 0x7FFFF);
     }
 
     template <mem_primitive T>
@@ -559,7 +677,7 @@ private:
             const uint32 index = (address >> 3u) & 0x7F;
             const uint32 subindex = ((address >> 1u) & 0x3) ^ 3;
             write16(m_dsp.program[index].u16[subindex], value16);
-            m_dsp.UpdateProgramLength(index);
+            m_dsp.UpdateProgram(index);
             return;
         } else if (AddressInRange<0xC00, 0xDFF>(address)) {
             // DSP TEMP
@@ -1144,12 +1262,32 @@ private:
     template <bool debug>
     void ProcessSlots(uint32 i);
 
+    // Writes the slot output to the DSP MIXS.
+    void WriteMIXS(const Slot &slot);
+
+    // Sends the slot output and the corresponding EFREG/EXTS effect output to the final output, and finishes the
+    // sample cycle after slot 31.
+    template <bool debug>
+    void ProcessSlotOutput(const Slot &slot);
+
     // Advances the sample counter by one.
     void IncrementSampleCounter();
 
     // Accumulates audio data into the final output using the given send level and panning parameters.
     void AddOutput(sint32 output, uint8 sendLevel, uint8 pan);
 
+    // Sends audio data to the final output using the given send level and panning parameters.
+    // With vectorized mixing enabled, the data is recorded into the mixer input buffers at the given index (0 to 31 for
+    // direct sends, 32 to 63 for effect sends) and accumulated at the end of the sample cycle; otherwise, it is
+    // accumulated immediately with AddOutput.
+    void SendOutput(uint32 index, sint32 output, uint8 sendLevel, uint8 pan);
+
+    // Mixes the first `count` direct sends and effect sends recorded in the mixer input buffers into `out`.
+    void MixRecordedOutputs(std::array<sint32, 2> &out, uint32 count) const;
+
+    // Mixes all 64 entries of the mixer input buffers into m_out using vector instructions.
+    void MixRecordedOutputs();
+
     // The SCSP performs 7 operations in parallel on 7 different slots from i to i-6:
     //   op1 (slot i-0): Phase generation and pitch LFO calculation
     //   op2 (slot i-1): X/Y modulation data read and address pointer calculation
@@ -1206,6 +1344,23 @@ private:
 
     std::array<sint32, 2> m_out;
 
+    // Vectorized mixer input buffers, in structure-of-arrays layout.
+    // Entries 0 to 31 contain direct sends from each slot, entries 32 to 49 contain effect sends from EFREG0-15 and
+    // EXTS0-1. The remaining entries are always zero.
+    // The factors are the combined send level and pan attenuation expressed as powers of two (or zero if muted), and
+    // the masks enable the extra 1.5 dB (-25%) attenuation applied by odd pan values.
+    alignas(32) std::array<sint32, 64> m_mixOutput;
+    alignas(32) std::array<sint32, 64> m_mixFactorL;
+    alignas(32) std::array<sint32, 64> m_mixFactorR;
+    alignas(32) std::array<sint32, 64> m_mixMaskL;
+    alignas(32) std::array<sint32, 64> m_mixMaskR;
+
+    bool m_vectorizedMixing = false;          // Whether vectorized mixing is in use for the current sample cycle
+    bool m_vectorizedMixingRequested = false; // Vectorized mixing configuration, applied at the next sample boundary
+
+    // Clears all entries in the vectorized mixer input buffers.
+    void ClearMixerInputs();
+
     // -------------------------------------------------------------------------
     // Interrupt handling
 
@@ -1216,6 +1371,8 @@ public:
     // Callbacks
 
     const cdblock::CBCDDASector CbCDDASector = util::MakeClassMemberRequiredCallback<&SCSP::ReceiveCDDA>(this);
+    const cdblock::CBCDDAPlaybackStart CbCDDAPlaybackStart =
+        util::MakeClassMemberRequiredCallback<&SCSP::BeginCDDAPlayback>(this);
 
     const sys::CBClockSpeedChange CbClockSpeedChange =
         util::MakeClassMemberRequiredCallback<&SCSP::UpdateClockRatios>(this);
@@ -1258,6 +1415,16 @@ public:
             return m_scsp.m_m68kInterruptLevels;
         }
 
+        // Returns the number of complete CDDA sectors currently buffered.
+        uint32 GetCDDABufferedSectors() const {
+            return m_scsp.GetCDDABufferLength() / 2352;
+        }
+
+        // Returns the number of times the CDDA buffer ran dry since the CD drive last started playback.
+        uint64 GetCDDAUnderruns() const {
+            return m_scsp.m_cddaUnderruns;
+        }
+
     private:
         SCSP &m_scsp;
     };
@@ -4,11 +4,22 @@
 
 #include <ymir/util/callback.hpp>
 
+#include <span>
+
 namespace ymir::scsp {
 
+// A single stereo output frame
+struct OutputFrame {
+    sint16 left;
+    sint16 right;
+};
+
 // Sample output callback, invoked every sample
 using CBOutputSample = util::OptionalCallback<void(sint16 left, sint16 right)>;
 
+// Batched sample output callback, invoked whenever the output batch is full or explicitly flushed
+using CBOutputSampleBatch = util::OptionalCallback<void(std::span<const OutputFrame> frames)>;
+
 // MIDI message output callback, invoked when a complete midi message is ready to send
 using CBSendMidiOutputMessage = util::OptionalCallback<void(std::span<uint8> msg)>;
 
@@ -28,6 +28,9 @@ inline constexpr uint64 kM68KCyclesPerSample = kCyclesPerSample / kCyclesPerM68K
 // SCSP clock frequency: 22,579,200 Hz = 44,100 Hz * 512 cycles per sample
 inline constexpr uint64 kClockFreq = kAudioFreq * kCyclesPerSample;
 
+// Maximum number of stereo frames accumulated by the SCSP before invoking the batched sample output callback
+inline constexpr uint32 kMaxOutputBatchSize = 512;
+
 // Pending interrupt flags
 inline constexpr uint16 kIntrINT0N = 0;          // External INT0N line
 inline constexpr uint16 kIntrINT1N = 1;          // External INT1N line
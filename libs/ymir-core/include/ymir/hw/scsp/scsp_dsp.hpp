@@ -4,10 +4,13 @@
 
 #include "scsp_dsp_instr.hpp"
 
+#include <ymir/hw/m68k/m68k_defs.hpp>
+
 #include <ymir/core/types.hpp>
 
 #include <ymir/util/bit_ops.hpp>
 #include <ymir/util/data_ops.hpp>
+#include <ymir/util/dirty_pages.hpp>
 #include <ymir/util/inline.hpp>
 
 #include <algorithm>
@@ -49,30 +52,32 @@ FORCE_INLINE static uint32 IntToFloat(const uint32 value) {
 
 class DSP {
 public:
-    explicit DSP(uint8 *ram);
+    DSP(uint8 *ram, util::DirtyPageTracker<m68k::kM68KWRAMSize> &ramDirty);
 
     void Reset();
 
     FORCE_INLINE void Step() {
         if (PC < m_programLength) {
-            const DSPInstr instr = program[PC];
+            const DSPDecodedInstr &instr = m_decodedProgram[PC];
 
-            if (instr.IRA <= 0x1F) {
+            switch (instr.input) {
+            case DSPDecodedInstr::Input::None: break;
+            case DSPDecodedInstr::Input::MEMS:
                 // MEMS area: 24 -> 24 bits
-                INPUTS = soundMem[instr.IRA];
-            } else if (instr.IRA <= 0x2F) {
+                INPUTS = soundMem[instr.inputIndex];
+                break;
+            case DSPDecodedInstr::Input::MIXS:
                 // MIXS area: 20 -> 24 bits
-                INPUTS = mixStack[GetMIXSIndex(instr.IRA & 0xF) ^ 0x10] << 4;
-            } else if (instr.IRA <= 0x31) {
+                INPUTS = mixStack[GetMIXSIndex(instr.inputIndex) ^ 0x10] << 4;
+                break;
+            case DSPDecodedInstr::Input::EXTS:
                 // EXTS area: 16 -> 24 bits
-                INPUTS = audioInOut[instr.IRA & 0x1] << 8;
+                INPUTS = audioInOut[instr.inputIndex] << 8;
+                break;
             }
 
-            const uint8 tempReadAddr = (instr.TRA + MDEC_CT) & 0x7F;
-            const uint8 tempWriteAddr = (instr.TWA + MDEC_CT) & 0x7F;
-
             const sint32 inputs = INPUTS;
-            const sint32 temp = tempMem[tempReadAddr];
+            const sint32 temp = tempMem[(instr.TRA + MDEC_CT) & 0x7F];
 
             const sint32 xval = instr.XSEL ? inputs : temp;
             uint16 yval;
@@ -80,22 +85,22 @@ public:
             case 0: yval = FRC_REG; break;
             case 1: yval = coeffs[instr.CRA]; break;
             case 2: yval = static_cast<uint16>(bit::extract<11, 23>(Y_REG)); break;
-            case 3: yval = static_cast<uint16>(bit::extract<4, 15>(Y_REG)); break;
+            default: yval = static_cast<uint16>(bit::extract<4, 15>(Y_REG)); break;
             }
 
             if (instr.YRL) {
                 Y_REG = bit::extract<0, 23>(inputs);
             }
 
-            sint32 shifterOut = static_cast<uint32>(bit::sign_extend<26>(SFT_REG)) << (instr.SHFT0 ^ instr.SHFT1);
-            if (instr.SHFT1 == 0) {
+            sint32 shifterOut = static_cast<uint32>(bit::sign_extend<26>(SFT_REG)) << instr.shiftAmount;
+            if (instr.saturate) {
                 shifterOut = std::clamp(shifterOut, -0x800000, 0x7FFFFF);
             } else {
                 shifterOut = bit::sign_extend<24>(shifterOut);
             }
 
             if (instr.FRCL) {
-                if (instr.SHFT == 3) {
+                if (instr.shiftedLatch) {
                     FRC_REG = bit::extract<0, 11>(shifterOut);
                 } else {
                     FRC_REG = bit::extract<11, 23>(shifterOut);
@@ -103,17 +108,12 @@ public:
             }
 
             uint32 sgaOutput;
-            if (instr.ZERO) {
-                sgaOutput = 0;
-            } else {
-                if (instr.BSEL) {
-                    sgaOutput = SFT_REG;
-                } else {
-                    sgaOutput = temp;
-                }
-                if (instr.NEGB) {
-                    sgaOutput = -(sint32)sgaOutput;
-                }
+            switch (instr.adderInput) {
+            case DSPDecodedInstr::AdderInput::Zero: sgaOutput = 0; break;
+            case DSPDecodedInstr::AdderInput::TEMP: sgaOutput = temp; break;
+            case DSPDecodedInstr::AdderInput::NegTEMP: sgaOutput = -temp; break;
+            case DSPDecodedInstr::AdderInput::SFT: sgaOutput = SFT_REG; break;
+            default: sgaOutput = -static_cast<sint32>(SFT_REG); break;
             }
             const uint32 product = (bit::sign_extend<13, sint64>(yval) * xval) >> 12;
             SFT_REG = (product + sgaOutput) & 0x3FFFFFF;
@@ -122,7 +122,7 @@ public:
                 effectOut[instr.EWA] = shifterOut >> 8;
             }
             if (instr.TWT) {
-                tempMem[tempWriteAddr] = shifterOut;
+                tempMem[(instr.TWA + MDEC_CT) & 0x7F] = shifterOut;
             }
             if (instr.IWT) {
                 soundMem[instr.IWA] = bit::sign_extend<24>(m_readValue);
@@ -130,7 +130,7 @@ public:
 
             if (m_readPending) {
                 uint16 tmp = ReadWRAM();
-                m_readValue = (m_readPending && m_readNOFL) ? (tmp << 8) : FloatToInt(tmp);
+                m_readValue = m_readNOFL ? (tmp << 8) : FloatToInt(tmp);
                 m_readPending = false;
                 m_readNOFL = false;
             } else if (m_writePending) {
@@ -160,7 +160,7 @@ public:
             }
 
             if (instr.ADRL) {
-                if (instr.SHFT == 3) {
+                if (instr.shiftedLatch) {
                     ADRS_REG = (shifterOut >> 12) & 0xFFF;
                 } else {
                     ADRS_REG = (inputs >> 16) & 0xFFF;
@@ -183,7 +183,9 @@ public:
         }
     }
 
-    void UpdateProgramLength(uint8 writeIndex);
+    // Must be invoked after writing to the program RAM.
+    // Updates the pre-decoded instruction and the effective program length.
+    void UpdateProgram(uint8 writeIndex);
 
     void DumpRegs(std::ostream &out) const;
 
@@ -252,6 +254,12 @@ private:
 
     uint8 m_programLength;
 
+    // Pre-decoded copy of the program RAM executed by Step()
+    alignas(16) std::array<DSPDecodedInstr, 128> m_decodedProgram;
+
+    void DecodeProgram();
+    void UpdateProgramLength(uint8 writeIndex);
+
     sint32 INPUTS; // (24-bit) INPUTS - input data
 
     uint32 SFT_REG;  // (26-bit)
@@ -281,6 +289,7 @@ private:
     uint32 m_readWriteAddr;
 
     uint8 *m_WRAM;
+    util::DirtyPageTracker<m68k::kM68KWRAMSize> &m_WRAMDirty;
 
     [[nodiscard]] FORCE_INLINE uint16 ReadWRAM() const {
         const uint32 address = m_readWriteAddr * sizeof(uint16);
@@ -295,6 +304,7 @@ private:
         const uint32 address = m_readWriteAddr * sizeof(uint16);
         if (address < 0x80000) {
             util::WriteBE<uint16>(&m_WRAM[address], m_writeValue);
+            m_WRAMDirty.Mark(address);
         }
     }
 };
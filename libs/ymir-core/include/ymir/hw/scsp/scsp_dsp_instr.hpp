@@ -46,4 +46,87 @@ union DSPInstr {
 };
 static_assert(sizeof(DSPInstr) == sizeof(uint64));
 
+// A DSP instruction unpacked into a form that is cheaper to execute.
+// Bit fields are expanded into whole bytes and multi-field decisions (input source, adder input, shifter mode) are
+// resolved ahead of time so that DSP::Step only performs the work the instruction actually requests.
+struct DSPDecodedInstr {
+    enum class Input : uint8 { None, MEMS, MIXS, EXTS };
+    enum class AdderInput : uint8 { Zero, TEMP, NegTEMP, SFT, NegSFT };
+
+    Input input;           // Source of INPUTS
+    uint8 inputIndex;      // MEMS address, MIXS offset or EXTS index
+    AdderInput adderInput; // Shifter/adder input (ZERO, BSEL, NEGB)
+    uint8 YSEL;            // Multiplier Y input select
+    uint8 CRA;             // COEF read address
+    uint8 TRA;             // TEMP read address
+    uint8 TWA;             // TEMP write address
+    uint8 IWA;             // MEMS write address
+    uint8 EWA;             // EFREG write address
+    uint8 MASA;            // MADRS read address
+    uint8 NXADR;           // Address increment (0 or 1)
+    uint8 shiftAmount;     // SHFT0 ^ SHFT1
+    bool saturate;         // SHFT1 == 0 - saturate shifter output instead of wrapping
+    bool shiftedLatch;     // SHFT == 3 - FRCL and ADRL latch from the shifter output instead of INPUTS/shifter high bits
+    bool XSEL;             // 1=INPUTS, 0=TEMP
+    bool YRL;              // Latch INPUTS into Y_REG
+    bool FRCL;             // Latch FRC_REG
+    bool ADRL;             // Latch ADRS_REG
+    bool ADREB;            // Add ADRS_REG to the address
+    bool TABLE;            // Do not apply ring buffer offset and mask
+    bool EWT;              // Write EFREG
+    bool TWT;              // Write TEMP
+    bool IWT;              // Write MEMS
+    bool MRD;              // Read wave memory
+    bool MWT;              // Write wave memory
+    bool NOFL;             // Skip float conversion on wave memory access
+
+    [[nodiscard]] static constexpr DSPDecodedInstr Decode(DSPInstr instr) {
+        DSPDecodedInstr decoded{};
+        if (instr.IRA <= 0x1F) {
+            decoded.input = Input::MEMS;
+            decoded.inputIndex = instr.IRA;
+        } else if (instr.IRA <= 0x2F) {
+            decoded.input = Input::MIXS;
+            decoded.inputIndex = instr.IRA & 0xF;
+        } else if (instr.IRA <= 0x31) {
+            decoded.input = Input::EXTS;
+            decoded.inputIndex = instr.IRA & 0x1;
+        } else {
+            decoded.input = Input::None;
+            decoded.inputIndex = 0;
+        }
+        if (instr.ZERO) {
+            decoded.adderInput = AdderInput::Zero;
+        } else if (instr.BSEL) {
+            decoded.adderInput = instr.NEGB ? AdderInput::NegSFT : AdderInput::SFT;
+        } else {
+            decoded.adderInput = instr.NEGB ? AdderInput::NegTEMP : AdderInput::TEMP;
+        }
+        decoded.YSEL = instr.YSEL;
+        decoded.CRA = instr.CRA;
+        decoded.TRA = instr.TRA;
+        decoded.TWA = instr.TWA;
+        decoded.IWA = instr.IWA;
+        decoded.EWA = instr.EWA;
+        decoded.MASA = instr.MASA;
+        decoded.NXADR = instr.NXADR;
+        decoded.shiftAmount = instr.SHFT0 ^ instr.SHFT1;
+        decoded.saturate = instr.SHFT1 == 0;
+        decoded.shiftedLatch = instr.SHFT == 3;
+        decoded.XSEL = instr.XSEL;
+        decoded.YRL = instr.YRL;
+        decoded.FRCL = instr.FRCL;
+        decoded.ADRL = instr.ADRL;
+        decoded.ADREB = instr.ADREB;
+        decoded.TABLE = instr.TABLE;
+        decoded.EWT = instr.EWT;
+        decoded.TWT = instr.TWT;
+        decoded.IWT = instr.IWT;
+        decoded.MRD = instr.MRD;
+        decoded.MWT = instr.MWT;
+        decoded.NOFL = instr.NOFL;
+        return decoded;
+    }
+};
+
 } // namespace ymir::scsp
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <ymir/core/types.hpp>
+
+#include <ymir/util/inline.hpp>
+
+#include <array>
+
+namespace ymir::scsp {
+
+// Converts the SCSP output into an arbitrary sample rate using a polyphase windowed-sinc filter.
+//
+// The filter uses kTaps taps per phase and kPhases phases. Fractional positions between phases are handled by linearly
+// interpolating the outputs of the two nearest phases. The latency is fixed at kTaps / 2 input samples.
+//
+// The conversion ratio can be fine-tuned at runtime with SetRateAdjustment in order to implement dynamic rate control,
+// which allows frontends to keep their audio buffers at a stable level while synchronizing to video.
+class Resampler {
+public:
+    static constexpr uint32 kTaps = 32;
+    static constexpr uint32 kPhases = 256;
+
+    static constexpr uint32 kMinSampleRate = 8000;
+    static constexpr uint32 kMaxSampleRate = 192000;
+
+    // Maximum deviation from the nominal rate allowed by SetRateAdjustment
+    static constexpr double kMaxRateAdjustment = 0.005;
+
+    // Phase and sample history of the conversion, which determine the outputs for upcoming input samples.
+    struct StreamState {
+        uint64 position;
+        alignas(32) std::array<float, kTaps * 2> historyL;
+        alignas(32) std::array<float, kTaps * 2> historyR;
+        uint32 historyPos;
+    };
+
+    Resampler();
+
+    // Clears the sample history and resets the phase.
+    void Reset();
+
+    // Saves or restores the phase and sample history. The configured rates and rate adjustment are left untouched.
+    void SaveStreamState(StreamState &state) const;
+    void LoadStreamState(const StreamState &state);
+
+    // Configures the input and output sample rates and rebuilds the filter.
+    // Rates are clamped between kMinSampleRate and kMaxSampleRate.
+    void Configure(uint32 inputRate, uint32 outputRate);
+
+    [[nodiscard]] uint32 GetInputRate() const noexcept {
+        return m_inputRate;
+    }
+
+    [[nodiscard]] uint32 GetOutputRate() const noexcept {
+        return m_outputRate;
+    }
+
+    // Scales the effective output rate by the given factor, clamped to 1 +- kMaxRateAdjustment.
+    // Values above 1 produce slightly more output samples per input sample; values below 1 produce slightly fewer.
+    void SetRateAdjustment(double factor);
+
+    [[nodiscard]] double GetRateAdjustment() const noexcept {
+        return m_rateAdjustment;
+    }
+
+    // Feeds one stereo input sample and invokes `output(sint16 left, sint16 right)` for every output sample produced.
+    template <typename Fn>
+    FORCE_INLINE void Process(sint16 left, sint16 right, Fn &&output) {
+        m_historyL[m_historyPos] = m_historyL[m_historyPos + kTaps] = left;
+        m_historyR[m_historyPos] = m_historyR[m_historyPos + kTaps] = right;
+        m_historyPos = (m_historyPos + 1) % kTaps;
+
+        while (m_position < kPositionOne) {
+            sint16 outL, outR;
+            Interpolate(static_cast<uint32>(m_position), outL, outR);
+            output(outL, outR);
+            m_position += m_step;
+        }
+        m_position -= kPositionOne;
+    }
+
+private:
+    // Output position is a 32.32 fixed-point value relative to the center of the history window
+    static constexpr uint64 kPositionOne = 1ull << 32ull;
+
+    uint32 m_inputRate;
+    uint32 m_outputRate;
+    double m_rateAdjustment;
+
+    uint64 m_position; // Position of the next output sample
+    uint64 m_step;     // Position increment per output sample
+
+    // Filter coefficients for each phase, plus one extra phase to interpolate past the last phase
+    alignas(32) std::array<float, (kPhases + 1) * kTaps> m_coeffs;
+
+    // Sample history, stored twice in a row so that the most recent kTaps samples are always contiguous
+    alignas(32) std::array<float, kTaps * 2> m_historyL;
+    alignas(32) std::array<float, kTaps * 2> m_historyR;
+    uint32 m_historyPos; // Index of the oldest sample in the history
+
+    void UpdateStep();
+
+    // Computes the output sample at the given fractional position (0.32 fixed-point) between the two center samples.
+    void Interpolate(uint32 fracPos, sint16 &outL, sint16 &outR) const;
+};
+
+} // namespace ymir::scsp
@@ -107,6 +107,9 @@ public:
     [[nodiscard]] cart::BaseCartridge &GetCartridge() {
         return m_cartSlot.GetCartridge();
     }
+    [[nodiscard]] const cart::BaseCartridge &GetCartridge() const {
+        return m_cartSlot.GetCartridge();
+    }
 
     // -------------------------------------------------------------------------
     // DSP
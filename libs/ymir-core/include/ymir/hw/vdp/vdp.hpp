@@ -17,12 +17,14 @@
 #include <ymir/sys/bus.hpp>
 #include <ymir/sys/system.hpp>
 
+#include <ymir/state/state_dirty_pages.hpp>
 #include <ymir/state/state_vdp.hpp>
 
 #include <ymir/hw/hw_defs.hpp>
 
 #include <ymir/util/bit_ops.hpp>
 #include <ymir/util/data_ops.hpp>
+#include <ymir/util/dirty_pages.hpp>
 #include <ymir/util/event.hpp>
 #include <ymir/util/inline.hpp>
 #include <ymir/util/unreachable.hpp>
@@ -30,6 +32,7 @@
 #include <blockingconcurrentqueue.h>
 
 #include <array>
+#include <atomic>
 #include <iosfwd>
 #include <span>
 #include <thread>
@@ -122,9 +125,17 @@ public:
     // Save states
 
     void SaveState(state::VDPState &state) const;
+    void SaveStateIncremental(state::VDPState &state, state::DirtyPages &dirty);
     [[nodiscard]] bool ValidateState(const state::VDPState &state) const;
     void LoadState(const state::VDPState &state);
 
+    // Marks all VDP1 and VDP2 memory pages as modified so that the next incremental save copies them.
+    void InvalidateIncrementalState();
+
+    // Marks all VDP1 and VDP2 memory pages as unmodified.
+    // Only valid when the state object used for incremental saves matches the current memory contents.
+    void ClearDirtyPages();
+
     // -------------------------------------------------------------------------
     // Rendering control
 
@@ -135,9 +146,32 @@ public:
     // Detemrines if a layer is forcibly disabled.
     bool IsLayerEnabled(Layer layer) const;
 
+    // Enables or disables VDP2 rendering.
+    // While disabled, VDP2 scanlines are not drawn and the frame completion callback is not invoked, but everything
+    // that affects emulation (VDP1 drawing, timings, interrupts) still runs. Useful to fast-forward emulation when the
+    // output is not going to be displayed.
+    void SetRenderingEnabled(bool enabled) {
+        m_renderingEnabled = enabled;
+    }
+
+    // Determines if VDP2 rendering is enabled.
+    bool IsRenderingEnabled() const {
+        return m_renderingEnabled;
+    }
+
 private:
     VDPState m_state;
 
+    // Pages of VDP1 and VDP2 memory modified since the last incremental save.
+    // Mutable since they're cleared while saving the state.
+    mutable util::DirtyPageTracker<kVDP1VRAMSize> m_VRAM1Dirty;
+    mutable util::DirtyPageTracker<kVDP2VRAMSize> m_VRAM2Dirty;
+    mutable util::DirtyPageTracker<kVDP2CRAMSize> m_CRAMDirty;
+    mutable std::array<util::DirtyPageTracker<kVDP1FramebufferRAMSize>, 2> m_spriteFBDirty;
+
+    template <bool incremental>
+    void SaveStateImpl(state::VDPState &state, state::DirtyPages *dirty) const;
+
     // Cached CRAM colors converted from RGB555 to RGB888.
     // Only valid when color RAM mode is one of the RGB555 modes.
     alignas(16) std::array<Color888, kVDP2CRAMSize / sizeof(uint16)> m_CRAMCache;
@@ -495,6 +529,9 @@ private:
         }
     };
 
+    // Granularity of CRAM resyncs after loading states
+    static constexpr size_t kCRAMResyncPageSize = 256;
+
     mutable struct VDPRenderContext {
         struct QueueTraits : moodycamel::ConcurrentQueueDefaultTraits {
             static constexpr size_t BLOCK_SIZE = 64;
@@ -520,6 +557,18 @@ private:
         std::array<VDPRenderEvent, 64> pendingEvents;
         size_t pendingEventsCount = 0;
 
+        // Number of events sent to the render thread (written by the emulator thread) and processed by it (written by
+        // the render thread). The render thread is idle when both match and there are no pending events.
+        uint64 enqueuedEventCount = 0;
+        std::atomic<uint64> processedEventCount = 0;
+
+        // Pages of VRAM and CRAM replaced by the emulator thread outside of write events, i.e. when loading a state.
+        // The render thread copies them over on PostLoadStateSync.
+        // All pages start out marked so that the first sync copies everything.
+        util::DirtyPageTracker<kVDP1VRAMSize> VRAM1Resync;
+        util::DirtyPageTracker<kVDP2VRAMSize> VRAM2Resync;
+        util::DirtyPageTracker<kVDP2CRAMSize, kCRAMResyncPageSize> CRAMResync;
+
         bool vdp1Done;
 
         struct VDP1 {
@@ -564,6 +613,23 @@ private:
             vdp1Done = false;
         }
 
+        void MarkAllForResync() {
+            VRAM1Resync.MarkAll();
+            VRAM2Resync.MarkAll();
+            CRAMResync.MarkAll();
+        }
+
+        // Waits until the render thread has processed all events sent so far.
+        // Returns immediately if it is already idle, avoiding a round trip through the render thread.
+        void WaitIdle() {
+            if (pendingEventsCount == 0 && processedEventCount.load(std::memory_order_acquire) == enqueuedEventCount) {
+                return;
+            }
+            EnqueueEvent(VDPRenderEvent::PreSaveStateSync());
+            preSaveSyncSignal.Wait();
+            preSaveSyncSignal.Reset();
+        }
+
         void EnqueueEvent(VDPRenderEvent &&event) {
             switch (event.type) {
             case VDPRenderEvent::Type::VDP1VRAMWriteByte:
@@ -578,6 +644,7 @@ private:
                 pendingEvents[pendingEventsCount++] = event;
                 if (pendingEventsCount == pendingEvents.size()) {
                     eventQueue.enqueue_bulk(pTok, pendingEvents.begin(), pendingEventsCount);
+                    enqueuedEventCount += pendingEventsCount;
                     pendingEventsCount = 0;
                 }
                 break;
@@ -585,9 +652,11 @@ private:
                 // Send any pending writes before rendering
                 if (pendingEventsCount > 0) {
                     eventQueue.enqueue_bulk(pTok, pendingEvents.begin(), pendingEventsCount);
+                    enqueuedEventCount += pendingEventsCount;
                     pendingEventsCount = 0;
                 }
                 eventQueue.enqueue(pTok, event);
+                ++enqueuedEventCount;
                 break;
             }
         }
@@ -1036,6 +1105,10 @@ private:
     // [5] -           NBG3        NBG3
     std::array<bool, 6> m_layerRendered;
 
+    // Whether VDP2 lines are drawn and completed frames are reported.
+    // Externally configured - do not include in save state!
+    bool m_renderingEnabled = true;
+
     // Common layer states.
     // Entry [0] is primary and [1] is alternate field for deinterlacing.
     //     RBG0+RBG1   RBG0        no RBGs
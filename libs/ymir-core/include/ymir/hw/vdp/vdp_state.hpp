@@ -50,11 +50,14 @@ struct VDPState {
     // -------------------------------------------------------------------------
     // Save states
 
-    void SaveState(state::VDPState &state) const {
-        state.VRAM1 = VRAM1;
-        state.VRAM2 = VRAM2;
-        state.CRAM = CRAM;
-        state.spriteFB = spriteFB;
+    // Memory is only copied if includeMemory is true.
+    void SaveState(state::VDPState &state, bool includeMemory = true) const {
+        if (includeMemory) {
+            state.VRAM1 = VRAM1;
+            state.VRAM2 = VRAM2;
+            state.CRAM = CRAM;
+            state.spriteFB = spriteFB;
+        }
         state.displayFB = displayFB;
 
         state.regs1.TVMR = regs1.ReadTVMR();
@@ -254,11 +257,14 @@ struct VDPState {
         return true;
     }
 
-    void LoadState(const state::VDPState &state) {
-        VRAM1 = state.VRAM1;
-        VRAM2 = state.VRAM2;
-        CRAM = state.CRAM;
-        spriteFB = state.spriteFB;
+    // Memory is only copied if includeMemory is true.
+    void LoadState(const state::VDPState &state, bool includeMemory = true) {
+        if (includeMemory) {
+            VRAM1 = state.VRAM1;
+            VRAM2 = state.VRAM2;
+            CRAM = state.CRAM;
+            spriteFB = state.spriteFB;
+        }
         displayFB = state.displayFB;
 
         regs1.WriteTVMR(state.regs1.TVMR);
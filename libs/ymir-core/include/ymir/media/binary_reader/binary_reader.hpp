@@ -7,6 +7,9 @@
 namespace ymir::media {
 
 // Interface that specifies the contract for reading binary files.
+//
+// Implementations must support concurrent reads from multiple threads. Readers are shared between copies of a disc,
+// which may be used by systems running on different threads.
 class IBinaryReader {
 public:
     virtual ~IBinaryReader() = default;
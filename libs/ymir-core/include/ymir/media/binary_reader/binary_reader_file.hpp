@@ -4,11 +4,13 @@
 
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <span>
 
 namespace ymir::media {
 
 // Implementation of IBinaryReader backed by a file.
+// Reads are serialized since they share the file stream's position.
 class FileBinaryReader final : public IBinaryReader {
 public:
     // Initializes a file content pointing to no file.
@@ -35,10 +37,10 @@ public:
     }
 
     FileBinaryReader(const FileBinaryReader &) = delete;
-    FileBinaryReader(FileBinaryReader &&) = default;
+    FileBinaryReader(FileBinaryReader &&) = delete;
 
     FileBinaryReader &operator=(const FileBinaryReader &) = delete;
-    FileBinaryReader &operator=(FileBinaryReader &&) = default;
+    FileBinaryReader &operator=(FileBinaryReader &&) = delete;
 
     uintmax_t Size() const final {
         return m_size;
@@ -52,6 +54,8 @@ public:
         // the file starting from offset
         size = std::min(size, m_size - offset);
         size = std::min(size, output.size());
+        std::unique_lock lock{m_mutex};
+        m_in.clear();
         m_in.seekg(offset, std::ios::beg);
         m_in.read(reinterpret_cast<char *>(output.data()), size);
         return m_in.gcount();
@@ -59,6 +63,7 @@ public:
 
 private:
     mutable std::ifstream m_in;
+    mutable std::mutex m_mutex;
     uintmax_t m_size;
 };
 
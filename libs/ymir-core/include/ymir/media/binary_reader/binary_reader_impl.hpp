@@ -5,4 +5,5 @@
 #include "binary_reader_file.hpp"
 #include "binary_reader_mem.hpp"
 #include "binary_reader_mmap.hpp"
+#include "binary_reader_preload.hpp"
 #include "binary_reader_subview.hpp"
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "binary_reader.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <thread>
+
+namespace ymir::media {
+
+// Implementation of IBinaryReader that progressively loads the contents of another reader into memory.
+//
+// Reads are served by the source reader until the data is available in memory. A background thread copies the source
+// into an in-memory buffer one region at a time, switching each region over to the in-memory copy as soon as it is
+// loaded. Once every region is loaded, the source is no longer used by the foreground.
+//
+// Only one reader preloads at a time across the entire program; background threads of other readers wait for their
+// turn. This avoids thrashing the storage device with concurrent sequential reads when a disc image is split into
+// multiple files.
+class PreloadingBinaryReader final : public IBinaryReader {
+public:
+    // Memory-maps the specified file and starts preloading it into memory.
+    // If any errors occur while opening the file, initializes an empty reader and returns the error in the provided
+    // std::error_code object.
+    PreloadingBinaryReader(std::filesystem::path path, std::error_code &error);
+
+    // Preloads the contents of source into memory, reading from it on demand until the data is loaded.
+    // If backgroundSource is provided, the background thread reads from it instead of source. This can be used to avoid
+    // contention on readers with internal state, such as a separate handle to the same file. backgroundSource must
+    // provide the same contents as source.
+    PreloadingBinaryReader(std::shared_ptr<IBinaryReader> source, std::shared_ptr<IBinaryReader> backgroundSource = {});
+
+    ~PreloadingBinaryReader();
+
+    PreloadingBinaryReader(const PreloadingBinaryReader &) = delete;
+    PreloadingBinaryReader(PreloadingBinaryReader &&) = delete;
+
+    PreloadingBinaryReader &operator=(const PreloadingBinaryReader &) = delete;
+    PreloadingBinaryReader &operator=(PreloadingBinaryReader &&) = delete;
+
+    uintmax_t Size() const final {
+        return m_size;
+    }
+
+    uintmax_t Read(uintmax_t offset, uintmax_t size, std::span<uint8> output) const final;
+
+    // Determines if the entire contents have been loaded into memory.
+    bool IsPreloaded() const {
+        return m_complete.load(std::memory_order_acquire);
+    }
+
+private:
+    // Size of each region loaded by the background thread.
+    static constexpr uintmax_t kRegionSize = 256 * 1024;
+
+    std::shared_ptr<IBinaryReader> m_source;
+    std::shared_ptr<IBinaryReader> m_backgroundSource;
+
+    uintmax_t m_size = 0;
+    std::unique_ptr<uint8[]> m_data;
+    std::unique_ptr<std::atomic<bool>[]> m_regionLoaded;
+    std::atomic<bool> m_complete = false;
+
+    std::thread m_thread;
+    std::atomic<bool> m_stop = false;
+
+    void Start();
+    void PreloadThread();
+};
+
+} // namespace ymir::media
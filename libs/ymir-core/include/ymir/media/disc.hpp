@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <memory>
 #include <span>
@@ -29,7 +30,7 @@ struct Index {
 };
 
 struct Track {
-    std::unique_ptr<IBinaryReader> binaryReader;
+    std::shared_ptr<IBinaryReader> binaryReader; // Shared between clones of the disc
     uint32 index = 0;
     uint32 sectorSize = 0;
     uint32 userDataOffset = 0;
@@ -43,6 +44,12 @@ struct Track {
 
     std::vector<Index> indices;
 
+    // EDC of synthesized sectors, indexed by frame address relative to the start of the track.
+    // Each entry holds the EDC in the lower 32 bits and a valid flag in bit 32, and is filled in on the first read of the
+    // sector. Only present on data tracks with cooked sectors; see BuildSectorCache().
+    // Shared between clones of the disc.
+    std::shared_ptr<std::atomic<uint64>[]> edcCache;
+
     uint8 FindIndex(uint32 frameAddress) const {
         auto it = std::find_if(indices.begin(), indices.end(), [=](const Index &index) {
             return frameAddress >= index.startFrameAddress && frameAddress <= index.endFrameAddress;
@@ -60,6 +67,16 @@ struct Track {
         userDataOffset = size >= 2352 ? (mode2 ? 24 : 16) : size >= 2340 ? (mode2 ? 12 : 4) : 0;
     }
 
+    // Prepares the caches of reconstructed sector data.
+    // Must be called once the sector size, control/ADR and frame range of the track are final.
+    void BuildSectorCache() {
+        edcCache.reset();
+        if (controlADR == 0x01 || sectorSize >= 2336 || endFrameAddress < startFrameAddress) {
+            return;
+        }
+        edcCache = std::make_unique<std::atomic<uint64>[]>(endFrameAddress - startFrameAddress + 1);
+    }
+
     // Reads the user data portion of a sector.
     // Returns true if the sector was read successfully.
     // Returns false if the sector could not be fully read or the frame address is out of range.
@@ -155,7 +172,20 @@ struct Track {
             std::span<uint8> pParityBuf{outBuf.subspan(2076, 172)};
             std::span<uint8> qParityBuf{outBuf.subspan(2248, 104)};
 
-            const uint32 crc = CalcCRC(std::span<uint8, 2064>{outBuf.first(2064)});
+            // The EDC only depends on the sector contents, which never change
+            uint32 crc;
+            const uint32 cacheIndex = frameAddress - startFrameAddress;
+            if (edcCache) {
+                const uint64 cachedCRC = edcCache[cacheIndex].load(std::memory_order_relaxed);
+                if (cachedCRC >> 32ull) {
+                    crc = static_cast<uint32>(cachedCRC);
+                } else {
+                    crc = CalcCRC(std::span<uint8, 2064>{outBuf.first(2064)});
+                    edcCache[cacheIndex].store((1ull << 32ull) | crc, std::memory_order_relaxed);
+                }
+            } else {
+                crc = CalcCRC(std::span<uint8, 2064>{outBuf.first(2064)});
+            }
             util::WriteLE<uint32>(&edcBuf[0], crc);
 
             std::fill(interBuf.begin(), interBuf.end(), 0x00);
@@ -230,6 +260,13 @@ struct Session {
         toc.fill(0xFFFFFFFF);
     }
 
+    // Prepares the caches of reconstructed sector data of all tracks in this session.
+    void BuildSectorCaches() {
+        for (uint32 i = 0; i < numTracks; i++) {
+            tracks[firstTrackIndex + i].BuildSectorCache();
+        }
+    }
+
     const Track *FindTrack(uint32 absFrameAddress) const {
         const uint8 trackIndex = FindTrackIndex(absFrameAddress);
         if (trackIndex != 0xFF) {
@@ -319,6 +356,15 @@ struct Disc {
     Disc &operator=(const Disc &) = delete;
     Disc &operator=(Disc &&) = default;
 
+    // Creates a copy of this disc that shares the binary readers and sector caches of all tracks with this instance.
+    // Binary readers must be safe to use from multiple threads if the copies are used concurrently.
+    Disc Clone() const {
+        Disc disc{};
+        disc.sessions = sessions;
+        disc.header = header.Clone();
+        return disc;
+    }
+
     void Swap(Disc &&disc) {
         sessions.swap(disc.sessions);
         header.Swap(std::move(disc.header));
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <ymir/core/hash.hpp>
+#include <ymir/core/types.hpp>
+
+#include "saturn_header.hpp"
+
+#include <array>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace ymir::media {
+
+// Disc image file formats supported by the loaders.
+enum class DiscFormat : uint8 { Unknown, CHD, BinCue, MdfMds, ImgCcdSub, ISO, YCD };
+
+std::string_view ToString(DiscFormat format);
+
+// Basic identification of a disc image.
+struct DiscProbeResult {
+    DiscFormat format = DiscFormat::Unknown;
+
+    // Raw contents of the Saturn disc header, located in the first 256 bytes of the user data of the first sector
+    std::array<uint8, 256> rawHeader{};
+
+    // Parsed Saturn disc header. Invalid if the image is not a Saturn disc.
+    SaturnHeader header;
+
+    // Disc hash, matching the value computed by fs::Filesystem::GetHash() and Saturn::GetDiscHash() once the disc is
+    // loaded. Only valid if hasHash is true.
+    XXH128Hash hash{};
+    bool hasHash = false;
+};
+
+// Identifies the disc image at the specified path without preparing it for emulation.
+//
+// The loader is chosen based on the file extension, falling back to trying every loader in the same order as LoadDisc.
+// Only the track layout, the header sector and the sectors covered by the disc hash are read from the image. CHD images
+// are opened with a minimal hunk cache and no decompression threads.
+//
+// Returns true if the image could be loaded, in which case result.format is set and the header and hash are filled in
+// if available.
+bool ProbeDisc(std::filesystem::path path, DiscProbeResult &result);
+
+// Caches the results of ProbeDisc on disk in order to speed up repeated scans of large disc image libraries.
+//
+// Entries are keyed by the absolute path to the image file and validated against the file size and last modification
+// time. Files that are not loadable disc images are also recorded so that they are not probed again until they change.
+// Only the file passed to ProbeDisc is checked; changes made exclusively to auxiliary files (such as the BIN files
+// referenced by a CUE sheet) are not detected.
+//
+// This class is not thread-safe.
+class DiscIndexCache {
+public:
+    // Loads the index from the specified file, replacing any existing entries.
+    // Returns true if the file was loaded successfully. On failure, the index is left empty.
+    bool Load(const std::filesystem::path &indexPath);
+
+    // Writes the index to the specified file.
+    // The file is replaced atomically, so an interrupted write never leaves a truncated index behind.
+    // Returns true if the file was saved successfully.
+    bool Save(const std::filesystem::path &indexPath) const;
+
+    // Retrieves the probe result for the specified disc image, probing the image and updating the index if there is no
+    // up-to-date entry for it. Failed probes are recorded as well.
+    // Returns true if the image is a loadable disc image.
+    bool Probe(const std::filesystem::path &path, DiscProbeResult &result);
+
+    // Removes entries for files that no longer exist.
+    void Prune();
+
+    // Removes all entries.
+    void Clear();
+
+    // Returns the number of entries in the index.
+    size_t Size() const {
+        return m_entries.size();
+    }
+
+    // Determines if the index has been modified since it was last loaded or saved.
+    bool IsDirty() const {
+        return m_dirty;
+    }
+
+private:
+    struct Entry {
+        uintmax_t fileSize;
+        sint64 lastWriteTime;
+        DiscFormat format;
+        bool hasHash;
+        XXH128Hash hash;
+        std::array<uint8, 256> rawHeader;
+    };
+
+    std::unordered_map<std::string, Entry> m_entries;
+    mutable bool m_dirty = false;
+};
+
+} // namespace ymir::media
@@ -12,8 +12,10 @@
 
 #include <cassert>
 #include <map>
-#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace ymir::media::fs {
@@ -156,6 +158,21 @@ private:
     friend class Filesystem;
 };
 
+// Sectors occupied by a file, as recorded in the file system index.
+struct FileExtent {
+    uint32 startFrameAddress; // Absolute frame address of the first sector
+    uint32 endFrameAddress;   // Absolute frame address of the last sector (inclusive)
+    uint32 size;              // File size in bytes
+    uint32 directory;         // Index of the directory containing the file
+    uint32 entry;             // Index of the file in the directory contents
+    std::string path;         // Full path to the file, in the format returned by Filesystem::GetPathAtFrameAddress
+};
+
+// Computes the disc hash from the first 16 data sectors and the volume descriptors without parsing the file system.
+// Returns true if successful, or false if the disc has no valid volume descriptor set.
+// For valid discs, the result matches the hash returned by Filesystem::GetHash().
+bool CalcDiscHash(const Disc &disc, XXH128Hash &outHash);
+
 class Filesystem {
 public:
     // Clears the loaded file system.
@@ -210,14 +227,28 @@ public:
     // Retrieves the file info from the current directory for the given absolute file ID.
     const FileInfo &GetFileInfo(uint32 fileID) const;
 
-    // Retrieves the filesystem entry at the specified frame address.
+    // Retrieves the filesystem entry at the specified absolute frame address.
     // Retuns nullptr if there is no file at that FAD, it is out of range or it doesn't point to a data track.
     const FilesystemEntry *GetFileAtFrameAddress(uint32 fad) const;
 
-    // Retrieves the full path of the file at the specified frame address.
-    // Retuns nullptr if there is no file at that FAD, it is out of range or it doesn't point to a data track.
+    // Retrieves the full path of the file at the specified absolute frame address.
+    // Retuns an empty string if there is no file at that FAD, it is out of range or it doesn't point to a data track.
     std::string GetPathAtFrameAddress(uint32 fad) const;
 
+    // Retrieves the extents of all non-empty files in the file system, sorted by starting frame address.
+    // The index is built when the file system is read and remains valid until it is cleared or read again.
+    std::span<const FileExtent> GetFileExtents() const {
+        return m_fileExtents;
+    }
+
+    // Finds the extent of the file at the specified absolute frame address in logarithmic time.
+    // Returns nullptr if there is no file at that FAD.
+    const FileExtent *FindFileExtent(uint32 fad) const;
+
+    // Finds the extent of the file with the specified full path in constant time.
+    // Returns nullptr if there is no non-empty file with that path.
+    const FileExtent *FindFileExtent(std::string_view path) const;
+
     // -------------------------------------------------------------------------
     // Save states
 
@@ -232,18 +263,18 @@ private:
     // Disc hash
     XXH128Hash m_hash{};
 
-    struct FileIndex {
-        size_t directory;
-        size_t file;
-    };
-    // Frame address to file map.
-    // The key is actually the upper bound of the filesystem entry.
-    std::map<uint32, FileIndex> m_fadToFiles{};
-
-    std::optional<FileIndex> LookupFileIndexAtFrameAddress(uint32 fad) const;
+    // File extents sorted by starting frame address.
+    std::vector<FileExtent> m_fileExtents{};
+    // Highest end frame address among the extents up to and including each index, used to find files whose extent
+    // overlaps later extents.
+    std::vector<uint32> m_fileExtentsMaxEnd{};
+    // Full path to file extent index map.
+    std::unordered_map<std::string, size_t> m_pathToFileExtent{};
 
     std::string BuildPath(uint16 directoryIndex) const;
 
+    void BuildFileIndex();
+
     // Current file system operation state.
     // These fields should be stored in the save state
 
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <ymir/media/disc.hpp>
+#include <ymir/media/loader/loader_chd.hpp>
 
 #include <filesystem>
 
 namespace ymir::media {
 
 // Attempts to load a CD image from any of the supported file formats:
+//   Ymir YCD    (if provided a .ycd file; loads the first disc in the file)
 //   MAME CHD    (if provided a .chd file)
 //   BIN/CUE     (if provided a .cue file)
 //   MDF/MDS     (if provided a .mds file)
@@ -15,6 +17,9 @@ namespace ymir::media {
 // Returns true if loading the file (and any auxiliary files) succeeded.
 // If this function returns false, the Disc object is invalidated.
 // preloadToRAM specifies if the entire disc image should be preloaded into memory.
-bool LoadDisc(std::filesystem::path path, Disc &disc, bool preloadToRAM);
+// Preloading happens in a background thread; the disc can be used immediately while it is loaded.
+// chdCacheOptions configures the decompressed hunk cache used by CHD images.
+bool LoadDisc(std::filesystem::path path, Disc &disc, bool preloadToRAM,
+              const loader::chd::HunkCacheOptions &chdCacheOptions = {});
 
 } // namespace ymir::media
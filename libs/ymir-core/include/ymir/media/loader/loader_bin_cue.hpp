@@ -41,6 +41,7 @@ namespace ymir::media::loader::bincue {
 // Returns true if loading all files succeeded.
 // If this function returns false, the Disc object is invalidated.
 // preloadToRAM specifies if the entire disc image should be preloaded into memory.
+// Preloading happens in a background thread; the disc can be used immediately while it is loaded.
 bool Load(std::filesystem::path cuePath, Disc &disc, bool preloadToRAM);
 
 } // namespace ymir::media::loader::bincue
@@ -2,6 +2,8 @@
 
 #include <ymir/media/disc.hpp>
 
+#include <ymir/core/types.hpp>
+
 #include <filesystem>
 
 // CHD (Compressed Hunks of Data) is a file format created by MAME authors to store compressed CD-ROM data.
@@ -10,10 +12,27 @@
 
 namespace ymir::media::loader::chd {
 
+// Parameters for the decompressed hunk cache.
+struct HunkCacheOptions {
+    // Maximum amount of memory used to store decompressed hunks, in bytes.
+    // The cache is allocated up front; the least recently used hunks are evicted once it fills up.
+    size_t memoryBudget = 32 * 1024 * 1024;
+
+    // Number of background threads used to decompress upcoming hunks.
+    // Set to 0 to decompress hunks on demand only.
+    uint32 decompressionThreads = 0;
+
+    // Number of hunks past the most recently read hunk to decompress in the background.
+    // Limited to half of the cache capacity. Has no effect if decompressionThreads is 0.
+    uint32 readAheadHunks = 8;
+};
+
 // Attempts to load a CHD file from chdPath into the specified Disc object.
 // Returns true if loading all files succeeded.
 // If this function returns false, the Disc object is invalidated.
 // preloadToRAM specifies if the entire disc image should be preloaded into memory.
-bool Load(std::filesystem::path chdPath, Disc &disc, bool preloadToRAM);
+// Preloading happens in a background thread; the disc can be used immediately while it is loaded.
+// cacheOptions configures the decompressed hunk cache used by this disc.
+bool Load(std::filesystem::path chdPath, Disc &disc, bool preloadToRAM, const HunkCacheOptions &cacheOptions = {});
 
 } // namespace ymir::media::loader::chd
@@ -18,6 +18,7 @@ namespace ymir::media::loader::iso {
 // Returns true if loading the file succeeded.
 // If this function returns false, the Disc object is invalidated.
 // preloadToRAM specifies if the entire disc image should be preloaded into memory.
+// Preloading happens in a background thread; the disc can be used immediately while it is loaded.
 bool Load(std::filesystem::path isoPath, Disc &disc, bool preloadToRAM);
 
 } // namespace ymir::media::loader::iso
@@ -13,6 +13,7 @@ namespace ymir::media::loader::mdfmds {
 // Returns true if loading the files succeeded.
 // If this function returns false, the Disc object is invalidated.
 // preloadToRAM specifies if the entire disc image should be preloaded into memory.
+// Preloading happens in a background thread; the disc can be used immediately while it is loaded.
 bool Load(std::filesystem::path mdsPath, Disc &disc, bool preloadToRAM);
 
 } // namespace ymir::media::loader::mdfmds
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <ymir/media/disc.hpp>
+
+#include <ymir/core/types.hpp>
+
+#include <filesystem>
+#include <span>
+
+// YCD (Ymir Compressed Disc) is a simple seekable compressed disc image format native to Ymir.
+//
+// The file stores the raw sector data of every track as it would be read from the original image. Sectors are appended
+// to a shared pool which is split into fixed-size chunks compressed independently with LZ4, allowing any sector to be
+// located with a single table lookup and decompressed with very low latency. The file is memory-mapped and chunks are
+// decompressed on demand.
+//
+// A single file may contain multiple discs, such as all discs of a multi-disc game. Identical sectors can optionally be
+// stored only once across the entire set.
+//
+// File layout (all values little-endian):
+//   Header (48 bytes):
+//     char[4]   magic "YCD\x1A"
+//     uint32    version
+//     uint32    uncompressed chunk size in bytes
+//     uint32    number of chunks
+//     uint64    uncompressed pool size in bytes
+//     uint64    chunk table offset
+//     uint64    disc table offset
+//     uint32    number of discs
+//     uint32    reserved, must be zero
+//   Chunk data:
+//     Compressed chunks. A chunk whose stored size equals its uncompressed size is stored uncompressed.
+//   Chunk table (one entry per chunk):
+//     uint64    file offset of the chunk data
+//     uint32    stored size in bytes
+//   Disc table (one entry per disc):
+//     uint32    number of sessions
+//     Sessions:
+//       uint32  start frame address
+//       uint32  end frame address
+//       uint32  first track index
+//       uint32  number of tracks
+//       Tracks (starting from the first track index):
+//         uint32    sector size
+//         uint8     control/ADR
+//         uint8     flags: bit 0 = mode 2, bit 1 = interleaved subchannel, bit 2 = big-endian audio
+//         uint32    start frame address
+//         uint32    end frame address
+//         uint32    number of indices
+//         Indices:
+//           uint32  start frame address
+//           uint32  end frame address
+//         uint64    track data size in bytes
+//         uint64[]  pool offset of each sector of the track data
+
+namespace ymir::media::loader::ycd {
+
+// Parameters for writing YCD files.
+struct WriteOptions {
+    // Store identical sectors only once across all discs in the file.
+    bool deduplicate = true;
+};
+
+// Statistics about a written YCD file.
+struct WriteStats {
+    uint64 totalSectors = 0;     // Number of sectors in all tracks of all discs
+    uint64 uniqueSectors = 0;    // Number of sectors stored in the pool
+    uint64 uncompressedSize = 0; // Size of the sector pool before compression
+    uint64 compressedSize = 0;   // Size of the compressed chunks
+};
+
+// Attempts to load the disc at discIndex from the YCD file at ycdPath into the specified Disc object.
+// Returns true if loading the file succeeded.
+// If this function returns false, the Disc object is invalidated.
+// preloadToRAM specifies if the entire disc image should be decompressed into memory.
+// Decompression happens in a background thread; the disc can be used immediately while it is loaded.
+bool Load(std::filesystem::path ycdPath, Disc &disc, bool preloadToRAM, uint32 discIndex = 0);
+
+// Retrieves the number of discs stored in the YCD file at ycdPath.
+// Returns 0 if the file is not a valid YCD file.
+uint32 GetDiscCount(std::filesystem::path ycdPath);
+
+// Writes the specified discs into a YCD file at ycdPath, in the given order.
+// The discs can be loaded from any supported format. The file is written to a temporary file first and then moved into
+// place, so an interrupted conversion never leaves a truncated file behind.
+// Returns true if the file was written successfully. If stats is not null, it is filled in with statistics about the
+// written file.
+bool Write(std::filesystem::path ycdPath, std::span<const Disc *const> discs, const WriteOptions &options = {},
+           WriteStats *stats = nullptr);
+
+} // namespace ymir::media::loader::ycd
@@ -26,6 +26,25 @@ struct SaturnHeader {
     SaturnHeader &operator=(const SaturnHeader &) = delete;
     SaturnHeader &operator=(SaturnHeader &&) = default;
 
+    SaturnHeader Clone() const {
+        SaturnHeader header{};
+        header.hwID = hwID;
+        header.makerID = makerID;
+        header.productNumber = productNumber;
+        header.version = version;
+        header.releaseDate = releaseDate;
+        header.deviceInfo = deviceInfo;
+        header.compatAreaCode = compatAreaCode;
+        header.compatPeripherals = compatPeripherals;
+        header.gameTitle = gameTitle;
+        header.ipSize = ipSize;
+        header.masterStackSize = masterStackSize;
+        header.slaveStackSize = slaveStackSize;
+        header.firstReadAddress = firstReadAddress;
+        header.firstReadSize = firstReadSize;
+        return header;
+    }
+
     void Swap(SaturnHeader &&header) {
         hwID.swap(header.hwID);
         makerID.swap(header.makerID);
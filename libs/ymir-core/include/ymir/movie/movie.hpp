@@ -0,0 +1,307 @@
+#pragma once
+
+#include <ymir/hw/smpc/peripheral/peripheral_report.hpp>
+#include <ymir/state/state.hpp>
+
+#include <ymir/core/configuration.hpp>
+#include <ymir/core/hash.hpp>
+#include <ymir/core/types.hpp>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <system_error>
+#include <vector>
+
+// Input movies record everything needed to replay a play session deterministically: the peripheral reports returned
+// to the SMPC on every frame, the few frontend events that act on the system directly (resets, the reset button and
+// the disc tray) and periodic keyframes with the full system state.
+//
+// Playback starts from the keyframe at frame 0 and replays the inputs and events frame by frame. The remaining
+// keyframes make seeking cheap: the player restores the nearest keyframe at or before the target frame and
+// fast-forwards from there with rendering disabled. Keyframes may also be flagged as resync points, which are always
+// restored during playback; recorders write those after changes they cannot represent as inputs or events, such as
+// loading a save state or poking memory from a debugger.
+//
+// Keyframes contain raw binary states (see state_binary.hpp) along with the contents of the internal backup memory,
+// which is not part of the system state. Binary states are only valid within the same build of the emulator, which is
+// no real limitation for seeking since changes to the emulator's timings would cause movies to desync anyway. To keep
+// movies playable from the start after the binary layout changes, the keyframe at frame 0 also stores the state in a
+// persistent format supplied by the frontend, such as the archive format used by save state files. The core treats
+// that data as opaque; see MoviePlayer::SetPersistentStateLoader.
+//
+// The file is written as a stream of records. A record cut short by a crash is simply ignored when reading, so
+// interrupted recordings remain playable up to the last complete record.
+//
+// File layout (all values little-endian):
+//   Header (48 bytes):
+//     char[4]   magic "YMV\x1A"
+//     uint32    version
+//     uint8[16] IPL ROM hash
+//     uint8[16] disc hash
+//     uint32    keyframe interval in frames
+//     uint8     flags: bit 0 = SH-2 cache emulation, bit 1 = reserved,
+//                      bit 2 = external backup memory cartridge inserted
+//     uint8     CD read speed factor
+//     uint8     CD audio buffer latency
+//     uint8     reserved, must be zero
+//   Records:
+//     uint8     record type
+//     Type 0 - repeated frames:
+//       varint    number of frames with the same inputs as the previous frame and no events
+//     Type 1 - frame:
+//       uint8     contents: bit 0 = port 1 report, bit 1 = port 2 report, bit 2 = events
+//       Report[]  new peripheral reports for the ports flagged in contents; the others repeat the previous frame's
+//       uint8     event flags (MovieEvent), if flagged in contents
+//     Type 2 - keyframe:
+//       uint64    frame number
+//       uint8     flags: bit 0 = resync point, bit 1 = persistent state
+//       Block     binary state
+//       Block     internal backup memory image
+//       Block     persistent state, if flagged
+//   Report:
+//     uint8     peripheral type (PeripheralType), followed by the report fields of that type in declaration order.
+//               Buttons are stored as uint16, everything else as uint8.
+//   Block:
+//     uint32    uncompressed size
+//     uint32    stored size; the data is stored uncompressed if this equals the uncompressed size
+//     uint8[]   data compressed with LZ4
+//   varint:
+//     Unsigned LEB128 integer.
+//
+// Keyframe N holds the state right before frame N is run, after the events of frame N have been applied. The first
+// record of every movie is a resync keyframe at frame 0.
+
+namespace ymir {
+
+struct Saturn;
+
+} // namespace ymir
+
+namespace ymir::movie {
+
+// Default distance between regular keyframes, in frames.
+// Around 30 seconds of NTSC video; a good balance between file size and seek latency.
+inline constexpr uint32 kDefaultKeyframeInterval = 1800;
+
+// Events applied to the system before running a frame.
+namespace event {
+    inline constexpr uint8 kHardReset = 1u << 0u;
+    inline constexpr uint8 kSoftReset = 1u << 1u;
+    inline constexpr uint8 kPressResetButton = 1u << 2u;
+    inline constexpr uint8 kReleaseResetButton = 1u << 3u;
+    inline constexpr uint8 kOpenTray = 1u << 4u;
+    inline constexpr uint8 kCloseTray = 1u << 5u;
+} // namespace event
+
+// Inputs and events of a single frame.
+struct MovieFrame {
+    // Reports returned to peripherals connected to ports 1 and 2.
+    // The type determines which peripheral is connected to the port while playing back the frame.
+    std::array<peripheral::PeripheralReport, 2> inputs{};
+
+    // event::k* flags. Events are applied in the order they are declared above; at most one of each pair of opposite
+    // events (reset button press/release, tray open/close) should be set.
+    uint8 events = 0;
+};
+
+// Emulator settings that affect emulation of the recorded session.
+struct MovieInfo {
+    XXH128Hash iplHash{};
+    XXH128Hash discHash{};
+
+    uint32 keyframeInterval = kDefaultKeyframeInterval;
+
+    bool emulateSH2Cache = false;
+    uint8 cdReadSpeedFactor = 2;
+    uint8 cddaBufferLatency = 4;
+
+    // An external backup memory cartridge was inserted. Its contents are not recorded.
+    bool externalBackupMemory = false;
+};
+
+// Captures the movie information from the current system configuration.
+MovieInfo CaptureMovieInfo(Saturn &saturn);
+
+// Applies the settings stored in the movie information to the given configuration.
+void ApplyMovieInfo(const MovieInfo &info, core::Configuration &config);
+
+// -----------------------------------------------------------------------------
+// Recording
+
+// Writes input movie files.
+class MovieWriter {
+public:
+    ~MovieWriter();
+
+    // Creates a movie file at the specified path and writes the initial keyframe with the given state and internal
+    // backup memory contents. persistentState holds the same state in the frontend's persistent format; it is stored
+    // in the initial keyframe unless empty.
+    // Returns false and sets error if the file could not be written.
+    bool Open(const std::filesystem::path &path, const MovieInfo &info, const state::State &initialState,
+              std::span<const uint8> backupRAM, std::span<const uint8> persistentState, std::error_code &error);
+
+    // Flushes pending records and closes the file.
+    void Close();
+
+    bool IsOpen() const {
+        return m_out.is_open();
+    }
+
+    // Determines if a regular keyframe should be written before the next frame.
+    bool IsKeyframeDue() const {
+        return m_frameCount - m_lastKeyframe >= m_keyframeInterval;
+    }
+
+    // Writes a keyframe for the next frame. Must be called before the frame is written.
+    // Resync keyframes are always restored during playback.
+    // Returns false if the data could not be written.
+    bool WriteKeyframe(const state::State &state, std::span<const uint8> backupRAM, bool resync);
+
+    // Appends a frame to the movie.
+    // Returns false if the data could not be written.
+    bool WriteFrame(const MovieFrame &frame);
+
+    // Retrieves the number of frames written so far.
+    uint64 GetFrameCount() const {
+        return m_frameCount;
+    }
+
+private:
+    std::ofstream m_out;
+    std::vector<uint8> m_buffer;
+
+    uint32 m_keyframeInterval = kDefaultKeyframeInterval;
+    uint64 m_frameCount = 0;
+    uint64 m_lastKeyframe = 0;
+
+    MovieFrame m_lastFrame{};
+    uint32 m_repeatCount = 0;
+
+    std::vector<uint8> m_stateBuffer;
+    std::vector<uint8> m_compressBuffer;
+
+    bool WriteKeyframeRecord(const state::State &state, std::span<const uint8> backupRAM,
+                             std::span<const uint8> persistentState, bool resync);
+    void FlushRepeats();
+    bool FlushBuffer();
+};
+
+// -----------------------------------------------------------------------------
+// Playback
+
+// A keyframe in a movie file.
+struct MovieKeyframe {
+    uint64 frame;    // Frame number
+    bool resync;     // Whether this keyframe must be restored during playback
+    bool persistent; // Whether this keyframe includes the state in the persistent format
+    uint64 offset;   // File offset of the keyframe data blocks
+};
+
+// Reads input movie files.
+//
+// The inputs of all frames are decoded into memory when opening the file; keyframes are read on demand.
+class MovieReader {
+public:
+    // Opens and indexes the movie file at the specified path.
+    // Returns false and sets error if the file could not be read or is not a valid movie file.
+    bool Open(const std::filesystem::path &path, std::error_code &error);
+
+    const MovieInfo &GetInfo() const {
+        return m_info;
+    }
+
+    uint64 GetFrameCount() const {
+        return m_frames.size();
+    }
+
+    const MovieFrame &GetFrame(uint64 frame) const {
+        return m_frames[frame];
+    }
+
+    std::span<const MovieKeyframe> GetKeyframes() const {
+        return m_keyframes;
+    }
+
+    // Finds the index of the last keyframe at or before the specified frame.
+    size_t FindKeyframe(uint64 frame) const;
+
+    // Reads the binary state and internal backup memory image of the keyframe at the specified index.
+    // If persistentState is not null, it also receives the persistent state, or is cleared if the keyframe has none.
+    // Returns false if the data could not be read or is corrupted.
+    bool ReadKeyframe(size_t index, std::vector<uint8> &binaryState, std::vector<uint8> &backupRAM,
+                      std::vector<uint8> *persistentState = nullptr) const;
+
+private:
+    std::filesystem::path m_path;
+    MovieInfo m_info;
+    std::vector<MovieFrame> m_frames;
+    std::vector<MovieKeyframe> m_keyframes;
+};
+
+// Plays back a movie on a Saturn instance.
+//
+// The system must have the movie's IPL ROM and disc loaded, and should be configured with ApplyMovieInfo. The player
+// replaces the peripheral report callbacks and the peripherals connected to both ports while it exists; the caller is
+// responsible for restoring them afterwards.
+//
+// Playback replaces the internal backup memory with in-memory images restored from keyframes, so changes made during
+// playback are not written to any backup memory file.
+class MoviePlayer {
+public:
+    // Decodes a state stored in the frontend's persistent format. Returns false if the data is invalid.
+    using PersistentStateLoader = std::function<bool(std::span<const uint8> data, state::State &state)>;
+
+    MoviePlayer(Saturn &saturn, const MovieReader &movie);
+
+    // Sets the function used to decode persistent states. Keyframes that hold a persistent state are restored from it
+    // when their binary state cannot be loaded, which happens when the movie was recorded by a build of the emulator
+    // with a different state layout. Seeking then falls back to the initial keyframe and fast-forwards from there.
+    void SetPersistentStateLoader(PersistentStateLoader loader) {
+        m_persistentStateLoader = std::move(loader);
+    }
+
+    // Runs the next frame of the movie.
+    // Returns false if the movie has ended or a keyframe could not be restored.
+    bool RunFrame();
+
+    // Moves playback to the specified frame, which is clamped to the end of the movie.
+    // Restores the nearest keyframe at or before the frame, unless playback can simply continue from the current
+    // position, then fast-forwards to the target frame with rendering disabled.
+    // Returns false if a keyframe could not be restored.
+    bool Seek(uint64 frame);
+
+    // Retrieves the number of the next frame to be run.
+    uint64 GetCurrentFrame() const {
+        return m_currFrame;
+    }
+
+    bool IsFinished() const {
+        return m_currFrame >= m_movie.GetFrameCount();
+    }
+
+private:
+    Saturn &m_saturn;
+    const MovieReader &m_movie;
+
+    uint64 m_currFrame = 0;
+
+    // Set after restoring the keyframe at m_currFrame, which already includes that frame's events
+    bool m_keyframeRestored = false;
+
+    PersistentStateLoader m_persistentStateLoader;
+
+    std::vector<uint8> m_stateBuffer;
+    std::vector<uint8> m_backupRAMBuffer;
+    std::vector<uint8> m_persistentStateBuffer;
+
+    bool RestoreKeyframe(size_t index);
+    void ConnectPeripherals(const MovieFrame &frame);
+
+    template <uint32 port>
+    void ReadPeripheral(peripheral::PeripheralReport &report);
+};
+
+} // namespace ymir::movie
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "state_cdblock.hpp"
+#include "state_dirty_pages.hpp"
 #include "state_scheduler.hpp"
 #include "state_scsp.hpp"
 #include "state_scu.hpp"
@@ -9,6 +10,8 @@
 #include "state_system.hpp"
 #include "state_vdp.hpp"
 
+#include <span>
+
 namespace ymir::state {
 
 struct State {
@@ -26,4 +29,38 @@ struct State {
     uint64 ssh2SpilloverCycles;
 };
 
+// Returns the number of pages in the specified memory region.
+inline constexpr size_t GetMemoryPageCount(MemoryRegion region) {
+    switch (region) {
+    case MemoryRegion::WRAMLow: return sys::kWRAMLowSize / kMemoryPageSize;
+    case MemoryRegion::WRAMHigh: return sys::kWRAMHighSize / kMemoryPageSize;
+    case MemoryRegion::VDP1VRAM: return vdp::kVDP1VRAMSize / kMemoryPageSize;
+    case MemoryRegion::VDP1FB0: return vdp::kVDP1FramebufferRAMSize / kMemoryPageSize;
+    case MemoryRegion::VDP1FB1: return vdp::kVDP1FramebufferRAMSize / kMemoryPageSize;
+    case MemoryRegion::VDP2VRAM: return vdp::kVDP2VRAMSize / kMemoryPageSize;
+    case MemoryRegion::VDP2CRAM: return vdp::kVDP2CRAMSize / kMemoryPageSize;
+    case MemoryRegion::SCSPWRAM: return m68k::kM68KWRAMSize / kMemoryPageSize;
+    case MemoryRegion::CDBlockBuffers: return cdblock::kNumBuffers + 1;
+    default: return 0;
+    }
+}
+
+// Retrieves the contents of a page of the specified memory region of the state.
+inline std::span<uint8> GetMemoryPage(State &state, MemoryRegion region, size_t page) {
+    auto slice = [&](auto &array) { return std::span<uint8>{array}.subspan(page * kMemoryPageSize, kMemoryPageSize); };
+
+    switch (region) {
+    case MemoryRegion::WRAMLow: return slice(state.system.WRAMLow);
+    case MemoryRegion::WRAMHigh: return slice(state.system.WRAMHigh);
+    case MemoryRegion::VDP1VRAM: return slice(state.vdp.VRAM1);
+    case MemoryRegion::VDP1FB0: return slice(state.vdp.spriteFB[0]);
+    case MemoryRegion::VDP1FB1: return slice(state.vdp.spriteFB[1]);
+    case MemoryRegion::VDP2VRAM: return slice(state.vdp.VRAM2);
+    case MemoryRegion::VDP2CRAM: return slice(state.vdp.CRAM);
+    case MemoryRegion::SCSPWRAM: return slice(state.scsp.WRAM);
+    case MemoryRegion::CDBlockBuffers: return state.cdblock.buffers[page].data;
+    default: return {};
+    }
+}
+
 } // namespace ymir::state
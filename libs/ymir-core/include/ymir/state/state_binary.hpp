@@ -0,0 +1,115 @@
+#pragma once
+
+#include "state.hpp"
+
+#include <ymir/core/types.hpp>
+
+#include <span>
+#include <vector>
+
+namespace ymir::state {
+
+// Raw binary save state format.
+//
+// Stores the components of a State as raw memory blocks, which makes saving and loading little more than a few memory
+// copies. Since the blocks mirror the in-memory layout of the state structs, binary states are only meant to be used
+// within the same build of the emulator (e.g. to keep states in memory); use the cereal serializers for persistent
+// files.
+//
+// Layout:
+//   BinaryStateHeader
+//   BinaryStateSection[sectionCount]
+//   Section contents, each aligned to kBinaryStateAlignment bytes
+//
+// Most sections are raw copies of the corresponding state structs. The SCU and SMPC sections store their fields one
+// after another, since their structs contain vectors; the contents of those vectors are stored in separate sections.
+
+inline constexpr uint32 kBinaryStateMagic = 0x53524D59; // "YMRS"
+inline constexpr uint16 kBinaryStateVersion = 1;
+
+// Revision of the raw state struct layouts, mixed into the layout hash. The hash only detects changes to struct sizes
+// and alignments; bump this whenever fields are reordered, renamed to hold different data or replaced with fields of
+// the same size.
+inline constexpr uint32 kBinaryStateLayoutRevision = 1;
+
+// Written in the native byte order. Reads back as 0xFFFE if the state was written on a machine with the opposite byte
+// order.
+inline constexpr uint16 kBinaryStateByteOrderMark = 0xFEFF;
+
+// Alignment of section contents relative to the start of the binary state.
+inline constexpr size_t kBinaryStateAlignment = 64;
+
+// The tracked memory regions listed in MemoryRegion are omitted from the state. Reading such a state leaves those
+// regions untouched.
+inline constexpr uint32 kBinaryStateFlagNoTrackedMemory = 1u << 0u;
+
+enum class BinaryStateSectionID : uint32 {
+    Scheduler,   // SchedulerState
+    System,      // SystemState
+    MSH2,        // SH2State
+    SSH2,        // SH2State
+    SCU,         // SCUState fields
+    SCUCartData, // SCUState::cartData contents
+    SMPC,        // SMPCState fields
+    SMPCReport,  // SMPCState::INTBACK::report contents
+    VDP,         // VDPState
+    SCSP,        // SCSPState
+    CDBlock,     // CDBlockState
+    Spillover,   // State::msh2SpilloverCycles and State::ssh2SpilloverCycles
+
+    Count
+};
+
+struct BinaryStateHeader {
+    uint32 magic;         // kBinaryStateMagic
+    uint16 version;       // kBinaryStateVersion
+    uint16 byteOrderMark; // kBinaryStateByteOrderMark
+    uint32 flags;         // kBinaryStateFlag* bits
+    uint32 sectionCount;  // Number of entries in the section table
+    uint64 layoutHash;    // Fingerprint of the raw block layouts; must match the reader's
+    uint64 size;          // Total size of the binary state, including the header and section table
+};
+
+struct BinaryStateSection {
+    BinaryStateSectionID id;
+    uint32 reserved;
+    uint64 offset; // Offset from the start of the binary state
+    uint64 size;
+};
+
+// References the contents of a binary state in place.
+//
+// The raw memory blocks are read directly from the binary state buffer, which must outlive the view. Only the small SCU
+// and SMPC sections are decoded into copies.
+struct BinaryStateView {
+    const SchedulerState *scheduler = nullptr;
+    const SystemState *system = nullptr;
+    const SH2State *msh2 = nullptr;
+    const SH2State *ssh2 = nullptr;
+    SCUState scu;
+    SMPCState smpc;
+    const VDPState *vdp = nullptr;
+    const SCSPState *scsp = nullptr;
+    const CDBlockState *cdblock = nullptr;
+
+    uint64 msh2SpilloverCycles = 0;
+    uint64 ssh2SpilloverCycles = 0;
+};
+
+// Writes the state into out in the raw binary format, replacing its contents.
+// If excludeTrackedMemory is true, the tracked memory regions are left out (see kBinaryStateFlagNoTrackedMemory).
+void WriteBinaryState(const State &state, std::vector<uint8> &out, bool excludeTrackedMemory = false);
+
+// Reads a binary state into the given state object.
+// Trailing bytes after the end of the binary state are ignored.
+// Returns false if the data is not a valid binary state written by this build, in which case the state object is left
+// untouched.
+bool ReadBinaryState(std::span<const uint8> data, State &state);
+
+// Parses a binary state into a view that references its contents in place.
+// The data must be aligned suitably for the state structs (16 bytes, which is guaranteed for buffers allocated with
+// operator new on most platforms) and must include all memory regions.
+// Returns false if the data cannot be viewed in place or is not a valid binary state written by this build.
+bool ParseBinaryState(std::span<const uint8> data, BinaryStateView &view);
+
+} // namespace ymir::state
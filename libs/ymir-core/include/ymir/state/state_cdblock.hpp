@@ -88,11 +88,17 @@ struct CDBlockState {
         uint8 codingInfo;
 
         // 0 to kNumPartitions-1 = that partition
+        // kNumPartitions = reserved for Put Sector Data transfers
         // 255 = scratch buffer or not used
-        // All buffers are stored sequentially
         uint8 partitionIndex;
+
+        // Index of the next buffer in the same partition or reserved list, or 255 if this is the last buffer
+        uint8 next;
     };
+    // Buffers are stored at their index in the buffer pool, followed by the scratch buffer
     alignas(16) std::array<BufferState, cdblock::kNumBuffers + 1> buffers; // 200 buffers + 1 scratch buffer
+    std::array<uint8, cdblock::kNumPartitions> partitionFirstBuffers; // First buffer of each partition, 255 if empty
+    uint8 reservedFirstBuffer;                                        // First reserved buffer, 255 if none
     uint32 scratchBufferPutIndex;
     uint32 reservedBuffers;
 
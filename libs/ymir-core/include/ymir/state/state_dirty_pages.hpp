@@ -0,0 +1,73 @@
+#pragma once
+
+#include <ymir/util/dirty_pages.hpp>
+
+#include <ymir/core/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace ymir::state {
+
+// Large memory regions of a State whose modified pages are tracked for incremental saves.
+enum class MemoryRegion : uint8 {
+    WRAMLow,        // SystemState::WRAMLow
+    WRAMHigh,       // SystemState::WRAMHigh
+    VDP1VRAM,       // VDPState::VRAM1
+    VDP1FB0,        // VDPState::spriteFB[0]
+    VDP1FB1,        // VDPState::spriteFB[1]
+    VDP2VRAM,       // VDPState::VRAM2
+    VDP2CRAM,       // VDPState::CRAM
+    SCSPWRAM,       // SCSPState::WRAM
+    CDBlockBuffers, // CDBlockState::buffers[].data; one page per buffer
+};
+
+inline constexpr size_t kNumMemoryRegions = static_cast<size_t>(MemoryRegion::CDBlockBuffers) + 1;
+
+// Size of the pages of all memory regions except CD Block buffers, which are tracked individually.
+inline constexpr size_t kMemoryPageSize = util::kDirtyPageSize;
+
+// Lists the memory pages copied into a State by Saturn::SaveStateIncremental.
+struct DirtyPages {
+    // Page indices of each memory region, in ascending order
+    std::array<std::vector<uint16>, kNumMemoryRegions> pages;
+
+    void Clear() {
+        for (auto &list : pages) {
+            list.clear();
+        }
+    }
+
+    // Returns the total number of pages in all regions.
+    size_t Count() const {
+        size_t count = 0;
+        for (auto &list : pages) {
+            count += list.size();
+        }
+        return count;
+    }
+
+    std::vector<uint16> &operator[](MemoryRegion region) {
+        return pages[static_cast<size_t>(region)];
+    }
+
+    const std::vector<uint16> &operator[](MemoryRegion region) const {
+        return pages[static_cast<size_t>(region)];
+    }
+};
+
+// Copies the dirty pages of src into dst, records them in dirty and clears their flags.
+template <size_t N>
+void CopyDirtyPages(util::DirtyPageTracker<N> &tracker, const std::array<uint8, N> &src, std::array<uint8, N> &dst,
+                    DirtyPages &dirty, MemoryRegion region) {
+    static_assert(N % kMemoryPageSize == 0);
+    auto &pages = dirty[region];
+    tracker.ConsumeDirtyPages([&](size_t page) {
+        const size_t offset = page * kMemoryPageSize;
+        std::copy_n(src.begin() + offset, kMemoryPageSize, dst.begin() + offset);
+        pages.push_back(page);
+    });
+}
+
+} // namespace ymir::state
@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+@file
+@brief Registry of read-only assets shared between Saturn instances.
+*/
+
+#include "memory.hpp"
+
+#include <ymir/hw/cart/cart_impl_rom.hpp>
+
+#include <ymir/media/disc.hpp>
+#include <ymir/media/loader/loader_chd.hpp>
+
+#include <ymir/core/hash.hpp>
+#include <ymir/core/types.hpp>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+
+namespace ymir::sys {
+
+/// @brief Deduplicates read-only assets shared between multiple Saturn instances in the same process.
+///
+/// IPL ROM images and ROM cartridge images are immutable and reference counted. Requesting an image whose contents
+/// match a registered image returns the registered image, so every instance using the same IPL ROM or ROM cartridge
+/// shares a single copy.
+///
+/// Disc images are loaded once per path. Each request returns a copy of the disc that shares the binary readers,
+/// including the CHD hunk cache and decompression threads, the preloaded disc contents and the reconstructed sector
+/// caches with every other copy of that disc.
+///
+/// Assets remain registered until released with `ReleaseUnused()` or `Clear()`. Instances keep using the assets they
+/// hold even after the registry releases them.
+///
+/// All methods are thread-safe.
+class AssetRegistry {
+public:
+    /// @brief Retrieves a shared IPL ROM image with the given contents, registering a new image if needed.
+    /// @param[in] ipl the contents of the IPL ROM image
+    /// @return a shared pointer to the image; never `nullptr`
+    [[nodiscard]] std::shared_ptr<const IPLImage> GetIPL(std::span<const uint8, kIPLSize> ipl);
+
+    /// @brief Retrieves a shared ROM cartridge image with the given contents, registering a new image if needed.
+    ///
+    /// Images smaller than the cartridge are padded with zeros, as done by `cart::ROMCartridge::LoadROM`.
+    ///
+    /// @param[in] rom the contents of the ROM cartridge image
+    /// @return a shared pointer to the image; never `nullptr`
+    [[nodiscard]] std::shared_ptr<const cart::ROMImage> GetROMCart(std::span<const uint8> rom);
+
+    /// @brief Loads a disc image that shares its resources with every other copy loaded from the same path.
+    ///
+    /// The image is loaded from the file the first time the path is requested; `preloadToRAM` and `chdCacheOptions`
+    /// only take effect then. Subsequent requests clone the registered disc.
+    ///
+    /// @param[in] path the path to the disc image
+    /// @param[out] disc receives a copy of the disc; invalidated if the image fails to load
+    /// @param[in] preloadToRAM whether the entire disc image should be preloaded into memory
+    /// @param[in] chdCacheOptions the decompressed hunk cache options for CHD images
+    /// @return `true` if the disc image was loaded successfully
+    bool LoadDisc(const std::filesystem::path &path, media::Disc &disc, bool preloadToRAM,
+                  const media::loader::chd::HunkCacheOptions &chdCacheOptions = {});
+
+    /// @brief Releases all assets that are not in use by any Saturn instance or disc copy.
+    void ReleaseUnused();
+
+    /// @brief Releases all assets.
+    void Clear();
+
+private:
+    struct DiscEntry {
+        media::Disc disc;
+
+        // Total reference count of the track binary readers held by the registered disc alone
+        long baseUseCount;
+    };
+
+    mutable std::mutex m_mutex;
+
+    std::unordered_map<XXH128Hash, std::shared_ptr<const IPLImage>> m_iplImages;
+    std::unordered_map<XXH128Hash, std::shared_ptr<const cart::ROMImage>> m_romImages;
+    std::map<std::filesystem::path, DiscEntry> m_discs;
+};
+
+} // namespace ymir::sys
@@ -9,6 +9,7 @@
 
 #include <filesystem>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace ymir::bup {
@@ -46,6 +47,14 @@ public:
     // `error` will contain any error that occurs while loading or manipulating the file.
     void CreateFrom(const std::filesystem::path &path, BackupMemorySize size, std::error_code &error);
 
+    // Loads a copy of the given backup memory image into memory.
+    // The image size determines the backup memory size. The backup memory is not backed by any file, so changes are
+    // lost when the object is destroyed.
+    //
+    // Returns BackupMemoryImageLoadResult::Success if the image was loaded successfully.
+    // Returns BackupMemoryImageLoadResult::InvalidSize if the image size doesn't match any of the valid sizes.
+    BackupMemoryImageLoadResult LoadFrom(std::span<const uint8> image);
+
     bool CopyFrom(const IBackupMemory &backupRAM) final;
 
     std::filesystem::path GetPath() const final;
@@ -83,11 +92,10 @@ public:
     bool Delete(std::string_view filename) final;
 
 private:
-    // TODO: support three types
-    // - in-memory (std::vector)
-    // - memory-mapped file (mio::mmap_sink)
-    // - memory-mapped copy-on-write file (mio::mmap_cow_sink)
-    mio::mmap_sink m_backupRAM;
+    // TODO: support memory-mapped copy-on-write files (mio::mmap_cow_sink)
+    mio::mmap_sink m_backupRAM;  // Memory-mapped file, if the image is backed by a file
+    std::vector<uint8> m_memory; // In-memory image, if the image is not backed by a file
+    std::span<uint8> m_data;     // Contents of the image, pointing to either of the above
 
     std::filesystem::path m_path;
 
@@ -106,6 +114,9 @@ private:
     std::vector<BackupFileParams> m_fileParams;
     std::vector<uint64> m_blockBitmap;
 
+    // Validates the size of the image in m_data and updates the backup memory parameters.
+    BackupMemoryImageLoadResult SetupImage();
+
     // -------------------------------------------------------------------------
     // Data interface
 
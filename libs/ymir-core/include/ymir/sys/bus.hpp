@@ -11,11 +11,13 @@
 
 #include <ymir/util/bit_ops.hpp>
 #include <ymir/util/data_ops.hpp>
+#include <ymir/util/dirty_pages.hpp>
 #include <ymir/util/function_info.hpp>
 #include <ymir/util/inline.hpp>
 #include <ymir/util/type_traits_ex.hpp>
 #include <ymir/util/unreachable.hpp>
 
+#include <atomic>
 #include <concepts>
 #include <type_traits>
 
@@ -32,19 +34,29 @@ using FnWrite32 = void (*)(uint32 address, uint32 value, void *ctx); ///< Functi
 using FnNotifySCUDMA = void (*)(uint32 address, bool active,
                                 void *ctx); ///< Function signature for SCU DMA notifications.
 
+using FnReadBlock16 = bool (*)(uint32 address, uint16 *out, uint32 count,
+                               void *ctx); ///< Function signature for 16-bit block reads.
+using FnReadBlock32 = bool (*)(uint32 address, uint32 *out, uint32 count,
+                               void *ctx); ///< Function signature for 32-bit block reads.
+
 /// @brief Specifies valid bus handler function types.
 /// @tparam T the type to check
 template <typename T>
 concept bus_handler_fn =
     fninfo::IsAssignable<FnRead8, T> || fninfo::IsAssignable<FnRead16, T> || fninfo::IsAssignable<FnRead32, T> ||
     fninfo::IsAssignable<FnWrite8, T> || fninfo::IsAssignable<FnWrite16, T> || fninfo::IsAssignable<FnWrite32, T> ||
-    fninfo::IsAssignable<FnNotifySCUDMA, T>;
+    fninfo::IsAssignable<FnNotifySCUDMA, T> || fninfo::IsAssignable<FnReadBlock16, T> ||
+    fninfo::IsAssignable<FnReadBlock32, T>;
 
 /// @brief Represents a memory bus interconnecting various components in the system.
 ///
 /// `Read` and `Write` perform reads and writes with all side-effects and restrictions imposed by the hardware.
 /// `Peek` and `Poke` bypass restrictions and don't cause any side-effects. These are meant to be used by debuggers.
 ///
+/// `ReadBlock` performs a sequence of reads from the same address in one call. It is meant to be used by DMA engines to
+/// quickly drain FIFO-like ports such as the CD Block data transfer register. Block read handlers can only be mapped as
+/// normal handlers.
+///
 /// `Map` methods assign read/write functions to a range of addresses. `MapNormal` refers to the regular `Read`/`Write`
 /// functions and `MapSideEffectFree` refers to the `Peek`/`Poke` variants. `Unmap` clears the assignments.
 class Bus {
@@ -125,6 +137,8 @@ public:
         const uint32 endIndex = end >> kPageGranularityBits;
         for (uint32 i = startIndex; i <= endIndex; i++) {
             m_pages[i] = {};
+            m_blockPages[i] = {};
+            m_arrayDirtyFlags[i] = nullptr;
         }
     }
 
@@ -151,12 +165,56 @@ public:
         uint32 offset = 0;
         for (uint32 i = startIndex; i <= endIndex; i++) {
             m_pages[i] = {}; // clear all handlers
+            m_blockPages[i] = {};
+            m_arrayDirtyFlags[i] = nullptr;
             m_pages[i].array = &array[offset & kMask];
             m_pages[i].arrayWritable = writable;
             offset += kPageSize;
         }
     }
 
+    /// @brief Convenience method that maps a read-only array to the specified range.
+    ///
+    /// Behaves like `MapArray(start, end, array, false)`. The bus never writes to read-only arrays, which allows the
+    /// same array to be mapped into multiple buses concurrently.
+    ///
+    /// @tparam N the size of the array. Must be a power of two and at least as large as the bus's page size
+    /// @param[in] start the lower bound of the address range to map the handlers into
+    /// @param[in] end the upper bound of the address range to map the handlers into
+    /// @param array a reference to the array to be mapped
+    template <size_t N>
+        requires(bit::is_power_of_two(N) && N >= kPageSize)
+    void MapArray(uint32 start, uint32 end, const std::array<uint8, N> &array) {
+        MapArray(start, end, const_cast<std::array<uint8, N> &>(array), false);
+    }
+
+    /// @brief Convenience method that maps a writable array to the specified range and tracks modified pages.
+    ///
+    /// Behaves like `MapArray(start, end, array, true)`, additionally marking pages of the array as dirty in `dirty`
+    /// whenever they are written to through `Write` or `Poke`.
+    ///
+    /// @tparam N the size of the array. Must be a power of two and at least as large as the bus's page size
+    /// @param[in] start the lower bound of the address range to map the handlers into
+    /// @param[in] end the upper bound of the address range to map the handlers into
+    /// @param array a reference to the array to be mapped
+    /// @param dirty a reference to the tracker of modified pages of the array
+    template <size_t N>
+        requires(bit::is_power_of_two(N) && N >= kPageSize)
+    void MapArray(uint32 start, uint32 end, std::array<uint8, N> &array, util::DirtyPageTracker<N> &dirty) {
+        static_assert(kPageSize % util::kDirtyPageSize == 0);
+        static constexpr uint32 kMask = N - 1;
+
+        MapArray(start, end, array, true);
+
+        const uint32 startIndex = start >> kPageGranularityBits;
+        const uint32 endIndex = end >> kPageGranularityBits;
+        uint32 offset = 0;
+        for (uint32 i = startIndex; i <= endIndex; i++) {
+            m_arrayDirtyFlags[i] = dirty.GetFlag((offset & kMask) / util::kDirtyPageSize);
+            offset += kPageSize;
+        }
+    }
+
     // -----------------------------------------------------------------------------------------------------------------
     // Accessors
 
@@ -198,6 +256,7 @@ public:
         if (entry.array) {
             if (entry.arrayWritable) {
                 util::WriteBE<T>(&entry.array[address & kPageMask], value);
+                MarkArrayDirty(address);
             }
             return;
         }
@@ -223,6 +282,33 @@ public:
         entry.notifySCUDMA(address, active, entry.ctx);
     }
 
+    /// @brief Performs `count` consecutive reads from the specified address using the block read handler assigned to it.
+    ///
+    /// The values are read as if by `count` calls to `Read<T>(address)`, but the handler may produce them in bulk.
+    /// Handlers either read all values or none at all, in which case the caller must fall back to regular reads.
+    ///
+    /// @tparam T the data type of the access; must be 16-bit or 32-bit
+    /// @param[in] address the address to read
+    /// @param[out] out the buffer to store the values into; must have room for `count` values
+    /// @param[in] count the number of values to read
+    /// @return `true` if the values were read, `false` if block reads are not supported at the address
+    template <mem_primitive T>
+        requires(!std::is_same_v<T, uint8>)
+    FLATTEN FORCE_INLINE bool ReadBlock(uint32 address, T *out, uint32 count) const {
+        address &= kAddressMask & ~(sizeof(T) - 1);
+
+        const BlockPage &entry = m_blockPages[address >> kPageGranularityBits];
+
+        if constexpr (std::is_same_v<T, uint16>) {
+            return entry.readBlock16(address, out, count, entry.ctx);
+        } else if constexpr (std::is_same_v<T, uint32>) {
+            return entry.readBlock32(address, out, count, entry.ctx);
+        } else {
+            // should never happen
+            util::unreachable();
+        }
+    }
+
     /// @brief Reads data from the bus using the side-effect-free handler assigned to the specified address.
     /// @tparam T the data type of the access
     /// @param[in] address the address to read
@@ -261,6 +347,7 @@ public:
         if (entry.array) {
             if (entry.arrayWritable) {
                 util::WriteBE<T>(&entry.array[address & kPageMask], value);
+                MarkArrayDirty(address);
             }
             return;
         }
@@ -309,6 +396,27 @@ private:
 
     alignas(64) std::array<MemoryPage, kPageCount> m_pages;
 
+    // Dirty page flags of the arrays mapped to each page, pointing to the flag of the first dirty page within the bus
+    // page. Null if the array is not tracked. Kept separately for the same reason as block handlers below.
+    std::array<std::atomic<uint8> *, kPageCount> m_arrayDirtyFlags{};
+
+    FORCE_INLINE void MarkArrayDirty(uint32 address) {
+        if (std::atomic<uint8> *flags = m_arrayDirtyFlags[address >> kPageGranularityBits]) {
+            flags[(address & kPageMask) / util::kDirtyPageSize].store(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Block read handlers are kept separately to keep the size of MemoryPage down, as they're only used by DMA
+    // transfers.
+    struct BlockPage {
+        void *ctx = nullptr;
+
+        FnReadBlock16 readBlock16 = [](uint32, uint16 *, uint32, void *) { return false; };
+        FnReadBlock32 readBlock32 = [](uint32, uint32 *, uint32, void *) { return false; };
+    };
+
+    std::array<BlockPage, kPageCount> m_blockPages;
+
     template <bool normal, bool sideEffectFree, bus_handler_fn... THandlers>
         requires util::unique_types<THandlers...>
     void Map(uint32 start, uint32 end, void *context, THandlers &&...handlers) {
@@ -317,19 +425,24 @@ private:
         for (uint32 i = startIndex; i <= endIndex; i++) {
             m_pages[i].array = nullptr;
             m_pages[i].arrayWritable = false;
+            m_arrayDirtyFlags[i] = nullptr;
 
             m_pages[i].ctx = context;
+            if (m_blockPages[i].ctx != context) {
+                // Don't leave block handlers pointing to a different component
+                m_blockPages[i] = {};
+            }
             if constexpr (normal) {
-                (AssignHandler<false>(m_pages[i], std::forward<THandlers>(handlers)), ...);
+                (AssignHandler<false>(m_pages[i], m_blockPages[i], context, std::forward<THandlers>(handlers)), ...);
             }
             if constexpr (sideEffectFree) {
-                (AssignHandler<true>(m_pages[i], std::forward<THandlers>(handlers)), ...);
+                (AssignHandler<true>(m_pages[i], m_blockPages[i], context, std::forward<THandlers>(handlers)), ...);
             }
         }
     }
 
     template <bool peekpoke, bus_handler_fn THandler>
-    static void AssignHandler(MemoryPage &page, THandler &&handler) {
+    static void AssignHandler(MemoryPage &page, BlockPage &blockPage, void *context, THandler &&handler) {
         if constexpr (peekpoke) {
             if constexpr (fninfo::IsAssignable<FnRead8, THandler>) {
                 page.peek8 = handler;
@@ -359,6 +472,12 @@ private:
                 page.write32 = handler;
             } else if constexpr (fninfo::IsAssignable<FnNotifySCUDMA, THandler>) {
                 page.notifySCUDMA = handler;
+            } else if constexpr (fninfo::IsAssignable<FnReadBlock16, THandler>) {
+                blockPage.ctx = context;
+                blockPage.readBlock16 = handler;
+            } else if constexpr (fninfo::IsAssignable<FnReadBlock32, THandler>) {
+                blockPage.ctx = context;
+                blockPage.readBlock32 = handler;
             }
         }
     }
@@ -13,6 +13,7 @@ comprising the main system memory and 32 KiB of internal backup memory for stori
 #include <ymir/sys/backup_ram.hpp>
 #include <ymir/sys/bus.hpp>
 
+#include <ymir/state/state_dirty_pages.hpp>
 #include <ymir/state/state_system.hpp>
 
 #include <ymir/core/hash.hpp>
@@ -20,10 +21,25 @@ comprising the main system memory and 32 KiB of internal backup memory for stori
 
 #include <array>
 #include <iosfwd>
+#include <memory>
 #include <span>
 
 namespace ymir::sys {
 
+/// @brief An immutable IPL ROM image.
+///
+/// IPL ROM images are never modified once loaded, so a single image can be shared by any number of systems, including
+/// systems running concurrently on different threads.
+struct IPLImage {
+    alignas(16) std::array<uint8, kIPLSize> data; ///< The contents of the IPL ROM
+    XXH128Hash hash;                              ///< The IPL ROM hash code
+
+    /// @brief Creates an IPL ROM image with a copy of the given contents and computes its hash code.
+    /// @param[in] ipl the contents of the IPL ROM image
+    /// @return a shared pointer to the new image
+    static std::shared_ptr<const IPLImage> Create(std::span<const uint8, kIPLSize> ipl);
+};
+
 /// @brief Contains the Sega Saturn system memory components: The IPL ROM, Work RAM (low and high), and the internal
 /// backup memory.
 struct SystemMemory {
@@ -43,7 +59,23 @@ struct SystemMemory {
 
     /// @brief Loads the specified IPL ROM image.
     /// @param[in] ipl the contents of the IPL ROM image
-    void LoadIPL(std::span<uint8, kIPLSize> ipl);
+    void LoadIPL(std::span<const uint8, kIPLSize> ipl);
+
+    /// @brief Loads the specified shared IPL ROM image.
+    /// @param[in] ipl the IPL ROM image; must not be `nullptr`
+    void LoadIPL(std::shared_ptr<const IPLImage> ipl);
+
+    /// @brief Retrieves the contents of the IPL ROM.
+    /// @return the contents of the currently loaded IPL ROM image
+    std::span<const uint8, kIPLSize> GetIPL() const {
+        return m_ipl->data;
+    }
+
+    /// @brief Retrieves the shared IPL ROM image.
+    /// @return the currently loaded IPL ROM image
+    const std::shared_ptr<const IPLImage> &GetIPLImage() const {
+        return m_ipl;
+    }
 
     /// @brief Retrieves the IPL ROM hash code.
     /// @return the hash code of the currently loaded IPL ROM image
@@ -71,6 +103,12 @@ struct SystemMemory {
         return m_internalBackupRAM;
     }
 
+    /// @brief Retrieves the internal backup memory instance.
+    /// @return the object representing the system's internal backup memory
+    const bup::IBackupMemory &GetInternalBackupRAM() const {
+        return m_internalBackupRAM;
+    }
+
     /// @brief Replaces the internal backup memory object with the provided instance.
     ///
     /// The new backup memory must be 32 KiB in size.
@@ -96,6 +134,15 @@ struct SystemMemory {
     /// @param[out] state the state object to store into
     void SaveState(state::SystemState &state) const;
 
+    /// @brief Saves the system memory state into the given state object, copying only the Work RAM pages modified since
+    /// the previous incremental save.
+    ///
+    /// @remark It is recommended to use the `ymir::Saturn::SaveStateIncremental` method instead.
+    ///
+    /// @param[in,out] state the state object to update
+    /// @param[out] dirty receives the list of pages copied into the state
+    void SaveStateIncremental(state::SystemState &state, state::DirtyPages &dirty);
+
     /// @brief Validates the given state object.
     /// @param[in] state the state object to validate
     /// @return `true` if the state is valid
@@ -112,12 +159,16 @@ struct SystemMemory {
     // -------------------------------------------------------------------------
     // Memory
 
-    alignas(16) std::array<uint8, kIPLSize> IPL; ///< 512 KiB IPL ROM (aka BIOS ROM)
-
     alignas(16) std::array<uint8, kWRAMLowSize> WRAMLow;   ///< 1 MiB Low Work RAM (slow)
     alignas(16) std::array<uint8, kWRAMHighSize> WRAMHigh; ///< 1 MiB High Work RAM (fast)
 
+    util::DirtyPageTracker<kWRAMLowSize> WRAMLowDirty;   ///< Low Work RAM pages modified since last incremental save
+    util::DirtyPageTracker<kWRAMHighSize> WRAMHighDirty; ///< High Work RAM pages modified since last incremental save
+
 private:
+    std::shared_ptr<const IPLImage> m_ipl; ///< 512 KiB IPL ROM (aka BIOS ROM)
+    Bus *m_bus = nullptr;                  ///< The bus the IPL ROM is mapped into, used to remap it when replaced
+
     bup::BackupMemory m_internalBackupRAM; ///< Internal backup memory
 
     XXH128Hash m_iplHash{}; ///< Cached IPL ROM hash
@@ -13,6 +13,7 @@ See @ref index for instructions on how to use the emulator.
 #include <ymir/core/scheduler.hpp>
 
 #include <ymir/state/state.hpp>
+#include <ymir/state/state_binary.hpp>
 
 #include <ymir/debug/debug_break.hpp>
 
@@ -81,7 +82,14 @@ struct Saturn {
 
     /// @brief Loads the specified IPL ROM image.
     /// @param[in] ipl the contents of the IPL ROM image
-    void LoadIPL(std::span<uint8, sys::kIPLSize> ipl);
+    void LoadIPL(std::span<const uint8, sys::kIPLSize> ipl);
+
+    /// @brief Loads the specified shared IPL ROM image.
+    ///
+    /// The image is not copied, so any number of instances can share a single image. See sys::AssetRegistry.
+    ///
+    /// @param[in] ipl the IPL ROM image; must not be `nullptr`
+    void LoadIPL(std::shared_ptr<const sys::IPLImage> ipl);
 
     /// @brief Loads the specified internal backup memory image.
     ///
@@ -235,6 +243,29 @@ struct Saturn {
     /// @param[out] state the state object to store into
     void SaveState(state::State &state) const;
 
+    /// @brief Updates the given state object with the current system state, copying only the memory pages modified
+    /// since the previous incremental save.
+    ///
+    /// Work RAM, VDP1 and VDP2 memory, SCSP WRAM and CD Block sector buffers are tracked in pages. Only the pages listed
+    /// in `dirty` are written to; all other pages of those memory regions are left untouched. Every other part of the
+    /// state is saved in full. This makes repeated saves of consecutive frames much cheaper than `SaveState`.
+    ///
+    /// The state object must have been filled in by a previous save (full or incremental) and must not be modified
+    /// between incremental saves, otherwise its untracked pages will no longer match the system state. All pages are
+    /// considered modified after construction, hard resets, `LoadState` and `InvalidateIncrementalState`.
+    ///
+    /// Cartridge memory is not tracked and is always saved in full.
+    ///
+    /// @param[in,out] state the state object to update
+    /// @param[out] dirty receives the list of memory pages written to the state object
+    void SaveStateIncremental(state::State &state, state::DirtyPages &dirty);
+
+    /// @brief Marks all memory pages as modified, forcing the next incremental save to copy all memory.
+    ///
+    /// Must be invoked if the state object used for incremental saves was modified by anything other than
+    /// `SaveStateIncremental`.
+    void InvalidateIncrementalState();
+
     /// @brief Loads a complete system state from the given state object.
     ///
     /// Requires the IPL ROM and disc hashes to match. Additional filtering and validations are performed by components
@@ -244,6 +275,55 @@ struct Saturn {
     /// @return `true` if the state was loaded successfully
     [[nodiscard]] bool LoadState(const state::State &state);
 
+    /// @brief Loads a complete system state directly from a binary state view, without copying it into a state object
+    /// first.
+    ///
+    /// Performs the same validations as `LoadState(const state::State &)`.
+    ///
+    /// @param[in] view the binary state view to load from (see `state::ParseBinaryState`)
+    /// @return `true` if the state was loaded successfully
+    [[nodiscard]] bool LoadState(const state::BinaryStateView &view);
+
+    /// @brief Loads a complete system state from a state object that is being kept up to date with
+    /// `SaveStateIncremental`, without invalidating the incremental state.
+    ///
+    /// Since the system state matches the state object after loading, all memory pages are marked as unmodified instead
+    /// of modified, so that the next incremental save into the same object only copies the pages modified after this
+    /// call. The load itself still copies the entire state, but repeatedly restoring a snapshot (e.g. for run-ahead) no
+    /// longer forces the following incremental save to copy every memory page.
+    ///
+    /// Must only be used with the state object passed to the latest `SaveStateIncremental` call. Using it with any other
+    /// state object leaves the incremental state inconsistent.
+    ///
+    /// Performs the same validations as `LoadState`.
+    ///
+    /// @param[in] state the state object to load from
+    /// @return `true` if the state was loaded successfully
+    [[nodiscard]] bool LoadStateIncremental(const state::State &state);
+
+    // -------------------------------------------------------------------------
+    // Forking
+
+    /// @brief Creates an independent copy of this system in its current state.
+    ///
+    /// The copy reuses the parts of the system that never change instead of loading them again: the binary readers,
+    /// sector caches and file system structure of the disc, the IPL ROM image and the ROM cartridge image are shared
+    /// with this instance, and the SH-2 and M68K instruction decode tables are global to the process. Everything else,
+    /// including all RAM and cartridge memory, is copied through a save state, which amounts to a series of memory
+    /// copies.
+    ///
+    /// The internal backup memory and backup memory cartridges are copied into memory buffers, so the copy never writes
+    /// to the files backing the backup memories of this instance.
+    ///
+    /// The copy uses the same configuration as this instance, but has no peripherals connected, no callbacks registered
+    /// and debug tracing disabled. Set them up as needed before running the copy.
+    ///
+    /// This instance must not be running while it is being forked. The copy may run on a different thread, as long as
+    /// the binary readers of the disc support concurrent reads.
+    ///
+    /// @return the new system, or `nullptr` if the system state could not be copied
+    [[nodiscard]] std::unique_ptr<Saturn> Fork() const;
+
     // -------------------------------------------------------------------------
     // Debugger
 
@@ -254,6 +334,13 @@ struct Saturn {
     }
 
 private:
+    /// @brief Validates and loads a complete system state.
+    /// @tparam TState `state::State` or `state::BinaryStateView`
+    /// @param[in] state the state to load from
+    /// @return `true` if the state was loaded successfully
+    template <typename TState>
+    bool LoadStateImpl(const TState &state);
+
     /// @brief Runs the emulator until the end of the current frame.
     /// @tparam debug whether to use debug tracing
     /// @tparam enableSH2Cache whether to emulate SH-2 caches
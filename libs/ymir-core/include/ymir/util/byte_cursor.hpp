@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+@file
+@brief Defines `util::ByteCursor`, a bounds-checked sequential reader over a byte buffer.
+*/
+
+#include <ymir/core/types.hpp>
+
+#include "data_ops.hpp"
+
+#include <span>
+
+namespace util {
+
+/// @brief Sequential reader of little-endian values from a byte buffer with bounds checking.
+///
+/// Any out-of-bounds read sets the error flag and returns zero. Once the flag is set, all further reads fail as well,
+/// so that a sequence of reads can be validated with a single call to `IsOK()` at the end.
+class ByteCursor {
+public:
+    /// @brief Creates a cursor positioned at the given offset into the data.
+    /// @param[in] data the buffer to read from
+    /// @param[in] offset the initial position; the cursor starts in the error state if it is past the end of the data
+    ByteCursor(std::span<const uint8> data, uint64 offset)
+        : m_data(data)
+        , m_offset(offset)
+        , m_ok(offset <= data.size()) {}
+
+    /// @brief Reads a little-endian integer and advances the cursor past it.
+    /// @tparam T the integer type
+    /// @return the value read, or zero if there is not enough data left
+    template <typename T>
+    T Read() {
+        if (!m_ok || m_data.size() - m_offset < sizeof(T)) {
+            m_ok = false;
+            return 0;
+        }
+        const T value = ReadLE<T>(&m_data[m_offset]);
+        m_offset += sizeof(T);
+        return value;
+    }
+
+    /// @brief Reads an unsigned LEB128 integer of up to 64 bits and advances the cursor past it.
+    /// @return the value read, or zero if the data is truncated or the encoding is too long
+    uint64 ReadVarint() {
+        uint64 value = 0;
+        for (uint32 shift = 0; shift < 64; shift += 7) {
+            const uint8 byte = Read<uint8>();
+            value |= static_cast<uint64>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        m_ok = false;
+        return 0;
+    }
+
+    /// @brief Advances the cursor by the given number of bytes.
+    /// @param[in] size the number of bytes to skip
+    void Skip(uint64 size) {
+        if (!m_ok || m_data.size() - m_offset < size) {
+            m_ok = false;
+            return;
+        }
+        m_offset += size;
+    }
+
+    /// @brief Determines if all reads so far were within bounds.
+    bool IsOK() const {
+        return m_ok;
+    }
+
+    /// @brief Determines if the cursor is at the end of the data.
+    bool AtEnd() const {
+        return m_offset == m_data.size();
+    }
+
+    /// @brief Retrieves the current position of the cursor.
+    uint64 Offset() const {
+        return m_offset;
+    }
+
+private:
+    std::span<const uint8> m_data;
+    uint64 m_offset;
+    bool m_ok;
+};
+
+} // namespace util
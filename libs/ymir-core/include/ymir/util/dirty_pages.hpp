@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+@file
+@brief Defines `util::DirtyPageTracker`, a set of flags tracking modified pages of a memory region.
+*/
+
+#include <ymir/core/types.hpp>
+
+#include "inline.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace util {
+
+/// @brief Default size of a page tracked by `util::DirtyPageTracker`.
+inline constexpr size_t kDirtyPageSize = 4096;
+
+/// @brief Tracks which pages of a memory region have been modified.
+///
+/// Each page has a byte flag that is set when any byte of the page is written to. Flags are set with relaxed atomic
+/// stores, which compile down to plain byte stores, so pages may be marked from multiple threads.
+///
+/// All pages start out marked as dirty.
+///
+/// @tparam kSize the size of the memory region in bytes
+/// @tparam kPageSize the size of a page in bytes
+template <size_t kSize, size_t kPageSize = kDirtyPageSize>
+class DirtyPageTracker {
+public:
+    static constexpr size_t kPageCount = (kSize + kPageSize - 1) / kPageSize;
+
+    DirtyPageTracker() {
+        MarkAll();
+    }
+
+    /// @brief Marks the page containing the specified offset as dirty.
+    /// @param[in] offset the offset into the memory region
+    FORCE_INLINE void Mark(size_t offset) {
+        m_flags[offset / kPageSize].store(1, std::memory_order_relaxed);
+    }
+
+    /// @brief Marks all pages overlapping the specified range as dirty.
+    /// @param[in] offset the offset into the memory region
+    /// @param[in] length the length of the range in bytes
+    void MarkRange(size_t offset, size_t length) {
+        if (length == 0) {
+            return;
+        }
+        const size_t lastPage = (offset + length - 1) / kPageSize;
+        for (size_t page = offset / kPageSize; page <= lastPage; ++page) {
+            m_flags[page].store(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Marks all pages as dirty.
+    void MarkAll() {
+        for (auto &flag : m_flags) {
+            flag.store(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Marks all pages as clean.
+    void ClearAll() {
+        for (auto &flag : m_flags) {
+            flag.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Determines if the specified page is dirty.
+    /// @param[in] page the page index
+    /// @return `true` if the page has been modified since it was last cleared
+    [[nodiscard]] FORCE_INLINE bool IsDirty(size_t page) const {
+        return m_flags[page].load(std::memory_order_relaxed) != 0;
+    }
+
+    /// @brief Invokes `fn(page)` for every dirty page in ascending order, clearing the flags of visited pages.
+    /// @tparam Fn the type of the function to invoke
+    /// @param[in] fn the function to invoke for each dirty page
+    template <typename Fn>
+    void ConsumeDirtyPages(Fn &&fn) {
+        for (size_t page = 0; page < kPageCount; ++page) {
+            if (m_flags[page].load(std::memory_order_relaxed) != 0) {
+                m_flags[page].store(0, std::memory_order_relaxed);
+                fn(page);
+            }
+        }
+    }
+
+    /// @brief Retrieves a pointer to the flag of the specified page.
+    ///
+    /// Writing a nonzero value to the flag marks the page as dirty.
+    ///
+    /// @param[in] page the page index
+    /// @return a pointer to the page's flag
+    std::atomic<uint8> *GetFlag(size_t page) {
+        return &m_flags[page];
+    }
+
+private:
+    std::array<std::atomic<uint8>, kPageCount> m_flags;
+};
+
+} // namespace util
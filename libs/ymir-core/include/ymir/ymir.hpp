@@ -7,6 +7,7 @@
 
 #include <ymir/version.hpp>
 
+#include <ymir/sys/asset_registry.hpp>
 #include <ymir/sys/saturn.hpp>
 
 #include <ymir/media/loader/loader.hpp>
@@ -9,6 +9,35 @@ void Configuration::NotifyObservers() {
 
     audio.interpolation.Notify();
     audio.threadedSCSP.Notify();
+    audio.vectorizedMixing.Notify();
+    audio.outputSampleRate.Notify();
+    audio.cddaBufferLatency.Notify();
+
+    cdblock.sectorPrefetch.Notify();
+}
+
+void Configuration::CopyFrom(const Configuration &other) {
+    system.autodetectRegion = other.system.autodetectRegion;
+    system.preferredRegionOrder = *other.system.preferredRegionOrder;
+    system.videoStandard = other.system.videoStandard.Get();
+    system.emulateSH2Cache = other.system.emulateSH2Cache.Get();
+
+    rtc.mode = other.rtc.mode.Get();
+    rtc.virtHardResetStrategy = other.rtc.virtHardResetStrategy;
+    rtc.virtHardResetTimestamp = other.rtc.virtHardResetTimestamp;
+
+    video.threadedVDP = other.video.threadedVDP.Get();
+    video.threadedDeinterlacer = other.video.threadedDeinterlacer.Get();
+    video.includeVDP1InRenderThread = other.video.includeVDP1InRenderThread.Get();
+
+    audio.interpolation = other.audio.interpolation.Get();
+    audio.threadedSCSP = other.audio.threadedSCSP.Get();
+    audio.vectorizedMixing = other.audio.vectorizedMixing.Get();
+    audio.outputSampleRate = other.audio.outputSampleRate.Get();
+    audio.cddaBufferLatency = other.audio.cddaBufferLatency.Get();
+
+    cdblock.readSpeedFactor = other.cdblock.readSpeedFactor.Get();
+    cdblock.sectorPrefetch = other.cdblock.sectorPrefetch.Get();
 }
 
 } // namespace ymir::core
@@ -11,6 +11,12 @@
 #include <cassert>
 #include <utility>
 
+#if defined(_M_X64) || defined(__x86_64__)
+    #include <immintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
 namespace ymir::cdblock {
 
 // -----------------------------------------------------------------------------
@@ -37,6 +43,85 @@ static uint32 CalcPutOffset(uint32 size) {
     return std::min(2352u - size, 24u);
 }
 
+// Copies count big-endian 16-bit words from src into dst, converting them to native byte order.
+static void CopyWordsBE(uint16 *dst, const uint8 *src, size_t count) {
+    size_t i = 0;
+#if defined(_M_X64) || defined(__x86_64__)
+    #if defined(__AVX2__)
+    for (; i + 16 <= count; i += 16) {
+        const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&src[i * 2]));
+        const __m256i swapped = _mm256_or_si256(_mm256_slli_epi16(words, 8), _mm256_srli_epi16(words, 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(&dst[i]), swapped);
+    }
+    #endif
+    for (; i + 8 <= count; i += 8) {
+        const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[i * 2]));
+        const __m128i swapped = _mm_or_si128(_mm_slli_epi16(words, 8), _mm_srli_epi16(words, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[i]), swapped);
+    }
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    for (; i + 8 <= count; i += 8) {
+        const uint8x16_t words = vld1q_u8(&src[i * 2]);
+        vst1q_u8(reinterpret_cast<uint8 *>(&dst[i]), vrev16q_u8(words));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = util::ReadBE<uint16>(&src[i * 2]);
+    }
+}
+
+// Converts a sector of CDDA samples to little-endian in place, optionally attenuating them by 12 dB.
+static void ConvertCDDASector(std::span<uint8, 2352> data, bool bigEndian, bool attenuate) {
+    if (!bigEndian && !attenuate) {
+        return;
+    }
+
+    size_t offset = 0;
+#if defined(_M_X64) || defined(__x86_64__)
+    #if defined(__AVX2__)
+    for (; offset + 32 <= data.size(); offset += 32) {
+        __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&data[offset]));
+        if (bigEndian) {
+            samples = _mm256_or_si256(_mm256_slli_epi16(samples, 8), _mm256_srli_epi16(samples, 8));
+        }
+        if (attenuate) {
+            samples = _mm256_srai_epi16(samples, 2);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(&data[offset]), samples);
+    }
+    #endif
+    for (; offset + 16 <= data.size(); offset += 16) {
+        __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&data[offset]));
+        if (bigEndian) {
+            samples = _mm_or_si128(_mm_slli_epi16(samples, 8), _mm_srli_epi16(samples, 8));
+        }
+        if (attenuate) {
+            samples = _mm_srai_epi16(samples, 2);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&data[offset]), samples);
+    }
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    for (; offset + 16 <= data.size(); offset += 16) {
+        uint8x16_t bytes = vld1q_u8(&data[offset]);
+        if (bigEndian) {
+            bytes = vrev16q_u8(bytes);
+        }
+        if (attenuate) {
+            bytes = vreinterpretq_u8_s16(vshrq_n_s16(vreinterpretq_s16_u8(bytes), 2));
+        }
+        vst1q_u8(&data[offset], bytes);
+    }
+#endif
+    for (; offset < data.size(); offset += 2) {
+        sint16 sample = static_cast<sint16>(bigEndian ? util::ReadBE<uint16>(&data[offset])
+                                                      : util::ReadLE<uint16>(&data[offset]));
+        if (attenuate) {
+            sample >>= 2;
+        }
+        util::WriteLE<sint16>(&data[offset], sample);
+    }
+}
+
 // -----------------------------------------------------------------------------
 // Implementation
 
@@ -58,6 +143,8 @@ CDBlock::CDBlock(core::Scheduler &scheduler, core::Configuration::CDBlock &confi
     });
     m_readSpeedFactor = 2;
 
+    config.sectorPrefetch.Observe(m_sectorPrefetch);
+
     for (int i = 0; auto &filter : m_filters) {
         filter.index = i;
         i++;
@@ -72,6 +159,8 @@ void CDBlock::Reset(bool hard) {
     m_CR[2] = 0x4C4F; // 'LO'
     m_CR[3] = 0x434B; // 'CK'
 
+    m_prefetcher.Stop();
+
     m_status.statusCode = kStatusCodePause;
     m_status.frameAddress = 0xFFFFFF;
     m_status.flags = 0xF;
@@ -161,6 +250,12 @@ void CDBlock::MapMemory(sys::Bus &bus) {
             [](uint32 address, uint32 value, void *ctx) {
                 cast(ctx).WriteReg<uint16>(address + 0, value >> 16u);
                 cast(ctx).WriteReg<uint16>(address + 2, value >> 0u);
+            },
+            [](uint32 address, uint16 *out, uint32 count, void *ctx) {
+                return cast(ctx).ReadRegBlock<uint16>(address, out, count);
+            },
+            [](uint32 address, uint32 *out, uint32 count, void *ctx) {
+                return cast(ctx).ReadRegBlock<uint32>(address, out, count);
             });
 
         bus.MapSideEffectFree(
@@ -181,7 +276,10 @@ void CDBlock::UpdateClockRatios(const sys::ClockRatios &clockRatios) {
 }
 
 void CDBlock::LoadDisc(media::Disc &&disc) {
-    m_disc.Swap(std::move(disc));
+    {
+        auto lock = m_prefetcher.LockDisc();
+        m_disc.Swap(std::move(disc));
+    }
 
     const uint8 status = GetStatusCode();
     if (status == kStatusCodeNoDisc || status == kStatusCodeOpen || status == kStatusCodePlay ||
@@ -201,9 +299,20 @@ void CDBlock::LoadDisc(media::Disc &&disc) {
     }
 }
 
+void CDBlock::LoadDiscFrom(const CDBlock &other) {
+    {
+        auto lock = m_prefetcher.LockDisc();
+        m_disc = other.m_disc.Clone();
+    }
+    m_fs = other.m_fs;
+}
+
 void CDBlock::EjectDisc() {
     if (!m_disc.sessions.empty()) {
-        m_disc = {};
+        {
+            auto lock = m_prefetcher.LockDisc();
+            m_disc = {};
+        }
 
         m_status.statusCode = kStatusCodeNoDisc;
         m_status.frameAddress = 0xFFFFFF;
@@ -262,6 +371,15 @@ XXH128Hash CDBlock::GetDiscHash() const {
 }
 
 void CDBlock::SaveState(state::CDBlockState &state) const {
+    SaveStateImpl<false>(state, nullptr);
+}
+
+void CDBlock::SaveStateIncremental(state::CDBlockState &state, state::DirtyPages &dirty) {
+    SaveStateImpl<true>(state, &dirty);
+}
+
+template <bool incremental>
+void CDBlock::SaveStateImpl(state::CDBlockState &state, state::DirtyPages *dirty) const {
     state.discHash = m_fs.GetHash();
 
     state.CR = m_CR;
@@ -330,13 +448,13 @@ void CDBlock::SaveState(state::CDBlockState &state) const {
 
     state.xferExtraCount = m_xferExtraCount;
 
-    // Store partition buffers first, then scratch buffers.
-    // Since there are always 200 buffers (and one extra scratch buffer), we can use the free buffer count to determine
-    // both how many scratch buffers to write and where to begin writing them.
-
-    // Clear all buffers first
-    for (auto &buffer : state.buffers) {
-        buffer.data.fill(0);
+    // Buffers are stored at their pool index; the scratch buffer goes at the end.
+    // Clear all buffers first. Incremental saves only touch the data of buffers that changed since the last save.
+    for (uint32 i = 0; i < kNumBuffers; i++) {
+        auto &buffer = state.buffers[i];
+        if (!incremental || m_partitionManager.IsBufferDirty(i)) {
+            buffer.data.fill(0);
+        }
         buffer.size = 0;
         buffer.frameAddress = 0;
         buffer.fileNum = 0;
@@ -344,24 +462,26 @@ void CDBlock::SaveState(state::CDBlockState &state) const {
         buffer.submode = 0;
         buffer.codingInfo = 0;
         buffer.partitionIndex = 0xFF;
+        buffer.next = 0xFF;
     }
 
-    // Write partition buffers
-    m_partitionManager.SaveState(state);
+    // Write partition and reserved buffers
+    m_partitionManager.SaveState<incremental>(state, dirty);
 
-    // Write scratch buffers after partition buffers
-    const uint32 basePos = kNumBuffers - m_partitionManager.GetFreeBufferCount();
-    uint32 pos = basePos;
-    while (pos < kNumBuffers + 1) {
-        auto &scratchBuffer = m_scratchBuffers[pos - basePos];
-        state.buffers[pos].data = scratchBuffer.data;
-        state.buffers[pos].size = scratchBuffer.size;
-        state.buffers[pos].frameAddress = scratchBuffer.frameAddress;
-        state.buffers[pos].fileNum = scratchBuffer.subheader.fileNum;
-        state.buffers[pos].chanNum = scratchBuffer.subheader.chanNum;
-        state.buffers[pos].submode = scratchBuffer.subheader.submode;
-        state.buffers[pos].codingInfo = scratchBuffer.subheader.codingInfo;
-        ++pos;
+    // Write scratch buffer
+    auto &scratchBuffer = state.buffers[kNumBuffers];
+    scratchBuffer.data = m_scratchBuffer.data;
+    scratchBuffer.size = m_scratchBuffer.size;
+    scratchBuffer.frameAddress = m_scratchBuffer.frameAddress;
+    scratchBuffer.fileNum = m_scratchBuffer.subheader.fileNum;
+    scratchBuffer.chanNum = m_scratchBuffer.subheader.chanNum;
+    scratchBuffer.submode = m_scratchBuffer.subheader.submode;
+    scratchBuffer.codingInfo = m_scratchBuffer.subheader.codingInfo;
+    scratchBuffer.partitionIndex = 0xFF;
+    scratchBuffer.next = 0xFF;
+    if constexpr (incremental) {
+        // The scratch buffer is overwritten by nearly every drive read, so it's always reported as modified
+        (*dirty)[state::MemoryRegion::CDBlockBuffers].push_back(kNumBuffers);
     }
 
     state.scratchBufferPutIndex = m_scratchBufferPutIndex;
@@ -443,6 +563,13 @@ void CDBlock::LoadState(const state::CDBlockState &state) {
     m_bufferFullPause = state.bufferFullPause;
     m_playEndPending = state.playEndPending;
 
+    // Restart read-ahead from the restored drive position
+    if (m_status.statusCode == kStatusCodePlay || m_status.statusCode == kStatusCodeSeek) {
+        StartPrefetch(m_status.frameAddress, m_playEndPos);
+    } else {
+        m_prefetcher.Stop();
+    }
+
     m_readSpeed = state.readSpeed;
 
     m_discAuthStatus = state.discAuthStatus;
@@ -477,21 +604,16 @@ void CDBlock::LoadState(const state::CDBlockState &state) {
 
     m_xferExtraCount = state.xferExtraCount;
 
-    // Read partition buffers followed by scratch buffers
+    // Read partition and reserved buffers, then the scratch buffer
     m_partitionManager.LoadState(state);
-    const uint32 basePos = kNumBuffers - m_partitionManager.GetFreeBufferCount();
-    uint32 pos = basePos;
-    while (pos < kNumBuffers + 1) {
-        auto &scratchBuffer = m_scratchBuffers[pos - basePos];
-        scratchBuffer.data = state.buffers[pos].data;
-        scratchBuffer.size = state.buffers[pos].size;
-        scratchBuffer.frameAddress = state.buffers[pos].frameAddress;
-        scratchBuffer.subheader.fileNum = state.buffers[pos].fileNum;
-        scratchBuffer.subheader.chanNum = state.buffers[pos].chanNum;
-        scratchBuffer.subheader.submode = state.buffers[pos].submode;
-        scratchBuffer.subheader.codingInfo = state.buffers[pos].codingInfo;
-        ++pos;
-    }
+    const auto &scratchBuffer = state.buffers[kNumBuffers];
+    m_scratchBuffer.data = scratchBuffer.data;
+    m_scratchBuffer.size = scratchBuffer.size;
+    m_scratchBuffer.frameAddress = scratchBuffer.frameAddress;
+    m_scratchBuffer.subheader.fileNum = scratchBuffer.fileNum;
+    m_scratchBuffer.subheader.chanNum = scratchBuffer.chanNum;
+    m_scratchBuffer.subheader.submode = scratchBuffer.submode;
+    m_scratchBuffer.subheader.codingInfo = scratchBuffer.codingInfo;
 
     m_scratchBufferPutIndex = state.scratchBufferPutIndex;
 
@@ -660,6 +782,36 @@ void CDBlock::PokeReg(uint32 address, T value) {
     }
 }
 
+template <mem_primitive T>
+bool CDBlock::ReadRegBlock(uint32 address, T *out, uint32 count) {
+    // Only the data transfer register can be read in blocks.
+    // 32-bit reads are aligned to 0x00 and read both halves of the register.
+    if ((address & 0x3F) > 0x02) {
+        return false;
+    }
+
+    if constexpr (std::is_same_v<T, uint16>) {
+        return DoReadTransferBlock(out, count);
+    } else if constexpr (std::is_same_v<T, uint32>) {
+        std::array<uint16, 256> words;
+        while (count > 0) {
+            const uint32 chunkSize = std::min<uint32>(count, words.size() / 2);
+            if (!DoReadTransferBlock(words.data(), chunkSize * 2)) {
+                // Can only happen on the first chunk since the transfer type doesn't change mid-transfer
+                return false;
+            }
+            for (uint32 i = 0; i < chunkSize; ++i) {
+                out[i] = (words[i * 2 + 0] << 16u) | words[i * 2 + 1];
+            }
+            out += chunkSize;
+            count -= chunkSize;
+        }
+        return true;
+    } else {
+        return false;
+    }
+}
+
 bool CDBlock::SetupGenericPlayback(uint32 startParam, uint32 endParam, uint16 repeatParam) {
     // Handle "no change" parameters
     const bool keepEndParam = endParam == 0xFFFFFF;
@@ -743,6 +895,8 @@ bool CDBlock::SetupGenericPlayback(uint32 startParam, uint32 endParam, uint16 re
             } else {
                 m_status.frameAddress = frameAddress;
             }
+            StartPrefetch(m_status.frameAddress, m_playEndPos);
+            m_cbCDDAPlaybackStart();
         } else {
             m_targetDriveCycles = kDriveCyclesNotPlaying;
             m_status.statusCode = kStatusCodePause;
@@ -825,6 +979,8 @@ bool CDBlock::SetupGenericPlayback(uint32 startParam, uint32 endParam, uint16 re
             } else {
                 m_status.frameAddress = frameAddress;
             }
+            StartPrefetch(m_status.frameAddress, m_playEndPos);
+            m_cbCDDAPlaybackStart();
         } else {
             // The disc image is truncated or corrupted
             // Let's pretend this is a disc read error
@@ -904,9 +1060,18 @@ bool CDBlock::SetupFilePlayback(uint32 fileID, uint32 offset, uint8 filterNumber
 
     devlog::debug<grp::play_init>("Read file {} (ID {}), offset {}, filter {}, frame addresses {:06X} to {:06X}",
                                   fileInfo.name, fileID, offset, filterNumber, m_playStartPos, m_playEndPos);
+    StartPrefetch(m_playStartPos, m_playEndPos);
     return true;
 }
 
+void CDBlock::StartPrefetch(uint32 startFrameAddress, uint32 endFrameAddress) {
+    if (m_prefetcher.IsEnabled() != m_sectorPrefetch) {
+        devlog::debug<grp::base>("{} sector prefetching", (m_sectorPrefetch ? "Enabling" : "Disabling"));
+        m_prefetcher.SetEnabled(m_sectorPrefetch);
+    }
+    m_prefetcher.Start(startFrameAddress, endFrameAddress);
+}
+
 bool CDBlock::SetupScan(uint8 direction) {
     if (direction >= 2) {
         return false;
@@ -992,39 +1157,28 @@ void CDBlock::ProcessDriveStatePlay() {
             const media::Session &session = m_disc.sessions.back();
             const media::Track *track = session.FindTrack(frameAddress);
 
-            Buffer &buffer = m_scratchBuffers[0];
+            Buffer &buffer = m_scratchBuffer;
 
             // Sanity check: is the track valid?
-            if (track != nullptr && track->ReadSector(frameAddress, buffer.data)) [[likely]] {
+            if (track != nullptr && m_prefetcher.ReadSector(*track, frameAddress, buffer.data, buffer.subheader))
+                [[likely]] {
                 devlog::trace<grp::play>("Read {} bytes from frame address {:06X}", track->sectorSize, frameAddress);
 
                 if (track->controlADR == 0x01) {
-                    // If playing an audio track, send to SCSP
-                    if (track->bigEndian) {
-                        // Swap endianness if necessary
-                        for (uint32 offset = 0; offset < 2352; offset += 2) {
-                            util::WriteLE<uint16>(&buffer.data[offset], util::ReadBE<uint16>(&buffer.data[offset]));
-                        }
-                    }
+                    // If playing an audio track, convert to little-endian samples and send to SCSP.
+                    // While scanning, lower volume by 12 dB.
+                    ConvertCDDASector(buffer.data, track->bigEndian, scan);
 
-                    if (scan) {
-                        // While scanning, lower volume by 12 dB
-                        for (uint32 offset = 0; offset < 2352; offset += 2) {
-                            util::WriteLE<sint16>(&buffer.data[offset],
-                                                  util::ReadLE<sint16>(&buffer.data[offset]) >> 2u);
-                        }
-                    }
-
-                    // The callback returns how many thirds of the buffer are full
-                    const uint32 currBufferLength =
+                    // The callback returns a pacing hint based on how full the SCSP CDDA buffer is
+                    const uint32 pacing =
                         m_cbCDDASector(std::span<uint8, 2352>(buffer.data.begin(), buffer.data.end()));
 
                     // Adjust pace based on how full the SCSP CDDA buffer is
-                    if (currBufferLength < 1) {
-                        // Run faster if the buffer is less than a third full
+                    if (pacing < 1) {
+                        // Run faster if the buffer is below the latency target
                         m_targetDriveCycles = kDriveCyclesPlaying1x - (kDriveCyclesPlaying1x >> 2);
-                    } else if (currBufferLength >= 2) {
-                        // Run slower if the buffer is more than two-thirds full
+                    } else if (pacing >= 2) {
+                        // Run slower if the buffer is well above the latency target
                         m_targetDriveCycles = kDriveCyclesPlaying1x + (kDriveCyclesPlaying1x >> 2);
                     } else {
                         // Normal speed otherwise
@@ -1043,34 +1197,13 @@ void CDBlock::ProcessDriveStatePlay() {
                 } else {
                     buffer.size = m_getSectorLength;
                     buffer.frameAddress = frameAddress;
-                    track->ReadSectorSubheader(frameAddress, buffer.subheader);
 
                     // Check against CD device filter and send data to the appropriate destination
-                    uint8 filterNum = m_cdDeviceConnection;
-                    for (int i = 0; i < kNumFilters && filterNum != Filter::kDisconnected; i++) {
-                        const Filter &filter = m_filters[filterNum];
-                        if (filter.Test(buffer)) {
-                            if (filter.passOutput == Filter::kDisconnected) [[unlikely]] {
-                                devlog::trace<grp::play>("Passed filter; output disconnected - discarded");
-                            } else {
-                                assert(filter.passOutput < m_filters.size());
-                                devlog::trace<grp::play>("Passed filter; sent to buffer partition {}",
-                                                         filter.passOutput);
-                                m_partitionManager.InsertHead(filter.passOutput, buffer);
-                                m_lastCDWritePartition = filter.passOutput;
-                                SetInterrupt(kHIRQ_CSCT);
-                            }
-                            break;
-                        } else {
-                            if (filter.failOutput == Filter::kDisconnected) [[unlikely]] {
-                                devlog::trace<grp::play>("Filtered out; output disconnected - discarded");
-                                break;
-                            } else {
-                                assert(filter.failOutput < m_filters.size());
-                                devlog::trace<grp::play>("Filtered out; sent to filter {}", filter.failOutput);
-                                filterNum = filter.failOutput;
-                            }
-                        }
+                    const uint8 partitionNum = RouteSector(m_cdDeviceConnection, buffer);
+                    if (partitionNum != Filter::kDisconnected) {
+                        m_partitionManager.InsertHead(partitionNum, buffer);
+                        m_lastCDWritePartition = partitionNum;
+                        SetInterrupt(kHIRQ_CSCT);
                     }
                 }
 
@@ -1127,6 +1260,7 @@ void CDBlock::ProcessDriveStatePlay() {
             }
             m_status.frameAddress = m_playStartPos;
             m_status.repeatCount++;
+            StartPrefetch(m_playStartPos, m_playEndPos);
         } else {
             devlog::debug<grp::play>("Playback ended");
             m_playEndPending = true;
@@ -1278,9 +1412,9 @@ void CDBlock::SetupPutSectorTransfer(uint16 sectorCount, uint8 partitionNumber)
 
     m_scratchBufferPutIndex = 0;
 
-    // Prepare sectors in scratch area
+    // Prepare reserved sectors
     for (uint32 i = 0; i < sectorCount; ++i) {
-        auto &buffer = m_scratchBuffers[i];
+        Buffer &buffer = *m_partitionManager.GetReservedBuffer(i);
         buffer.frameAddress = 0;
         buffer.size = m_putSectorLength;
         buffer.subheader.fileNum = 0;
@@ -1431,9 +1565,7 @@ void CDBlock::ReadSector() {
         const uint32 limit = mode1 ? 16u : 24u;
         const uint32 offset = std::min(2352u - getLength, limit);
 
-        for (size_t i = 0; i < getLength; i += sizeof(uint16)) {
-            m_xferBuffer[i / sizeof(uint16)] = util::ReadBE<uint16>(&buffer->data[i + offset]);
-        }
+        CopyWordsBE(m_xferBuffer.data(), &buffer->data[offset], getLength / sizeof(uint16));
         m_xferGetLength = getLength;
 
         // Extend total transfer length if the current sector length was extended
@@ -1486,6 +1618,34 @@ uint16 CDBlock::DoReadTransfer() {
     return value;
 }
 
+bool CDBlock::DoReadTransferBlock(uint16 *out, uint32 count) {
+    // Only sector transfers are worth optimizing; everything else goes through the regular path
+    if (m_xferType != TransferType::GetSector && m_xferType != TransferType::GetThenDeleteSector) {
+        return false;
+    }
+
+    while (count > 0) {
+        const uint32 sectorWords = std::min<uint32>(m_xferGetLength / sizeof(uint16), m_xferBuffer.size());
+
+        // Copy the run of words that ends before the last word of the sector or the end of the transfer.
+        // The last word of each sector goes through DoReadTransfer() to load the next sector.
+        if (m_xferPos < m_xferLength && m_xferBufferPos + 1 < sectorWords) {
+            const uint32 run = std::min({count, sectorWords - m_xferBufferPos - 1, m_xferLength - m_xferPos});
+            std::copy_n(&m_xferBuffer[m_xferBufferPos], run, out);
+            m_xferBufferPos += run;
+            out += run;
+            count -= run;
+            AdvanceTransfer(run);
+            if (count == 0) {
+                break;
+            }
+        }
+        *out++ = DoReadTransfer();
+        --count;
+    }
+    return true;
+}
+
 void CDBlock::DoWriteTransfer(uint16 value) {
     if (m_xferPos >= m_xferLength) {
         return;
@@ -1493,8 +1653,8 @@ void CDBlock::DoWriteTransfer(uint16 value) {
 
     switch (m_xferType) {
     case TransferType::PutSector:
-        if (m_scratchBufferPutIndex < m_scratchBuffers.size()) {
-            auto &buffer = m_scratchBuffers[m_scratchBufferPutIndex];
+        if (Buffer *pBuffer = m_partitionManager.GetReservedBuffer(m_scratchBufferPutIndex)) {
+            Buffer &buffer = *pBuffer;
             if (m_xferBufferPos < m_putSectorLength) {
                 const uint32 writePos = m_xferBufferPos + m_putOffset;
                 util::WriteBE<uint16>(&buffer.data[writePos], value);
@@ -1524,9 +1684,9 @@ void CDBlock::DoWriteTransfer(uint16 value) {
     AdvanceTransfer();
 }
 
-void CDBlock::AdvanceTransfer() {
-    m_xferPos++;
-    m_xferCount++;
+void CDBlock::AdvanceTransfer(uint32 count) {
+    m_xferPos += count;
+    m_xferCount += count;
     if (m_xferPos >= m_xferLength) {
         devlog::trace<grp::xfer>("Transfer finished - {} of {} words transferred", m_xferCount, m_xferLength);
     }
@@ -1557,10 +1717,7 @@ void CDBlock::EndTransfer() {
     case TransferType::PutSector: //
     {
         const uint32 sectorCount = m_xferLength * sizeof(uint16) / m_putSectorLength;
-        if (m_partitionManager.UseReservedBuffers(sectorCount)) {
-            for (uint32 i = 0; i < sectorCount; ++i) {
-                m_partitionManager.InsertHead(m_xferPartition, m_scratchBuffers[i]);
-            }
+        if (m_partitionManager.UseReservedBuffers(m_xferPartition, sectorCount)) {
             devlog::trace<grp::xfer>("Sector sent to partition {}", m_xferPartition);
         } else {
             devlog::trace<grp::xfer>("Not enough room to write sector");
@@ -1613,6 +1770,29 @@ void CDBlock::DisconnectFilterInput(uint8 filterNumber) {
     }
 }
 
+uint8 CDBlock::RouteSector(uint8 filterNumber, const Buffer &buffer) const {
+    for (int i = 0; i < kNumFilters && filterNumber != Filter::kDisconnected; i++) {
+        const Filter &filter = m_filters[filterNumber];
+        if (filter.Test(buffer)) {
+            if (filter.passOutput == Filter::kDisconnected) [[unlikely]] {
+                devlog::trace<grp::play>("Passed filter; output disconnected - discarded");
+            } else {
+                assert(filter.passOutput < kNumPartitions);
+                devlog::trace<grp::play>("Passed filter; sent to buffer partition {}", filter.passOutput);
+            }
+            return filter.passOutput;
+        }
+        if (filter.failOutput == Filter::kDisconnected) [[unlikely]] {
+            devlog::trace<grp::play>("Filtered out; output disconnected - discarded");
+            break;
+        }
+        assert(filter.failOutput < m_filters.size());
+        devlog::trace<grp::play>("Filtered out; sent to filter {}", filter.failOutput);
+        filterNumber = filter.failOutput;
+    }
+    return Filter::kDisconnected;
+}
+
 void CDBlock::SetupCommand() {
     m_scheduler.ScheduleFromNow(m_commandExecEvent, 50);
 }
@@ -1659,8 +1839,8 @@ FORCE_INLINE void CDBlock::ProcessCommand() {
     case 0x62: CmdDeleteSectorData(); break;
     case 0x63: CmdGetThenDeleteSectorData(); break;
     case 0x64: CmdPutSectorData(); break;
-    // case 0x65: CmdCopySectorData(); break;
-    // case 0x66: CmdMoveSectorData(); break;
+    case 0x65: CmdCopySectorData(); break;
+    case 0x66: CmdMoveSectorData(); break;
     case 0x67: CmdGetCopyError(); break;
     case 0x70: CmdChangeDirectory(); break;
     case 0x71: CmdReadDirectory(); break;
@@ -2920,20 +3100,48 @@ void CDBlock::CmdCopySectorData() {
     // sector offset
     // source partition number   <blank>
     // sector number
-    // const uint8 dstPartitionNumber = bit::extract<0, 7>(m_CR[0]);
-    // const uint16 sectorOffset = m_CR[1];
-    // const uint8 srcPartitionNumber = bit::extract<8, 15>(m_CR[2]);
-    // const uint16 sectorNumber = m_CR[3];
-
-    // TODO: setup async sector copy transfer
-    // TODO: report Reject status if not enough buffer space available
-    devlog::info<grp::base>("Copy sector data command is unimplemented");
-    YMIR_DEV_CHECK();
+    const uint8 dstFilterNumber = bit::extract<0, 7>(m_CR[0]);
+    const uint16 sectorOffset = m_CR[1];
+    const uint8 srcPartitionNumber = bit::extract<8, 15>(m_CR[2]);
+    const uint16 sectorNumber = m_CR[3];
 
-    // Output structure: standard CD status data
-    ReportCDStatus();
+    // The copy is performed immediately instead of completing in the background
+    bool reject = false;
+    if (dstFilterNumber >= kNumFilters || srcPartitionNumber >= kNumPartitions) [[unlikely]] {
+        devlog::trace<grp::base>("Copy sector data rejected: invalid partition {} or filter {}", srcPartitionNumber,
+                                 dstFilterNumber);
+        reject = true;
+    } else if (m_partitionManager.CountSectors(srcPartitionNumber, sectorOffset, sectorNumber) >
+               m_partitionManager.GetFreeBufferCount()) [[unlikely]] {
+        devlog::trace<grp::base>("Copy sector data rejected: not enough free buffers available");
+        reject = true;
+    } else {
+        // Send each sector through the destination filter; copies are appended to the end of their partitions, so the
+        // positions of the remaining source sectors are unaffected
+        const uint32 count = m_partitionManager.CountSectors(srcPartitionNumber, sectorOffset, sectorNumber);
+        const uint16 start = sectorOffset == 0xFFFF ? m_partitionManager.GetBufferCount(srcPartitionNumber) - 1
+                                                    : sectorOffset;
+        uint32 copied = 0;
+        for (uint32 i = 0; i < count; i++) {
+            const uint16 pos = start + i;
+            const uint8 dstPartitionNumber =
+                RouteSector(dstFilterNumber, *m_partitionManager.GetTail(srcPartitionNumber, pos));
+            if (dstPartitionNumber != Filter::kDisconnected) {
+                copied += m_partitionManager.CopySectors(dstPartitionNumber, srcPartitionNumber, pos, 1);
+            }
+        }
+        devlog::trace<grp::base>("Copied {} of {} sectors from partition {} through filter {}", copied, count,
+                                 srcPartitionNumber, dstFilterNumber);
+    }
 
-    SetInterrupt(kHIRQ_CMOK | kHIRQ_ECPY);
+    // Output structure: standard CD status data
+    if (reject) [[unlikely]] {
+        ReportCDStatus(kStatusReject);
+        SetInterrupt(kHIRQ_CMOK);
+    } else {
+        ReportCDStatus();
+        SetInterrupt(kHIRQ_CMOK | kHIRQ_ECPY);
+    }
 }
 
 void CDBlock::CmdMoveSectorData() {
@@ -2944,19 +3152,45 @@ void CDBlock::CmdMoveSectorData() {
     // sector offset
     // source partition number   <blank>
     // sector number
-    // const uint8 dstPartitionNumber = bit::extract<0, 7>(m_CR[0]);
-    // const uint16 sectorOffset = m_CR[1];
-    // const uint8 srcPartitionNumber = bit::extract<8, 15>(m_CR[2]);
-    // const uint16 sectorNumber = m_CR[3];
+    const uint8 dstFilterNumber = bit::extract<0, 7>(m_CR[0]);
+    const uint16 sectorOffset = m_CR[1];
+    const uint8 srcPartitionNumber = bit::extract<8, 15>(m_CR[2]);
+    const uint16 sectorNumber = m_CR[3];
 
-    // TODO: setup async sector move transfer
-    devlog::info<grp::base>("Move sector data command is unimplemented");
-    YMIR_DEV_CHECK();
+    // The move is performed immediately instead of completing in the background
+    bool reject = false;
+    if (dstFilterNumber >= kNumFilters || srcPartitionNumber >= kNumPartitions) [[unlikely]] {
+        devlog::trace<grp::base>("Move sector data rejected: invalid partition {} or filter {}", srcPartitionNumber,
+                                 dstFilterNumber);
+        reject = true;
+    } else {
+        // Send each sector through the destination filter. Moving sectors only relinks the buffers; no sector data is
+        // copied. Sectors discarded by the filters are freed. Either way, the next sector takes its place.
+        const uint32 count = m_partitionManager.CountSectors(srcPartitionNumber, sectorOffset, sectorNumber);
+        const uint16 pos = sectorOffset == 0xFFFF ? m_partitionManager.GetBufferCount(srcPartitionNumber) - 1
+                                                  : sectorOffset;
+        uint32 moved = 0;
+        for (uint32 i = 0; i < count; i++) {
+            const uint8 dstPartitionNumber =
+                RouteSector(dstFilterNumber, *m_partitionManager.GetTail(srcPartitionNumber, pos));
+            if (dstPartitionNumber != Filter::kDisconnected) {
+                moved += m_partitionManager.MoveSectors(dstPartitionNumber, srcPartitionNumber, pos, 1);
+            } else {
+                m_partitionManager.DeleteSectors(srcPartitionNumber, pos, 1);
+            }
+        }
+        devlog::trace<grp::base>("Moved {} of {} sectors from partition {} through filter {}", moved, count,
+                                 srcPartitionNumber, dstFilterNumber);
+    }
 
     // Output structure: standard CD status data
-    ReportCDStatus();
-
-    SetInterrupt(kHIRQ_CMOK | kHIRQ_ECPY);
+    if (reject) [[unlikely]] {
+        ReportCDStatus(kStatusReject);
+        SetInterrupt(kHIRQ_CMOK);
+    } else {
+        ReportCDStatus();
+        SetInterrupt(kHIRQ_CMOK | kHIRQ_ECPY);
+    }
 }
 
 void CDBlock::CmdGetCopyError() {
@@ -3328,6 +3562,14 @@ std::string CDBlock::Probe::GetPathAtFrameAddress(uint32 fad) const {
     return m_cdblock.m_fs.GetPathAtFrameAddress(fad);
 }
 
+std::span<const media::fs::FileExtent> CDBlock::Probe::GetFileExtents() const {
+    return m_cdblock.m_fs.GetFileExtents();
+}
+
+const media::fs::FileExtent *CDBlock::Probe::FindFileExtent(uint32 fad) const {
+    return m_cdblock.m_fs.FindFileExtent(fad);
+}
+
 std::span<const Filter, kNumFilters> CDBlock::Probe::GetFilters() const {
     return m_cdblock.m_filters;
 }
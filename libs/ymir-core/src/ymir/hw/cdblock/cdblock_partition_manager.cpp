@@ -1,94 +1,112 @@
-#include <ymir/hw/cdblock/cdblock.hpp>
+#include <ymir/hw/cdblock/cdblock_partition_manager.hpp>
 
 #include "cdblock_devlog.hpp"
 
 #include <cassert>
-#include <numeric>
 #include <utility>
 
 namespace ymir::cdblock {
 
-CDBlock::PartitionManager::PartitionManager() {
+PartitionManager::PartitionManager() {
     Reset();
 }
 
-void CDBlock::PartitionManager::Reset() {
-    m_partitions.fill({});
-    m_freeBuffers = kNumBuffers;
-    m_reservedBuffers = 0;
-    devlog::trace<grp::part_mgr>("Cleared partitions; free buffers = {}", m_freeBuffers);
+void PartitionManager::Reset() {
+    m_lists.fill({kNoBuffer, kNoBuffer, 0});
+    for (uint32 i = 0; i < kNumBuffers; i++) {
+        m_prev[i] = i == 0 ? kNoBuffer : i - 1;
+        m_next[i] = i == kNumBuffers - 1 ? kNoBuffer : i + 1;
+    }
+    m_lists[kFreeList] = {0, kNumBuffers - 1, kNumBuffers};
+    m_cursorList = kNoBuffer;
+    m_dirty.MarkAll();
+    devlog::trace<grp::part_mgr>("Cleared partitions; free buffers = {}", m_lists[kFreeList].count);
 }
 
-uint8 CDBlock::PartitionManager::GetBufferCount(uint8 partitionIndex) const {
-    assert(partitionIndex < m_partitions.size());
-    devlog::trace<grp::part_mgr>("Partition {} has {} buffers", partitionIndex, m_partitions[partitionIndex].size());
-    return m_partitions[partitionIndex].size();
+uint8 PartitionManager::GetBufferCount(uint8 partitionIndex) const {
+    assert(partitionIndex < kNumPartitions);
+    devlog::trace<grp::part_mgr>("Partition {} has {} buffers", partitionIndex, m_lists[partitionIndex].count);
+    return m_lists[partitionIndex].count;
 }
 
-uint32 CDBlock::PartitionManager::GetFreeBufferCount() const {
-    const uint32 freeCount = m_freeBuffers - m_reservedBuffers;
+uint32 PartitionManager::GetFreeBufferCount() const {
+    const uint32 freeCount = m_lists[kFreeList].count;
     devlog::trace<grp::part_mgr>("Free buffers = {}", freeCount);
     return freeCount;
 }
 
-bool CDBlock::PartitionManager::ReserveBuffers(uint16 count) {
-    if (count == 0 || count > m_freeBuffers) {
+bool PartitionManager::ReserveBuffers(uint16 count) {
+    if (count == 0 || count > m_lists[kFreeList].count + m_lists[kReservedList].count) {
         return false;
     }
-    m_reservedBuffers = count;
+    ReleaseReservedBuffers();
+    Splice(kReservedList, kFreeList, m_lists[kFreeList].first, count);
     return true;
 }
 
-bool CDBlock::PartitionManager::UseReservedBuffers(uint16 count) {
-    if (count <= m_reservedBuffers) {
-        m_reservedBuffers -= count;
+Buffer *PartitionManager::GetReservedBuffer(uint16 index) {
+    if (index >= m_lists[kReservedList].count) {
+        return nullptr;
+    }
+    const uint8 bufferIndex = FindBuffer(kReservedList, index);
+    m_dirty.Mark(bufferIndex);
+    return &m_buffers[bufferIndex];
+}
+
+bool PartitionManager::UseReservedBuffers(uint8 partitionIndex, uint16 count) {
+    assert(partitionIndex < kNumPartitions);
+    if (count <= m_lists[kReservedList].count) {
+        Splice(partitionIndex, kReservedList, m_lists[kReservedList].first, count);
+        devlog::trace<grp::part_mgr>("Inserted {} reserved buffers into partition {} -> {} buffers", count,
+                                     partitionIndex, m_lists[partitionIndex].count);
         return true;
     }
     return false;
 }
 
-void CDBlock::PartitionManager::ReleaseReservedBuffers() {
-    m_reservedBuffers = 0;
+void PartitionManager::ReleaseReservedBuffers() {
+    Splice(kFreeList, kReservedList, m_lists[kReservedList].first, m_lists[kReservedList].count);
 }
 
-void CDBlock::PartitionManager::InsertHead(uint8 partitionIndex, const Buffer &buffer) {
-    assert(partitionIndex < m_partitions.size());
-    assert(m_freeBuffers > 0);
-    auto &partition = m_partitions[partitionIndex];
-    partition.push_back(buffer);
-    m_freeBuffers--;
+void PartitionManager::InsertHead(uint8 partitionIndex, const Buffer &buffer) {
+    assert(partitionIndex < kNumPartitions);
+    assert(m_lists[kFreeList].count > 0);
+    const uint8 bufferIndex = m_lists[kFreeList].first;
+    m_buffers[bufferIndex] = buffer;
+    Splice(partitionIndex, kFreeList, bufferIndex, 1);
     devlog::trace<grp::part_mgr>("Inserted buffer into partition {} -> {} buffers; free buffers = {}", partitionIndex,
-                                 partition.size(), m_freeBuffers);
+                                 m_lists[partitionIndex].count, m_lists[kFreeList].count);
 }
 
-Buffer *CDBlock::PartitionManager::GetTail(uint8 partitionIndex, uint8 offset) {
-    assert(partitionIndex < m_partitions.size());
-    auto &partition = m_partitions[partitionIndex];
-    if (offset < partition.size()) {
-        return &*(partition.begin() + offset);
+Buffer *PartitionManager::GetTail(uint8 partitionIndex, uint8 offset) {
+    assert(partitionIndex < kNumPartitions);
+    const uint8 bufferIndex = FindBuffer(partitionIndex, offset);
+    if (bufferIndex != kNoBuffer) {
+        return &m_buffers[bufferIndex];
     } else {
         return nullptr;
     }
 }
 
-bool CDBlock::PartitionManager::RemoveTail(uint8 partitionIndex, uint8 offset) {
-    assert(partitionIndex < m_partitions.size());
-    auto &partition = m_partitions[partitionIndex];
-    if (offset < partition.size()) {
-        partition.erase(partition.begin() + offset);
-        m_freeBuffers++;
+bool PartitionManager::RemoveTail(uint8 partitionIndex, uint8 offset) {
+    assert(partitionIndex < kNumPartitions);
+    const uint8 bufferIndex = FindBuffer(partitionIndex, offset);
+    if (bufferIndex != kNoBuffer) {
+        Splice(kFreeList, partitionIndex, bufferIndex, 1);
         devlog::trace<grp::part_mgr>("Removed buffer from partition {} -> {} buffers; free buffers = {}",
-                                     partitionIndex, partition.size(), m_freeBuffers);
+                                     partitionIndex, m_lists[partitionIndex].count, m_lists[kFreeList].count);
         return true;
     }
     return false;
 }
 
-uint32 CDBlock::PartitionManager::DeleteSectors(uint8 partitionIndex, uint16 sectorPos, uint16 sectorCount) {
-    assert(partitionIndex < m_partitions.size());
+uint32 PartitionManager::DeleteSectors(uint8 partitionIndex, uint16 sectorPos, uint16 sectorCount) {
+    assert(partitionIndex < kNumPartitions);
 
-    auto &partition = m_partitions[partitionIndex];
-    const uint32 totalSectors = partition.size();
+    const uint32 totalSectors = m_lists[partitionIndex].count;
+    if (totalSectors == 0) {
+        return 0;
+    }
     uint16 start, end;
     if (sectorPos == 0xFFFF) {
         start = totalSectors - 1;
@@ -102,87 +120,338 @@ uint32 CDBlock::PartitionManager::DeleteSectors(uint8 partitionIndex, uint16 sec
     }
     start = std::min<uint16>(start, totalSectors - 1);
     end = std::min<uint16>(end, totalSectors - 1);
-    partition.erase(partition.begin() + start, partition.begin() + end + 1);
-    m_freeBuffers += end - start + 1;
-    devlog::trace<grp::part_mgr>("Removed {} buffers from partition {} -> {} buffers; free buffers = {}",
-                                 end - start + 1, partitionIndex, partition.size(), m_freeBuffers);
-    return end - start + 1;
-}
-
-void CDBlock::PartitionManager::Clear(uint8 partitionIndex) {
-    assert(partitionIndex < m_partitions.size());
-    auto &partition = m_partitions[partitionIndex];
-    m_freeBuffers += partition.size();
-    devlog::trace<grp::part_mgr>("Cleared all {} buffers from partition {}; free buffers = {}", partition.size(),
-                                 partitionIndex, m_freeBuffers);
-    partition.clear();
-}
-
-uint32 CDBlock::PartitionManager::CalculateSize(uint8 partitionIndex, uint32 start, uint32 end) const {
-    assert(partitionIndex < m_partitions.size());
-    auto &partition = m_partitions[partitionIndex];
-    start = std::min<uint32>(start, partition.size() - 1);
-    end = std::min<uint32>(end, partition.size() - 1);
-    const uint32 size = std::accumulate(partition.begin() + start, partition.begin() + end + 1, 0u,
-                                        [](const uint32 lhs, const Buffer &rhs) { return lhs + rhs.size; });
+    const uint32 count = end - start + 1;
+    Splice(kFreeList, partitionIndex, FindBuffer(partitionIndex, start), count);
+    devlog::trace<grp::part_mgr>("Removed {} buffers from partition {} -> {} buffers; free buffers = {}", count,
+                                 partitionIndex, m_lists[partitionIndex].count, m_lists[kFreeList].count);
+    return count;
+}
+
+uint32 PartitionManager::CountSectors(uint8 partitionIndex, uint16 sectorPos, uint16 sectorCount) const {
+    assert(partitionIndex < kNumPartitions);
+    uint8 start;
+    return ResolveSectorRange(partitionIndex, sectorPos, sectorCount, start);
+}
+
+uint32 PartitionManager::MoveSectors(uint8 dstPartitionIndex, uint8 srcPartitionIndex, uint16 sectorPos,
+                                     uint16 sectorCount) {
+    assert(dstPartitionIndex < kNumPartitions);
+    assert(srcPartitionIndex < kNumPartitions);
+
+    uint8 start;
+    const uint32 count = ResolveSectorRange(srcPartitionIndex, sectorPos, sectorCount, start);
+    if (count == 0) {
+        return 0;
+    }
+    Splice(dstPartitionIndex, srcPartitionIndex, FindBuffer(srcPartitionIndex, start), count);
+    devlog::trace<grp::part_mgr>("Moved {} buffers from partition {} to partition {} -> {} buffers", count,
+                                 srcPartitionIndex, dstPartitionIndex, m_lists[dstPartitionIndex].count);
+    return count;
+}
+
+uint32 PartitionManager::CopySectors(uint8 dstPartitionIndex, uint8 srcPartitionIndex, uint16 sectorPos,
+                                     uint16 sectorCount) {
+    assert(dstPartitionIndex < kNumPartitions);
+    assert(srcPartitionIndex < kNumPartitions);
+
+    uint8 start;
+    const uint32 count = ResolveSectorRange(srcPartitionIndex, sectorPos, sectorCount, start);
+    if (count == 0 || count > m_lists[kFreeList].count) {
+        return 0;
+    }
+
+    // Collect the source buffers first, since the source and destination may be the same partition
+    std::array<uint8, kNumBuffers> srcBuffers;
+    uint8 srcIndex = FindBuffer(srcPartitionIndex, start);
+    for (uint32 i = 0; i < count; i++) {
+        srcBuffers[i] = srcIndex;
+        srcIndex = m_next[srcIndex];
+    }
+    for (uint32 i = 0; i < count; i++) {
+        const uint8 dstIndex = m_lists[kFreeList].first;
+        m_buffers[dstIndex] = m_buffers[srcBuffers[i]];
+        Splice(dstPartitionIndex, kFreeList, dstIndex, 1);
+    }
+    devlog::trace<grp::part_mgr>("Copied {} buffers from partition {} to partition {} -> {} buffers; free buffers = {}",
+                                 count, srcPartitionIndex, dstPartitionIndex, m_lists[dstPartitionIndex].count,
+                                 m_lists[kFreeList].count);
+    return count;
+}
+
+void PartitionManager::Clear(uint8 partitionIndex) {
+    assert(partitionIndex < kNumPartitions);
+    const uint8 count = m_lists[partitionIndex].count;
+    Splice(kFreeList, partitionIndex, m_lists[partitionIndex].first, count);
+    devlog::trace<grp::part_mgr>("Cleared all {} buffers from partition {}; free buffers = {}", count, partitionIndex,
+                                 m_lists[kFreeList].count);
+}
+
+uint32 PartitionManager::CalculateSize(uint8 partitionIndex, uint32 start, uint32 end) const {
+    assert(partitionIndex < kNumPartitions);
+    const List &partition = m_lists[partitionIndex];
+    if (partition.count == 0) {
+        return 0;
+    }
+    start = std::min<uint32>(start, partition.count - 1);
+    end = std::min<uint32>(end, partition.count - 1);
+    uint32 size = 0;
+    uint8 bufferIndex = FindBuffer(partitionIndex, start);
+    for (uint32 i = start; i <= end; i++) {
+        size += m_buffers[bufferIndex].size;
+        bufferIndex = m_next[bufferIndex];
+    }
     devlog::trace<grp::part_mgr>("Calculated partition {} size from {} to {} = {} bytes", partitionIndex, start, end,
                                  size);
     return size;
 }
 
-void CDBlock::PartitionManager::SaveState(state::CDBlockState &state) const {
-    size_t bufferIndex = 0;
-    for (size_t i = 0; i < m_partitions.size(); i++) {
-        for (const auto &buffer : m_partitions[i]) {
-            state.buffers[bufferIndex].data = buffer.data;
-            state.buffers[bufferIndex].size = buffer.size;
-            state.buffers[bufferIndex].frameAddress = buffer.frameAddress;
-            state.buffers[bufferIndex].fileNum = buffer.subheader.fileNum;
-            state.buffers[bufferIndex].chanNum = buffer.subheader.chanNum;
-            state.buffers[bufferIndex].submode = buffer.subheader.submode;
-            state.buffers[bufferIndex].codingInfo = buffer.subheader.codingInfo;
-            state.buffers[bufferIndex].partitionIndex = i;
-            bufferIndex++;
+uint32 PartitionManager::ResolveSectorRange(uint8 listIndex, uint16 sectorPos, uint16 sectorCount, uint8 &start) const {
+    const uint32 totalSectors = m_lists[listIndex].count;
+    if (totalSectors == 0 || sectorCount == 0) {
+        return 0;
+    }
+    const uint32 pos = sectorPos == 0xFFFF ? totalSectors - 1 : sectorPos;
+    if (pos >= totalSectors) {
+        return 0;
+    }
+    start = pos;
+    if (sectorCount == 0xFFFF) {
+        return totalSectors - pos;
+    }
+    return std::min<uint32>(sectorCount, totalSectors - pos);
+}
+
+void PartitionManager::InvalidateCursor(uint8 listIndex) {
+    if (m_cursorList == listIndex) {
+        m_cursorList = kNoBuffer;
+    }
+}
+
+uint8 PartitionManager::FindBuffer(uint8 listIndex, uint8 offset) const {
+    const List &list = m_lists[listIndex];
+    if (offset >= list.count) {
+        return kNoBuffer;
+    }
+
+    // Resume from the last lookup if possible, otherwise walk from whichever end of the list is closest
+    uint8 bufferIndex;
+    if (m_cursorList == listIndex && offset >= m_cursorOffset && offset - m_cursorOffset <= list.count - 1 - offset) {
+        bufferIndex = m_cursorBuffer;
+        for (uint32 i = m_cursorOffset; i < offset; i++) {
+            bufferIndex = m_next[bufferIndex];
+        }
+    } else if (offset <= list.count / 2) {
+        bufferIndex = list.first;
+        for (uint32 i = 0; i < offset; i++) {
+            bufferIndex = m_next[bufferIndex];
+        }
+    } else {
+        bufferIndex = list.last;
+        for (uint32 i = list.count - 1; i > offset; i--) {
+            bufferIndex = m_prev[bufferIndex];
         }
     }
-    state.reservedBuffers = m_reservedBuffers;
+
+    m_cursorList = listIndex;
+    m_cursorOffset = offset;
+    m_cursorBuffer = bufferIndex;
+    return bufferIndex;
 }
 
-bool CDBlock::PartitionManager::ValidateState(const state::CDBlockState &state) const {
-    uint32 usedBuffers = 0u;
-    for (const auto &buffer : state.buffers) {
-        if (buffer.partitionIndex < kNumPartitions) {
-            ++usedBuffers;
-        } else if (buffer.partitionIndex != 0xFF) {
+void PartitionManager::Append(uint8 listIndex, uint8 bufferIndex) {
+    List &list = m_lists[listIndex];
+    m_prev[bufferIndex] = list.last;
+    m_next[bufferIndex] = kNoBuffer;
+    if (list.last != kNoBuffer) {
+        m_next[list.last] = bufferIndex;
+    } else {
+        list.first = bufferIndex;
+    }
+    list.last = bufferIndex;
+    list.count++;
+}
+
+void PartitionManager::Unlink(uint8 listIndex, uint8 bufferIndex) {
+    List &list = m_lists[listIndex];
+    const uint8 prev = m_prev[bufferIndex];
+    const uint8 next = m_next[bufferIndex];
+    if (prev != kNoBuffer) {
+        m_next[prev] = next;
+    } else {
+        list.first = next;
+    }
+    if (next != kNoBuffer) {
+        m_prev[next] = prev;
+    } else {
+        list.last = prev;
+    }
+    list.count--;
+}
+
+void PartitionManager::Splice(uint8 dstListIndex, uint8 srcListIndex, uint8 bufferIndex, uint8 count) {
+    if (count == 0) {
+        return;
+    }
+    InvalidateCursor(dstListIndex);
+    InvalidateCursor(srcListIndex);
+
+    List &src = m_lists[srcListIndex];
+    List &dst = m_lists[dstListIndex];
+    assert(count <= src.count);
+
+    // Detach the run [first, last] from the source list
+    const uint8 first = bufferIndex;
+    uint8 last = first;
+    for (uint32 i = 1; i < count; i++) {
+        last = m_next[last];
+    }
+    const uint8 prev = m_prev[first];
+    const uint8 next = m_next[last];
+    if (prev != kNoBuffer) {
+        m_next[prev] = next;
+    } else {
+        src.first = next;
+    }
+    if (next != kNoBuffer) {
+        m_prev[next] = prev;
+    } else {
+        src.last = prev;
+    }
+    src.count -= count;
+
+    // Free buffers are saved as zeros, so buffers entering or leaving the free list change the saved contents
+    if (dstListIndex == kFreeList || srcListIndex == kFreeList) {
+        uint8 dirtyIndex = first;
+        for (uint32 i = 0; i < count; i++) {
+            m_dirty.Mark(dirtyIndex);
+            dirtyIndex = m_next[dirtyIndex];
+        }
+    }
+
+    // Attach it to the end of the destination list
+    m_prev[first] = dst.last;
+    m_next[last] = kNoBuffer;
+    if (dst.last != kNoBuffer) {
+        m_next[dst.last] = first;
+    } else {
+        dst.first = first;
+    }
+    dst.last = last;
+    dst.count += count;
+}
+
+template <bool incremental>
+void PartitionManager::SaveState(state::CDBlockState &state, state::DirtyPages *dirty) const {
+    auto saveList = [&](uint8 listIndex, uint8 partitionIndex) {
+        for (uint8 bufferIndex = m_lists[listIndex].first; bufferIndex != kNoBuffer;
+             bufferIndex = m_next[bufferIndex]) {
+            const Buffer &buffer = m_buffers[bufferIndex];
+            auto &bufferState = state.buffers[bufferIndex];
+            if (!incremental || m_dirty.IsDirty(bufferIndex)) {
+                bufferState.data = buffer.data;
+            }
+            bufferState.size = buffer.size;
+            bufferState.frameAddress = buffer.frameAddress;
+            bufferState.fileNum = buffer.subheader.fileNum;
+            bufferState.chanNum = buffer.subheader.chanNum;
+            bufferState.submode = buffer.subheader.submode;
+            bufferState.codingInfo = buffer.subheader.codingInfo;
+            bufferState.partitionIndex = partitionIndex;
+            bufferState.next = m_next[bufferIndex];
+        }
+    };
+
+    for (uint8 i = 0; i < kNumPartitions; i++) {
+        saveList(i, i);
+        state.partitionFirstBuffers[i] = m_lists[i].first;
+    }
+    saveList(kReservedList, kNumPartitions);
+    state.reservedFirstBuffer = m_lists[kReservedList].first;
+    state.reservedBuffers = m_lists[kReservedList].count;
+
+    if constexpr (incremental) {
+        auto &pages = (*dirty)[state::MemoryRegion::CDBlockBuffers];
+        m_dirty.ConsumeDirtyPages([&](size_t bufferIndex) { pages.push_back(bufferIndex); });
+    }
+}
+
+template void PartitionManager::SaveState<false>(state::CDBlockState &, state::DirtyPages *) const;
+template void PartitionManager::SaveState<true>(state::CDBlockState &, state::DirtyPages *) const;
+
+bool PartitionManager::ValidateState(const state::CDBlockState &state) const {
+    // Every list must be a well-formed chain of buffers belonging to that list, and every used buffer must be reachable
+    std::array<bool, kNumBuffers> visited{};
+    uint32 linkedBuffers = 0;
+    auto validateList = [&](uint8 first, uint8 partitionIndex, uint32 &count) {
+        count = 0;
+        for (uint8 bufferIndex = first; bufferIndex != kNoBuffer; bufferIndex = state.buffers[bufferIndex].next) {
+            if (bufferIndex >= kNumBuffers || visited[bufferIndex]) {
+                return false;
+            }
+            if (state.buffers[bufferIndex].partitionIndex != partitionIndex) {
+                return false;
+            }
+            visited[bufferIndex] = true;
+            ++count;
+        }
+        linkedBuffers += count;
+        return true;
+    };
+
+    uint32 count;
+    for (uint8 i = 0; i < kNumPartitions; i++) {
+        if (!validateList(state.partitionFirstBuffers[i], i, count)) {
             return false;
         }
     }
-    if (state.reservedBuffers + usedBuffers > kNumBuffers) {
+    if (!validateList(state.reservedFirstBuffer, kNumPartitions, count)) {
+        return false;
+    }
+    if (count != state.reservedBuffers) {
         return false;
     }
-    return true;
-}
 
-void CDBlock::PartitionManager::LoadState(const state::CDBlockState &state) {
-    for (auto &partition : m_partitions) {
-        partition.clear();
+    uint32 usedBuffers = 0u;
+    for (uint32 i = 0; i < kNumBuffers; i++) {
+        const uint8 partitionIndex = state.buffers[i].partitionIndex;
+        if (partitionIndex <= kNumPartitions) {
+            ++usedBuffers;
+        } else if (partitionIndex != 0xFF) {
+            return false;
+        }
     }
-    m_freeBuffers = kNumBuffers;
+    return usedBuffers == linkedBuffers;
+}
+
+void PartitionManager::LoadState(const state::CDBlockState &state) {
+    m_lists.fill({kNoBuffer, kNoBuffer, 0});
+    m_cursorList = kNoBuffer;
 
-    for (const auto &buffer : state.buffers) {
-        if (buffer.partitionIndex < kNumPartitions) {
-            auto &partBuffer = m_partitions[buffer.partitionIndex].emplace_back();
-            partBuffer.data = buffer.data;
-            partBuffer.size = buffer.size;
-            partBuffer.frameAddress = buffer.frameAddress;
-            partBuffer.subheader.fileNum = buffer.fileNum;
-            partBuffer.subheader.chanNum = buffer.chanNum;
-            partBuffer.subheader.submode = buffer.submode;
-            partBuffer.subheader.codingInfo = buffer.codingInfo;
-            --m_freeBuffers;
+    auto loadList = [&](uint8 listIndex, uint8 first) {
+        for (uint8 bufferIndex = first; bufferIndex != kNoBuffer; bufferIndex = state.buffers[bufferIndex].next) {
+            const auto &bufferState = state.buffers[bufferIndex];
+            Buffer &buffer = m_buffers[bufferIndex];
+            buffer.data = bufferState.data;
+            buffer.size = bufferState.size;
+            buffer.frameAddress = bufferState.frameAddress;
+            buffer.subheader.fileNum = bufferState.fileNum;
+            buffer.subheader.chanNum = bufferState.chanNum;
+            buffer.subheader.submode = bufferState.submode;
+            buffer.subheader.codingInfo = bufferState.codingInfo;
+            Append(listIndex, bufferIndex);
+        }
+    };
+
+    for (uint8 i = 0; i < kNumPartitions; i++) {
+        loadList(i, state.partitionFirstBuffers[i]);
+    }
+    loadList(kReservedList, state.reservedFirstBuffer);
+    for (uint32 i = 0; i < kNumBuffers; i++) {
+        if (state.buffers[i].partitionIndex == 0xFF) {
+            Append(kFreeList, i);
         }
     }
-    m_reservedBuffers = state.reservedBuffers;
+    m_dirty.MarkAll();
 }
 
 } // namespace ymir::cdblock
@@ -0,0 +1,164 @@
+#include <ymir/hw/cdblock/cdblock_prefetcher.hpp>
+
+#include <ymir/util/thread_name.hpp>
+
+#include <algorithm>
+
+namespace ymir::cdblock {
+
+SectorPrefetcher::SectorPrefetcher(const media::Disc &disc)
+    : m_disc(disc) {}
+
+SectorPrefetcher::~SectorPrefetcher() {
+    SetEnabled(false);
+}
+
+void SectorPrefetcher::SetEnabled(bool enabled) {
+    if (m_enabled == enabled) {
+        return;
+    }
+
+    m_enabled = enabled;
+    if (enabled) {
+        m_running = true;
+        m_thread = std::thread{[&] { WorkerThread(); }};
+    } else {
+        m_running = false;
+        Stop();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+}
+
+void SectorPrefetcher::Start(uint32 startFrameAddress, uint32 endFrameAddress) {
+    {
+        std::unique_lock lock{m_requestMutex};
+        m_requestStart = startFrameAddress;
+        m_requestEnd = endFrameAddress;
+        m_requestActive = true;
+        m_generation.fetch_add(1, std::memory_order_release);
+    }
+    m_requestEvent.Set();
+    m_ringNotFullEvent.Set();
+}
+
+void SectorPrefetcher::Stop() {
+    {
+        std::unique_lock lock{m_requestMutex};
+        m_requestActive = false;
+        m_generation.fetch_add(1, std::memory_order_release);
+    }
+    m_requestEvent.Set();
+    m_ringNotFullEvent.Set();
+}
+
+std::unique_lock<std::mutex> SectorPrefetcher::LockDisc() {
+    Stop();
+    return std::unique_lock{m_discMutex};
+}
+
+bool SectorPrefetcher::ReadSector(const media::Track &track, uint32 frameAddress, std::span<uint8, 2352> outBuf,
+                                  media::Subheader &outSubheader) {
+    if (m_enabled) {
+        const uint32 generation = m_generation.load(std::memory_order_relaxed);
+        const uint32 tail = m_ringTail.load(std::memory_order_acquire);
+        uint32 head = m_ringHead.load(std::memory_order_relaxed);
+
+        // Skip over stale entries and sectors that have already been passed by the drive head
+        bool hit = false;
+        while (head != tail) {
+            const Entry &entry = m_ring[head % kRingSize];
+            if (entry.generation == generation) {
+                if (entry.frameAddress > frameAddress) {
+                    // Sector is further ahead; keep it for later
+                    break;
+                }
+                if (entry.frameAddress == frameAddress && entry.valid) {
+                    std::copy(entry.data.begin(), entry.data.end(), outBuf.begin());
+                    outSubheader = entry.subheader;
+                    hit = true;
+                }
+            }
+            ++head;
+            if (hit) {
+                break;
+            }
+        }
+
+        m_ringHead.store(head, std::memory_order_release);
+        m_ringNotFullEvent.Set();
+
+        if (hit) {
+            ++m_hits;
+            return true;
+        }
+        ++m_misses;
+    }
+
+    std::unique_lock lock{m_discMutex};
+    return ReadSectorDirect(track, frameAddress, outBuf, outSubheader);
+}
+
+void SectorPrefetcher::WorkerThread() {
+    util::SetCurrentThreadName("CD sector prefetch thread");
+
+    while (m_running) {
+        m_requestEvent.Wait();
+        m_requestEvent.Reset();
+
+        uint32 generation;
+        uint32 frameAddress;
+        uint32 endFrameAddress;
+        {
+            std::unique_lock lock{m_requestMutex};
+            if (!m_requestActive) {
+                continue;
+            }
+            generation = m_generation.load(std::memory_order_acquire);
+            frameAddress = m_requestStart;
+            endFrameAddress = m_requestEnd;
+        }
+
+        while (m_running && frameAddress <= endFrameAddress &&
+               m_generation.load(std::memory_order_acquire) == generation) {
+            // Wait until there is room in the ring
+            const uint32 tail = m_ringTail.load(std::memory_order_relaxed);
+            if (tail - m_ringHead.load(std::memory_order_acquire) >= kRingSize) {
+                m_ringNotFullEvent.Reset();
+                if (tail - m_ringHead.load(std::memory_order_acquire) >= kRingSize) {
+                    m_ringNotFullEvent.Wait();
+                }
+                continue;
+            }
+
+            Entry &entry = m_ring[tail % kRingSize];
+            {
+                std::unique_lock lock{m_discMutex};
+                if (m_generation.load(std::memory_order_acquire) != generation) {
+                    // The request changed or the disc is about to be modified
+                    break;
+                }
+
+                const media::Track *track =
+                    m_disc.sessions.empty() ? nullptr : m_disc.sessions.back().FindTrack(frameAddress);
+                entry.generation = generation;
+                entry.frameAddress = frameAddress;
+                entry.valid = track != nullptr && ReadSectorDirect(*track, frameAddress, entry.data, entry.subheader);
+            }
+            m_ringTail.store(tail + 1, std::memory_order_release);
+            ++frameAddress;
+        }
+    }
+}
+
+bool SectorPrefetcher::ReadSectorDirect(const media::Track &track, uint32 frameAddress, std::span<uint8, 2352> outBuf,
+                                        media::Subheader &outSubheader) {
+    if (!track.ReadSector(frameAddress, outBuf)) {
+        return false;
+    }
+    track.ReadSectorSubheader(frameAddress, outSubheader);
+    return true;
+}
+
+} // namespace ymir::cdblock
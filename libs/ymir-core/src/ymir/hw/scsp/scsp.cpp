@@ -6,6 +6,12 @@
 #include <limits>
 #include <ostream>
 
+#if defined(_M_X64) || defined(__x86_64__)
+    #include <immintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
 using namespace ymir::m68k;
 
 namespace ymir::scsp {
@@ -31,17 +37,63 @@ FORCE_INLINE static void TraceKeyOnExecute(debug::ISCSPTracer *tracer, uint32 sl
     }
 }
 
+// -----------------------------------------------------------------------------
+// Vectorized mixer tables
+
+// Combined send level and pan attenuation parameters for the vectorized mixer.
+//
+// AddOutput computes each channel's contribution as:
+//   x = (output << 14) >> (SDL ^ 7)
+//   pan = x >> (PAN >> 1), minus 25% if PAN is odd, or zero if PAN = 0xF
+//   contribution = x >> 14 or pan >> 14, depending on the pan channel select bit
+//
+// Because output << 14 has 14 trailing zeros and the send level and pan shifts add up to at most 14, the first two
+// shifts never discard any bits and can be replaced by a multiplication by a power of two. Only the -25% adjustment
+// and the final shift need to be performed as actual arithmetic shifts, both of which are constant across all slots.
+struct MixLevels {
+    sint32 factorL;
+    sint32 factorR;
+    sint32 maskL;
+    sint32 maskR;
+};
+
+// Mix levels indexed by (SDL << 5) | PAN
+static constexpr auto kMixLevels = [] {
+    std::array<MixLevels, 256> arr{};
+    for (uint32 sendLevel = 1; sendLevel < 8; ++sendLevel) {
+        for (uint32 pan = 0; pan < 32; ++pan) {
+            const uint32 panAmount = pan & 0xF;
+            const sint32 sendShift = sendLevel ^ 7u;
+            const sint32 panShift = panAmount >> 1u;
+            const sint32 directFactor = 1 << (14 - sendShift);
+            const sint32 panFactor = panAmount == 0xF ? 0 : 1 << (14 - sendShift - panShift);
+            const sint32 panMask = (panAmount & 1) ? -1 : 0;
+            const bool panChanSel = (pan & 0x10) != 0;
+
+            auto &levels = arr[(sendLevel << 5u) | pan];
+            levels.factorL = panChanSel ? directFactor : panFactor;
+            levels.factorR = panChanSel ? panFactor : directFactor;
+            levels.maskL = panChanSel ? 0 : panMask;
+            levels.maskR = panChanSel ? panMask : 0;
+        }
+    }
+    return arr;
+}();
+
 // -----------------------------------------------------------------------------
 // Implementation
 
 SCSP::SCSP(core::Scheduler &scheduler, core::Configuration::Audio &config)
     : m_m68k(*this)
     , m_scheduler(scheduler)
-    , m_dsp(m_WRAM.data()) {
+    , m_dsp(m_WRAM.data(), m_WRAMDirty) {
 
     // Replicate interpolation mode to avoid an extra dereference in the hot path
     config.interpolation.Observe(m_interpMode);
     config.threadedSCSP.Observe([&](bool value) { EnableThreading(value); });
+    config.vectorizedMixing.Observe(m_vectorizedMixingRequested);
+    config.outputSampleRate.Observe(m_outputSampleRateRequested);
+    config.cddaBufferLatency.Observe([&](uint8 value) { m_cddaLatency = std::clamp<uint8>(value, 2u, 8u); });
 
     m_sampleTickEvent = m_scheduler.RegisterEvent(core::events::SCSPSample, this, OnSampleTickEvent<false>);
 
@@ -54,6 +106,7 @@ SCSP::SCSP(core::Scheduler &scheduler, core::Configuration::Audio &config)
 
 void SCSP::Reset(bool hard) {
     m_WRAM.fill(0);
+    m_WRAMDirty.MarkAll();
 
     m_midiInputBuffer.fill(0);
     m_midiInputReadPos = 0;
@@ -69,6 +122,8 @@ void SCSP::Reset(bool hard) {
     m_cddaReadPos = 0;
     m_cddaWritePos = 0;
     m_cddaReady = false;
+    m_cddaStarved = false;
+    m_cddaUnderruns = 0;
 
     m_m68k.Reset(true);
     m_m68kSpilloverCycles = 0;
@@ -82,6 +137,9 @@ void SCSP::Reset(bool hard) {
     m_currSlot = 0;
 
     m_out.fill(0);
+    ClearMixerInputs();
+    m_vectorizedMixing = m_vectorizedMixingRequested;
+    m_resampler.Reset();
 
     if (hard) {
         m_scheduler.ScheduleFromNow(m_sampleTickEvent, kCyclesPerSample);
@@ -123,11 +181,51 @@ void SCSP::Reset(bool hard) {
     m_dsp.Reset();
 }
 
+void SCSP::SetSampleCallback(CBOutputSample callback) {
+    FlushSampleBatch();
+    m_cbOutputSample = callback;
+    m_outputBatchEnabled = false;
+}
+
+void SCSP::SetSampleBatchCallback(CBOutputSampleBatch callback, uint32 batchSize) {
+    FlushSampleBatch();
+    m_cbOutputSampleBatch = callback;
+    m_outputBatchEnabled = true;
+    SetSampleBatchSize(batchSize);
+}
+
+void SCSP::SetSampleBatchSize(uint32 batchSize) {
+    m_outputBatchSize = std::clamp<uint32>(batchSize, 1u, kMaxOutputBatchSize);
+    if (m_outputBatchCount >= m_outputBatchSize) {
+        FlushSampleBatch();
+    }
+}
+
+void SCSP::FlushSampleBatch() {
+    if (m_outputBatchCount > 0) {
+        m_cbOutputSampleBatch(std::span<const OutputFrame>(m_outputBatch).first(m_outputBatchCount));
+        m_outputBatchCount = 0;
+    }
+}
+
+void SCSP::UpdateOutputSampleRate() {
+    const uint32 rate = std::clamp<uint32>(m_outputSampleRateRequested, Resampler::kMinSampleRate,
+                                           Resampler::kMaxSampleRate);
+    m_outputSampleRateRequested = rate;
+    m_resamplerEnabled = rate != kAudioFreq;
+    if (m_resamplerEnabled) {
+        m_resampler.Configure(kAudioFreq, rate);
+        devlog::debug<grp::base>("Resampling output to {} Hz", rate);
+    } else {
+        devlog::debug<grp::base>("Resampler disabled; outputting at native {} Hz", kAudioFreq);
+    }
+}
+
 void SCSP::MapMemory(sys::Bus &bus) {
     static constexpr auto cast = [](void *ctx) -> SCSP & { return *static_cast<SCSP *>(ctx); };
 
     // WRAM
-    bus.MapArray(0x5A0'0000, 0x5A7'FFFF, m_WRAM, true);
+    bus.MapArray(0x5A0'0000, 0x5A7'FFFF, m_WRAM, m_WRAMDirty);
 
     // Unused hole
     bus.MapBoth(
@@ -191,16 +289,40 @@ void SCSP::SetDebugTracing(bool enable) {
 }
 
 uint32 SCSP::ReceiveCDDA(std::span<uint8, 2352> data) {
+    if (m_cddaStarved) {
+        // The buffer ran dry while the stream was playing
+        ++m_cddaUnderruns;
+        m_cddaStarved = false;
+    }
+
+    // The drive only adjusts its speed in response to the pacing hint and may still overrun the buffer; drop the
+    // oldest sector rather than overwrite samples that are being played back
+    if (GetCDDABufferLength() + 2352 >= m_cddaBuffer.size()) {
+        m_cddaReadPos = (m_cddaReadPos + 2352) % m_cddaBuffer.size();
+    }
+
     std::copy_n(data.begin(), 2352, m_cddaBuffer.begin() + m_cddaWritePos);
     m_cddaWritePos = (m_cddaWritePos + 2352) % m_cddaBuffer.size();
-    sint32 len = static_cast<sint32>(m_cddaWritePos) - m_cddaReadPos;
-    if (len < 0) {
-        len += m_cddaBuffer.size();
-    }
-    if (len >= 2352 * 4) {
+    const uint32 len = GetCDDABufferLength();
+    if (len >= 2352 * m_cddaLatency) {
         m_cddaReady = true;
     }
-    return len * 3 / m_cddaBuffer.size();
+
+    // Keep the buffer between 1 and 5 sectors above the latency target, leaving at least two sectors of headroom in
+    // the ring for the drive to react to the slow down request
+    const uint32 slowThreshold = std::min<uint32>(m_cddaLatency + 6, kCDDABufferSectors - 2);
+    if (len < 2352 * (m_cddaLatency + 1)) {
+        return 0;
+    } else if (len >= 2352 * slowThreshold) {
+        return 2;
+    } else {
+        return 1;
+    }
+}
+
+void SCSP::BeginCDDAPlayback() {
+    m_cddaStarved = false;
+    m_cddaUnderruns = 0;
 }
 
 void SCSP::ReceiveMidiInput(MidiMessage &msg) {
@@ -341,7 +463,20 @@ void SCSP::SetCPUEnabled(bool enabled) {
 }
 
 void SCSP::SaveState(state::SCSPState &state) const {
-    state.WRAM = m_WRAM;
+    SaveStateImpl<false>(state, nullptr);
+}
+
+void SCSP::SaveStateIncremental(state::SCSPState &state, state::DirtyPages &dirty) {
+    SaveStateImpl<true>(state, &dirty);
+}
+
+template <bool incremental>
+void SCSP::SaveStateImpl(state::SCSPState &state, state::DirtyPages *dirty) const {
+    if constexpr (incremental) {
+        state::CopyDirtyPages(m_WRAMDirty, m_WRAM, state.WRAM, *dirty, state::MemoryRegion::SCSPWRAM);
+    } else {
+        state.WRAM = m_WRAM;
+    }
     state.cddaBuffer = m_cddaBuffer;
     state.cddaReadPos = m_cddaReadPos;
     state.cddaWritePos = m_cddaWritePos;
@@ -394,6 +529,10 @@ void SCSP::SaveState(state::SCSPState &state) const {
     state.currSlot = m_currSlot;
 
     state.out = m_out;
+    if (m_vectorizedMixing) {
+        // Include the sends recorded so far in this sample cycle
+        MixRecordedOutputs(state.out, (m_currSlot - 6u) & 31u);
+    }
 
     std::copy(m_midiInputBuffer.begin(), m_midiInputBuffer.end(), state.midiInputBuffer.begin());
     state.midiInputReadPos = m_midiInputReadPos;
@@ -449,10 +588,12 @@ bool SCSP::ValidateState(const state::SCSPState &state) const {
 
 void SCSP::LoadState(const state::SCSPState &state) {
     m_WRAM = state.WRAM;
+    m_WRAMDirty.MarkAll();
     m_cddaBuffer = state.cddaBuffer;
     m_cddaReadPos = state.cddaReadPos % m_cddaBuffer.size();
     m_cddaWritePos = state.cddaWritePos % m_cddaBuffer.size();
     m_cddaReady = state.cddaReady;
+    m_cddaStarved = false;
 
     m_m68k.LoadState(state.m68k);
     m_m68kSpilloverCycles = state.m68kSpilloverCycles;
@@ -502,6 +643,7 @@ void SCSP::LoadState(const state::SCSPState &state) {
     m_currSlot = state.currSlot;
 
     m_out = state.out;
+    ClearMixerInputs();
 
     std::copy(state.midiInputBuffer.begin(), state.midiInputBuffer.end(), m_midiInputBuffer.begin());
     m_midiInputReadPos = state.midiInputReadPos;
@@ -794,6 +936,28 @@ FORCE_INLINE void SCSP::UpdateTimers() {
     }
 }
 
+FORCE_INLINE void SCSP::OutputSample(sint16 left, sint16 right) {
+    if (m_outputSampleRateRequested != GetOutputSampleRate()) [[unlikely]] {
+        UpdateOutputSampleRate();
+    }
+    if (m_resamplerEnabled) {
+        m_resampler.Process(left, right, [this](sint16 left, sint16 right) { EmitSample(left, right); });
+    } else {
+        EmitSample(left, right);
+    }
+}
+
+FORCE_INLINE void SCSP::EmitSample(sint16 left, sint16 right) {
+    if (m_outputBatchEnabled) {
+        m_outputBatch[m_outputBatchCount++] = {left, right};
+        if (m_outputBatchCount >= m_outputBatchSize) {
+            FlushSampleBatch();
+        }
+    } else {
+        m_cbOutputSample(left, right);
+    }
+}
+
 template <bool debug>
 FORCE_INLINE void SCSP::ProcessSlots(uint32 i) {
     const uint32 op1SlotIndex = i;
@@ -817,12 +981,7 @@ FORCE_INLINE void SCSP::ProcessSlots(uint32 i) {
     m_dsp.Step();
 
     // Cycles 2,3
-    if (op7Slot.inputMixingLevel > 0) {
-        const sint32 mixsOutput = (op7Slot.output << 4) >> (op7Slot.inputMixingLevel ^ 7);
-        m_dsp.MIXSSlotWrite(op7Slot.inputSelect, mixsOutput);
-    } else {
-        m_dsp.MIXSSlotZero(op7Slot.inputSelect);
-    }
+    WriteMIXS(op7Slot);
 
     SlotProcessStep2_2(op2Slot);
     SlotProcessStep3_2(op3Slot);
@@ -842,20 +1001,43 @@ FORCE_INLINE void SCSP::ProcessSlots(uint32 i) {
     SlotProcessStep6_4(op6Slot);
     m_dsp.Step();
 
+    ProcessSlotOutput<debug>(op7Slot);
+
+    m_soundStackIndex = (m_soundStackIndex + 1) & 63;
+}
+
+FORCE_INLINE void SCSP::WriteMIXS(const Slot &slot) {
+    if (slot.inputMixingLevel > 0) {
+        const sint32 mixsOutput = (slot.output << 4) >> (slot.inputMixingLevel ^ 7);
+        m_dsp.MIXSSlotWrite(slot.inputSelect, mixsOutput);
+    } else {
+        m_dsp.MIXSSlotZero(slot.inputSelect);
+    }
+}
+
+template <bool debug>
+FORCE_INLINE void SCSP::ProcessSlotOutput(const Slot &slot) {
+    const uint32 slotIndex = slot.index;
+
     // Accumulate direct send output
-    AddOutput(op7Slot.output, op7Slot.directSendLevel, op7Slot.directPan);
+    SendOutput(slotIndex, slot.output, slot.directSendLevel, slot.directPan);
 
-    TraceSlotSample<debug>(m_tracer, op7SlotIndex, op7Slot.output);
+    TraceSlotSample<debug>(m_tracer, slotIndex, slot.output);
 
-    if (op7SlotIndex < 16) {
+    if (slotIndex < 16) {
         // Accumulate EFREG into final output
-        AddOutput(m_dsp.effectOut[op7SlotIndex], op7Slot.effectSendLevel, op7Slot.effectPan);
-    } else if (op7SlotIndex < 18) {
+        SendOutput(32 + slotIndex, m_dsp.effectOut[slotIndex], slot.effectSendLevel, slot.effectPan);
+    } else if (slotIndex < 18) {
         // Accumulate EXTS into final output
-        AddOutput(m_dsp.audioInOut[op7SlotIndex & 1], op7Slot.effectSendLevel, op7Slot.effectPan);
-    } else if (op7SlotIndex == 31) {
+        SendOutput(32 + slotIndex, m_dsp.audioInOut[slotIndex & 1], slot.effectSendLevel, slot.effectPan);
+    } else if (slotIndex == 31) {
         // Finish sample cycle
 
+        // Mix all recorded sends
+        if (m_vectorizedMixing) {
+            MixRecordedOutputs();
+        }
+
         // Master volume attenuates sound in steps of 3 dB, or 0.5 bits per step
         auto applyMasterVolume = [&](sint32 out) {
             if (m_masterVolume == 0) {
@@ -887,9 +1069,12 @@ FORCE_INLINE void SCSP::ProcessSlots(uint32 i) {
         }
 
         // Write to output and reset
-        m_cbOutputSample(m_out[0], m_out[1]);
+        OutputSample(m_out[0], m_out[1]);
         m_out.fill(0);
 
+        // Apply mixer configuration changes at the sample boundary
+        m_vectorizedMixing = m_vectorizedMixingRequested;
+
         // Copy CDDA data to DSP EXTS (0=left, 1=right)
         if (m_cddaReady && m_cddaReadPos != m_cddaWritePos) {
             m_dsp.audioInOut[0] = util::ReadLE<uint16>(&m_cddaBuffer[m_cddaReadPos + 0]);
@@ -899,11 +1084,12 @@ FORCE_INLINE void SCSP::ProcessSlots(uint32 i) {
             // Buffer underrun
             m_dsp.audioInOut[0] = 0;
             m_dsp.audioInOut[1] = 0;
+            if (m_cddaReady) {
+                m_cddaStarved = true;
+            }
             m_cddaReady = false;
         }
     }
-
-    m_soundStackIndex = (m_soundStackIndex + 1) & 63;
 }
 
 FORCE_INLINE void SCSP::IncrementSampleCounter() {
@@ -945,6 +1131,139 @@ FORCE_INLINE void SCSP::AddOutput(sint32 output, uint8 sendLevel, uint8 pan) {
     m_out[1] += (panChanSel ? panOut : output) >> 14;
 }
 
+FORCE_INLINE void SCSP::SendOutput(uint32 index, sint32 output, uint8 sendLevel, uint8 pan) {
+    if (m_vectorizedMixing) {
+        const MixLevels &levels = kMixLevels[(sendLevel << 5u) | pan];
+        m_mixOutput[index] = output;
+        m_mixFactorL[index] = levels.factorL;
+        m_mixFactorR[index] = levels.factorR;
+        m_mixMaskL[index] = levels.maskL;
+        m_mixMaskR[index] = levels.maskR;
+    } else {
+        AddOutput(output, sendLevel, pan);
+    }
+}
+
+void SCSP::MixRecordedOutputs(std::array<sint32, 2> &out, uint32 count) const {
+    auto mix = [&](uint32 index) {
+        sint32 outL = m_mixOutput[index] * m_mixFactorL[index];
+        sint32 outR = m_mixOutput[index] * m_mixFactorR[index];
+        outL -= (outL >> 2) & m_mixMaskL[index];
+        outR -= (outR >> 2) & m_mixMaskR[index];
+        out[0] += outL >> 14;
+        out[1] += outR >> 14;
+    };
+
+    for (uint32 i = 0; i < count; ++i) {
+        mix(i);
+    }
+    for (uint32 i = 0; i < std::min(count, 18u); ++i) {
+        mix(32 + i);
+    }
+}
+
+FORCE_INLINE void SCSP::MixRecordedOutputs() {
+    static constexpr uint32 kCount = 64;
+    uint32 i = 0;
+    sint32 outL = 0;
+    sint32 outR = 0;
+
+#if defined(_M_X64) || defined(__x86_64__)
+    // NOTE: outputs are 16-bit values and factors are at most 1 << 14, so the products can be computed with 16-bit
+    // multiply-add instructions as long as the upper 16 bits of every factor are zero.
+    #if defined(__AVX2__)
+    // Eight sends at a time
+    __m256i accL_x8 = _mm256_setzero_si256();
+    __m256i accR_x8 = _mm256_setzero_si256();
+    for (; i + 8 <= kCount; i += 8) {
+        const __m256i output_x8 = _mm256_load_si256(reinterpret_cast<const __m256i *>(&m_mixOutput[i]));
+        const __m256i factorL_x8 = _mm256_load_si256(reinterpret_cast<const __m256i *>(&m_mixFactorL[i]));
+        const __m256i factorR_x8 = _mm256_load_si256(reinterpret_cast<const __m256i *>(&m_mixFactorR[i]));
+        const __m256i maskL_x8 = _mm256_load_si256(reinterpret_cast<const __m256i *>(&m_mixMaskL[i]));
+        const __m256i maskR_x8 = _mm256_load_si256(reinterpret_cast<const __m256i *>(&m_mixMaskR[i]));
+
+        __m256i mixL_x8 = _mm256_madd_epi16(output_x8, factorL_x8);
+        __m256i mixR_x8 = _mm256_madd_epi16(output_x8, factorR_x8);
+        mixL_x8 = _mm256_sub_epi32(mixL_x8, _mm256_and_si256(_mm256_srai_epi32(mixL_x8, 2), maskL_x8));
+        mixR_x8 = _mm256_sub_epi32(mixR_x8, _mm256_and_si256(_mm256_srai_epi32(mixR_x8, 2), maskR_x8));
+        accL_x8 = _mm256_add_epi32(accL_x8, _mm256_srai_epi32(mixL_x8, 14));
+        accR_x8 = _mm256_add_epi32(accR_x8, _mm256_srai_epi32(mixR_x8, 14));
+    }
+    __m128i accL_x4 = _mm_add_epi32(_mm256_castsi256_si128(accL_x8), _mm256_extracti128_si256(accL_x8, 1));
+    __m128i accR_x4 = _mm_add_epi32(_mm256_castsi256_si128(accR_x8), _mm256_extracti128_si256(accR_x8, 1));
+    #else
+    __m128i accL_x4 = _mm_setzero_si128();
+    __m128i accR_x4 = _mm_setzero_si128();
+    #endif
+
+    #if defined(__SSE2__)
+    // Four sends at a time
+    for (; i + 4 <= kCount; i += 4) {
+        const __m128i output_x4 = _mm_load_si128(reinterpret_cast<const __m128i *>(&m_mixOutput[i]));
+        const __m128i factorL_x4 = _mm_load_si128(reinterpret_cast<const __m128i *>(&m_mixFactorL[i]));
+        const __m128i factorR_x4 = _mm_load_si128(reinterpret_cast<const __m128i *>(&m_mixFactorR[i]));
+        const __m128i maskL_x4 = _mm_load_si128(reinterpret_cast<const __m128i *>(&m_mixMaskL[i]));
+        const __m128i maskR_x4 = _mm_load_si128(reinterpret_cast<const __m128i *>(&m_mixMaskR[i]));
+
+        __m128i mixL_x4 = _mm_madd_epi16(output_x4, factorL_x4);
+        __m128i mixR_x4 = _mm_madd_epi16(output_x4, factorR_x4);
+        mixL_x4 = _mm_sub_epi32(mixL_x4, _mm_and_si128(_mm_srai_epi32(mixL_x4, 2), maskL_x4));
+        mixR_x4 = _mm_sub_epi32(mixR_x4, _mm_and_si128(_mm_srai_epi32(mixR_x4, 2), maskR_x4));
+        accL_x4 = _mm_add_epi32(accL_x4, _mm_srai_epi32(mixL_x4, 14));
+        accR_x4 = _mm_add_epi32(accR_x4, _mm_srai_epi32(mixR_x4, 14));
+    }
+    #endif
+
+    // Horizontal sum
+    accL_x4 = _mm_add_epi32(accL_x4, _mm_shuffle_epi32(accL_x4, _MM_SHUFFLE(1, 0, 3, 2)));
+    accR_x4 = _mm_add_epi32(accR_x4, _mm_shuffle_epi32(accR_x4, _MM_SHUFFLE(1, 0, 3, 2)));
+    accL_x4 = _mm_add_epi32(accL_x4, _mm_shuffle_epi32(accL_x4, _MM_SHUFFLE(2, 3, 0, 1)));
+    accR_x4 = _mm_add_epi32(accR_x4, _mm_shuffle_epi32(accR_x4, _MM_SHUFFLE(2, 3, 0, 1)));
+    outL = _mm_cvtsi128_si32(accL_x4);
+    outR = _mm_cvtsi128_si32(accR_x4);
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    // Four sends at a time
+    int32x4_t accL_x4 = vdupq_n_s32(0);
+    int32x4_t accR_x4 = vdupq_n_s32(0);
+    for (; i + 4 <= kCount; i += 4) {
+        const int32x4_t output_x4 = vld1q_s32(&m_mixOutput[i]);
+        const int32x4_t factorL_x4 = vld1q_s32(&m_mixFactorL[i]);
+        const int32x4_t factorR_x4 = vld1q_s32(&m_mixFactorR[i]);
+        const int32x4_t maskL_x4 = vld1q_s32(&m_mixMaskL[i]);
+        const int32x4_t maskR_x4 = vld1q_s32(&m_mixMaskR[i]);
+
+        int32x4_t mixL_x4 = vmulq_s32(output_x4, factorL_x4);
+        int32x4_t mixR_x4 = vmulq_s32(output_x4, factorR_x4);
+        mixL_x4 = vsubq_s32(mixL_x4, vandq_s32(vshrq_n_s32(mixL_x4, 2), maskL_x4));
+        mixR_x4 = vsubq_s32(mixR_x4, vandq_s32(vshrq_n_s32(mixR_x4, 2), maskR_x4));
+        accL_x4 = vaddq_s32(accL_x4, vshrq_n_s32(mixL_x4, 14));
+        accR_x4 = vaddq_s32(accR_x4, vshrq_n_s32(mixR_x4, 14));
+    }
+    outL = vaddvq_s32(accL_x4);
+    outR = vaddvq_s32(accR_x4);
+#endif
+
+    for (; i < kCount; ++i) {
+        sint32 mixL = m_mixOutput[i] * m_mixFactorL[i];
+        sint32 mixR = m_mixOutput[i] * m_mixFactorR[i];
+        mixL -= (mixL >> 2) & m_mixMaskL[i];
+        mixR -= (mixR >> 2) & m_mixMaskR[i];
+        outL += mixL >> 14;
+        outR += mixR >> 14;
+    }
+
+    m_out[0] += outL;
+    m_out[1] += outR;
+}
+
+void SCSP::ClearMixerInputs() {
+    m_mixOutput.fill(0);
+    m_mixFactorL.fill(0);
+    m_mixFactorR.fill(0);
+    m_mixMaskL.fill(0);
+    m_mixMaskR.fill(0);
+}
+
 template <bool debug>
 FORCE_INLINE void SCSP::SlotProcessStep1_4(Slot &slot) {
     m_lfsr = (m_lfsr >> 1u) | (((m_lfsr >> 5u) ^ m_lfsr) & 1u) << 16u;
@@ -978,7 +1297,7 @@ FORCE_INLINE void SCSP::SlotProcessStep1_4(Slot &slot) {
 
     if constexpr (devlog::debug_enabled<grp::kyonex>) {
         if (slot.index == 31 && m_kyonexExecute) {
-            static char out[32];
+            char out[32];
             for (auto &slot : m_slots) {
                 out[slot.index] = slot.keyOnBit ? '+' : '_';
             }
@@ -4,8 +4,9 @@
 
 namespace ymir::scsp {
 
-DSP::DSP(uint8 *ram)
-    : m_WRAM(ram) {
+DSP::DSP(uint8 *ram, util::DirtyPageTracker<m68k::kM68KWRAMSize> &ramDirty)
+    : m_WRAM(ram)
+    , m_WRAMDirty(ramDirty) {
     Reset();
 }
 
@@ -29,6 +30,7 @@ void DSP::Reset() {
     PC = 0x68;
 
     m_programLength = 0;
+    DecodeProgram();
 
     INPUTS = 0;
 
@@ -52,6 +54,17 @@ void DSP::Reset() {
     m_readWriteAddr = 0;
 }
 
+void DSP::UpdateProgram(uint8 writeIndex) {
+    m_decodedProgram[writeIndex] = DSPDecodedInstr::Decode(program[writeIndex]);
+    UpdateProgramLength(writeIndex);
+}
+
+void DSP::DecodeProgram() {
+    for (size_t i = 0; i < program.size(); i++) {
+        m_decodedProgram[i] = DSPDecodedInstr::Decode(program[i]);
+    }
+}
+
 void DSP::UpdateProgramLength(uint8 writeIndex) {
     const bool wroteNOP = program[writeIndex].u64 == 0;
     if (wroteNOP && writeIndex == m_programLength - 1) {
@@ -144,9 +157,11 @@ void DSP::LoadState(const state::SCSPDSP &state) {
             m_programLength = i + 1;
         }
     }
-    if (m_programLength < program.size()) {
+    // An empty program is not run at all, as after a reset
+    if (m_programLength > 0 && m_programLength < program.size()) {
         ++m_programLength;
     }
+    DecodeProgram();
 
     tempMem = state.TEMP;
     soundMem = state.MEMS;
@@ -0,0 +1,163 @@
+#include <ymir/hw/scsp/scsp_resampler.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numbers>
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #include <immintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
+namespace ymir::scsp {
+
+Resampler::Resampler() {
+    Configure(44100, 44100);
+}
+
+void Resampler::Reset() {
+    m_historyL.fill(0.0f);
+    m_historyR.fill(0.0f);
+    m_historyPos = 0;
+    m_position = 0;
+}
+
+void Resampler::SaveStreamState(StreamState &state) const {
+    state.position = m_position;
+    state.historyL = m_historyL;
+    state.historyR = m_historyR;
+    state.historyPos = m_historyPos;
+}
+
+void Resampler::LoadStreamState(const StreamState &state) {
+    m_position = state.position;
+    m_historyL = state.historyL;
+    m_historyR = state.historyR;
+    m_historyPos = state.historyPos % kTaps;
+}
+
+void Resampler::Configure(uint32 inputRate, uint32 outputRate) {
+    m_inputRate = std::clamp(inputRate, kMinSampleRate, kMaxSampleRate);
+    m_outputRate = std::clamp(outputRate, kMinSampleRate, kMaxSampleRate);
+    m_rateAdjustment = 1.0;
+
+    // Place the cutoff slightly below the Nyquist frequency of the lower of the two rates, expressed in cycles per
+    // input sample, leaving room for the transition band
+    static constexpr double kRolloff = 0.91;
+    const double cutoff = 0.5 * kRolloff * std::min(1.0, static_cast<double>(m_outputRate) / m_inputRate);
+
+    static constexpr double kHalfTaps = kTaps / 2;
+    for (uint32 phase = 0; phase <= kPhases; ++phase) {
+        const double frac = static_cast<double>(phase) / kPhases;
+        float *coeffs = &m_coeffs[phase * kTaps];
+
+        double sum = 0.0;
+        for (uint32 tap = 0; tap < kTaps; ++tap) {
+            // Distance from the output position in input samples
+            const double t = static_cast<double>(tap) - (kHalfTaps - 1.0) - frac;
+
+            const double x = 2.0 * cutoff * t;
+            const double sinc = x == 0.0 ? 1.0 : std::sin(std::numbers::pi * x) / (std::numbers::pi * x);
+
+            // Blackman window
+            const double w = t / kHalfTaps;
+            const double window =
+                std::abs(w) >= 1.0
+                    ? 0.0
+                    : 0.42 + 0.5 * std::cos(std::numbers::pi * w) + 0.08 * std::cos(2.0 * std::numbers::pi * w);
+
+            const double coeff = 2.0 * cutoff * sinc * window;
+            coeffs[tap] = static_cast<float>(coeff);
+            sum += coeff;
+        }
+
+        // Normalize for unity gain at DC
+        for (uint32 tap = 0; tap < kTaps; ++tap) {
+            coeffs[tap] = static_cast<float>(coeffs[tap] / sum);
+        }
+    }
+
+    UpdateStep();
+    Reset();
+}
+
+void Resampler::SetRateAdjustment(double factor) {
+    m_rateAdjustment = std::clamp(factor, 1.0 - kMaxRateAdjustment, 1.0 + kMaxRateAdjustment);
+    UpdateStep();
+}
+
+void Resampler::UpdateStep() {
+    const double ratio = static_cast<double>(m_inputRate) / (m_outputRate * m_rateAdjustment);
+    m_step = static_cast<uint64>(ratio * static_cast<double>(kPositionOne));
+}
+
+// Computes the dot products of the samples with two sets of coefficients.
+FORCE_INLINE static void DotProduct2(const float *samples, const float *coeffs0, const float *coeffs1, float &out0,
+                                     float &out1) {
+    static constexpr uint32 kTaps = Resampler::kTaps;
+    uint32 i = 0;
+    out0 = 0.0f;
+    out1 = 0.0f;
+
+#if defined(_M_X64) || defined(__x86_64__)
+    __m128 acc0_x4 = _mm_setzero_ps();
+    __m128 acc1_x4 = _mm_setzero_ps();
+    for (; i + 4 <= kTaps; i += 4) {
+        const __m128 samples_x4 = _mm_loadu_ps(&samples[i]);
+        acc0_x4 = _mm_add_ps(acc0_x4, _mm_mul_ps(samples_x4, _mm_load_ps(&coeffs0[i])));
+        acc1_x4 = _mm_add_ps(acc1_x4, _mm_mul_ps(samples_x4, _mm_load_ps(&coeffs1[i])));
+    }
+
+    // Horizontal sum
+    acc0_x4 = _mm_add_ps(acc0_x4, _mm_movehl_ps(acc0_x4, acc0_x4));
+    acc1_x4 = _mm_add_ps(acc1_x4, _mm_movehl_ps(acc1_x4, acc1_x4));
+    acc0_x4 = _mm_add_ss(acc0_x4, _mm_shuffle_ps(acc0_x4, acc0_x4, _MM_SHUFFLE(1, 1, 1, 1)));
+    acc1_x4 = _mm_add_ss(acc1_x4, _mm_shuffle_ps(acc1_x4, acc1_x4, _MM_SHUFFLE(1, 1, 1, 1)));
+    out0 = _mm_cvtss_f32(acc0_x4);
+    out1 = _mm_cvtss_f32(acc1_x4);
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    float32x4_t acc0_x4 = vdupq_n_f32(0.0f);
+    float32x4_t acc1_x4 = vdupq_n_f32(0.0f);
+    for (; i + 4 <= kTaps; i += 4) {
+        const float32x4_t samples_x4 = vld1q_f32(&samples[i]);
+        acc0_x4 = vfmaq_f32(acc0_x4, samples_x4, vld1q_f32(&coeffs0[i]));
+        acc1_x4 = vfmaq_f32(acc1_x4, samples_x4, vld1q_f32(&coeffs1[i]));
+    }
+    out0 = vaddvq_f32(acc0_x4);
+    out1 = vaddvq_f32(acc1_x4);
+#endif
+
+    for (; i < kTaps; ++i) {
+        out0 += samples[i] * coeffs0[i];
+        out1 += samples[i] * coeffs1[i];
+    }
+}
+
+void Resampler::Interpolate(uint32 fracPos, sint16 &outL, sint16 &outR) const {
+    static constexpr uint32 kPhaseBits = std::countr_zero(kPhases);
+    static constexpr uint32 kPhaseShift = 32u - kPhaseBits;
+    static constexpr float kInterpScale = 1.0f / static_cast<float>(1u << kPhaseShift);
+
+    const uint32 phase = fracPos >> kPhaseShift;
+    const float interp = static_cast<float>(fracPos & ((1u << kPhaseShift) - 1u)) * kInterpScale;
+
+    const float *coeffs0 = &m_coeffs[phase * kTaps];
+    const float *coeffs1 = &m_coeffs[(phase + 1) * kTaps];
+
+    float left0, left1, right0, right1;
+    DotProduct2(&m_historyL[m_historyPos], coeffs0, coeffs1, left0, left1);
+    DotProduct2(&m_historyR[m_historyPos], coeffs0, coeffs1, right0, right1);
+
+    const float left = left0 + (left1 - left0) * interp;
+    const float right = right0 + (right1 - right0) * interp;
+
+    auto toSample = [](float value) -> sint16 {
+        return static_cast<sint16>(std::clamp(std::lround(value), -32768l, 32767l));
+    };
+    outL = toSample(left);
+    outR = toSample(right);
+}
+
+} // namespace ymir::scsp
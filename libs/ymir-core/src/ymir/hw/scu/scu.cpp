@@ -8,6 +8,8 @@
 #include <ymir/util/inline.hpp>
 #include <ymir/util/size_ops.hpp>
 
+#include <algorithm>
+#include <array>
 #include <bit>
 
 namespace ymir::scu {
@@ -422,6 +424,11 @@ bool SCU::ValidateState(const state::SCUState &state) const {
             return false;
         }
         break;
+    case state::SCUState::CartType::ROM:
+        if (state.cartData.size() != cart::kROMCartSize) {
+            return false;
+        }
+        break;
     default: break;
     }
 
@@ -449,8 +456,12 @@ void SCU::LoadState(const state::SCUState &state) {
     }
     case state::SCUState::CartType::ROM: //
     {
-        auto *cart = m_cartSlot.InsertCartridge<cart::ROMCartridge>();
-        cart->LoadROM(std::span<const uint8, 4_MiB>(state.cartData.begin(), 4_MiB));
+        // Keep the current cartridge if there is one; it will hold on to its image if the contents match
+        auto *cart = m_cartSlot.GetCartridge().As<cart::CartType::ROM>();
+        if (cart == nullptr) {
+            cart = m_cartSlot.InsertCartridge<cart::ROMCartridge>();
+        }
+        cart->LoadROM(std::span<const uint8, cart::kROMCartSize>(state.cartData.begin(), cart::kROMCartSize));
         break;
     }
     default: break;
@@ -742,7 +753,32 @@ void SCU::RunDMA() {
             }
 
             // 32-bit transfers -- the bulk of the DMA operation
+            // Fixed-address sources such as the CD Block data transfer register may be read in blocks. This is only
+            // done once the previously read longword has been fully consumed so that the sequence of reads is
+            // preserved.
+            bool blockRead = ch.currSrcAddrInc == 0;
+            std::array<uint32, 64> blockBuf;
             while (ch.currXferCount >= 4) {
+                if (blockRead && bufPos == 4) {
+                    const uint32 count = std::min<uint32>(ch.currXferCount / 4u, blockBuf.size());
+                    if (m_bus.ReadBlock<uint32>(ch.currSrcAddr & ~3u, blockBuf.data(), count)) {
+                        devlog::trace<grp::dma>("SCU DMA{}: Block read of {} longwords from {:08X}", level, count,
+                                                ch.currSrcAddr & ~3u);
+                        for (uint32 i = 0; i < count; ++i) {
+                            incDst();
+                            const uint32 addr = (currDstAddr + currDstOffset) & ~3u;
+                            const uint32 value = blockBuf[i];
+                            m_bus.Write<uint32>(addr, value);
+                            currDstOffset += 4;
+                            devlog::trace<grp::dma>("SCU DMA{}: 32-bit write to {:08X} -> {:08X}", level, addr, value);
+                        }
+                        ch.currXferCount -= count * 4u;
+                        buf = blockBuf[count - 1];
+                        continue;
+                    }
+                    blockRead = false;
+                }
+
                 incDst();
                 const uint32 addr = (currDstAddr + currDstOffset) & ~3u;
                 const uint32 value = read32();
@@ -72,6 +72,8 @@ void SCUDSP::Reset(bool hard) {
     dmaReadAddr = 0;
     dmaWriteAddr = 0;
     dmaAddrInc = 0;
+    dmaAddrD0 = 0;
+    dmaPC = 0;
 
     m_cyclesSpillover = 0u;
 }
@@ -276,6 +278,7 @@ void SCUDSP::SaveState(state::SCUDSPState &state) const {
     state.dmaWriteAddr = dmaWriteAddr;
     state.dmaAddrInc = dmaAddrInc;
     state.dmaAddrD0 = dmaAddrD0;
+    state.dmaPC = dmaPC;
     state.cyclesSpillover = m_cyclesSpillover;
 }
 
@@ -321,6 +324,7 @@ void SCUDSP::LoadState(const state::SCUDSPState &state) {
     dmaWriteAddr = state.dmaWriteAddr & 0x7FFFFFC;
     dmaAddrInc = state.dmaAddrInc;
     dmaAddrD0 = state.dmaAddrD0 & 0x7FFFFFF;
+    dmaPC = state.dmaPC;
     m_cyclesSpillover = state.cyclesSpillover;
 }
 
@@ -7,6 +7,7 @@
 #include <ymir/util/unreachable.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <ostream>
 #include <string>
@@ -1534,6 +1535,38 @@ void SH2::RunDMAC(uint32 channel) {
 
     TraceDMAXferBegin<debug>(m_tracer, channel, ch.srcAddress, ch.dstAddress, ch.xferCount, xferSize, srcInc, dstInc);
 
+    // Fixed-address 16-bit and 32-bit reads from the cache-through area may be served in blocks by FIFO-like ports such
+    // as the CD Block data transfer register. Values are buffered here and consumed one unit at a time.
+    const uint32 srcPartition = (ch.srcAddress >> 29u) & 0b111;
+    bool blockRead = srcInc == 0 && (srcPartition == 0b001 || srcPartition == 0b101) &&
+                     (ch.xferSize == DMATransferSize::Word || ch.xferSize == DMATransferSize::Longword) &&
+                     (ch.srcAddress & (xferSize - 1)) == 0;
+    std::array<uint32, 64> blockBuf;
+    uint32 blockPos = 0;
+    uint32 blockCount = 0;
+
+    // Returns true if the next value is available in the block buffer, refilling it if necessary.
+    auto readBlock = [&]() -> bool {
+        if (blockPos < blockCount) {
+            return true;
+        }
+        const uint32 count = std::min<uint32>(ch.xferCount, blockBuf.size());
+        if (!blockRead || count == 0) {
+            return false;
+        }
+        const uint32 address = ch.srcAddress & 0x7FFFFFF;
+        if (ch.xferSize == DMATransferSize::Word) {
+            std::array<uint16, blockBuf.size()> words;
+            blockRead = m_bus.ReadBlock<uint16>(address, words.data(), count);
+            std::copy_n(words.begin(), count, blockBuf.begin());
+        } else {
+            blockRead = m_bus.ReadBlock<uint32>(address, blockBuf.data(), count);
+        }
+        blockPos = 0;
+        blockCount = blockRead ? count : 0;
+        return blockRead;
+    };
+
     do {
         // Perform one unit of transfer
         switch (ch.xferSize) {
@@ -1546,7 +1579,7 @@ void SH2::RunDMAC(uint32 channel) {
             break;
         }
         case DMATransferSize::Word: {
-            const uint16 value = MemReadWord<enableCache>(ch.srcAddress);
+            const uint16 value = readBlock() ? blockBuf[blockPos++] : MemReadWord<enableCache>(ch.srcAddress);
             devlog::trace<grp::dma_xfer>(m_logPrefix, "DMAC{} 16-bit transfer from {:08X} to {:08X} -> {:X}", channel,
                                          ch.srcAddress, ch.dstAddress, value);
             MemWriteWord<debug, enableCache>(ch.dstAddress, value);
@@ -1554,7 +1587,7 @@ void SH2::RunDMAC(uint32 channel) {
             break;
         }
         case DMATransferSize::Longword: {
-            const uint32 value = MemReadLong<enableCache>(ch.srcAddress);
+            const uint32 value = readBlock() ? blockBuf[blockPos++] : MemReadLong<enableCache>(ch.srcAddress);
             devlog::trace<grp::dma_xfer>(m_logPrefix, "DMAC{} 32-bit transfer from {:08X} to {:08X} -> {:X}", channel,
                                          ch.srcAddress, ch.dstAddress, value);
             MemWriteLong<debug, enableCache>(ch.dstAddress, value);
@@ -7,7 +7,9 @@
 #include <ymir/util/thread_name.hpp>
 #include <ymir/util/unreachable.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <limits>
 
 #if defined(_M_X64) || defined(__x86_64__)
@@ -107,11 +109,15 @@ void VDP::Reset(bool hard) {
     m_state.Reset(hard);
     if (hard) {
         m_CRAMCache.fill({});
+        InvalidateIncrementalState();
     }
 
     m_VDP1TimingPenaltyCycles = 0;
     m_VDP1TimingPenaltyPerWrite = kVDP1TimingPenaltyPerWrite;
 
+    // The render thread resets its copies of VRAM and CRAM on every reset
+    m_VDPRenderContext.MarkAllForResync();
+
     if (m_threadedVDPRendering) {
         m_VDPRenderContext.EnqueueEvent(VDPRenderEvent::Reset());
     } else {
@@ -402,6 +408,7 @@ template <mem_primitive T, bool poke>
 FORCE_INLINE void VDP::VDP1WriteVRAM(uint32 address, T value) {
     address &= 0x7FFFF;
     util::WriteBE<T>(&m_state.VRAM1[address], value);
+    m_VRAM1Dirty.Mark(address);
     if (m_effectiveRenderVDP1InVDP2Thread) {
         m_VDPRenderContext.EnqueueEvent(VDPRenderEvent::VDP1VRAMWrite<T>(address, value));
     }
@@ -424,6 +431,7 @@ template <mem_primitive T>
 FORCE_INLINE void VDP::VDP1WriteFB(uint32 address, T value) {
     address &= 0x3FFFF;
     util::WriteBE<T>(&m_state.spriteFB[m_state.displayFB ^ 1][address], value);
+    m_spriteFBDirty[m_state.displayFB ^ 1].Mark(address);
     if (m_deinterlaceRender) {
         util::WriteBE<T>(&m_altSpriteFB[m_state.displayFB ^ 1][address & 0x3FFFF], value);
     }
@@ -491,6 +499,7 @@ FORCE_INLINE void VDP::VDP2WriteVRAM(uint32 address, T value) {
     // TODO: handle VRSIZE.VRAMSZ
     address &= 0x7FFFF;
     util::WriteBE<T>(&m_state.VRAM2[address], value);
+    m_VRAM2Dirty.Mark(address);
     if (m_threadedVDPRendering) {
         m_VDPRenderContext.EnqueueEvent(VDPRenderEvent::VDP2VRAMWrite<T>(address, value));
     }
@@ -525,6 +534,7 @@ FORCE_INLINE void VDP::VDP2WriteCRAM(uint32 address, T value) {
         devlog::trace<grp::vdp2_regs>("{}-bit VDP2 CRAM write to {:05X} = {:X}", sizeof(T) * 8, address, value);
     }
     util::WriteBE<T>(&m_state.CRAM[address], value);
+    m_CRAMDirty.Mark(address);
     VDP2UpdateCRAMCache<T>(address);
     if (m_threadedVDPRendering) {
         m_VDPRenderContext.EnqueueEvent(VDPRenderEvent::VDP2CRAMWrite<T>(address, value));
@@ -534,6 +544,7 @@ FORCE_INLINE void VDP::VDP2WriteCRAM(uint32 address, T value) {
             devlog::trace<grp::vdp2_regs>("   replicated to {:05X}", address ^ 0x800);
         }
         util::WriteBE<T>(&m_state.CRAM[address ^ 0x800], value);
+        m_CRAMDirty.Mark(address ^ 0x800);
         VDP2UpdateCRAMCache<T>(address);
         if (m_threadedVDPRendering) {
             m_VDPRenderContext.EnqueueEvent(VDPRenderEvent::VDP2CRAMWrite<T>(address ^ 0x800, value));
@@ -600,13 +611,31 @@ FORCE_INLINE void VDP::VDP2WriteReg(uint32 address, uint16 value) {
 }
 
 void VDP::SaveState(state::VDPState &state) const {
+    SaveStateImpl<false>(state, nullptr);
+}
+
+void VDP::SaveStateIncremental(state::VDPState &state, state::DirtyPages &dirty) {
+    SaveStateImpl<true>(state, &dirty);
+}
+
+template <bool incremental>
+void VDP::SaveStateImpl(state::VDPState &state, state::DirtyPages *dirty) const {
+    // VRAM, CRAM and registers are read from the emulator's copies, which are always up to date. The renderer state is
+    // updated by the render thread while processing events, so it must catch up first. This is usually already the
+    // case since states are saved between frames, after rendering has finished.
     if (m_threadedVDPRendering) {
-        m_VDPRenderContext.EnqueueEvent(VDPRenderEvent::PreSaveStateSync());
-        m_VDPRenderContext.preSaveSyncSignal.Wait();
-        m_VDPRenderContext.preSaveSyncSignal.Reset();
+        m_VDPRenderContext.WaitIdle();
     }
 
-    m_state.SaveState(state);
+    if constexpr (incremental) {
+        using enum state::MemoryRegion;
+        state::CopyDirtyPages(m_VRAM1Dirty, m_state.VRAM1, state.VRAM1, *dirty, VDP1VRAM);
+        state::CopyDirtyPages(m_spriteFBDirty[0], m_state.spriteFB[0], state.spriteFB[0], *dirty, VDP1FB0);
+        state::CopyDirtyPages(m_spriteFBDirty[1], m_state.spriteFB[1], state.spriteFB[1], *dirty, VDP1FB1);
+        state::CopyDirtyPages(m_VRAM2Dirty, m_state.VRAM2, state.VRAM2, *dirty, VDP2VRAM);
+        state::CopyDirtyPages(m_CRAMDirty, m_state.CRAM, state.CRAM, *dirty, VDP2CRAM);
+    }
+    m_state.SaveState(state, !incremental);
 
     state.renderer.vdp1State.sysClipH = m_VDP1RenderContext.sysClipH;
     state.renderer.vdp1State.sysClipV = m_VDP1RenderContext.sysClipV;
@@ -674,12 +703,65 @@ bool VDP::ValidateState(const state::VDPState &state) const {
     return true;
 }
 
+void VDP::InvalidateIncrementalState() {
+    m_VRAM1Dirty.MarkAll();
+    m_VRAM2Dirty.MarkAll();
+    m_CRAMDirty.MarkAll();
+    for (auto &fbDirty : m_spriteFBDirty) {
+        fbDirty.MarkAll();
+    }
+}
+
+void VDP::ClearDirtyPages() {
+    m_VRAM1Dirty.ClearAll();
+    m_VRAM2Dirty.ClearAll();
+    m_CRAMDirty.ClearAll();
+    for (auto &fbDirty : m_spriteFBDirty) {
+        fbDirty.ClearAll();
+    }
+}
+
+// Copies the pages of src that differ from dst, invoking fn(page) for each copied page.
+template <size_t kPageSize, size_t kSize, typename Fn>
+static void CopyChangedPages(const std::array<uint8, kSize> &src, std::array<uint8, kSize> &dst, Fn &&fn) {
+    static_assert(kSize % kPageSize == 0);
+    for (size_t page = 0; page < kSize / kPageSize; ++page) {
+        const size_t offset = page * kPageSize;
+        if (std::memcmp(&src[offset], &dst[offset], kPageSize) != 0) {
+            std::memcpy(&dst[offset], &src[offset], kPageSize);
+            fn(page);
+        }
+    }
+}
+
 void VDP::LoadState(const state::VDPState &state) {
-    m_state.LoadState(state);
+    auto &rctx = m_VDPRenderContext;
 
-    for (uint32 address = 0; address < kVDP2CRAMSize; address += 2) {
-        VDP2UpdateCRAMCache<uint16>(address);
+    // Let the render thread finish writing to the sprite framebuffers
+    if (m_threadedVDPRendering) {
+        rctx.WaitIdle();
+    }
+
+    // Only replace the memory pages that differ from the state. The render thread's copies of VRAM and CRAM mirror the
+    // emulator's, so only those pages need to be resynced.
+    CopyChangedPages<util::kDirtyPageSize>(state.VRAM1, m_state.VRAM1,
+                                     [&](size_t page) { rctx.VRAM1Resync.Mark(page * util::kDirtyPageSize); });
+    CopyChangedPages<util::kDirtyPageSize>(state.VRAM2, m_state.VRAM2,
+                                     [&](size_t page) { rctx.VRAM2Resync.Mark(page * util::kDirtyPageSize); });
+    CopyChangedPages<kCRAMResyncPageSize>(state.CRAM, m_state.CRAM, [&](size_t page) {
+        const uint32 baseAddress = page * kCRAMResyncPageSize;
+        rctx.CRAMResync.Mark(baseAddress);
+        for (uint32 address = baseAddress; address < baseAddress + kCRAMResyncPageSize; address += 2) {
+            VDP2UpdateCRAMCache<uint16>(address);
+        }
+    });
+    for (size_t i = 0; i < 2; i++) {
+        CopyChangedPages<util::kDirtyPageSize>(state.spriteFB[i], m_state.spriteFB[i], [](size_t) {});
     }
+
+    m_state.LoadState(state, false);
+    InvalidateIncrementalState();
+
     VDP2UpdateEnabledBGs();
 
     if (m_threadedVDPRendering) {
@@ -756,6 +838,9 @@ void VDP::LoadState(const state::VDPState &state) {
     case VerticalPhase::TopBorder: [[fallthrough]];
     case VerticalPhase::LastLine: m_state.regs2.VCNTSkip = m_VCounterSkip; break;
     }
+
+    // The state stores VCNT as read by software; convert it back to the internal counter
+    m_state.regs2.VCNT = static_cast<uint16>(state.regs2.VCNT - m_state.regs2.VCNTSkip) >> m_state.regs2.VCNTShift;
 }
 
 void VDP::SetLayerEnabled(Layer layer, bool enabled) {
@@ -795,6 +880,7 @@ void VDP::EnableThreadedVDP(bool enable) {
 
     m_threadedVDPRendering = enable;
     if (enable) {
+        m_VDPRenderContext.MarkAllForResync();
         m_VDPRenderContext.EnqueueEvent(VDPRenderEvent::UpdateEffectiveRenderingFlags());
         m_VDPRenderContext.EnqueueEvent(VDPRenderEvent::PostLoadStateSync());
         m_VDPRenderThread = std::thread{[&] { VDPRenderThread(); }};
@@ -813,6 +899,7 @@ void VDP::EnableThreadedVDP(bool enable) {
         VDPRenderEvent dummy{};
         while (m_VDPRenderContext.eventQueue.try_dequeue(dummy)) {
         }
+        m_VDPRenderContext.processedEventCount = m_VDPRenderContext.enqueuedEventCount;
         UpdateEffectiveRenderingFlags();
     }
 }
@@ -1046,7 +1133,11 @@ void VDP::BeginHPhaseActiveDisplay() {
                 m_cbVDP1DrawFinished();
                 m_VDPRenderContext.vdp1Done = false;
             }
-            m_VDPRenderContext.EnqueueEvent(VDPRenderEvent::VDP2DrawLine(m_state.regs2.VCNT));
+            if (m_renderingEnabled) {
+                m_VDPRenderContext.EnqueueEvent(VDPRenderEvent::VDP2DrawLine(m_state.regs2.VCNT));
+            }
+            VDP2CalcAccessPatterns(m_state.regs2);
+        } else if (!m_renderingEnabled) {
             VDP2CalcAccessPatterns(m_state.regs2);
         } else {
             const bool interlaced = m_state.regs2.TVMD.IsInterlaced();
@@ -1190,7 +1281,9 @@ void VDP::BeginVPhaseBlankingAndSync() {
         m_VDPRenderContext.renderFinishedSignal.Wait();
         m_VDPRenderContext.renderFinishedSignal.Reset();
     }
-    m_cbFrameComplete(m_framebuffer.data(), m_HRes, m_VRes);
+    if (m_renderingEnabled) {
+        m_cbFrameComplete(m_framebuffer.data(), m_HRes, m_VRes);
+    }
 }
 
 void VDP::BeginVPhaseVCounterSkip() {
@@ -1383,20 +1476,41 @@ void VDP::VDPRenderThread() {
                 break;
 
             case EvtType::PreSaveStateSync: rctx.preSaveSyncSignal.Set(); break;
-            case EvtType::PostLoadStateSync:
+            case EvtType::PostLoadStateSync: {
+                const uint8 oldCRAMMode = rctx.vdp2.regs.vramControl.colorRAMMode;
                 rctx.vdp1.regs = m_state.regs1;
-                rctx.vdp1.VRAM = m_state.VRAM1;
                 rctx.vdp2.regs = m_state.regs2;
-                rctx.vdp2.VRAM = m_state.VRAM2;
-                rctx.vdp2.CRAM = m_state.CRAM;
+
+                // Only copy the pages replaced by the emulator thread
+                auto copyPage = [](auto &dst, const auto &src, size_t offset, size_t size) {
+                    std::copy_n(src.begin() + offset, size, dst.begin() + offset);
+                };
+                rctx.VRAM1Resync.ConsumeDirtyPages([&](size_t page) {
+                    copyPage(rctx.vdp1.VRAM, m_state.VRAM1, page * util::kDirtyPageSize, util::kDirtyPageSize);
+                });
+                rctx.VRAM2Resync.ConsumeDirtyPages([&](size_t page) {
+                    copyPage(rctx.vdp2.VRAM, m_state.VRAM2, page * util::kDirtyPageSize, util::kDirtyPageSize);
+                });
+                uint32 changedCRAMPages = 0;
+                rctx.CRAMResync.ConsumeDirtyPages([&](size_t page) {
+                    copyPage(rctx.vdp2.CRAM, m_state.CRAM, page * kCRAMResyncPageSize, kCRAMResyncPageSize);
+                    changedCRAMPages |= 1u << page;
+                });
                 rctx.postLoadSyncSignal.Set();
                 VDP2UpdateEnabledBGs();
+
+                // Refill the CRAM cache entries of the copied pages, or the entire cache if the color RAM mode changed
+                const bool refillAll = rctx.vdp2.regs.vramControl.colorRAMMode != oldCRAMMode;
                 for (uint32 addr = 0; addr < rctx.vdp2.CRAM.size(); addr += sizeof(uint16)) {
+                    if (!refillAll && (changedCRAMPages & (1u << (addr / kCRAMResyncPageSize))) == 0) {
+                        continue;
+                    }
                     const uint16 colorValue = VDP2ReadRendererCRAM<uint16>(addr);
                     const Color555 color5{.u16 = colorValue};
                     rctx.vdp2.CRAMCache[addr / sizeof(uint16)] = ConvertRGB555to888(color5);
                 }
                 break;
+            }
             case EvtType::VDP1StateSync:
                 rctx.vdp1.regs = m_state.regs1;
                 rctx.vdp1.VRAM = m_state.VRAM1;
@@ -1414,6 +1528,7 @@ void VDP::VDPRenderThread() {
                 break;
             }
         }
+        rctx.processedEventCount.fetch_add(count, std::memory_order_release);
     }
 }
 
@@ -1538,6 +1653,7 @@ FORCE_INLINE void VDP::VDP1EraseFramebuffer() {
     const uint8 fbIndex = VDP1GetDisplayFBIndex();
     auto &fb = m_state.spriteFB[fbIndex];
     auto &altFB = m_altSpriteFB[fbIndex];
+    m_spriteFBDirty[fbIndex].MarkAll();
 
     const bool halfResH =
         !regs1.hdtvEnable && !regs1.fbRotEnable && regs1.pixel8Bits && (regs2.TVMD.HRESOn & 0b110) == 0b000;
@@ -1897,6 +2013,9 @@ FORCE_INLINE void VDP::VDP1PlotPixel(CoordS32 coord, const VDP1PixelParams &pixe
     auto &drawFB = (altFB ? m_altSpriteFB : m_state.spriteFB)[fbIndex];
     if (regs1.pixel8Bits) {
         fbOffset &= 0x3FFFF;
+        if (!altFB) {
+            m_spriteFBDirty[fbIndex].Mark(fbOffset);
+        }
         // TODO: what happens if pixelParams.mode.colorCalcBits/gouraudEnable != 0?
         if (pixelParams.mode.msbOn) {
             drawFB[fbOffset] |= 0x80;
@@ -1912,6 +2031,9 @@ FORCE_INLINE void VDP::VDP1PlotPixel(CoordS32 coord, const VDP1PixelParams &pixe
         }
     } else {
         fbOffset = (fbOffset * sizeof(uint16)) & 0x3FFFE;
+        if (!altFB) {
+            m_spriteFBDirty[fbIndex].Mark(fbOffset);
+        }
         uint8 *pixel = &drawFB[fbOffset];
 
         if (pixelParams.mode.msbOn) {
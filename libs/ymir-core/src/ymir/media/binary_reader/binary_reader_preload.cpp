@@ -0,0 +1,159 @@
+#include <ymir/media/binary_reader/binary_reader_preload.hpp>
+
+#include <ymir/media/binary_reader/binary_reader_mmap.hpp>
+
+#include <ymir/util/scope_guard.hpp>
+#include <ymir/util/thread_name.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+
+namespace ymir::media {
+
+// Ensures only one reader preloads data at a time
+static std::mutex s_preloadMutex;
+static std::condition_variable s_preloadCond;
+static bool s_preloadBusy = false;
+
+PreloadingBinaryReader::PreloadingBinaryReader(std::filesystem::path path, std::error_code &error) {
+    auto source = std::make_shared<MemoryMappedBinaryReader>(path, error);
+    if (error) {
+        return;
+    }
+    m_source = source;
+    m_backgroundSource = source;
+    Start();
+}
+
+PreloadingBinaryReader::PreloadingBinaryReader(std::shared_ptr<IBinaryReader> source,
+                                               std::shared_ptr<IBinaryReader> backgroundSource)
+    : m_source(std::move(source))
+    , m_backgroundSource(std::move(backgroundSource)) {
+
+    if (!m_source) {
+        return;
+    }
+    if (!m_backgroundSource) {
+        m_backgroundSource = m_source;
+    }
+    Start();
+}
+
+PreloadingBinaryReader::~PreloadingBinaryReader() {
+    {
+        std::unique_lock lock{s_preloadMutex};
+        m_stop = true;
+    }
+    s_preloadCond.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+uintmax_t PreloadingBinaryReader::Read(uintmax_t offset, uintmax_t size, std::span<uint8> output) const {
+    if (offset >= m_size) {
+        return 0;
+    }
+    // Limit size to the smallest of the requested size, the output buffer size and the amount of bytes available in
+    // the file starting from offset
+    size = std::min(size, m_size - offset);
+    size = std::min(size, output.size());
+
+    if (m_complete.load(std::memory_order_acquire)) {
+        std::copy_n(&m_data[offset], size, output.begin());
+        return size;
+    }
+
+    // Split the read into runs of regions that are either entirely loaded or not loaded yet
+    const uintmax_t end = offset + size;
+    uintmax_t pos = offset;
+    while (pos < end) {
+        const bool loaded = m_regionLoaded && m_regionLoaded[pos / kRegionSize].load(std::memory_order_acquire);
+        uintmax_t runEnd = std::min((pos / kRegionSize + 1) * kRegionSize, end);
+        while (runEnd < end && m_regionLoaded &&
+               m_regionLoaded[runEnd / kRegionSize].load(std::memory_order_acquire) == loaded) {
+            runEnd = std::min(runEnd + kRegionSize, end);
+        }
+
+        const uintmax_t runSize = runEnd - pos;
+        std::span<uint8> runOutput = output.subspan(pos - offset, runSize);
+        if (loaded) {
+            std::copy_n(&m_data[pos], runSize, runOutput.begin());
+        } else {
+            const uintmax_t readSize = m_source->Read(pos, runSize, runOutput);
+            if (readSize < runSize) {
+                return pos - offset + readSize;
+            }
+        }
+        pos = runEnd;
+    }
+    return size;
+}
+
+void PreloadingBinaryReader::Start() {
+    m_size = m_source->Size();
+    if (m_size == 0) {
+        m_complete = true;
+        return;
+    }
+
+    // Skip preloading if the image doesn't fit in memory; the reader keeps working from the source
+    m_data.reset(new (std::nothrow) uint8[m_size]);
+    if (!m_data) {
+        return;
+    }
+
+    const uintmax_t regionCount = (m_size + kRegionSize - 1) / kRegionSize;
+    m_regionLoaded = std::make_unique<std::atomic<bool>[]>(regionCount);
+    for (uintmax_t i = 0; i < regionCount; ++i) {
+        m_regionLoaded[i].store(false, std::memory_order_relaxed);
+    }
+
+    m_thread = std::thread{[&] { PreloadThread(); }};
+}
+
+void PreloadingBinaryReader::PreloadThread() {
+    util::SetCurrentThreadName("Disc preload thread");
+
+    // Wait for other readers to finish preloading
+    {
+        std::unique_lock lock{s_preloadMutex};
+        s_preloadCond.wait(lock, [&] { return !s_preloadBusy || m_stop; });
+        if (m_stop) {
+            return;
+        }
+        s_preloadBusy = true;
+    }
+    util::ScopeGuard sgReleasePreload{[&] {
+        {
+            std::unique_lock lock{s_preloadMutex};
+            s_preloadBusy = false;
+        }
+        s_preloadCond.notify_all();
+    }};
+
+    bool complete = true;
+    for (uintmax_t offset = 0, region = 0; offset < m_size; offset += kRegionSize, ++region) {
+        if (m_stop) {
+            complete = false;
+            break;
+        }
+        const uintmax_t size = std::min(kRegionSize, m_size - offset);
+        if (m_backgroundSource->Read(offset, size, std::span<uint8>{&m_data[offset], size}) != size) {
+            // The source failed to provide the data; leave the rest of the image on the source
+            complete = false;
+            break;
+        }
+        m_regionLoaded[region].store(true, std::memory_order_release);
+    }
+    if (complete) {
+        m_complete.store(true, std::memory_order_release);
+    }
+
+    // The background source is no longer needed
+    m_backgroundSource.reset();
+}
+
+} // namespace ymir::media
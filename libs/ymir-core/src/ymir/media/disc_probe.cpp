@@ -0,0 +1,345 @@
+#include <ymir/media/disc_probe.hpp>
+
+#include <ymir/media/disc.hpp>
+#include <ymir/media/filesystem.hpp>
+#include <ymir/media/loader/loader_bin_cue.hpp>
+#include <ymir/media/loader/loader_chd.hpp>
+#include <ymir/media/loader/loader_img_ccd_sub.hpp>
+#include <ymir/media/loader/loader_iso.hpp>
+#include <ymir/media/loader/loader_mdf_mds.hpp>
+#include <ymir/media/loader/loader_ycd.hpp>
+
+#include <ymir/util/data_ops.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+namespace ymir::media {
+
+std::string_view ToString(DiscFormat format) {
+    switch (format) {
+    case DiscFormat::CHD: return "CHD";
+    case DiscFormat::BinCue: return "BIN/CUE";
+    case DiscFormat::MdfMds: return "MDF/MDS";
+    case DiscFormat::ImgCcdSub: return "IMG/CCD/SUB";
+    case DiscFormat::ISO: return "ISO";
+    case DiscFormat::YCD: return "YCD";
+    default: return "Unknown";
+    }
+}
+
+// Attempts to load the disc with the loader for the given format.
+static bool LoadWithFormat(DiscFormat format, const std::filesystem::path &path, Disc &disc) {
+    switch (format) {
+    case DiscFormat::CHD: {
+        loader::chd::HunkCacheOptions cacheOptions{};
+        cacheOptions.memoryBudget = 0; // use the smallest possible cache
+        cacheOptions.decompressionThreads = 0;
+        return loader::chd::Load(path, disc, false, cacheOptions);
+    }
+    case DiscFormat::BinCue: return loader::bincue::Load(path, disc, false);
+    case DiscFormat::MdfMds: return loader::mdfmds::Load(path, disc, false);
+    case DiscFormat::ImgCcdSub: return loader::ccd::Load(path, disc, false);
+    case DiscFormat::ISO: return loader::iso::Load(path, disc, false);
+    case DiscFormat::YCD: return loader::ycd::Load(path, disc, false);
+    default: return false;
+    }
+}
+
+static DiscFormat GuessFormat(const std::filesystem::path &path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return std::tolower(c); });
+    if (ext == ".ycd") {
+        return DiscFormat::YCD;
+    }
+    if (ext == ".chd") {
+        return DiscFormat::CHD;
+    }
+    if (ext == ".cue") {
+        return DiscFormat::BinCue;
+    }
+    if (ext == ".mds") {
+        return DiscFormat::MdfMds;
+    }
+    if (ext == ".ccd") {
+        return DiscFormat::ImgCcdSub;
+    }
+    if (ext == ".iso") {
+        return DiscFormat::ISO;
+    }
+    return DiscFormat::Unknown;
+}
+
+bool ProbeDisc(std::filesystem::path path, DiscProbeResult &result) {
+    result.format = DiscFormat::Unknown;
+    result.rawHeader.fill(0);
+    result.header.Invalidate();
+    result.hash.fill(0);
+    result.hasHash = false;
+
+    Disc disc{};
+
+    // Try the most likely loader first, then fall back to the same order used by LoadDisc.
+    // NOTE: ISO must be the last to be tested since its detection is more lenient
+    static constexpr DiscFormat kFormats[] = {DiscFormat::YCD,    DiscFormat::CHD,       DiscFormat::BinCue,
+                                              DiscFormat::MdfMds, DiscFormat::ImgCcdSub, DiscFormat::ISO};
+    const DiscFormat guessedFormat = GuessFormat(path);
+    if (guessedFormat != DiscFormat::Unknown && LoadWithFormat(guessedFormat, path, disc)) {
+        result.format = guessedFormat;
+    } else {
+        for (DiscFormat format : kFormats) {
+            if (format != guessedFormat && LoadWithFormat(format, path, disc)) {
+                result.format = format;
+                break;
+            }
+        }
+    }
+    if (result.format == DiscFormat::Unknown) {
+        return false;
+    }
+
+    // Read the raw header from the first data sector
+    if (!disc.sessions.empty()) {
+        if (const Track *track = disc.sessions.front().FindTrack(150)) {
+            std::array<uint8, 2048> headerData{};
+            if (track->ReadSectorUserData(150, headerData)) {
+                std::copy_n(headerData.begin(), result.rawHeader.size(), result.rawHeader.begin());
+            }
+        }
+    }
+    result.header.ReadFrom(result.rawHeader);
+
+    result.hasHash = fs::CalcDiscHash(disc, result.hash);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Disc index cache
+
+// Index file layout (all values little-endian):
+//   Header:
+//     char[4]  magic "YDIX"
+//     uint32   version
+//     uint32   entry count
+//   Entries:
+//     uint32   path length in bytes
+//     char[]   UTF-8 path
+//     uint64   file size
+//     sint64   last write time
+//     uint8    format; Unknown (0) marks files that are not loadable disc images
+//     uint8    has hash (0 or 1)
+//     uint8[16] hash
+//     uint8[256] raw Saturn header
+static constexpr std::array<char, 4> kIndexMagic = {'Y', 'D', 'I', 'X'};
+// Version 1 indexes are identical but only contain loadable disc images.
+static constexpr uint32 kIndexVersion = 2;
+static constexpr size_t kEntryFixedSize = sizeof(uint64) + sizeof(sint64) + 2 + 16 + 256;
+
+// Returns the key used to store the given path in the index.
+static std::string MakeKey(const std::filesystem::path &path) {
+    std::error_code err{};
+    std::filesystem::path absPath = std::filesystem::absolute(path, err);
+    if (err) {
+        absPath = path;
+    }
+    const std::u8string u8path = absPath.lexically_normal().u8string();
+    return {u8path.begin(), u8path.end()};
+}
+
+// Retrieves the size and last modification time of the given file.
+static bool GetFileStamp(const std::filesystem::path &path, uintmax_t &fileSize, sint64 &lastWriteTime) {
+    std::error_code err{};
+    fileSize = std::filesystem::file_size(path, err);
+    if (err) {
+        return false;
+    }
+    const auto time = std::filesystem::last_write_time(path, err);
+    if (err) {
+        return false;
+    }
+    lastWriteTime = time.time_since_epoch().count();
+    return true;
+}
+
+bool DiscIndexCache::Load(const std::filesystem::path &indexPath) {
+    m_entries.clear();
+    m_dirty = false;
+
+    std::ifstream in{indexPath, std::ios::binary};
+    if (!in) {
+        return false;
+    }
+
+    std::vector<uint8> buf{};
+    auto read = [&](size_t size) -> const uint8 * {
+        buf.resize(size);
+        in.read(reinterpret_cast<char *>(buf.data()), size);
+        return in.gcount() == static_cast<std::streamsize>(size) ? buf.data() : nullptr;
+    };
+
+    const uint8 *header = read(kIndexMagic.size() + sizeof(uint32) * 2);
+    if (header == nullptr || !std::equal(kIndexMagic.begin(), kIndexMagic.end(), header)) {
+        return false;
+    }
+    const uint32 version = util::ReadLE<uint32>(&header[4]);
+    if (version < 1 || version > kIndexVersion) {
+        return false;
+    }
+    const uint32 count = util::ReadLE<uint32>(&header[8]);
+
+    for (uint32 i = 0; i < count; ++i) {
+        const uint8 *lenData = read(sizeof(uint32));
+        if (lenData == nullptr) {
+            m_entries.clear();
+            return false;
+        }
+        const uint32 pathLength = util::ReadLE<uint32>(lenData);
+
+        const uint8 *pathData = read(pathLength);
+        if (pathData == nullptr) {
+            m_entries.clear();
+            return false;
+        }
+        std::string key{reinterpret_cast<const char *>(pathData), pathLength};
+
+        const uint8 *data = read(kEntryFixedSize);
+        if (data == nullptr) {
+            m_entries.clear();
+            return false;
+        }
+        Entry entry{};
+        entry.fileSize = util::ReadLE<uint64>(&data[0]);
+        entry.lastWriteTime = util::ReadLE<sint64>(&data[8]);
+        entry.format = static_cast<DiscFormat>(data[16]);
+        entry.hasHash = data[17] != 0;
+        std::copy_n(&data[18], entry.hash.size(), entry.hash.begin());
+        std::copy_n(&data[34], entry.rawHeader.size(), entry.rawHeader.begin());
+        if (entry.format > DiscFormat::YCD) {
+            m_entries.clear();
+            return false;
+        }
+        m_entries.insert_or_assign(std::move(key), entry);
+    }
+
+    return true;
+}
+
+bool DiscIndexCache::Save(const std::filesystem::path &indexPath) const {
+    std::vector<uint8> out{};
+    out.reserve(12 + m_entries.size() * (kEntryFixedSize + sizeof(uint32) + 128));
+
+    auto append = [&](size_t size) -> uint8 * {
+        out.resize(out.size() + size);
+        return &out[out.size() - size];
+    };
+
+    uint8 *header = append(kIndexMagic.size() + sizeof(uint32) * 2);
+    std::copy(kIndexMagic.begin(), kIndexMagic.end(), header);
+    util::WriteLE<uint32>(&header[4], kIndexVersion);
+    util::WriteLE<uint32>(&header[8], m_entries.size());
+
+    for (const auto &[key, entry] : m_entries) {
+        util::WriteLE<uint32>(append(sizeof(uint32)), key.size());
+        std::copy(key.begin(), key.end(), append(key.size()));
+
+        uint8 *data = append(kEntryFixedSize);
+        util::WriteLE<uint64>(&data[0], entry.fileSize);
+        util::WriteLE<sint64>(&data[8], entry.lastWriteTime);
+        data[16] = static_cast<uint8>(entry.format);
+        data[17] = entry.hasHash;
+        std::copy(entry.hash.begin(), entry.hash.end(), &data[18]);
+        std::copy(entry.rawHeader.begin(), entry.rawHeader.end(), &data[34]);
+    }
+
+    // Write to a temporary file first, then replace the index
+    std::filesystem::path tmpPath = indexPath;
+    tmpPath += ".tmp";
+    {
+        std::ofstream file{tmpPath, std::ios::binary | std::ios::trunc};
+        if (!file) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char *>(out.data()), out.size());
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::error_code err{};
+    std::filesystem::rename(tmpPath, indexPath, err);
+    if (err) {
+        std::filesystem::remove(tmpPath, err);
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool DiscIndexCache::Probe(const std::filesystem::path &path, DiscProbeResult &result) {
+    uintmax_t fileSize;
+    sint64 lastWriteTime;
+    if (!GetFileStamp(path, fileSize, lastWriteTime)) {
+        return false;
+    }
+
+    std::string key = MakeKey(path);
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+        const Entry &entry = it->second;
+        if (entry.fileSize == fileSize && entry.lastWriteTime == lastWriteTime) {
+            if (entry.format == DiscFormat::Unknown) {
+                // Known not to be a disc image
+                result = {};
+                return false;
+            }
+            result.format = entry.format;
+            result.rawHeader = entry.rawHeader;
+            result.header.Invalidate();
+            result.header.ReadFrom(result.rawHeader);
+            result.hash = entry.hash;
+            result.hasHash = entry.hasHash;
+            return true;
+        }
+
+        // Stale entry
+        m_entries.erase(it);
+        m_dirty = true;
+    }
+
+    // Failed probes are cached too so that rescans skip files that are not disc images
+    const bool loaded = ProbeDisc(path, result);
+
+    Entry entry{};
+    entry.fileSize = fileSize;
+    entry.lastWriteTime = lastWriteTime;
+    entry.format = result.format;
+    entry.hasHash = result.hasHash;
+    entry.hash = result.hash;
+    entry.rawHeader = result.rawHeader;
+    m_entries.insert_or_assign(std::move(key), entry);
+    m_dirty = true;
+    return loaded;
+}
+
+void DiscIndexCache::Prune() {
+    std::erase_if(m_entries, [&](const auto &item) {
+        const std::u8string u8key{item.first.begin(), item.first.end()};
+        std::error_code err{};
+        if (std::filesystem::exists(std::filesystem::path{u8key}, err)) {
+            return false;
+        }
+        m_dirty = true;
+        return true;
+    });
+}
+
+void DiscIndexCache::Clear() {
+    if (!m_entries.empty()) {
+        m_entries.clear();
+        m_dirty = true;
+    }
+}
+
+} // namespace ymir::media
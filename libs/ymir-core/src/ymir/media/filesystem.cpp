@@ -5,6 +5,7 @@
 
 #include <xxh3.h>
 
+#include <algorithm>
 #include <cassert>
 #include <unordered_map>
 #include <vector>
@@ -13,114 +14,150 @@ using namespace ymir::media::iso9660;
 
 namespace ymir::media::fs {
 
-void Filesystem::Clear() {
-    m_directories.clear();
-    m_currDirectory = ~0;
-    m_currFileOffset = 0;
-    m_hash.fill(0);
-    m_fadToFiles.clear();
-}
+namespace {
 
-bool Filesystem::Read(const Disc &disc) {
-    Clear();
-    util::ScopeGuard sgInvalidate = [&] { Clear(); };
-
-    // TODO: test multisession discs
-
-    // Bail out if there are no sessions in the disc
-    if (disc.sessions.empty()) {
-        return false;
-    }
-
-    // The Saturn uses the volume descriptor from the final session on the disc
-    const Session &session = disc.sessions.back();
-
-    // The volume descriptor is at frame address 166 (00:02:16) from the start of the session
-    const uint32 absVolumeDescAddress = session.startFrameAddress + 166;
-
-    // Find the track containing the frame address
-    const Track *pTrack = session.FindTrack(absVolumeDescAddress);
-    if (pTrack == nullptr) {
-        // Could not find track with the specified frame address
-        return false;
-    }
-    const Track &track = *pTrack;
-    if (track.controlADR != 0x41) {
-        // Not a data track
-        return false;
-    }
-
-    // Buffer for sector data
-    std::array<uint8, 2048> buf{};
+    // Finds the data track containing the volume descriptors of the final session on the disc.
+    // The Saturn uses the volume descriptor from the final session, located at frame address 166 (00:02:16) from the
+    // start of the session.
+    // Returns nullptr if there is no such track.
+    const Track *FindVolumeDescriptorTrack(const Disc &disc, uint32 &volumeDescAddress) {
+        // TODO: test multisession discs
+        if (disc.sessions.empty()) {
+            return nullptr;
+        }
+        const Session &session = disc.sessions.back();
+        volumeDescAddress = session.startFrameAddress + 166;
 
-    // Found the track; begin hashing the first 16 sectors
-    XXH3_state_t *xxh3State = XXH3_createState();
-    assert(xxh3State != NULL && "Out of memory!");
-    util::ScopeGuard sgFreeXXH3State{[&] { XXH3_freeState(xxh3State); }};
-    XXH3_128bits_reset(xxh3State);
-    for (uint32 sectorIndex = 150; sectorIndex < 166; sectorIndex++) {
-        // Fail if we can't read the sector
-        if (!track.ReadSectorUserData(sectorIndex, buf)) {
-            YMIR_DEV_CHECK();
-            return false;
+        const Track *track = session.FindTrack(volumeDescAddress);
+        if (track == nullptr || track->controlADR != 0x41) {
+            // Could not find a data track with the specified frame address
+            return nullptr;
         }
-        XXH3_128bits_update(xxh3State, buf.data(), buf.size());
+        return track;
     }
 
-    // Read volume descriptors; hash these sectors as well
-    const uint32 volumeDescAddress = absVolumeDescAddress;
-    for (uint32 sectorIndex = volumeDescAddress;; sectorIndex++) {
-        // Fail if we can't read the sector
-        if (!track.ReadSectorUserData(sectorIndex, buf)) {
-            YMIR_DEV_CHECK();
-            return false;
+    // Reads the sectors that make up the disc hash: the 16 sectors preceding the volume descriptors, followed by the
+    // volume descriptors up to and including the terminator.
+    // Invokes onVolumeDescriptor(header, sector) for every volume descriptor preceding the terminator; returning false
+    // from it aborts the scan.
+    // Returns true and writes the hash to outHash if the terminator was found.
+    template <typename TFnOnVolumeDescriptor>
+    bool HashDiscSectors(const Track &track, uint32 volumeDescAddress, XXH128Hash &outHash,
+                         TFnOnVolumeDescriptor &&onVolumeDescriptor) {
+        // Buffer for sector data
+        std::array<uint8, 2048> buf{};
+
+        XXH3_state_t *xxh3State = XXH3_createState();
+        assert(xxh3State != NULL && "Out of memory!");
+        util::ScopeGuard sgFreeXXH3State{[&] { XXH3_freeState(xxh3State); }};
+        XXH3_128bits_reset(xxh3State);
+        for (uint32 sectorIndex = 150; sectorIndex < 166; sectorIndex++) {
+            // Fail if we can't read the sector
+            if (!track.ReadSectorUserData(sectorIndex, buf)) {
+                return false;
+            }
+            XXH3_128bits_update(xxh3State, buf.data(), buf.size());
         }
-        XXH3_128bits_update(xxh3State, buf.data(), buf.size());
 
-        // Try reading volume descriptor; fail if invalid
-        VolumeDescriptorHeader volDescHeader{};
-        if (!volDescHeader.Read(buf)) {
-            YMIR_DEV_CHECK();
-            return false;
-        }
+        // Read volume descriptors; hash these sectors as well
+        for (uint32 sectorIndex = volumeDescAddress; sectorIndex <= track.endFrameAddress; sectorIndex++) {
+            // Fail if we can't read the sector
+            if (!track.ReadSectorUserData(sectorIndex, buf)) {
+                return false;
+            }
+            XXH3_128bits_update(xxh3State, buf.data(), buf.size());
 
-        // Succeed if we found a terminator
-        if (volDescHeader.type == VolumeDescriptorType::Terminator) {
-            sgInvalidate.Cancel();
-            if (!IsValid()) {
-                YMIR_DEV_CHECK();
+            // Try reading volume descriptor; fail if invalid
+            VolumeDescriptorHeader volDescHeader{};
+            if (!volDescHeader.Read(buf)) {
                 return false;
-            } else {
-                m_currDirectory = 0;
-                m_currFileOffset = 0;
+            }
+
+            // Succeed if we found a terminator
+            if (volDescHeader.type == VolumeDescriptorType::Terminator) {
                 XXH128_hash_t hash = XXH3_128bits_digest(xxh3State);
                 XXH128_canonical_t canonicalHash{};
                 XXH128_canonicalFromHash(&canonicalHash, hash);
-                std::copy_n(canonicalHash.digest, m_hash.size(), m_hash.begin());
+                std::copy_n(canonicalHash.digest, outHash.size(), outHash.begin());
                 return true;
             }
-        }
 
-        // Parse the different types of volume descriptors
-        // TODO: parse supplementary/enhanced volume descriptors, and maybe volume partition descriptors too
-        if (volDescHeader.type == VolumeDescriptorType::Primary) {
-            VolumeDescriptor volDesc{};
-            if (!volDesc.Read(buf)) {
-                YMIR_DEV_CHECK();
+            if (!onVolumeDescriptor(volDescHeader, std::span<uint8, 2048>{buf})) {
                 return false;
             }
+        }
 
-            // Try reading the path table records from the disc; fail on error
-            if (!ReadPathTableRecords(track, volDesc)) {
-                YMIR_DEV_CHECK();
-                return false;
+        // Ran out of sectors without finding a terminator
+        return false;
+    }
+
+} // namespace
+
+bool CalcDiscHash(const Disc &disc, XXH128Hash &outHash) {
+    uint32 volumeDescAddress{};
+    const Track *track = FindVolumeDescriptorTrack(disc, volumeDescAddress);
+    if (track == nullptr) {
+        return false;
+    }
+    return HashDiscSectors(*track, volumeDescAddress, outHash,
+                           [](const VolumeDescriptorHeader &, std::span<uint8, 2048>) { return true; });
+}
+
+void Filesystem::Clear() {
+    m_directories.clear();
+    m_currDirectory = ~0;
+    m_currFileOffset = 0;
+    m_hash.fill(0);
+    m_fileExtents.clear();
+    m_fileExtentsMaxEnd.clear();
+    m_pathToFileExtent.clear();
+}
+
+bool Filesystem::Read(const Disc &disc) {
+    Clear();
+    util::ScopeGuard sgInvalidate = [&] { Clear(); };
+
+    uint32 volumeDescAddress{};
+    const Track *track = FindVolumeDescriptorTrack(disc, volumeDescAddress);
+    if (track == nullptr) {
+        return false;
+    }
+
+    // Hash the disc while parsing the volume descriptors
+    // TODO: parse supplementary/enhanced volume descriptors, and maybe volume partition descriptors too
+    XXH128Hash hash{};
+    const bool hashed = HashDiscSectors(
+        *track, volumeDescAddress, hash,
+        [&](const VolumeDescriptorHeader &volDescHeader, std::span<uint8, 2048> buf) {
+            if (volDescHeader.type == VolumeDescriptorType::Primary) {
+                VolumeDescriptor volDesc{};
+                if (!volDesc.Read(buf)) {
+                    YMIR_DEV_CHECK();
+                    return false;
+                }
+
+                // Try reading the path table records from the disc; fail on error
+                if (!ReadPathTableRecords(*track, volDesc)) {
+                    YMIR_DEV_CHECK();
+                    return false;
+                }
             }
-        }
+            return true;
+        });
+    if (!hashed) {
+        YMIR_DEV_CHECK();
+        return false;
     }
 
-    // Fail if we somehow get here without finding a terminator
-    YMIR_DEV_CHECK();
-    return false;
+    sgInvalidate.Cancel();
+    if (!IsValid()) {
+        YMIR_DEV_CHECK();
+        return false;
+    }
+    m_currDirectory = 0;
+    m_currFileOffset = 0;
+    m_hash = hash;
+    return true;
 }
 
 bool Filesystem::ChangeDirectory(uint32 fileID) {
@@ -228,29 +265,49 @@ const FileInfo &media::fs::Filesystem::GetFileInfo(uint32 fileID) const {
 }
 
 const FilesystemEntry *Filesystem::GetFileAtFrameAddress(uint32 fad) const {
-    if (auto index = LookupFileIndexAtFrameAddress(fad)) {
-        auto &dir = m_directories[index->directory];
-        auto &contents = dir.GetContents();
-        return &contents[index->file];
+    if (const FileExtent *extent = FindFileExtent(fad)) {
+        assert(extent->directory < m_directories.size());
+        auto &contents = m_directories[extent->directory].GetContents();
+        assert(extent->entry < contents.size());
+        return &contents[extent->entry];
     }
     return nullptr;
 }
 
 std::string Filesystem::GetPathAtFrameAddress(uint32 fad) const {
-    if (auto index = LookupFileIndexAtFrameAddress(fad)) {
-        auto &dir = m_directories[index->directory];
-        auto &contents = dir.GetContents();
-        std::string path = BuildPath(index->directory);
-        std::string filename(contents[index->file].Name());
-        if (path == "/") {
-            return filename;
-        } else {
-            return path + "/" + filename;
-        }
+    if (const FileExtent *extent = FindFileExtent(fad)) {
+        return extent->path;
     }
     return "";
 }
 
+const FileExtent *Filesystem::FindFileExtent(uint32 fad) const {
+    // Find the last extent starting at or before the frame address
+    auto it = std::upper_bound(m_fileExtents.begin(), m_fileExtents.end(), fad,
+                               [](uint32 fad, const FileExtent &extent) { return fad < extent.startFrameAddress; });
+
+    // Walk back over extents that end before the frame address while an earlier one might still cover it
+    while (it != m_fileExtents.begin()) {
+        --it;
+        const size_t index = std::distance(m_fileExtents.begin(), it);
+        if (m_fileExtentsMaxEnd[index] < fad) {
+            break;
+        }
+        if (fad <= it->endFrameAddress) {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+const FileExtent *Filesystem::FindFileExtent(std::string_view path) const {
+    auto it = m_pathToFileExtent.find(std::string(path));
+    if (it == m_pathToFileExtent.end()) {
+        return nullptr;
+    }
+    return &m_fileExtents[it->second];
+}
+
 void Filesystem::SaveState(state::CDBlockState::FilesystemState &state) const {
     state.currDirectory = m_currDirectory;
     state.currFileOffset = m_currFileOffset;
@@ -268,24 +325,6 @@ void Filesystem::LoadState(const state::CDBlockState::FilesystemState &state) {
     m_currFileOffset = state.currFileOffset;
 }
 
-std::optional<Filesystem::FileIndex> Filesystem::LookupFileIndexAtFrameAddress(uint32 fad) const {
-    auto it = m_fadToFiles.upper_bound(fad);
-    if (it == m_fadToFiles.end()) {
-        return std::nullopt;
-    }
-
-    assert(it->second.directory < m_directories.size());
-    auto &dir = m_directories[it->second.directory];
-    auto &contents = dir.GetContents();
-
-    assert(it->second.file < contents.size());
-    auto &file = contents[it->second.file];
-    if (fad < file.FrameAddress()) {
-        return std::nullopt;
-    }
-    return it->second;
-}
-
 std::string Filesystem::BuildPath(uint16 directoryIndex) const {
     if (directoryIndex == 0) {
         // Root directory
@@ -394,7 +433,6 @@ bool Filesystem::ReadPathTableRecords(const Track &track, const VolumeDescriptor
             }
 
             // Create a directory entry
-            const size_t directoryIndex = m_directories.size();
             Directory &directory =
                 m_directories.emplace_back(dirRecord, pathTableRecord.parentDirNumber, pathTableRecord.directoryID);
             auto &contents = directory.GetContents();
@@ -445,16 +483,7 @@ bool Filesystem::ReadPathTableRecords(const Track &track, const VolumeDescriptor
                     const uint8 fileNum = 0;
 
                     // Add record to directory
-                    const size_t fsEntryIndex = contents.size();
-                    auto &fsEntry = contents.emplace_back(subdirRecord, pathRecIndex + 1, fileNum);
-
-                    // Map FAD->entry
-                    if (fsEntry.IsFile()) {
-                        const uint32 entryBaseFAD = fsEntry.FrameAddress();
-                        const uint32 entryFADCount = (fsEntry.Size() + 2047) / 2048;
-                        const uint32 finalFAD = entryBaseFAD + entryFADCount - 1;
-                        m_fadToFiles.insert({finalFAD, {directoryIndex, fsEntryIndex}});
-                    }
+                    contents.emplace_back(subdirRecord, pathRecIndex + 1, fileNum);
 
                     dirRecOffset += subdirRecord.recordSize;
                 }
@@ -491,7 +520,46 @@ bool Filesystem::ReadPathTableRecords(const Track &track, const VolumeDescriptor
         }
     }
 
+    BuildFileIndex();
+
     return true;
 }
 
+void Filesystem::BuildFileIndex() {
+    m_fileExtents.clear();
+    m_fileExtentsMaxEnd.clear();
+    m_pathToFileExtent.clear();
+
+    for (size_t dirIndex = 0; dirIndex < m_directories.size(); ++dirIndex) {
+        const auto &contents = m_directories[dirIndex].GetContents();
+        const std::string dirPath = BuildPath(dirIndex);
+        for (size_t entryIndex = 0; entryIndex < contents.size(); ++entryIndex) {
+            const FilesystemEntry &entry = contents[entryIndex];
+            if (!entry.IsFile() || entry.Size() == 0) {
+                continue;
+            }
+
+            FileExtent &extent = m_fileExtents.emplace_back();
+            extent.startFrameAddress = entry.FrameAddress() + 150;
+            extent.endFrameAddress = extent.startFrameAddress + (entry.Size() + 2047) / 2048 - 1;
+            extent.size = entry.Size();
+            extent.directory = dirIndex;
+            extent.entry = entryIndex;
+            extent.path = dirPath == "/" ? std::string(entry.Name()) : dirPath + "/" + std::string(entry.Name());
+        }
+    }
+
+    std::stable_sort(m_fileExtents.begin(), m_fileExtents.end(), [](const FileExtent &lhs, const FileExtent &rhs) {
+        return lhs.startFrameAddress < rhs.startFrameAddress;
+    });
+
+    m_fileExtentsMaxEnd.resize(m_fileExtents.size());
+    uint32 maxEnd = 0;
+    for (size_t i = 0; i < m_fileExtents.size(); ++i) {
+        maxEnd = std::max(maxEnd, m_fileExtents[i].endFrameAddress);
+        m_fileExtentsMaxEnd[i] = maxEnd;
+        m_pathToFileExtent.try_emplace(m_fileExtents[i].path, i);
+    }
+}
+
 } // namespace ymir::media::fs
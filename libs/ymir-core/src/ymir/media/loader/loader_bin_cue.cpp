@@ -176,7 +176,7 @@ bool Load(std::filesystem::path cuePath, Disc &disc, bool preloadToRAM) {
             // Reset pointer and load new file
             std::error_code err{};
             if (preloadToRAM) {
-                binaryReader = std::make_shared<MemoryBinaryReader>(binPath, err);
+                binaryReader = std::make_shared<PreloadingBinaryReader>(binPath, err);
             } else {
                 binaryReader = std::make_shared<MemoryMappedBinaryReader>(binPath, err);
             }
@@ -461,6 +461,7 @@ bool Load(std::filesystem::path cuePath, Disc &disc, bool preloadToRAM) {
     // Finish session
     session.endFrameAddress = frameAddress - 1;
     session.BuildTOC();
+    session.BuildSectorCaches();
 
     sgInvalidateDisc.Cancel();
 
@@ -1,5 +1,6 @@
 #include <ymir/media/loader/loader_chd.hpp>
 
+#include <ymir/media/binary_reader/binary_reader_preload.hpp>
 #include <ymir/media/binary_reader/binary_reader_subview.hpp>
 #include <ymir/media/frame_address.hpp>
 
@@ -7,40 +8,95 @@
 
 #include <ymir/util/arith_ops.hpp>
 #include <ymir/util/scope_guard.hpp>
+#include <ymir/util/thread_name.hpp>
 
 #include <fmt/format.h>
 #include <fmt/std.h>
 
 #include <libchdr/chd.h>
 
+#include <algorithm>
 #include <charconv>
-#include <map>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <span>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 namespace ymir::media::loader::chd {
 
 // Implementation of IBinaryReader that reads from a CHD file.
+//
+// Decompressed hunks are kept in a fixed-capacity cache backed by a single preallocated slab. Each slab slot holds one
+// hunk; slots are kept in an intrusive doubly-linked list ordered by recency of use, so lookups, insertions and
+// evictions are O(1). Once the cache is full, the least recently used hunk is evicted.
+//
+// Optionally, a pool of worker threads decompresses the hunks following the most recently read hunk ahead of time.
+// libchdr file handles are not thread-safe, so each worker opens its own handle to the CHD file. Hunks scheduled for
+// decompression are detached from the LRU list until they are ready, which keeps them from being evicted mid-flight.
+// If the reader needs a hunk that is still queued, it decompresses it directly instead of waiting for a worker.
+//
+// Reads are thread-safe, so a single reader can back the discs of several systems running on different threads. Data
+// is copied out of the cache while holding the cache lock, and reads on the main file handle are serialized.
 class CHDBinaryReader final : public IBinaryReader {
 public:
     // Initializes a CHD reader from the specified `chd_file` instance.
     // The instance is assumed to be already initialized.
-    CHDBinaryReader(chd_file *file)
+    // The path is used to open additional file handles for the decompression threads.
+    CHDBinaryReader(chd_file *file, const std::filesystem::path &path, const HunkCacheOptions &options)
         : m_file(file) {
         m_header = chd_get_header(file);
-        m_hunkBuffer.resize(m_header->hunkbytes);
+
+        const uint32 hunkSize = m_header->hunkbytes;
+        const uint32 capacity =
+            std::min<size_t>(std::max<size_t>(options.memoryBudget / hunkSize, kMinCapacity), m_header->hunkcount);
+        m_slab.resize(static_cast<size_t>(capacity) * hunkSize);
+        m_slots.resize(capacity);
+        m_hunkSlots.assign(m_header->hunkcount, kNoSlot);
+
+        // Start with all slots empty and linked in order
+        for (uint32 i = 0; i < capacity; ++i) {
+            Slot &slot = m_slots[i];
+            slot.hunk = kNoHunk;
+            slot.state = SlotState::Empty;
+            slot.prev = i == 0 ? kNoSlot : i - 1;
+            slot.next = i == capacity - 1 ? kNoSlot : i + 1;
+        }
+        m_lruHead = 0;
+        m_lruTail = capacity - 1;
+
+        m_readAheadHunks = std::min(options.readAheadHunks, capacity / 2);
+        if (m_readAheadHunks > 0) {
+            for (uint32 i = 0; i < options.decompressionThreads; ++i) {
+                chd_file *workerFile = nullptr;
+                if (chd_open(path.string().c_str(), CHD_OPEN_READ, nullptr, &workerFile) != CHDERR_NONE) {
+                    break;
+                }
+                m_workers.emplace_back([this, workerFile] { WorkerThread(workerFile); });
+            }
+        }
     }
+
     ~CHDBinaryReader() {
+        {
+            std::unique_lock lock{m_cacheMutex};
+            m_stopping = true;
+        }
+        m_jobCond.notify_all();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
         chd_close(m_file);
     }
 
-    CHDBinaryReader(const CHDBinaryReader &) = default;
-    CHDBinaryReader(CHDBinaryReader &&) = default;
+    CHDBinaryReader(const CHDBinaryReader &) = delete;
+    CHDBinaryReader(CHDBinaryReader &&) = delete;
 
-    CHDBinaryReader &operator=(const CHDBinaryReader &) = default;
-    CHDBinaryReader &operator=(CHDBinaryReader &&) = default;
+    CHDBinaryReader &operator=(const CHDBinaryReader &) = delete;
+    CHDBinaryReader &operator=(CHDBinaryReader &&) = delete;
 
     uint32 HunkSize() const {
         return m_header->hunkbytes;
@@ -67,14 +123,9 @@ public:
         const uint32 lastHunk = std::min<uint32>((offset + size - 1) / m_header->hunkbytes, m_header->hunkcount - 1);
         uintmax_t writeOffset = 0;
         uintmax_t remaining = size;
-        for (uintmax_t hunkIndex = firstHunk; hunkIndex <= lastHunk; hunkIndex++) {
-            if (!m_hunkCache.contains(hunkIndex)) {
-                chd_read(m_file, hunkIndex, m_hunkBuffer.data());
-                m_hunkCache[hunkIndex] = m_hunkBuffer;
-            }
-            auto &buffer = m_hunkCache[hunkIndex];
+        for (uint32 hunkIndex = firstHunk; hunkIndex <= lastHunk; hunkIndex++) {
             const uint32 requested = std::min<size_t>(remaining, m_header->hunkbytes - hunkOffset);
-            std::copy_n(buffer.begin() + hunkOffset, requested, output.begin() + writeOffset);
+            ReadHunk(hunkIndex, hunkOffset, requested, &output[writeOffset]);
 
             remaining -= requested;
             if (remaining == 0) {
@@ -83,14 +134,259 @@ public:
             writeOffset += requested;
             hunkOffset = 0;
         }
+
+        ScheduleReadAhead(lastHunk);
+
         return size - remaining;
     }
 
 private:
+    static constexpr uint32 kNoSlot = ~0u;
+    static constexpr uint32 kNoHunk = ~0u;
+
+    // Minimum number of hunks kept in the cache regardless of the memory budget
+    static constexpr uint32 kMinCapacity = 4;
+
+    enum class SlotState : uint8 {
+        Empty,    // Slot contains no data; linked in the LRU list
+        Ready,    // Slot contains a decompressed hunk; linked in the LRU list
+        Queued,   // Hunk is waiting to be decompressed by a worker; detached from the LRU list
+        Decoding, // Hunk is being decompressed; detached from the LRU list
+    };
+
+    struct Slot {
+        uint32 hunk;
+        uint32 prev; // Previous (more recently used) slot in the LRU list
+        uint32 next; // Next (less recently used) slot in the LRU list
+        SlotState state;
+    };
+
     chd_file *m_file;
     const chd_header *m_header;
-    mutable std::vector<uint8> m_hunkBuffer;
-    mutable std::map<uintmax_t, std::vector<uint8>> m_hunkCache;
+
+    mutable std::vector<uint8> m_slab;       // Decompressed hunk data, one hunk per slot
+    mutable std::vector<Slot> m_slots;       // Cache slots
+    mutable std::vector<uint32> m_hunkSlots; // Hunk index -> slot index, or kNoSlot if not cached
+    mutable uint32 m_lruHead;                // Most recently used slot
+    mutable uint32 m_lruTail;                // Least recently used slot
+
+    uint32 m_readAheadHunks = 0;
+    mutable uint32 m_lastScheduledHunk = kNoHunk;
+    mutable std::deque<uint32> m_jobs; // Slots queued for decompression, nearest hunks first
+
+    std::vector<std::thread> m_workers;
+    bool m_stopping = false;
+
+    mutable std::mutex m_cacheMutex;
+    mutable std::condition_variable m_jobCond;   // Signaled when jobs are queued or the workers are shut down
+    mutable std::condition_variable m_readyCond; // Signaled when a hunk is decompressed or a slot is released
+
+    mutable std::mutex m_fileMutex; // Serializes reads from m_file
+
+    uint8 *SlotData(uint32 slot) const {
+        return &m_slab[static_cast<size_t>(slot) * m_header->hunkbytes];
+    }
+
+    // -------------------------------------------------------------------------
+    // LRU list operations. Must be called with m_cacheMutex held.
+
+    void Unlink(uint32 index) const {
+        Slot &slot = m_slots[index];
+        if (slot.prev != kNoSlot) {
+            m_slots[slot.prev].next = slot.next;
+        } else {
+            m_lruHead = slot.next;
+        }
+        if (slot.next != kNoSlot) {
+            m_slots[slot.next].prev = slot.prev;
+        } else {
+            m_lruTail = slot.prev;
+        }
+        slot.prev = slot.next = kNoSlot;
+    }
+
+    void LinkFront(uint32 index) const {
+        Slot &slot = m_slots[index];
+        slot.prev = kNoSlot;
+        slot.next = m_lruHead;
+        if (m_lruHead != kNoSlot) {
+            m_slots[m_lruHead].prev = index;
+        } else {
+            m_lruTail = index;
+        }
+        m_lruHead = index;
+    }
+
+    void LinkBack(uint32 index) const {
+        Slot &slot = m_slots[index];
+        slot.prev = m_lruTail;
+        slot.next = kNoSlot;
+        if (m_lruTail != kNoSlot) {
+            m_slots[m_lruTail].next = index;
+        } else {
+            m_lruHead = index;
+        }
+        m_lruTail = index;
+    }
+
+    // Detaches the least recently used slot from the list and discards its contents.
+    uint32 Evict() const {
+        const uint32 index = m_lruTail;
+        Unlink(index);
+        Slot &slot = m_slots[index];
+        if (slot.hunk != kNoHunk) {
+            m_hunkSlots[slot.hunk] = kNoSlot;
+            slot.hunk = kNoHunk;
+        }
+        slot.state = SlotState::Empty;
+        return index;
+    }
+
+    // -------------------------------------------------------------------------
+
+    // Copies size bytes starting at offset from the decompressed contents of the specified hunk into out,
+    // decompressing the hunk if necessary.
+    void ReadHunk(uint32 hunkIndex, uint32 offset, uint32 size, uint8 *out) const {
+        std::unique_lock lock{m_cacheMutex};
+
+        while (true) {
+            const uint32 index = m_hunkSlots[hunkIndex];
+            if (index != kNoSlot) {
+                Slot &slot = m_slots[index];
+                switch (slot.state) {
+                case SlotState::Ready:
+                    // Cache hit; move to front
+                    Unlink(index);
+                    LinkFront(index);
+                    std::copy_n(SlotData(index) + offset, size, out);
+                    return;
+                case SlotState::Decoding:
+                    // A worker or another reader thread is already on it. Look the hunk up again once it is done since
+                    // it might be evicted in the meantime.
+                    m_readyCond.wait(lock, [&] { return slot.state != SlotState::Decoding; });
+                    continue;
+                case SlotState::Queued:
+                    // Take over the job; the worker will skip it
+                    Decode(lock, index);
+                    std::copy_n(SlotData(index) + offset, size, out);
+                    return;
+                default: break;
+                }
+            }
+
+            if (m_lruTail == kNoSlot) {
+                // Every slot is being decompressed by other threads
+                m_readyCond.wait(lock);
+                continue;
+            }
+
+            // Cache miss; reuse the least recently used slot
+            const uint32 newIndex = Evict();
+            Slot &slot = m_slots[newIndex];
+            slot.hunk = hunkIndex;
+            m_hunkSlots[hunkIndex] = newIndex;
+            Decode(lock, newIndex);
+            std::copy_n(SlotData(newIndex) + offset, size, out);
+            return;
+        }
+    }
+
+    // Decompresses the hunk assigned to the specified detached slot using the main file handle.
+    // Temporarily releases the cache lock while decompressing. The slot is ready and linked at the front of the LRU
+    // list on return.
+    void Decode(std::unique_lock<std::mutex> &lock, uint32 index) const {
+        Slot &slot = m_slots[index];
+        slot.state = SlotState::Decoding;
+        const uint32 hunkIndex = slot.hunk;
+        lock.unlock();
+        {
+            std::unique_lock fileLock{m_fileMutex};
+            chd_read(m_file, hunkIndex, SlotData(index));
+        }
+        lock.lock();
+        slot.state = SlotState::Ready;
+        LinkFront(index);
+        m_readyCond.notify_all();
+    }
+
+    // Queues the hunks following lastHunk for decompression on the worker threads.
+    void ScheduleReadAhead(uint32 lastHunk) const {
+        if (m_workers.empty()) {
+            return;
+        }
+
+        {
+            std::unique_lock lock{m_cacheMutex};
+            if (lastHunk == m_lastScheduledHunk) {
+                return;
+            }
+            m_lastScheduledHunk = lastHunk;
+
+            // Drop stale jobs that have not been picked up yet
+            for (uint32 index : m_jobs) {
+                Slot &slot = m_slots[index];
+                if (slot.state == SlotState::Queued) {
+                    m_hunkSlots[slot.hunk] = kNoSlot;
+                    slot.hunk = kNoHunk;
+                    slot.state = SlotState::Empty;
+                    LinkBack(index);
+                }
+            }
+            m_jobs.clear();
+            m_readyCond.notify_all();
+
+            const uint32 endHunk =
+                std::min<uint64>(static_cast<uint64>(lastHunk) + m_readAheadHunks, m_header->hunkcount - 1);
+            for (uint32 hunkIndex = lastHunk + 1; hunkIndex <= endHunk; ++hunkIndex) {
+                if (m_hunkSlots[hunkIndex] != kNoSlot) {
+                    continue;
+                }
+                if (m_lruTail == kNoSlot) {
+                    // Every slot is being decompressed by reader threads
+                    break;
+                }
+                const uint32 index = Evict();
+                Slot &slot = m_slots[index];
+                slot.hunk = hunkIndex;
+                slot.state = SlotState::Queued;
+                m_hunkSlots[hunkIndex] = index;
+                m_jobs.push_back(index);
+            }
+        }
+        m_jobCond.notify_all();
+    }
+
+    void WorkerThread(chd_file *file) {
+        util::SetCurrentThreadName("CHD decompression thread");
+
+        std::unique_lock lock{m_cacheMutex};
+        while (true) {
+            m_jobCond.wait(lock, [&] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) {
+                break;
+            }
+
+            const uint32 index = m_jobs.front();
+            m_jobs.pop_front();
+            Slot &slot = m_slots[index];
+            if (slot.state != SlotState::Queued) {
+                // Job was taken over by the reader
+                continue;
+            }
+
+            slot.state = SlotState::Decoding;
+            const uint32 hunkIndex = slot.hunk;
+            lock.unlock();
+            chd_read(file, hunkIndex, SlotData(index));
+            lock.lock();
+            slot.state = SlotState::Ready;
+            LinkFront(index);
+            m_readyCond.notify_all();
+        }
+        lock.unlock();
+
+        chd_close(file);
+    }
 };
 
 static bool SetTrackInfo(const chd_header *header, std::string_view typestring, Track &track) {
@@ -176,7 +472,7 @@ static bool SetTrackInfo(const chd_header *header, std::string_view typestring,
     return true;
 }
 
-bool Load(std::filesystem::path chdPath, Disc &disc, bool preloadToRAM) {
+bool Load(std::filesystem::path chdPath, Disc &disc, bool preloadToRAM, const HunkCacheOptions &cacheOptions) {
     util::ScopeGuard sgInvalidateDisc{[&] { disc.Invalidate(); }};
 
     chd_file *file = nullptr;
@@ -187,12 +483,20 @@ bool Load(std::filesystem::path chdPath, Disc &disc, bool preloadToRAM) {
     }
     const chd_header *header = chd_get_header(file);
 
+    std::shared_ptr<IBinaryReader> binaryReader = std::make_shared<CHDBinaryReader>(file, chdPath, cacheOptions);
     if (preloadToRAM) {
-        chd_precache(file);
+        // Decompress the entire image in the background through a separate file handle so that the preload thread
+        // doesn't compete with the emulator for the hunk cache
+        chd_file *preloadFile = nullptr;
+        if (chd_open(chdPath.string().c_str(), CHD_OPEN_READ, nullptr, &preloadFile) == CHDERR_NONE) {
+            HunkCacheOptions preloadCacheOptions{};
+            preloadCacheOptions.memoryBudget = 0; // use the smallest possible cache
+            preloadCacheOptions.decompressionThreads = 0;
+            auto preloadReader = std::make_shared<CHDBinaryReader>(preloadFile, chdPath, preloadCacheOptions);
+            binaryReader = std::make_shared<PreloadingBinaryReader>(binaryReader, preloadReader);
+        }
     }
 
-    auto binaryReader = std::make_shared<CHDBinaryReader>(file);
-
     auto &session = disc.sessions.emplace_back();
 
     std::vector<char> metabuf;
@@ -391,6 +695,7 @@ bool Load(std::filesystem::path chdPath, Disc &disc, bool preloadToRAM) {
     session.startFrameAddress = 0;
     session.endFrameAddress = frameAddress - 1;
     session.BuildTOC();
+    session.BuildSectorCaches();
 
     // Read Saturn disc header
     if (session.numTracks > 0) {
@@ -231,7 +231,7 @@ bool Load(std::filesystem::path ccdPath, Disc &disc, bool preloadToRAM) {
     std::error_code err{};
     std::shared_ptr<IBinaryReader> imgFile;
     if (preloadToRAM) {
-        imgFile = std::make_shared<MemoryBinaryReader>(imgPath, err);
+        imgFile = std::make_shared<PreloadingBinaryReader>(imgPath, err);
     } else {
         imgFile = std::make_shared<MemoryMappedBinaryReader>(imgPath, err);
     }
@@ -338,6 +338,7 @@ bool Load(std::filesystem::path ccdPath, Disc &disc, bool preloadToRAM) {
 
         // Finish session
         session.BuildTOC();
+        session.BuildSectorCaches();
     }
 
     sgInvalidateDisc.Cancel();
@@ -73,7 +73,7 @@ bool Load(std::filesystem::path isoPath, Disc &disc, bool preloadToRAM) {
 
     std::error_code err{};
     if (preloadToRAM) {
-        track.binaryReader = std::make_unique<MemoryBinaryReader>(isoPath, err);
+        track.binaryReader = std::make_unique<PreloadingBinaryReader>(isoPath, err);
     } else {
         track.binaryReader = std::make_unique<MemoryMappedBinaryReader>(isoPath, err);
     }
@@ -95,6 +95,7 @@ bool Load(std::filesystem::path isoPath, Disc &disc, bool preloadToRAM) {
     }
 
     session.BuildTOC();
+    session.BuildSectorCaches();
 
     sgInvalidateDisc.Cancel();
 
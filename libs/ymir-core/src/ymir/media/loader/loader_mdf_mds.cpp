@@ -277,7 +277,7 @@ bool Load(std::filesystem::path mdsPath, Disc &disc, bool preloadToRAM) {
                 if (!files.contains(mdfPath)) {
                     std::error_code err{};
                     if (preloadToRAM) {
-                        files.insert({mdfPath, std::make_shared<MemoryBinaryReader>(mdfPath, err)});
+                        files.insert({mdfPath, std::make_shared<PreloadingBinaryReader>(mdfPath, err)});
                     } else {
                         files.insert({mdfPath, std::make_shared<MemoryMappedBinaryReader>(mdfPath, err)});
                     }
@@ -350,6 +350,7 @@ bool Load(std::filesystem::path mdsPath, Disc &disc, bool preloadToRAM) {
         session.startFrameAddress = sessionData.sessionStart + 150;
         session.endFrameAddress = endFrameAddress;
         session.BuildTOC();
+        session.BuildSectorCaches();
     }
 
     sgInvalidateDisc.Cancel();
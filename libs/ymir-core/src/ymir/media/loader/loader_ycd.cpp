@@ -0,0 +1,700 @@
+#include <ymir/media/loader/loader_ycd.hpp>
+
+#include <ymir/media/binary_reader/binary_reader_preload.hpp>
+
+#include <ymir/core/hash.hpp>
+
+#include <ymir/util/byte_cursor.hpp>
+#include <ymir/util/data_ops.hpp>
+#include <ymir/util/scope_guard.hpp>
+
+#include <mio/mmap.hpp>
+
+#include <lz4.h>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace ymir::media::loader::ycd {
+
+static constexpr std::array<char, 4> kMagic = {'Y', 'C', 'D', '\x1A'};
+static constexpr uint32 kVersion = 1;
+static constexpr size_t kHeaderSize = 48;
+static constexpr size_t kChunkEntrySize = sizeof(uint64) + sizeof(uint32);
+
+// Uncompressed size of the chunks written by this implementation.
+// Large enough to give LZ4 some context to work with, small enough to keep random access latency low.
+static constexpr uint32 kChunkSize = 64 * 1024;
+
+// Upper bound for the chunk size accepted when loading files, to reject corrupted headers.
+static constexpr uint32 kMaxChunkSize = 16 * 1024 * 1024;
+
+namespace flags {
+    inline constexpr uint8 kMode2 = 1u << 0u;
+    inline constexpr uint8 kInterleavedSubchannel = 1u << 1u;
+    inline constexpr uint8 kBigEndian = 1u << 2u;
+} // namespace flags
+
+// -----------------------------------------------------------------------------
+// Reading
+
+struct Header {
+    uint32 chunkSize;
+    uint32 chunkCount;
+    uint64 poolSize;
+    uint64 chunkTableOffset;
+    uint64 discTableOffset;
+    uint32 discCount;
+};
+
+static bool ReadHeader(std::span<const uint8> data, Header &header) {
+    if (data.size() < kHeaderSize || !std::equal(kMagic.begin(), kMagic.end(), data.begin())) {
+        return false;
+    }
+
+    util::ByteCursor cursor{data, kMagic.size()};
+    if (cursor.Read<uint32>() != kVersion) {
+        return false;
+    }
+    header.chunkSize = cursor.Read<uint32>();
+    header.chunkCount = cursor.Read<uint32>();
+    header.poolSize = cursor.Read<uint64>();
+    header.chunkTableOffset = cursor.Read<uint64>();
+    header.discTableOffset = cursor.Read<uint64>();
+    header.discCount = cursor.Read<uint32>();
+
+    // Sanity checks
+    if (header.chunkSize == 0 || header.chunkSize > kMaxChunkSize) {
+        return false;
+    }
+    if (header.chunkCount != (header.poolSize + header.chunkSize - 1) / header.chunkSize) {
+        return false;
+    }
+    if (header.chunkTableOffset > data.size() ||
+        (data.size() - header.chunkTableOffset) / kChunkEntrySize < header.chunkCount) {
+        return false;
+    }
+    return cursor.IsOK();
+}
+
+// Decompresses chunks from the sector pool of a YCD file.
+//
+// The compressed data is accessed through a memory-mapped view of the file. A few recently decompressed chunks are
+// cached to serve sequential reads of sectors from the same chunk without decompressing it again.
+class SectorPool final : public IBinaryReader {
+public:
+    SectorPool(mio::mmap_source &&file, const Header &header)
+        : m_file(std::move(file))
+        , m_chunkSize(header.chunkSize)
+        , m_poolSize(header.poolSize) {
+
+        util::ByteCursor cursor{FileData(), header.chunkTableOffset};
+        m_chunks.resize(header.chunkCount);
+        for (Chunk &chunk : m_chunks) {
+            chunk.offset = cursor.Read<uint64>();
+            chunk.size = cursor.Read<uint32>();
+        }
+
+        for (CacheSlot &slot : m_cache) {
+            slot.chunk = kNoChunk;
+            slot.data.resize(m_chunkSize);
+        }
+    }
+
+    SectorPool(const SectorPool &) = delete;
+    SectorPool &operator=(const SectorPool &) = delete;
+
+    // Checks that every chunk lies within the file.
+    bool Validate() const {
+        const uint64 fileSize = m_file.size();
+        for (uint32 i = 0; i < m_chunks.size(); ++i) {
+            const Chunk &chunk = m_chunks[i];
+            if (chunk.offset > fileSize || fileSize - chunk.offset < chunk.size || chunk.size == 0 ||
+                chunk.size > static_cast<uint32>(LZ4_compressBound(ChunkSize(i)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uintmax_t Size() const final {
+        return m_poolSize;
+    }
+
+    // Reads size bytes from the uncompressed pool at the given offset into the output buffer.
+    // Returns the number of bytes read.
+    uintmax_t Read(uintmax_t offset, uintmax_t size, std::span<uint8> output) const final {
+        if (offset >= m_poolSize) {
+            return 0;
+        }
+        size = std::min(size, m_poolSize - offset);
+        size = std::min(size, output.size());
+
+        std::unique_lock lock{m_cacheMutex};
+        uintmax_t pos = 0;
+        while (pos < size) {
+            const uint32 chunkIndex = offset / m_chunkSize;
+            const uint32 chunkOffset = offset % m_chunkSize;
+            const std::vector<uint8> *chunkData = GetChunk(chunkIndex);
+            if (chunkData == nullptr) {
+                break;
+            }
+            const uintmax_t len = std::min<uintmax_t>(size - pos, ChunkSize(chunkIndex) - chunkOffset);
+            std::copy_n(chunkData->begin() + chunkOffset, len, output.begin() + pos);
+            pos += len;
+            offset += len;
+        }
+        return pos;
+    }
+
+private:
+    static constexpr uint32 kNoChunk = ~0u;
+    static constexpr size_t kCacheSize = 4;
+
+    struct Chunk {
+        uint64 offset;
+        uint32 size;
+    };
+
+    struct CacheSlot {
+        uint32 chunk;
+        std::vector<uint8> data;
+    };
+
+    mio::mmap_source m_file;
+    uint32 m_chunkSize;
+    uint64 m_poolSize;
+    std::vector<Chunk> m_chunks;
+
+    // Direct-mapped cache of decompressed chunks
+    mutable std::array<CacheSlot, kCacheSize> m_cache;
+    mutable std::mutex m_cacheMutex;
+
+    std::span<const uint8> FileData() const {
+        return {reinterpret_cast<const uint8 *>(m_file.data()), m_file.size()};
+    }
+
+    uint32 ChunkSize(uint32 chunkIndex) const {
+        const uint64 start = static_cast<uint64>(chunkIndex) * m_chunkSize;
+        return std::min<uint64>(m_chunkSize, m_poolSize - start);
+    }
+
+    bool DecompressChunk(uint32 chunkIndex, std::span<uint8> output) const {
+        const Chunk &chunk = m_chunks[chunkIndex];
+        const char *src = reinterpret_cast<const char *>(m_file.data()) + chunk.offset;
+        if (chunk.size == output.size()) {
+            // Stored uncompressed
+            std::copy_n(src, chunk.size, output.begin());
+            return true;
+        }
+        const int result =
+            LZ4_decompress_safe(src, reinterpret_cast<char *>(output.data()), chunk.size, output.size());
+        return result == static_cast<int>(output.size());
+    }
+
+    const std::vector<uint8> *GetChunk(uint32 chunkIndex) const {
+        CacheSlot &slot = m_cache[chunkIndex % kCacheSize];
+        if (slot.chunk != chunkIndex) {
+            if (!DecompressChunk(chunkIndex, std::span{slot.data}.first(ChunkSize(chunkIndex)))) {
+                slot.chunk = kNoChunk;
+                return nullptr;
+            }
+            slot.chunk = chunkIndex;
+        }
+        return &slot.data;
+    }
+};
+
+// Implementation of IBinaryReader that reads the data of a track from the sector pool of a YCD file.
+class YCDTrackBinaryReader final : public IBinaryReader {
+public:
+    YCDTrackBinaryReader(std::shared_ptr<const IBinaryReader> pool, uint32 sectorSize, uint64 size,
+                         std::vector<uint64> &&sectorOffsets)
+        : m_pool(std::move(pool))
+        , m_sectorSize(sectorSize)
+        , m_size(size)
+        , m_sectorOffsets(std::move(sectorOffsets)) {}
+
+    uintmax_t Size() const final {
+        return m_size;
+    }
+
+    uintmax_t Read(uintmax_t offset, uintmax_t size, std::span<uint8> output) const final {
+        if (offset >= m_size) {
+            return 0;
+        }
+        // Limit size to the smallest of the requested size, the output buffer size and the amount of bytes available in
+        // the track starting from offset
+        size = std::min(size, m_size - offset);
+        size = std::min(size, output.size());
+
+        uintmax_t pos = 0;
+        while (pos < size) {
+            const uint64 sector = offset / m_sectorSize;
+            const uint32 sectorOffset = offset % m_sectorSize;
+            const uintmax_t len = std::min<uintmax_t>(size - pos, m_sectorSize - sectorOffset);
+            const uintmax_t readLen =
+                m_pool->Read(m_sectorOffsets[sector] + sectorOffset, len, output.subspan(pos, len));
+            pos += readLen;
+            offset += readLen;
+            if (readLen < len) {
+                break;
+            }
+        }
+        return pos;
+    }
+
+private:
+    std::shared_ptr<const IBinaryReader> m_pool;
+    uint32 m_sectorSize;
+    uint64 m_size;
+    std::vector<uint64> m_sectorOffsets;
+};
+
+static bool ReadTrack(util::ByteCursor &cursor, const std::shared_ptr<const IBinaryReader> &pool, Track &track) {
+    const uint32 sectorSize = cursor.Read<uint32>();
+    track.controlADR = cursor.Read<uint8>();
+    const uint8 trackFlags = cursor.Read<uint8>();
+    track.mode2 = trackFlags & flags::kMode2;
+    track.interleavedSubchannel = trackFlags & flags::kInterleavedSubchannel;
+    track.bigEndian = trackFlags & flags::kBigEndian;
+    track.SetSectorSize(sectorSize);
+    track.startFrameAddress = cursor.Read<uint32>();
+    track.endFrameAddress = cursor.Read<uint32>();
+
+    const uint32 indexCount = cursor.Read<uint32>();
+    if (!cursor.IsOK() || indexCount > 100 || sectorSize == 0) {
+        return false;
+    }
+    track.indices.resize(indexCount);
+    for (Index &index : track.indices) {
+        index.startFrameAddress = cursor.Read<uint32>();
+        index.endFrameAddress = cursor.Read<uint32>();
+    }
+
+    const uint64 size = cursor.Read<uint64>();
+    if (!cursor.IsOK() || track.endFrameAddress < track.startFrameAddress ||
+        size > static_cast<uint64>(track.endFrameAddress - track.startFrameAddress + 1) * sectorSize) {
+        return false;
+    }
+    const uint64 sectorCount = (size + sectorSize - 1) / sectorSize;
+    std::vector<uint64> sectorOffsets(sectorCount);
+    for (uint64 i = 0; i < sectorCount; ++i) {
+        // Every sector must lie entirely within the pool
+        const uint64 offset = cursor.Read<uint64>();
+        const uint64 length = std::min<uint64>(sectorSize, size - i * sectorSize);
+        if (!cursor.IsOK() || offset > pool->Size() || pool->Size() - offset < length) {
+            return false;
+        }
+        sectorOffsets[i] = offset;
+    }
+
+    track.binaryReader = std::make_unique<YCDTrackBinaryReader>(pool, sectorSize, size, std::move(sectorOffsets));
+    return true;
+}
+
+static bool ReadSession(util::ByteCursor &cursor, const std::shared_ptr<const IBinaryReader> &pool, Session &session) {
+    session.startFrameAddress = cursor.Read<uint32>();
+    session.endFrameAddress = cursor.Read<uint32>();
+    session.firstTrackIndex = cursor.Read<uint32>();
+    session.numTracks = cursor.Read<uint32>();
+    if (!cursor.IsOK() || session.numTracks == 0 || session.firstTrackIndex >= session.tracks.size() ||
+        session.numTracks > session.tracks.size() - session.firstTrackIndex) {
+        return false;
+    }
+    session.lastTrackIndex = session.firstTrackIndex + session.numTracks - 1;
+
+    for (uint32 i = 0; i < session.numTracks; ++i) {
+        if (!ReadTrack(cursor, pool, session.tracks[session.firstTrackIndex + i])) {
+            return false;
+        }
+    }
+
+    session.BuildTOC();
+    session.BuildSectorCaches();
+    return true;
+}
+
+// Skips over a disc entry in the disc table.
+static bool SkipDisc(util::ByteCursor &cursor) {
+    const uint32 sessionCount = cursor.Read<uint32>();
+    for (uint32 i = 0; i < sessionCount && cursor.IsOK(); ++i) {
+        cursor.Read<uint32>(); // start frame address
+        cursor.Read<uint32>(); // end frame address
+        cursor.Read<uint32>(); // first track index
+        const uint32 numTracks = cursor.Read<uint32>();
+        for (uint32 j = 0; j < numTracks && cursor.IsOK(); ++j) {
+            const uint32 sectorSize = cursor.Read<uint32>();
+            cursor.Read<uint8>();  // control/ADR
+            cursor.Read<uint8>();  // flags
+            cursor.Read<uint32>(); // start frame address
+            cursor.Read<uint32>(); // end frame address
+            const uint32 indexCount = cursor.Read<uint32>();
+            for (uint32 k = 0; k < indexCount && cursor.IsOK(); ++k) {
+                cursor.Read<uint64>(); // start and end frame addresses
+            }
+            const uint64 size = cursor.Read<uint64>();
+            if (sectorSize == 0) {
+                return false;
+            }
+            const uint64 sectorCount = (size + sectorSize - 1) / sectorSize;
+            for (uint64 k = 0; k < sectorCount && cursor.IsOK(); ++k) {
+                cursor.Read<uint64>();
+            }
+        }
+    }
+    return cursor.IsOK();
+}
+
+bool Load(std::filesystem::path ycdPath, Disc &disc, bool preloadToRAM, uint32 discIndex) {
+    util::ScopeGuard sgInvalidateDisc{[&] { disc.Invalidate(); }};
+
+    std::error_code err{};
+    mio::mmap_source file = mio::make_mmap_source(ycdPath.native(), err);
+    if (err) {
+        // fmt::println("YCD: Could not open file: {}", err.message());
+        return false;
+    }
+
+    const std::span<const uint8> data{reinterpret_cast<const uint8 *>(file.data()), file.size()};
+    Header header{};
+    if (!ReadHeader(data, header)) {
+        // fmt::println("YCD: Not a YCD file or unsupported version");
+        return false;
+    }
+    if (discIndex >= header.discCount) {
+        // fmt::println("YCD: Disc {} not found; file contains {} discs", discIndex, header.discCount);
+        return false;
+    }
+
+    // Locate the disc entry
+    util::ByteCursor cursor{data, header.discTableOffset};
+    for (uint32 i = 0; i < discIndex; ++i) {
+        if (!SkipDisc(cursor)) {
+            return false;
+        }
+    }
+    const uint32 sessionCount = cursor.Read<uint32>();
+    if (!cursor.IsOK() || sessionCount == 0 || sessionCount > 99) {
+        return false;
+    }
+
+    // The pool takes ownership of the file mapping; keep reading the tables through the same view
+    auto sectorPool = std::make_shared<SectorPool>(std::move(file), header);
+    if (!sectorPool->Validate()) {
+        // fmt::println("YCD: Chunk table is corrupted");
+        return false;
+    }
+
+    std::shared_ptr<const IBinaryReader> pool = sectorPool;
+    if (preloadToRAM) {
+        // Decompress the entire pool in the background through a separate mapping so that the preload thread doesn't
+        // compete with the emulator for the chunk cache
+        mio::mmap_source preloadFile = mio::make_mmap_source(ycdPath.native(), err);
+        if (!err) {
+            auto preloadPool = std::make_shared<SectorPool>(std::move(preloadFile), header);
+            pool = std::make_shared<PreloadingBinaryReader>(sectorPool, preloadPool);
+        }
+    }
+
+    disc.sessions.clear();
+    for (uint32 i = 0; i < sessionCount; ++i) {
+        if (!ReadSession(cursor, pool, disc.sessions.emplace_back())) {
+            // fmt::println("YCD: Disc table is corrupted");
+            return false;
+        }
+    }
+
+    // Read the header
+    {
+        const Session &session = disc.sessions.front();
+        std::array<uint8, 2048> headerData{};
+        if (!session.tracks[session.firstTrackIndex].ReadSectorUserData(150, headerData)) {
+            // fmt::println("YCD: Could not read disc header");
+            return false;
+        }
+        disc.header.ReadFrom(std::span{headerData}.first<256>());
+    }
+
+    sgInvalidateDisc.Cancel();
+
+    return true;
+}
+
+uint32 GetDiscCount(std::filesystem::path ycdPath) {
+    std::ifstream in{ycdPath, std::ios::binary};
+    if (!in) {
+        return 0;
+    }
+
+    std::array<uint8, kHeaderSize> headerData{};
+    in.read(reinterpret_cast<char *>(headerData.data()), headerData.size());
+    if (in.gcount() != static_cast<std::streamsize>(headerData.size())) {
+        return 0;
+    }
+    if (!std::equal(kMagic.begin(), kMagic.end(), headerData.begin()) ||
+        util::ReadLE<uint32>(&headerData[4]) != kVersion) {
+        return 0;
+    }
+    return util::ReadLE<uint32>(&headerData[40]);
+}
+
+// -----------------------------------------------------------------------------
+// Writing
+
+// Accumulates sectors into the pool, compressing and writing out chunks as they fill up.
+class PoolWriter {
+public:
+    PoolWriter(std::ofstream &out, bool deduplicate)
+        : m_out(out)
+        , m_deduplicate(deduplicate) {
+        m_chunkBuffer.reserve(kChunkSize);
+        m_compressedBuffer.resize(LZ4_compressBound(kChunkSize));
+    }
+
+    // Adds a sector to the pool and returns its offset.
+    uint64 AddSector(std::span<const uint8> sector, WriteStats &stats) {
+        ++stats.totalSectors;
+
+        XXH128Hash hash{};
+        if (m_deduplicate) {
+            hash = CalcHash128(sector.data(), sector.size(), sector.size());
+            if (auto it = m_sectorOffsets.find(hash); it != m_sectorOffsets.end()) {
+                return it->second;
+            }
+        }
+
+        const uint64 offset = m_poolSize;
+        uintmax_t pos = 0;
+        while (pos < sector.size()) {
+            const uintmax_t len = std::min<uintmax_t>(sector.size() - pos, kChunkSize - m_chunkBuffer.size());
+            m_chunkBuffer.insert(m_chunkBuffer.end(), sector.begin() + pos, sector.begin() + pos + len);
+            pos += len;
+            if (m_chunkBuffer.size() == kChunkSize) {
+                FlushChunk();
+            }
+        }
+        m_poolSize += sector.size();
+        ++stats.uniqueSectors;
+
+        if (m_deduplicate) {
+            m_sectorOffsets.emplace(hash, offset);
+        }
+        return offset;
+    }
+
+    // Writes out the last partially filled chunk.
+    void Finish() {
+        if (!m_chunkBuffer.empty()) {
+            FlushChunk();
+        }
+    }
+
+    uint64 PoolSize() const {
+        return m_poolSize;
+    }
+
+    uint64 CompressedSize() const {
+        return m_compressedSize;
+    }
+
+    // Serializes the chunk table.
+    void WriteChunkTable(std::vector<uint8> &table) const {
+        table.resize(m_chunks.size() * kChunkEntrySize);
+        for (size_t i = 0; i < m_chunks.size(); ++i) {
+            util::WriteLE<uint64>(&table[i * kChunkEntrySize + 0], m_chunks[i].offset);
+            util::WriteLE<uint32>(&table[i * kChunkEntrySize + 8], m_chunks[i].size);
+        }
+    }
+
+    uint32 ChunkCount() const {
+        return m_chunks.size();
+    }
+
+private:
+    struct Chunk {
+        uint64 offset;
+        uint32 size;
+    };
+
+    std::ofstream &m_out;
+    bool m_deduplicate;
+
+    std::vector<uint8> m_chunkBuffer;
+    std::vector<uint8> m_compressedBuffer;
+    std::vector<Chunk> m_chunks;
+    uint64 m_poolSize = 0;
+    uint64 m_compressedSize = 0;
+
+    std::unordered_map<XXH128Hash, uint64> m_sectorOffsets;
+
+    void FlushChunk() {
+        const int compressedSize = LZ4_compress_default(reinterpret_cast<const char *>(m_chunkBuffer.data()),
+                                                        reinterpret_cast<char *>(m_compressedBuffer.data()),
+                                                        m_chunkBuffer.size(), m_compressedBuffer.size());
+
+        Chunk &chunk = m_chunks.emplace_back();
+        chunk.offset = m_out.tellp();
+        if (compressedSize <= 0 || static_cast<size_t>(compressedSize) >= m_chunkBuffer.size()) {
+            // Incompressible; store as is
+            chunk.size = m_chunkBuffer.size();
+            m_out.write(reinterpret_cast<const char *>(m_chunkBuffer.data()), m_chunkBuffer.size());
+        } else {
+            chunk.size = compressedSize;
+            m_out.write(reinterpret_cast<const char *>(m_compressedBuffer.data()), compressedSize);
+        }
+        m_compressedSize += chunk.size;
+        m_chunkBuffer.clear();
+    }
+};
+
+// Appends the description of a track to the disc table and adds its sectors to the pool.
+static void WriteTrack(const Track &track, PoolWriter &pool, std::vector<uint8> &table, WriteStats &stats) {
+    auto append = [&](size_t size) -> uint8 * {
+        table.resize(table.size() + size);
+        return &table[table.size() - size];
+    };
+
+    util::WriteLE<uint32>(append(sizeof(uint32)), track.sectorSize);
+    *append(1) = track.controlADR;
+    *append(1) = (track.mode2 ? flags::kMode2 : 0) | (track.interleavedSubchannel ? flags::kInterleavedSubchannel : 0) |
+                 (track.bigEndian ? flags::kBigEndian : 0);
+    util::WriteLE<uint32>(append(sizeof(uint32)), track.startFrameAddress);
+    util::WriteLE<uint32>(append(sizeof(uint32)), track.endFrameAddress);
+    util::WriteLE<uint32>(append(sizeof(uint32)), track.indices.size());
+    for (const Index &index : track.indices) {
+        util::WriteLE<uint32>(append(sizeof(uint32)), index.startFrameAddress);
+        util::WriteLE<uint32>(append(sizeof(uint32)), index.endFrameAddress);
+    }
+
+    // Only the sectors within the track's frame address range are ever read from the track data
+    uint64 size = 0;
+    if (track.binaryReader != nullptr && track.sectorSize != 0 && track.endFrameAddress >= track.startFrameAddress) {
+        const uint64 frames = track.endFrameAddress - track.startFrameAddress + 1;
+        size = std::min<uint64>(track.binaryReader->Size(), frames * track.sectorSize);
+    }
+
+    // Read sectors; the track data ends at the first short read
+    std::vector<uint8> sector(track.sectorSize);
+    std::vector<uint64> sectorOffsets;
+    uint64 offset = 0;
+    while (offset < size) {
+        const uintmax_t len = std::min<uint64>(track.sectorSize, size - offset);
+        const uintmax_t readLen = track.binaryReader->Read(offset, len, sector);
+        if (readLen == 0) {
+            break;
+        }
+        sectorOffsets.push_back(pool.AddSector(std::span{sector}.first(readLen), stats));
+        offset += readLen;
+        if (readLen < len) {
+            break;
+        }
+    }
+
+    util::WriteLE<uint64>(append(sizeof(uint64)), offset);
+    for (uint64 sectorOffset : sectorOffsets) {
+        util::WriteLE<uint64>(append(sizeof(uint64)), sectorOffset);
+    }
+}
+
+bool Write(std::filesystem::path ycdPath, std::span<const Disc *const> discs, const WriteOptions &options,
+           WriteStats *stats) {
+    WriteStats localStats{};
+    WriteStats &outStats = stats != nullptr ? *stats : localStats;
+    outStats = {};
+
+    if (discs.empty()) {
+        return false;
+    }
+
+    // Write to a temporary file first, then replace the target file
+    std::filesystem::path tmpPath = ycdPath;
+    tmpPath += ".tmp";
+    util::ScopeGuard sgRemoveTmp{[&] {
+        std::error_code err{};
+        std::filesystem::remove(tmpPath, err);
+    }};
+
+    {
+        std::ofstream out{tmpPath, std::ios::binary | std::ios::trunc};
+        if (!out) {
+            return false;
+        }
+
+        // Reserve space for the header; it's written once all offsets are known
+        std::array<uint8, kHeaderSize> header{};
+        out.write(reinterpret_cast<const char *>(header.data()), header.size());
+
+        PoolWriter pool{out, options.deduplicate};
+        std::vector<uint8> discTable{};
+        for (const Disc *disc : discs) {
+            // Session count is filled in after all sessions are written
+            const size_t sessionCountPos = discTable.size();
+            discTable.resize(sessionCountPos + sizeof(uint32));
+
+            uint32 sessionCount = 0;
+            for (const Session &session : disc->sessions) {
+                if (session.numTracks == 0) {
+                    continue;
+                }
+                const size_t pos = discTable.size();
+                discTable.resize(pos + sizeof(uint32) * 4);
+                util::WriteLE<uint32>(&discTable[pos + 0], session.startFrameAddress);
+                util::WriteLE<uint32>(&discTable[pos + 4], session.endFrameAddress);
+                util::WriteLE<uint32>(&discTable[pos + 8], session.firstTrackIndex);
+                util::WriteLE<uint32>(&discTable[pos + 12], session.numTracks);
+                for (uint32 i = 0; i < session.numTracks; ++i) {
+                    WriteTrack(session.tracks[session.firstTrackIndex + i], pool, discTable, outStats);
+                }
+                ++sessionCount;
+            }
+            if (sessionCount == 0) {
+                return false;
+            }
+            util::WriteLE<uint32>(&discTable[sessionCountPos], sessionCount);
+        }
+        pool.Finish();
+
+        std::vector<uint8> chunkTable{};
+        pool.WriteChunkTable(chunkTable);
+        const uint64 chunkTableOffset = out.tellp();
+        out.write(reinterpret_cast<const char *>(chunkTable.data()), chunkTable.size());
+        const uint64 discTableOffset = out.tellp();
+        out.write(reinterpret_cast<const char *>(discTable.data()), discTable.size());
+
+        std::copy(kMagic.begin(), kMagic.end(), header.begin());
+        util::WriteLE<uint32>(&header[4], kVersion);
+        util::WriteLE<uint32>(&header[8], kChunkSize);
+        util::WriteLE<uint32>(&header[12], pool.ChunkCount());
+        util::WriteLE<uint64>(&header[16], pool.PoolSize());
+        util::WriteLE<uint64>(&header[24], chunkTableOffset);
+        util::WriteLE<uint64>(&header[32], discTableOffset);
+        util::WriteLE<uint32>(&header[40], discs.size());
+        util::WriteLE<uint32>(&header[44], 0);
+        out.seekp(0);
+        out.write(reinterpret_cast<const char *>(header.data()), header.size());
+        if (!out) {
+            return false;
+        }
+
+        outStats.uncompressedSize = pool.PoolSize();
+        outStats.compressedSize = pool.CompressedSize();
+    }
+
+    std::error_code err{};
+    std::filesystem::rename(tmpPath, ycdPath, err);
+    if (err) {
+        return false;
+    }
+    sgRemoveTmp.Cancel();
+    return true;
+}
+
+} // namespace ymir::media::loader::ycd
@@ -0,0 +1,719 @@
+#include <ymir/movie/movie.hpp>
+
+#include <ymir/state/state_binary.hpp>
+#include <ymir/sys/saturn.hpp>
+
+#include <ymir/util/byte_cursor.hpp>
+#include <ymir/util/data_ops.hpp>
+
+#include <mio/mmap.hpp>
+
+#include <lz4.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <memory>
+
+namespace ymir::movie {
+
+static constexpr std::array<char, 4> kMagic = {'Y', 'M', 'V', '\x1A'};
+static constexpr uint32 kVersion = 2;
+static constexpr size_t kHeaderSize = 48;
+
+// Size of the buffered records that triggers a write to the file.
+static constexpr size_t kFlushThreshold = 64 * 1024;
+
+// Upper bound for the uncompressed size of keyframe blocks accepted when reading files, to reject corrupted data.
+static constexpr uint32 kMaxBlockSize = 64 * 1024 * 1024;
+
+namespace record {
+    inline constexpr uint8 kRepeat = 0;
+    inline constexpr uint8 kFrame = 1;
+    inline constexpr uint8 kKeyframe = 2;
+} // namespace record
+
+namespace contents {
+    inline constexpr uint8 kPort1 = 1u << 0u;
+    inline constexpr uint8 kPort2 = 1u << 1u;
+    inline constexpr uint8 kEvents = 1u << 2u;
+} // namespace contents
+
+namespace flags {
+    inline constexpr uint8 kSH2Cache = 1u << 0u;
+    inline constexpr uint8 kExternalBackupMemory = 1u << 2u;
+
+    inline constexpr uint8 kResync = 1u << 0u;
+    inline constexpr uint8 kPersistentState = 1u << 1u;
+} // namespace flags
+
+// Largest encoded peripheral report: type + Mission Stick report.
+static constexpr size_t kMaxReportSize = 1 + sizeof(uint16) + 7;
+
+using EncodedReport = std::array<uint8, kMaxReportSize>;
+
+// Encodes a peripheral report into out and returns the number of bytes used.
+static size_t EncodeReport(const peripheral::PeripheralReport &report, EncodedReport &out) {
+    using peripheral::PeripheralType;
+
+    size_t size = 0;
+    auto put8 = [&](uint8 value) { out[size++] = value; };
+    auto putButtons = [&](peripheral::Button buttons) {
+        util::WriteLE<uint16>(&out[size], static_cast<uint16>(buttons));
+        size += sizeof(uint16);
+    };
+
+    put8(static_cast<uint8>(report.type));
+    switch (report.type) {
+    case PeripheralType::None: break;
+    case PeripheralType::ControlPad: putButtons(report.report.controlPad.buttons); break;
+    case PeripheralType::AnalogPad: //
+    {
+        const auto &pad = report.report.analogPad;
+        putButtons(pad.buttons);
+        put8(pad.analog);
+        put8(pad.x);
+        put8(pad.y);
+        put8(pad.l);
+        put8(pad.r);
+        break;
+    }
+    case PeripheralType::ArcadeRacer:
+        putButtons(report.report.arcadeRacer.buttons);
+        put8(report.report.arcadeRacer.wheel);
+        break;
+    case PeripheralType::MissionStick: //
+    {
+        const auto &stick = report.report.missionStick;
+        putButtons(stick.buttons);
+        put8(stick.sixAxis);
+        put8(stick.x1);
+        put8(stick.y1);
+        put8(stick.z1);
+        put8(stick.x2);
+        put8(stick.y2);
+        put8(stick.z2);
+        break;
+    }
+    }
+    return size;
+}
+
+// Compares the relevant fields of two peripheral reports.
+static bool ReportsEqual(const peripheral::PeripheralReport &lhs, const peripheral::PeripheralReport &rhs) {
+    EncodedReport lhsData{};
+    EncodedReport rhsData{};
+    const size_t lhsSize = EncodeReport(lhs, lhsData);
+    const size_t rhsSize = EncodeReport(rhs, rhsData);
+    return lhsSize == rhsSize && std::equal(lhsData.begin(), lhsData.begin() + lhsSize, rhsData.begin());
+}
+
+static void AppendBytes(std::vector<uint8> &out, const void *data, size_t size) {
+    const uint8 *bytes = static_cast<const uint8 *>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+template <std::integral T>
+static void AppendLE(std::vector<uint8> &out, T value) {
+    std::array<uint8, sizeof(T)> bytes{};
+    util::WriteLE<T>(bytes.data(), value);
+    AppendBytes(out, bytes.data(), bytes.size());
+}
+
+static void AppendVarint(std::vector<uint8> &out, uint64 value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8>(value | 0x80));
+        value >>= 7u;
+    }
+    out.push_back(static_cast<uint8>(value));
+}
+
+// Compresses data and appends it to out as a block.
+static void AppendBlock(std::vector<uint8> &out, std::span<const uint8> data, std::vector<uint8> &compressBuffer) {
+    int compressedSize = 0;
+    if (data.size() <= LZ4_MAX_INPUT_SIZE) {
+        compressBuffer.resize(LZ4_compressBound(static_cast<int>(data.size())));
+        compressedSize = LZ4_compress_default(reinterpret_cast<const char *>(data.data()),
+                                              reinterpret_cast<char *>(compressBuffer.data()),
+                                              static_cast<int>(data.size()), static_cast<int>(compressBuffer.size()));
+    }
+
+    AppendLE<uint32>(out, data.size());
+    if (compressedSize > 0 && static_cast<size_t>(compressedSize) < data.size()) {
+        AppendLE<uint32>(out, compressedSize);
+        AppendBytes(out, compressBuffer.data(), compressedSize);
+    } else {
+        AppendLE<uint32>(out, data.size());
+        AppendBytes(out, data.data(), data.size());
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Movie information
+
+MovieInfo CaptureMovieInfo(Saturn &saturn) {
+    const auto &config = saturn.configuration;
+    return MovieInfo{
+        .iplHash = saturn.GetIPLHash(),
+        .discHash = saturn.GetDiscHash(),
+        .keyframeInterval = kDefaultKeyframeInterval,
+        .emulateSH2Cache = config.system.emulateSH2Cache,
+        .cdReadSpeedFactor = config.cdblock.readSpeedFactor,
+        .cddaBufferLatency = config.audio.cddaBufferLatency,
+        .externalBackupMemory = saturn.GetCartridge().GetType() == cart::CartType::BackupMemory,
+    };
+}
+
+void ApplyMovieInfo(const MovieInfo &info, core::Configuration &config) {
+    config.system.emulateSH2Cache = info.emulateSH2Cache;
+    config.cdblock.readSpeedFactor = info.cdReadSpeedFactor;
+    config.audio.cddaBufferLatency = info.cddaBufferLatency;
+}
+
+// -----------------------------------------------------------------------------
+// Recording
+
+MovieWriter::~MovieWriter() {
+    Close();
+}
+
+bool MovieWriter::Open(const std::filesystem::path &path, const MovieInfo &info, const state::State &initialState,
+                       std::span<const uint8> backupRAM, std::span<const uint8> persistentState,
+                       std::error_code &error) {
+    Close();
+
+    m_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_out) {
+        error.assign(errno, std::generic_category());
+        return false;
+    }
+
+    m_keyframeInterval = std::max<uint32>(info.keyframeInterval, 1);
+    m_frameCount = 0;
+    m_lastKeyframe = 0;
+    m_lastFrame = {};
+    m_repeatCount = 0;
+    m_buffer.clear();
+
+    uint8 headerFlags = 0;
+    if (info.emulateSH2Cache) {
+        headerFlags |= flags::kSH2Cache;
+    }
+    if (info.externalBackupMemory) {
+        headerFlags |= flags::kExternalBackupMemory;
+    }
+
+    AppendBytes(m_buffer, kMagic.data(), kMagic.size());
+    AppendLE<uint32>(m_buffer, kVersion);
+    AppendBytes(m_buffer, info.iplHash.data(), info.iplHash.size());
+    AppendBytes(m_buffer, info.discHash.data(), info.discHash.size());
+    AppendLE<uint32>(m_buffer, m_keyframeInterval);
+    m_buffer.push_back(headerFlags);
+    m_buffer.push_back(info.cdReadSpeedFactor);
+    m_buffer.push_back(info.cddaBufferLatency);
+    m_buffer.push_back(0);
+    assert(m_buffer.size() == kHeaderSize);
+
+    if (!WriteKeyframeRecord(initialState, backupRAM, persistentState, true)) {
+        error = std::make_error_code(std::errc::io_error);
+        m_out.close();
+        return false;
+    }
+    return true;
+}
+
+void MovieWriter::Close() {
+    if (!m_out.is_open()) {
+        return;
+    }
+    FlushRepeats();
+    FlushBuffer();
+    m_out.close();
+}
+
+bool MovieWriter::WriteKeyframe(const state::State &state, std::span<const uint8> backupRAM, bool resync) {
+    return WriteKeyframeRecord(state, backupRAM, {}, resync);
+}
+
+bool MovieWriter::WriteKeyframeRecord(const state::State &state, std::span<const uint8> backupRAM,
+                                      std::span<const uint8> persistentState, bool resync) {
+    if (!m_out.is_open()) {
+        return false;
+    }
+
+    FlushRepeats();
+
+    uint8 keyframeFlags = 0;
+    if (resync) {
+        keyframeFlags |= flags::kResync;
+    }
+    if (!persistentState.empty()) {
+        keyframeFlags |= flags::kPersistentState;
+    }
+
+    state::WriteBinaryState(state, m_stateBuffer);
+    m_buffer.push_back(record::kKeyframe);
+    AppendLE<uint64>(m_buffer, m_frameCount);
+    m_buffer.push_back(keyframeFlags);
+    AppendBlock(m_buffer, m_stateBuffer, m_compressBuffer);
+    AppendBlock(m_buffer, backupRAM, m_compressBuffer);
+    if (!persistentState.empty()) {
+        AppendBlock(m_buffer, persistentState, m_compressBuffer);
+    }
+    m_lastKeyframe = m_frameCount;
+
+    // Keyframes are rare; write them out right away so that they're not lost if the emulator crashes
+    return FlushBuffer();
+}
+
+bool MovieWriter::WriteFrame(const MovieFrame &frame) {
+    if (!m_out.is_open()) {
+        return false;
+    }
+
+    const bool port1Changed = !ReportsEqual(frame.inputs[0], m_lastFrame.inputs[0]);
+    const bool port2Changed = !ReportsEqual(frame.inputs[1], m_lastFrame.inputs[1]);
+    ++m_frameCount;
+    if (!port1Changed && !port2Changed && frame.events == 0) {
+        ++m_repeatCount;
+        return true;
+    }
+
+    FlushRepeats();
+
+    uint8 frameContents = 0;
+    if (port1Changed) {
+        frameContents |= contents::kPort1;
+    }
+    if (port2Changed) {
+        frameContents |= contents::kPort2;
+    }
+    if (frame.events != 0) {
+        frameContents |= contents::kEvents;
+    }
+
+    m_buffer.push_back(record::kFrame);
+    m_buffer.push_back(frameContents);
+    for (size_t i = 0; i < 2; ++i) {
+        if (frameContents & (contents::kPort1 << i)) {
+            EncodedReport report{};
+            const size_t size = EncodeReport(frame.inputs[i], report);
+            AppendBytes(m_buffer, report.data(), size);
+        }
+    }
+    if (frameContents & contents::kEvents) {
+        m_buffer.push_back(frame.events);
+    }
+    m_lastFrame = frame;
+
+    if (m_buffer.size() >= kFlushThreshold) {
+        return FlushBuffer();
+    }
+    return true;
+}
+
+void MovieWriter::FlushRepeats() {
+    if (m_repeatCount > 0) {
+        m_buffer.push_back(record::kRepeat);
+        AppendVarint(m_buffer, m_repeatCount);
+        m_repeatCount = 0;
+    }
+}
+
+bool MovieWriter::FlushBuffer() {
+    m_out.write(reinterpret_cast<const char *>(m_buffer.data()), m_buffer.size());
+    m_out.flush();
+    m_buffer.clear();
+    return m_out.good();
+}
+
+// -----------------------------------------------------------------------------
+// Reading
+
+static void ReadReport(util::ByteCursor &cursor, peripheral::PeripheralReport &report) {
+    using peripheral::PeripheralType;
+
+    auto readButtons = [&] { return static_cast<peripheral::Button>(cursor.Read<uint16>()); };
+
+    report = {};
+    report.type = static_cast<PeripheralType>(cursor.Read<uint8>());
+    switch (report.type) {
+    case PeripheralType::None: break;
+    case PeripheralType::ControlPad: report.report.controlPad.buttons = readButtons(); break;
+    case PeripheralType::AnalogPad: //
+    {
+        auto &pad = report.report.analogPad;
+        pad.buttons = readButtons();
+        pad.analog = cursor.Read<uint8>() != 0;
+        pad.x = cursor.Read<uint8>();
+        pad.y = cursor.Read<uint8>();
+        pad.l = cursor.Read<uint8>();
+        pad.r = cursor.Read<uint8>();
+        break;
+    }
+    case PeripheralType::ArcadeRacer:
+        report.report.arcadeRacer.buttons = readButtons();
+        report.report.arcadeRacer.wheel = cursor.Read<uint8>();
+        break;
+    case PeripheralType::MissionStick: //
+    {
+        auto &stick = report.report.missionStick;
+        stick.buttons = readButtons();
+        stick.sixAxis = cursor.Read<uint8>() != 0;
+        stick.x1 = cursor.Read<uint8>();
+        stick.y1 = cursor.Read<uint8>();
+        stick.z1 = cursor.Read<uint8>();
+        stick.x2 = cursor.Read<uint8>();
+        stick.y2 = cursor.Read<uint8>();
+        stick.z2 = cursor.Read<uint8>();
+        break;
+    }
+    default: report.type = PeripheralType::None; break;
+    }
+}
+
+// Skips over a block, validating its sizes.
+static void SkipBlock(util::ByteCursor &cursor) {
+    const uint32 size = cursor.Read<uint32>();
+    const uint32 storedSize = cursor.Read<uint32>();
+    if (size > kMaxBlockSize || storedSize > size) {
+        cursor.Skip(~0ull);
+        return;
+    }
+    cursor.Skip(storedSize);
+}
+
+bool MovieReader::Open(const std::filesystem::path &path, std::error_code &error) {
+    m_path.clear();
+    m_info = {};
+    m_frames.clear();
+    m_keyframes.clear();
+
+    mio::mmap_source file = mio::make_mmap_source(path.native(), error);
+    if (error) {
+        return false;
+    }
+    const std::span<const uint8> data{reinterpret_cast<const uint8 *>(file.data()), file.size()};
+
+    if (data.size() < kHeaderSize || !std::equal(kMagic.begin(), kMagic.end(), data.begin()) ||
+        util::ReadLE<uint32>(&data[4]) != kVersion) {
+        error = std::make_error_code(std::errc::invalid_argument);
+        return false;
+    }
+
+    util::ByteCursor cursor{data, 8};
+    for (uint8 &b : m_info.iplHash) {
+        b = cursor.Read<uint8>();
+    }
+    for (uint8 &b : m_info.discHash) {
+        b = cursor.Read<uint8>();
+    }
+    m_info.keyframeInterval = cursor.Read<uint32>();
+    const uint8 headerFlags = cursor.Read<uint8>();
+    m_info.emulateSH2Cache = headerFlags & flags::kSH2Cache;
+    m_info.externalBackupMemory = headerFlags & flags::kExternalBackupMemory;
+    m_info.cdReadSpeedFactor = cursor.Read<uint8>();
+    m_info.cddaBufferLatency = cursor.Read<uint8>();
+    cursor.Skip(1);
+
+    // Decode records until the end of the file or the first incomplete or invalid record
+    MovieFrame frame{};
+    while (!cursor.AtEnd()) {
+        util::ByteCursor recordCursor = cursor;
+        const uint8 type = recordCursor.Read<uint8>();
+        switch (type) {
+        case record::kRepeat: //
+        {
+            frame.events = 0;
+            const uint64 count = recordCursor.ReadVarint();
+            if (count > UINT32_MAX) {
+                recordCursor.Skip(~0ull);
+            }
+            if (recordCursor.IsOK()) {
+                m_frames.insert(m_frames.end(), count, frame);
+            }
+            break;
+        }
+        case record::kFrame: //
+        {
+            MovieFrame newFrame = frame;
+            newFrame.events = 0;
+            const uint8 frameContents = recordCursor.Read<uint8>();
+            for (size_t i = 0; i < 2; ++i) {
+                if (frameContents & (contents::kPort1 << i)) {
+                    ReadReport(recordCursor, newFrame.inputs[i]);
+                }
+            }
+            if (frameContents & contents::kEvents) {
+                newFrame.events = recordCursor.Read<uint8>();
+            }
+            if (recordCursor.IsOK()) {
+                frame = newFrame;
+                m_frames.push_back(frame);
+            }
+            break;
+        }
+        case record::kKeyframe: //
+        {
+            MovieKeyframe keyframe{};
+            keyframe.frame = recordCursor.Read<uint64>();
+            const uint8 keyframeFlags = recordCursor.Read<uint8>();
+            keyframe.resync = keyframeFlags & flags::kResync;
+            keyframe.persistent = keyframeFlags & flags::kPersistentState;
+            keyframe.offset = recordCursor.Offset();
+            SkipBlock(recordCursor);
+            SkipBlock(recordCursor);
+            if (keyframe.persistent) {
+                SkipBlock(recordCursor);
+            }
+            if (keyframe.frame != m_frames.size()) {
+                // Keyframes must be placed right before the frame they belong to
+                recordCursor.Skip(~0ull);
+            }
+            if (recordCursor.IsOK()) {
+                m_keyframes.push_back(keyframe);
+            }
+            break;
+        }
+        default: recordCursor.Skip(~0ull); break;
+        }
+
+        if (!recordCursor.IsOK()) {
+            break;
+        }
+        cursor = recordCursor;
+    }
+
+    if (m_keyframes.empty() || m_keyframes.front().frame != 0) {
+        m_frames.clear();
+        m_keyframes.clear();
+        error = std::make_error_code(std::errc::invalid_argument);
+        return false;
+    }
+
+    m_path = path;
+    return true;
+}
+
+size_t MovieReader::FindKeyframe(uint64 frame) const {
+    auto it = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), frame,
+                               [](uint64 value, const MovieKeyframe &keyframe) { return value < keyframe.frame; });
+    return it == m_keyframes.begin() ? 0 : std::distance(m_keyframes.begin(), it) - 1;
+}
+
+// Reads and decompresses a block from the stream.
+static bool ReadBlock(std::ifstream &in, std::vector<uint8> &out, std::vector<uint8> &compressBuffer) {
+    std::array<uint8, 8> sizes{};
+    in.read(reinterpret_cast<char *>(sizes.data()), sizes.size());
+    if (!in) {
+        return false;
+    }
+    const uint32 size = util::ReadLE<uint32>(&sizes[0]);
+    const uint32 storedSize = util::ReadLE<uint32>(&sizes[4]);
+    if (size > kMaxBlockSize || storedSize > size) {
+        return false;
+    }
+
+    out.resize(size);
+    if (storedSize == size) {
+        in.read(reinterpret_cast<char *>(out.data()), size);
+        return static_cast<bool>(in);
+    }
+
+    compressBuffer.resize(storedSize);
+    in.read(reinterpret_cast<char *>(compressBuffer.data()), storedSize);
+    if (!in) {
+        return false;
+    }
+    const int decompressedSize =
+        LZ4_decompress_safe(reinterpret_cast<const char *>(compressBuffer.data()), reinterpret_cast<char *>(out.data()),
+                            static_cast<int>(storedSize), static_cast<int>(size));
+    return decompressedSize >= 0 && static_cast<uint32>(decompressedSize) == size;
+}
+
+bool MovieReader::ReadKeyframe(size_t index, std::vector<uint8> &binaryState, std::vector<uint8> &backupRAM,
+                               std::vector<uint8> *persistentState) const {
+    if (index >= m_keyframes.size()) {
+        return false;
+    }
+
+    std::ifstream in{m_path, std::ios::binary};
+    in.seekg(m_keyframes[index].offset);
+    if (!in) {
+        return false;
+    }
+
+    std::vector<uint8> compressBuffer{};
+    if (!ReadBlock(in, binaryState, compressBuffer) || !ReadBlock(in, backupRAM, compressBuffer)) {
+        return false;
+    }
+    if (persistentState != nullptr) {
+        persistentState->clear();
+        if (m_keyframes[index].persistent) {
+            return ReadBlock(in, *persistentState, compressBuffer);
+        }
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Playback
+
+MoviePlayer::MoviePlayer(Saturn &saturn, const MovieReader &movie)
+    : m_saturn(saturn)
+    , m_movie(movie) {
+
+    auto &port1 = m_saturn.SMPC.GetPeripheralPort1();
+    auto &port2 = m_saturn.SMPC.GetPeripheralPort2();
+    port1.SetPeripheralReportCallback(util::MakeClassMemberOptionalCallback<&MoviePlayer::ReadPeripheral<1>>(this));
+    port2.SetPeripheralReportCallback(util::MakeClassMemberOptionalCallback<&MoviePlayer::ReadPeripheral<2>>(this));
+
+    // Peripherals capture the report callback when connected; reconnect them on the first frame
+    port1.DisconnectPeripherals();
+    port2.DisconnectPeripherals();
+}
+
+bool MoviePlayer::RunFrame() {
+    if (IsFinished()) {
+        return false;
+    }
+
+    const MovieFrame &frame = m_movie.GetFrame(m_currFrame);
+
+    bool restored = m_keyframeRestored;
+    m_keyframeRestored = false;
+    if (!restored) {
+        const size_t index = m_movie.FindKeyframe(m_currFrame);
+        const MovieKeyframe &keyframe = m_movie.GetKeyframes()[index];
+        if (keyframe.frame == m_currFrame && keyframe.resync) {
+            if (!RestoreKeyframe(index)) {
+                return false;
+            }
+            restored = true;
+        }
+    }
+
+    // Keyframes already include the events of their frame
+    if (!restored) {
+        if (frame.events & event::kHardReset) {
+            m_saturn.Reset(true);
+        }
+        if (frame.events & event::kSoftReset) {
+            m_saturn.Reset(false);
+        }
+        if (frame.events & event::kPressResetButton) {
+            m_saturn.SMPC.SetResetButtonState(true);
+        }
+        if (frame.events & event::kReleaseResetButton) {
+            m_saturn.SMPC.SetResetButtonState(false);
+        }
+        if (frame.events & event::kOpenTray) {
+            m_saturn.OpenTray();
+        }
+        if (frame.events & event::kCloseTray) {
+            m_saturn.CloseTray();
+        }
+    }
+
+    ConnectPeripherals(frame);
+    m_saturn.RunFrame();
+    ++m_currFrame;
+    return true;
+}
+
+bool MoviePlayer::Seek(uint64 frame) {
+    frame = std::min(frame, m_movie.GetFrameCount());
+
+    // Continue from the current position if no keyframe gets closer to the target
+    const size_t index = m_movie.FindKeyframe(frame);
+    const uint64 keyframeFrame = m_movie.GetKeyframes()[index].frame;
+    const bool started = m_currFrame > 0 || m_keyframeRestored;
+    if (!started || frame < m_currFrame || keyframeFrame > m_currFrame) {
+        if (RestoreKeyframe(index)) {
+            m_currFrame = keyframeFrame;
+        } else if (index != 0 && RestoreKeyframe(0)) {
+            // The binary state may be unusable in this build; the initial keyframe can be restored from its persistent
+            // state instead
+            m_currFrame = 0;
+        } else {
+            return false;
+        }
+        m_keyframeRestored = true;
+    }
+
+    const bool renderingEnabled = m_saturn.VDP.IsRenderingEnabled();
+    m_saturn.VDP.SetRenderingEnabled(false);
+    bool result = true;
+    while (m_currFrame < frame) {
+        if (!RunFrame()) {
+            result = false;
+            break;
+        }
+    }
+    m_saturn.VDP.SetRenderingEnabled(renderingEnabled);
+    return result;
+}
+
+bool MoviePlayer::RestoreKeyframe(size_t index) {
+    std::vector<uint8> *persistentState = m_persistentStateLoader ? &m_persistentStateBuffer : nullptr;
+    if (!m_movie.ReadKeyframe(index, m_stateBuffer, m_backupRAMBuffer, persistentState)) {
+        return false;
+    }
+
+    state::BinaryStateView view{};
+    if (!state::ParseBinaryState(m_stateBuffer, view) || !m_saturn.LoadState(view)) {
+        // Fall back to the persistent state, if there is one
+        if (persistentState == nullptr || persistentState->empty()) {
+            return false;
+        }
+        auto state = std::make_unique<state::State>();
+        if (!m_persistentStateLoader(*persistentState, *state) || !m_saturn.LoadState(*state)) {
+            return false;
+        }
+    }
+
+    // The movie was recorded without an internal backup memory image
+    if (m_backupRAMBuffer.empty()) {
+        return true;
+    }
+
+    bup::BackupMemory bupMem{};
+    if (bupMem.LoadFrom(m_backupRAMBuffer) != bup::BackupMemoryImageLoadResult::Success) {
+        return false;
+    }
+    return m_saturn.mem.SetInternalBackupRAM(std::move(bupMem));
+}
+
+void MoviePlayer::ConnectPeripherals(const MovieFrame &frame) {
+    using peripheral::PeripheralType;
+
+    auto connect = [](peripheral::PeripheralPort &port, PeripheralType type) {
+        if (port.GetPeripheral().GetType() == type) {
+            return;
+        }
+        switch (type) {
+        case PeripheralType::None: port.DisconnectPeripherals(); break;
+        case PeripheralType::ControlPad: port.ConnectControlPad(); break;
+        case PeripheralType::AnalogPad: port.ConnectAnalogPad(); break;
+        case PeripheralType::ArcadeRacer: port.ConnectArcadeRacer(); break;
+        case PeripheralType::MissionStick: port.ConnectMissionStick(); break;
+        }
+    };
+
+    connect(m_saturn.SMPC.GetPeripheralPort1(), frame.inputs[0].type);
+    connect(m_saturn.SMPC.GetPeripheralPort2(), frame.inputs[1].type);
+}
+
+template <uint32 port>
+void MoviePlayer::ReadPeripheral(peripheral::PeripheralReport &report) {
+    // Reports are requested while running a frame, so m_currFrame is the frame being run
+    if (IsFinished()) {
+        return;
+    }
+    const peripheral::PeripheralReport &input = m_movie.GetFrame(m_currFrame).inputs[port - 1];
+    if (input.type == report.type) {
+        report.report = input.report;
+    }
+}
+
+} // namespace ymir::movie
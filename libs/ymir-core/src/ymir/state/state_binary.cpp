@@ -0,0 +1,407 @@
+#include <ymir/state/state_binary.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+namespace ymir::state {
+
+namespace {
+
+    // Computes a fingerprint of the layout of all structs stored as raw memory blocks.
+    constexpr uint64 ComputeLayoutHash() {
+        uint64 hash = 0xCBF29CE484222325ull;
+        auto mix = [&](uint64 value) {
+            hash ^= value;
+            hash *= 0x100000001B3ull;
+        };
+        mix(kBinaryStateLayoutRevision);
+        auto mixType = [&]<typename T>(std::type_identity<T>) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            mix(sizeof(T));
+            mix(alignof(T));
+        };
+        mixType(std::type_identity<SchedulerState>{});
+        mixType(std::type_identity<SystemState>{});
+        mixType(std::type_identity<SH2State>{});
+        mixType(std::type_identity<SCUDMAState>{});
+        mixType(std::type_identity<SCUDSPState>{});
+        mixType(std::type_identity<VDPState>{});
+        mixType(std::type_identity<SCSPState>{});
+        mixType(std::type_identity<CDBlockState>{});
+
+        // Catch changes to the fields stored individually
+        mix(sizeof(SCUState));
+        mix(sizeof(SMPCState));
+        return hash;
+    }
+
+    constexpr uint64 kLayoutHash = ComputeLayoutHash();
+
+    constexpr size_t kSectionCount = static_cast<size_t>(BinaryStateSectionID::Count);
+
+    constexpr size_t kTableOffset = sizeof(BinaryStateHeader);
+    constexpr size_t kContentsOffset = kTableOffset + sizeof(BinaryStateSection) * kSectionCount;
+
+    constexpr size_t AlignUp(size_t value) {
+        return (value + kBinaryStateAlignment - 1) & ~(kBinaryStateAlignment - 1);
+    }
+
+    // Invokes fn on every field of the SCU state stored in the SCU section, in order.
+    template <typename TSCUState, typename Fn>
+    void VisitFields(TSCUState &s, Fn &&fn)
+        requires std::is_same_v<std::remove_const_t<TSCUState>, SCUState>
+    {
+        fn(s.dma);
+        fn(s.dsp);
+        fn(s.cartType);
+        fn(s.intrMask);
+        fn(s.intrStatus);
+        fn(s.abusIntrsPendingAck);
+        fn(s.pendingIntrLevel);
+        fn(s.pendingIntrIndex);
+        fn(s.timer0Counter);
+        fn(s.timer0Compare);
+        fn(s.timer1Reload);
+        fn(s.timer1Mode);
+        fn(s.timer1Triggered);
+        fn(s.timerEnable);
+        fn(s.wramSizeSelect);
+    }
+
+    // Invokes fn on every field of the SMPC state stored in the SMPC section, in order.
+    template <typename TSMPCState, typename Fn>
+    void VisitFields(TSMPCState &s, Fn &&fn)
+        requires std::is_same_v<std::remove_const_t<TSMPCState>, SMPCState>
+    {
+        fn(s.IREG);
+        fn(s.OREG);
+        fn(s.COMREG);
+        fn(s.SR);
+        fn(s.SF);
+        fn(s.PDR1);
+        fn(s.PDR2);
+        fn(s.DDR1);
+        fn(s.DDR2);
+        fn(s.IOSEL);
+        fn(s.EXLE);
+        fn(s.intback.getPeripheralData);
+        fn(s.intback.optimize);
+        fn(s.intback.port1mode);
+        fn(s.intback.port2mode);
+        fn(s.intback.reportOffset);
+        fn(s.intback.inProgress);
+        fn(s.busValue);
+        fn(s.resetDisable);
+        fn(s.rtcTimestamp);
+        fn(s.rtcSysClockCount);
+    }
+
+    template <typename TState>
+    size_t GetFieldsSize(const TState &s) {
+        size_t size = 0;
+        VisitFields(s, [&](const auto &field) { size += sizeof(field); });
+        return size;
+    }
+
+    template <typename TState>
+    void WriteFields(const TState &s, uint8 *out) {
+        VisitFields(s, [&](const auto &field) {
+            std::memcpy(out, &field, sizeof(field));
+            out += sizeof(field);
+        });
+    }
+
+    template <typename TState>
+    void ReadFields(TState &s, const uint8 *in) {
+        VisitFields(s, [&](auto &field) {
+            std::memcpy(&field, in, sizeof(field));
+            in += sizeof(field);
+        });
+    }
+
+    // A block of tracked memory within a state object.
+    struct Block {
+        size_t offset; // Offset from the start of the state object
+        size_t size;
+    };
+
+    // Lists the tracked memory regions of the state, sorted by offset.
+    std::vector<Block> GetTrackedBlocks(const State &state) {
+        // Only the addresses of the pages are needed here
+        State &mutState = const_cast<State &>(state);
+        const uint8 *base = reinterpret_cast<const uint8 *>(&state);
+
+        std::vector<Block> blocks;
+        for (size_t i = 0; i < kNumMemoryRegions; i++) {
+            const auto region = static_cast<MemoryRegion>(i);
+            const size_t pageCount = GetMemoryPageCount(region);
+            if (region == MemoryRegion::CDBlockBuffers) {
+                for (size_t page = 0; page < pageCount; page++) {
+                    const auto data = GetMemoryPage(mutState, region, page);
+                    blocks.push_back({static_cast<size_t>(data.data() - base), data.size()});
+                }
+            } else {
+                const auto data = GetMemoryPage(mutState, region, 0);
+                blocks.push_back({static_cast<size_t>(data.data() - base), pageCount * kMemoryPageSize});
+            }
+        }
+        std::ranges::sort(blocks, {}, &Block::offset);
+        return blocks;
+    }
+
+    // Describes how a raw section maps to the state object.
+    struct RawSection {
+        BinaryStateSectionID id;
+        size_t offset; // Offset of the struct from the start of the state object
+        size_t size;   // Size of the struct
+    };
+
+    template <typename T>
+    RawSection MakeRawSection(BinaryStateSectionID id, const State &state, const T &member) {
+        const size_t offset = reinterpret_cast<const uint8 *>(&member) - reinterpret_cast<const uint8 *>(&state);
+        return {id, offset, sizeof(T)};
+    }
+
+    std::array<RawSection, 7> GetRawSections(const State &state) {
+        using enum BinaryStateSectionID;
+        return {
+            MakeRawSection(Scheduler, state, state.scheduler), MakeRawSection(System, state, state.system),
+            MakeRawSection(MSH2, state, state.msh2),           MakeRawSection(SSH2, state, state.ssh2),
+            MakeRawSection(VDP, state, state.vdp),             MakeRawSection(SCSP, state, state.scsp),
+            MakeRawSection(CDBlock, state, state.cdblock),
+        };
+    }
+
+    // Invokes fn(offset, size) for each part of the raw section not covered by the excluded blocks.
+    template <typename Fn>
+    void ForEachIncludedRange(const RawSection &section, std::span<const Block> exclude, Fn &&fn) {
+        size_t pos = section.offset;
+        const size_t end = section.offset + section.size;
+        for (const Block &block : exclude) {
+            if (block.offset + block.size <= pos) {
+                continue;
+            }
+            if (block.offset >= end) {
+                break;
+            }
+            if (block.offset > pos) {
+                fn(pos, block.offset - pos);
+            }
+            pos = block.offset + block.size;
+        }
+        if (pos < end) {
+            fn(pos, end - pos);
+        }
+    }
+
+    size_t GetIncludedSize(const RawSection &section, std::span<const Block> exclude) {
+        size_t size = 0;
+        ForEachIncludedRange(section, exclude, [&](size_t, size_t rangeSize) { size += rangeSize; });
+        return size;
+    }
+
+    // Computes the expected size of each section.
+    std::array<size_t, kSectionCount> GetSectionSizes(const State &state, std::span<const Block> exclude,
+                                                      size_t cartDataSize, size_t reportSize) {
+        using enum BinaryStateSectionID;
+        std::array<size_t, kSectionCount> sizes{};
+        for (const RawSection &section : GetRawSections(state)) {
+            sizes[static_cast<size_t>(section.id)] = GetIncludedSize(section, exclude);
+        }
+        sizes[static_cast<size_t>(SCU)] = GetFieldsSize(state.scu);
+        sizes[static_cast<size_t>(SCUCartData)] = cartDataSize;
+        sizes[static_cast<size_t>(SMPC)] = GetFieldsSize(state.smpc);
+        sizes[static_cast<size_t>(SMPCReport)] = reportSize;
+        sizes[static_cast<size_t>(Spillover)] = sizeof(uint64) * 2;
+        return sizes;
+    }
+
+    // Validates the header and section table of a binary state.
+    // Returns the header and fills in the section table if valid.
+    bool ValidateBinaryState(std::span<const uint8> data, BinaryStateHeader &header,
+                             std::array<BinaryStateSection, kSectionCount> &sections) {
+        if (data.size() < kContentsOffset) {
+            return false;
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (header.magic != kBinaryStateMagic || header.byteOrderMark != kBinaryStateByteOrderMark ||
+            header.version != kBinaryStateVersion || header.layoutHash != kLayoutHash ||
+            (header.flags & ~kBinaryStateFlagNoTrackedMemory) != 0 || header.sectionCount != kSectionCount ||
+            header.size > data.size() || header.size < kContentsOffset) {
+            return false;
+        }
+
+        std::memcpy(sections.data(), &data[kTableOffset], sizeof(sections));
+        for (size_t i = 0; i < kSectionCount; i++) {
+            const BinaryStateSection &section = sections[i];
+            if (static_cast<size_t>(section.id) != i || section.offset < kContentsOffset ||
+                section.offset > header.size || section.size > header.size - section.offset) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Checks that the section sizes match the ones expected for the given state object.
+    bool ValidateSectionSizes(const State &state, const BinaryStateHeader &header,
+                              const std::array<BinaryStateSection, kSectionCount> &sections) {
+        using enum BinaryStateSectionID;
+        std::vector<Block> exclude;
+        if (header.flags & kBinaryStateFlagNoTrackedMemory) {
+            exclude = GetTrackedBlocks(state);
+        }
+        const auto sizes = GetSectionSizes(state, exclude, sections[static_cast<size_t>(SCUCartData)].size,
+                                           sections[static_cast<size_t>(SMPCReport)].size);
+        for (size_t i = 0; i < kSectionCount; i++) {
+            if (sections[i].size != sizes[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+void WriteBinaryState(const State &state, std::vector<uint8> &out, bool excludeTrackedMemory) {
+    using enum BinaryStateSectionID;
+
+    std::vector<Block> exclude;
+    if (excludeTrackedMemory) {
+        exclude = GetTrackedBlocks(state);
+    }
+
+    // Lay out sections
+    const auto sizes = GetSectionSizes(state, exclude, state.scu.cartData.size(), state.smpc.intback.report.size());
+    std::array<BinaryStateSection, kSectionCount> sections{};
+    size_t offset = kContentsOffset;
+    for (size_t i = 0; i < kSectionCount; i++) {
+        offset = AlignUp(offset);
+        sections[i].id = static_cast<BinaryStateSectionID>(i);
+        sections[i].reserved = 0;
+        sections[i].offset = offset;
+        sections[i].size = sizes[i];
+        offset += sizes[i];
+    }
+
+    out.resize(offset);
+    uint8 *dst = out.data();
+
+    BinaryStateHeader header{};
+    header.magic = kBinaryStateMagic;
+    header.version = kBinaryStateVersion;
+    header.byteOrderMark = kBinaryStateByteOrderMark;
+    header.flags = excludeTrackedMemory ? kBinaryStateFlagNoTrackedMemory : 0u;
+    header.sectionCount = kSectionCount;
+    header.layoutHash = kLayoutHash;
+    header.size = offset;
+    std::memcpy(dst, &header, sizeof(header));
+    std::memcpy(&dst[kTableOffset], sections.data(), sizeof(sections));
+
+    // Copy raw memory blocks
+    const uint8 *src = reinterpret_cast<const uint8 *>(&state);
+    for (const RawSection &rawSection : GetRawSections(state)) {
+        uint8 *sectionDst = &dst[sections[static_cast<size_t>(rawSection.id)].offset];
+        ForEachIncludedRange(rawSection, exclude, [&](size_t rangeOffset, size_t rangeSize) {
+            std::memcpy(sectionDst, &src[rangeOffset], rangeSize);
+            sectionDst += rangeSize;
+        });
+    }
+
+    // Write individual fields and vector contents
+    auto sectionData = [&](BinaryStateSectionID id) { return &dst[sections[static_cast<size_t>(id)].offset]; };
+    WriteFields(state.scu, sectionData(SCU));
+    std::ranges::copy(state.scu.cartData, sectionData(SCUCartData));
+    WriteFields(state.smpc, sectionData(SMPC));
+    std::ranges::copy(state.smpc.intback.report, sectionData(SMPCReport));
+    std::memcpy(sectionData(Spillover), &state.msh2SpilloverCycles, sizeof(uint64));
+    std::memcpy(sectionData(Spillover) + sizeof(uint64), &state.ssh2SpilloverCycles, sizeof(uint64));
+}
+
+bool ReadBinaryState(std::span<const uint8> data, State &state) {
+    using enum BinaryStateSectionID;
+
+    BinaryStateHeader header{};
+    std::array<BinaryStateSection, kSectionCount> sections{};
+    if (!ValidateBinaryState(data, header, sections) || !ValidateSectionSizes(state, header, sections)) {
+        return false;
+    }
+
+    std::vector<Block> exclude;
+    if (header.flags & kBinaryStateFlagNoTrackedMemory) {
+        exclude = GetTrackedBlocks(state);
+    }
+
+    // Copy raw memory blocks
+    uint8 *dst = reinterpret_cast<uint8 *>(&state);
+    for (const RawSection &rawSection : GetRawSections(state)) {
+        const uint8 *sectionSrc = &data[sections[static_cast<size_t>(rawSection.id)].offset];
+        ForEachIncludedRange(rawSection, exclude, [&](size_t rangeOffset, size_t rangeSize) {
+            std::memcpy(&dst[rangeOffset], sectionSrc, rangeSize);
+            sectionSrc += rangeSize;
+        });
+    }
+
+    // Read individual fields and vector contents
+    auto sectionData = [&](BinaryStateSectionID id) {
+        const BinaryStateSection &section = sections[static_cast<size_t>(id)];
+        return data.subspan(section.offset, section.size);
+    };
+    ReadFields(state.scu, sectionData(SCU).data());
+    state.scu.cartData.assign(sectionData(SCUCartData).begin(), sectionData(SCUCartData).end());
+    ReadFields(state.smpc, sectionData(SMPC).data());
+    state.smpc.intback.report.assign(sectionData(SMPCReport).begin(), sectionData(SMPCReport).end());
+    std::memcpy(&state.msh2SpilloverCycles, sectionData(Spillover).data(), sizeof(uint64));
+    std::memcpy(&state.ssh2SpilloverCycles, sectionData(Spillover).data() + sizeof(uint64), sizeof(uint64));
+
+    return true;
+}
+
+bool ParseBinaryState(std::span<const uint8> data, BinaryStateView &view) {
+    using enum BinaryStateSectionID;
+
+    BinaryStateHeader header{};
+    std::array<BinaryStateSection, kSectionCount> sections{};
+    if (!ValidateBinaryState(data, header, sections) || (header.flags & kBinaryStateFlagNoTrackedMemory)) {
+        return false;
+    }
+
+    // Raw sections must match the size of their structs and be suitably aligned to be referenced in place.
+    // Section sizes of the individually stored fields are constant.
+    auto sectionData = [&](BinaryStateSectionID id) {
+        const BinaryStateSection &section = sections[static_cast<size_t>(id)];
+        return data.subspan(section.offset, section.size);
+    };
+    bool valid = true;
+    auto rawSection = [&]<typename T>(BinaryStateSectionID id, const T *&ptr) {
+        const auto section = sectionData(id);
+        if (section.size() != sizeof(T) || reinterpret_cast<uintptr_t>(section.data()) % alignof(T) != 0) {
+            valid = false;
+            return;
+        }
+        ptr = reinterpret_cast<const T *>(section.data());
+    };
+    rawSection(Scheduler, view.scheduler);
+    rawSection(System, view.system);
+    rawSection(MSH2, view.msh2);
+    rawSection(SSH2, view.ssh2);
+    rawSection(VDP, view.vdp);
+    rawSection(SCSP, view.scsp);
+    rawSection(CDBlock, view.cdblock);
+    if (!valid || sectionData(SCU).size() != GetFieldsSize(view.scu) ||
+        sectionData(SMPC).size() != GetFieldsSize(view.smpc) || sectionData(Spillover).size() != sizeof(uint64) * 2) {
+        return false;
+    }
+
+    ReadFields(view.scu, sectionData(SCU).data());
+    view.scu.cartData.assign(sectionData(SCUCartData).begin(), sectionData(SCUCartData).end());
+    ReadFields(view.smpc, sectionData(SMPC).data());
+    view.smpc.intback.report.assign(sectionData(SMPCReport).begin(), sectionData(SMPCReport).end());
+    std::memcpy(&view.msh2SpilloverCycles, sectionData(Spillover).data(), sizeof(uint64));
+    std::memcpy(&view.ssh2SpilloverCycles, sectionData(Spillover).data() + sizeof(uint64), sizeof(uint64));
+
+    return true;
+}
+
+} // namespace ymir::state
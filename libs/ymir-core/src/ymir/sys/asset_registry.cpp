@@ -0,0 +1,100 @@
+#include <ymir/sys/asset_registry.hpp>
+
+#include <ymir/media/loader/loader.hpp>
+
+#include <algorithm>
+
+namespace ymir::sys {
+
+namespace {
+
+    // Sums the reference counts of the binary readers of all tracks in the disc.
+    long ReaderUseCount(const media::Disc &disc) {
+        long count = 0;
+        for (const media::Session &session : disc.sessions) {
+            for (uint32 i = 0; i < session.numTracks; i++) {
+                count += session.tracks[session.firstTrackIndex + i].binaryReader.use_count();
+            }
+        }
+        return count;
+    }
+
+    template <typename TMap>
+    void EraseUnused(TMap &map) {
+        std::erase_if(map, [](const auto &entry) { return entry.second.use_count() == 1; });
+    }
+
+} // namespace
+
+std::shared_ptr<const IPLImage> AssetRegistry::GetIPL(std::span<const uint8, kIPLSize> ipl) {
+    const XXH128Hash hash = CalcHash128(ipl.data(), ipl.size(), kIPLHashSeed);
+
+    std::unique_lock lock{m_mutex};
+    auto &image = m_iplImages[hash];
+    if (image == nullptr) {
+        image = IPLImage::Create(ipl);
+    }
+    return image;
+}
+
+std::shared_ptr<const cart::ROMImage> AssetRegistry::GetROMCart(std::span<const uint8> rom) {
+    auto newImage = std::make_shared<cart::ROMImage>();
+    std::copy_n(rom.begin(), std::min(rom.size(), cart::kROMCartSize), newImage->data.begin());
+    const XXH128Hash hash = CalcHash128(newImage->data.data(), newImage->data.size(), cart::kROMCartHashSeed);
+
+    std::unique_lock lock{m_mutex};
+    auto &image = m_romImages[hash];
+    if (image == nullptr) {
+        image = std::move(newImage);
+    }
+    return image;
+}
+
+bool AssetRegistry::LoadDisc(const std::filesystem::path &path, media::Disc &disc, bool preloadToRAM,
+                             const media::loader::chd::HunkCacheOptions &chdCacheOptions) {
+    std::error_code error{};
+    std::filesystem::path key = std::filesystem::weakly_canonical(path, error);
+    if (error) {
+        key = std::filesystem::absolute(path, error);
+        if (error) {
+            key = path;
+        }
+    }
+
+    // The lock is held while loading so that concurrent requests for the same path load the image only once
+    std::unique_lock lock{m_mutex};
+    if (auto it = m_discs.find(key); it != m_discs.end()) {
+        disc = it->second.disc.Clone();
+        return true;
+    }
+
+    media::Disc loadedDisc{};
+    if (!media::LoadDisc(path, loadedDisc, preloadToRAM, chdCacheOptions)) {
+        disc.Invalidate();
+        return false;
+    }
+    // Take the base count before handing out the first copy
+    const long baseUseCount = ReaderUseCount(loadedDisc);
+    disc = loadedDisc.Clone();
+    m_discs.emplace(std::move(key), DiscEntry{std::move(loadedDisc), baseUseCount});
+    return true;
+}
+
+void AssetRegistry::ReleaseUnused() {
+    std::unique_lock lock{m_mutex};
+    EraseUnused(m_iplImages);
+    EraseUnused(m_romImages);
+    std::erase_if(m_discs, [](const auto &entry) {
+        const DiscEntry &discEntry = entry.second;
+        return ReaderUseCount(discEntry.disc) == discEntry.baseUseCount;
+    });
+}
+
+void AssetRegistry::Clear() {
+    std::unique_lock lock{m_mutex};
+    m_iplImages.clear();
+    m_romImages.clear();
+    m_discs.clear();
+}
+
+} // namespace ymir::sys
@@ -43,10 +43,40 @@ BackupMemoryImageLoadResult BackupMemory::LoadFrom(const std::filesystem::path &
 
     // Attempt to memory-map the file
     m_backupRAM = mio::make_mmap_sink(path.native(), error);
+    m_memory = {};
+    m_data = {reinterpret_cast<uint8 *>(m_backupRAM.data()), m_backupRAM.size()};
     if (error) {
         return BackupMemoryImageLoadResult::FilesystemError;
     }
 
+    const BackupMemoryImageLoadResult result = SetupImage();
+    if (result != BackupMemoryImageLoadResult::Success) {
+        m_backupRAM.unmap();
+        return result;
+    }
+
+    m_path = path;
+
+    return BackupMemoryImageLoadResult::Success;
+}
+
+BackupMemoryImageLoadResult BackupMemory::LoadFrom(std::span<const uint8> image) {
+    m_backupRAM.unmap();
+    m_memory.assign(image.begin(), image.end());
+    m_data = m_memory;
+
+    const BackupMemoryImageLoadResult result = SetupImage();
+    if (result != BackupMemoryImageLoadResult::Success) {
+        m_memory = {};
+        return result;
+    }
+
+    m_path.clear();
+
+    return BackupMemoryImageLoadResult::Success;
+}
+
+BackupMemoryImageLoadResult BackupMemory::SetupImage() {
     m_addressShift = CheckInterleaved() ? 1u : 0u;
 
     // Determine if image size matches any valid backup memory size
@@ -54,7 +84,7 @@ BackupMemoryImageLoadResult BackupMemory::LoadFrom(const std::filesystem::path &
     BackupMemorySize size{};
     for (uint32 i = 0; i < std::size(kSizes); i++) {
         // Check for double size in case the image is interleaved
-        if (m_backupRAM.size() == (kSizes[i] << m_addressShift)) {
+        if (m_data.size() == (kSizes[i] << m_addressShift)) {
             valid = true;
             size = static_cast<BackupMemorySize>(i);
             break;
@@ -62,20 +92,19 @@ BackupMemoryImageLoadResult BackupMemory::LoadFrom(const std::filesystem::path &
     }
     if (!valid) {
         // Fail without specifying error code
-        m_backupRAM.unmap();
+        m_data = {};
+        m_addressMask = 0;
         return BackupMemoryImageLoadResult::InvalidSize;
     }
 
     // Update parameters
     m_headerValid = CheckHeader();
-    m_addressMask = m_backupRAM.size() - 1u;
+    m_addressMask = m_data.size() - 1u;
     m_blockSize = kBlockSizes[static_cast<size_t>(size)];
     m_blockBitmap.resize(GetTotalBlocks() / 64u);
 
     RebuildFileList(true);
 
-    m_path = path;
-
     return BackupMemoryImageLoadResult::Success;
 }
 
@@ -108,13 +137,15 @@ void BackupMemory::CreateFrom(const std::filesystem::path &path, BackupMemorySiz
 
     // Attempt to memory-map the file
     m_backupRAM = mio::make_mmap_sink(path.native(), error);
+    m_memory = {};
+    m_data = {reinterpret_cast<uint8 *>(m_backupRAM.data()), m_backupRAM.size()};
     if (error) {
         return;
     }
 
     // Update parameters
     m_addressShift = CheckInterleaved() ? 1u : 0u;
-    m_addressMask = m_backupRAM.size() - 1u;
+    m_addressMask = m_data.size() - 1u;
     m_blockSize = kBlockSizes[static_cast<size_t>(size)];
     m_blockBitmap.resize(GetTotalBlocks() / 64u);
 
@@ -193,7 +224,7 @@ bool BackupMemory::IsHeaderValid() const {
 }
 
 uint32 BackupMemory::Size() const {
-    return m_backupRAM.size() >> m_addressShift;
+    return m_data.size() >> m_addressShift;
 }
 
 uint32 BackupMemory::GetBlockSize() const {
@@ -245,8 +276,8 @@ void BackupMemory::Format() {
 
     // Fill even bytes with FFs if the file is interleaved
     if (m_addressShift > 0) {
-        for (uint32 i = 0; i < m_backupRAM.size(); i += 2) {
-            m_backupRAM[i] = 0xFF;
+        for (uint32 i = 0; i < m_data.size(); i += 2) {
+            m_data[i] = 0xFF;
         }
     }
 
@@ -545,8 +576,8 @@ void BackupMemory::RebuildFileList(bool force) const {
 
 bool BackupMemory::CheckInterleaved() const {
     // Checks if the image is in interleaved format: FF xx FF xx FF xx ...
-    for (uint32 i = 0; i < m_backupRAM.size(); i += 2) {
-        if (static_cast<uint8>(m_backupRAM[i]) != 0xFFu) {
+    for (uint32 i = 0; i < m_data.size(); i += 2) {
+        if (static_cast<uint8>(m_data[i]) != 0xFFu) {
             return false;
         }
     }
@@ -678,7 +709,7 @@ FORCE_INLINE uint8 BackupMemory::DataReadByte(uint32 address) const {
     if (m_addressMask != 0) {
         address <<= m_addressShift;
         address |= m_addressShift;
-        return m_backupRAM[address & m_addressMask];
+        return m_data[address & m_addressMask];
     } else {
         return 0xFFu;
     }
@@ -715,7 +746,7 @@ FORCE_INLINE void BackupMemory::DataWriteByte(uint32 address, uint8 value) {
     if (m_addressMask != 0) {
         address <<= m_addressShift;
         address |= m_addressShift;
-        m_backupRAM[address & m_addressMask] = value;
+        m_data[address & m_addressMask] = value;
         m_dirty = true;
     }
 }
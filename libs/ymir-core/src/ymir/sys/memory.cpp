@@ -2,10 +2,21 @@
 
 #include "null_ipl.hpp"
 
+#include <cassert>
+
 namespace ymir::sys {
 
+std::shared_ptr<const IPLImage> IPLImage::Create(std::span<const uint8, kIPLSize> ipl) {
+    auto image = std::make_shared<IPLImage>();
+    std::copy(ipl.begin(), ipl.end(), image->data.begin());
+    image->hash = CalcHash128(image->data.data(), image->data.size(), kIPLHashSeed);
+    return image;
+}
+
 SystemMemory::SystemMemory() {
-    IPL = nullipl::kNullIPL;
+    // Every system starts with the same null IPL ROM image
+    static const std::shared_ptr<const IPLImage> kNullIPLImage = IPLImage::Create(nullipl::kNullIPL);
+    LoadIPL(kNullIPLImage);
     Reset(true);
 }
 
@@ -13,14 +24,17 @@ void SystemMemory::Reset(bool hard) {
     if (hard) {
         WRAMLow.fill(0);
         WRAMHigh.fill(0);
+        WRAMLowDirty.MarkAll();
+        WRAMHighDirty.MarkAll();
     }
 }
 
 void SystemMemory::MapMemory(Bus &bus) {
-    bus.MapArray(0x000'0000, 0x00F'FFFF, IPL, false);
+    m_bus = &bus;
+    bus.MapArray(0x000'0000, 0x00F'FFFF, m_ipl->data);
     m_internalBackupRAM.MapMemory(bus, 0x018'0000, 0x01F'FFFF);
-    bus.MapArray(0x020'0000, 0x02F'FFFF, WRAMLow, true);
-    bus.MapArray(0x600'0000, 0x7FF'FFFF, WRAMHigh, true);
+    bus.MapArray(0x020'0000, 0x02F'FFFF, WRAMLow, WRAMLowDirty);
+    bus.MapArray(0x600'0000, 0x7FF'FFFF, WRAMHigh, WRAMHighDirty);
 
     // TODO: make this configurable
     // VA0/VA1: 030'0000 is unmapped; reads return all ones
@@ -30,9 +44,17 @@ void SystemMemory::MapMemory(Bus &bus) {
         [](uint32, void *) -> uint16 { return 0xFFFF; }, [](uint32, void *) -> uint32 { return 0xFFFFFFFF; });
 }
 
-void SystemMemory::LoadIPL(std::span<uint8, kIPLSize> ipl) {
-    std::copy(ipl.begin(), ipl.end(), IPL.begin());
-    m_iplHash = CalcHash128(IPL.data(), IPL.size(), kIPLHashSeed);
+void SystemMemory::LoadIPL(std::span<const uint8, kIPLSize> ipl) {
+    LoadIPL(IPLImage::Create(ipl));
+}
+
+void SystemMemory::LoadIPL(std::shared_ptr<const IPLImage> ipl) {
+    assert(ipl != nullptr);
+    m_ipl = std::move(ipl);
+    m_iplHash = m_ipl->hash;
+    if (m_bus != nullptr) {
+        m_bus->MapArray(0x000'0000, 0x00F'FFFF, m_ipl->data);
+    }
 }
 
 XXH128Hash SystemMemory::GetIPLHash() const {
@@ -57,6 +79,12 @@ void SystemMemory::SaveState(state::SystemState &state) const {
     state.WRAMHigh = WRAMHigh;
 }
 
+void SystemMemory::SaveStateIncremental(state::SystemState &state, state::DirtyPages &dirty) {
+    state.iplRomHash = m_iplHash;
+    state::CopyDirtyPages(WRAMLowDirty, WRAMLow, state.WRAMLow, dirty, state::MemoryRegion::WRAMLow);
+    state::CopyDirtyPages(WRAMHighDirty, WRAMHigh, state.WRAMHigh, dirty, state::MemoryRegion::WRAMHigh);
+}
+
 bool SystemMemory::ValidateState(const state::SystemState &state) const {
     if (state.iplRomHash != m_iplHash) {
         return false;
@@ -67,6 +95,8 @@ bool SystemMemory::ValidateState(const state::SystemState &state) const {
 void SystemMemory::LoadState(const state::SystemState &state) {
     WRAMLow = state.WRAMLow;
     WRAMHigh = state.WRAMHigh;
+    WRAMLowDirty.MarkAll();
+    WRAMHighDirty.MarkAll();
 }
 
 } // namespace ymir::sys
@@ -79,7 +79,7 @@ Saturn::Saturn()
                      SMPC.CbTriggerOptimizedINTBACKRead);
     SMPC.MapCallbacks(SCU.CbTriggerSystemManager, SCU.CbTriggerPad);
     SCSP.MapCallbacks(SCU.CbTriggerSoundRequest);
-    CDBlock.MapCallbacks(SCU.CbTriggerExtIntr0, SCSP.CbCDDASector);
+    CDBlock.MapCallbacks(SCU.CbTriggerExtIntr0, SCSP.CbCDDASector, SCSP.CbCDDAPlaybackStart);
 
     m_system.AddClockSpeedChangeCallback(SCSP.CbClockSpeedChange);
     m_system.AddClockSpeedChangeCallback(SMPC.CbClockSpeedChange);
@@ -149,10 +149,14 @@ const sys::ClockRatios &Saturn::GetClockRatios() const noexcept {
     return m_system.GetClockRatios();
 }
 
-void Saturn::LoadIPL(std::span<uint8, sys::kIPLSize> ipl) {
+void Saturn::LoadIPL(std::span<const uint8, sys::kIPLSize> ipl) {
     mem.LoadIPL(ipl);
 }
 
+void Saturn::LoadIPL(std::shared_ptr<const sys::IPLImage> ipl) {
+    mem.LoadIPL(std::move(ipl));
+}
+
 void Saturn::LoadInternalBackupMemoryImage(std::filesystem::path path, std::error_code &error) {
     mem.LoadInternalBackupMemoryImage(path, error);
 }
@@ -271,51 +275,145 @@ void Saturn::SaveState(state::State &state) const {
     CDBlock.SaveState(state.cdblock);
 }
 
+void Saturn::SaveStateIncremental(state::State &state, state::DirtyPages &dirty) {
+    dirty.Clear();
+    m_scheduler.SaveState(state.scheduler);
+    m_system.SaveState(state.system);
+    mem.SaveStateIncremental(state.system, dirty);
+    state.system.slaveSH2Enabled = slaveSH2Enabled;
+    state.msh2SpilloverCycles = m_msh2SpilloverCycles;
+    state.ssh2SpilloverCycles = m_ssh2SpilloverCycles;
+    masterSH2.SaveState(state.msh2);
+    slaveSH2.SaveState(state.ssh2);
+    SCU.SaveState(state.scu);
+    SMPC.SaveState(state.smpc);
+    VDP.SaveStateIncremental(state.vdp, dirty);
+    SCSP.SaveStateIncremental(state.scsp, dirty);
+    CDBlock.SaveStateIncremental(state.cdblock, dirty);
+}
+
+void Saturn::InvalidateIncrementalState() {
+    mem.WRAMLowDirty.MarkAll();
+    mem.WRAMHighDirty.MarkAll();
+    VDP.InvalidateIncrementalState();
+    SCSP.InvalidateIncrementalState();
+    CDBlock.InvalidateIncrementalState();
+}
+
 bool Saturn::LoadState(const state::State &state) {
-    if (!m_scheduler.ValidateState(state.scheduler)) {
+    return LoadStateImpl(state);
+}
+
+bool Saturn::LoadState(const state::BinaryStateView &view) {
+    return LoadStateImpl(view);
+}
+
+bool Saturn::LoadStateIncremental(const state::State &state) {
+    if (!LoadStateImpl(state)) {
+        return false;
+    }
+    mem.WRAMLowDirty.ClearAll();
+    mem.WRAMHighDirty.ClearAll();
+    VDP.ClearDirtyPages();
+    SCSP.ClearDirtyPages();
+    CDBlock.ClearDirtyPages();
+    return true;
+}
+
+std::unique_ptr<Saturn> Saturn::Fork() const {
+    auto fork = std::make_unique<Saturn>();
+    fork->configuration.CopyFrom(configuration);
+
+    // The save state validates the IPL ROM and disc hashes, so these must be loaded first
+    fork->mem.LoadIPL(mem.GetIPLImage());
+    fork->CDBlock.LoadDiscFrom(CDBlock);
+
+    // Share the ROM cartridge image; loading the state keeps it since the contents match
+    if (const auto *cart = SCU.GetCartridge().As<cart::CartType::ROM>()) {
+        fork->InsertCartridge<cart::ROMCartridge>()->LoadROM(cart->GetImage());
+    }
+
+    // Copy backup memories into memory buffers; these are not part of save states
+    bup::BackupMemory internalBackupRAM{};
+    if (internalBackupRAM.LoadFrom(mem.GetInternalBackupRAM().ReadAll()) == bup::BackupMemoryImageLoadResult::Success) {
+        fork->mem.SetInternalBackupRAM(std::move(internalBackupRAM));
+    }
+    if (const auto *cart = SCU.GetCartridge().As<cart::CartType::BackupMemory>()) {
+        bup::BackupMemory backupRAM{};
+        if (backupRAM.LoadFrom(cart->GetBackupMemory().ReadAll()) == bup::BackupMemoryImageLoadResult::Success) {
+            fork->InsertCartridge<cart::BackupMemoryCartridge>(std::move(backupRAM));
+        }
+    }
+
+    auto state = std::make_unique<state::State>();
+    SaveState(*state);
+    if (!fork->LoadState(*state)) {
+        return nullptr;
+    }
+    return fork;
+}
+
+namespace {
+
+    // Accesses the components of state::State (held by value) and state::BinaryStateView (held by pointer) uniformly.
+    template <typename T>
+    const T &Deref(const T &value) {
+        return value;
+    }
+
+    template <typename T>
+    const T &Deref(const T *value) {
+        return *value;
+    }
+
+} // namespace
+
+template <typename TState>
+bool Saturn::LoadStateImpl(const TState &state) {
+    if (!m_scheduler.ValidateState(Deref(state.scheduler))) {
         return false;
     }
-    if (!m_system.ValidateState(state.system)) {
+    if (!m_system.ValidateState(Deref(state.system))) {
         return false;
     }
-    if (!mem.ValidateState(state.system)) {
+    if (!mem.ValidateState(Deref(state.system))) {
         return false;
     }
-    if (!masterSH2.ValidateState(state.msh2)) {
+    if (!masterSH2.ValidateState(Deref(state.msh2))) {
         return false;
     }
-    if (!slaveSH2.ValidateState(state.ssh2)) {
+    if (!slaveSH2.ValidateState(Deref(state.ssh2))) {
         return false;
     }
-    if (!SCU.ValidateState(state.scu)) {
+    if (!SCU.ValidateState(Deref(state.scu))) {
         return false;
     }
-    if (!SMPC.ValidateState(state.smpc)) {
+    if (!SMPC.ValidateState(Deref(state.smpc))) {
         return false;
     }
-    if (!VDP.ValidateState(state.vdp)) {
+    if (!VDP.ValidateState(Deref(state.vdp))) {
         return false;
     }
-    if (!SCSP.ValidateState(state.scsp)) {
+    if (!SCSP.ValidateState(Deref(state.scsp))) {
         return false;
     }
-    if (!CDBlock.ValidateState(state.cdblock)) {
+    if (!CDBlock.ValidateState(Deref(state.cdblock))) {
         return false;
     }
 
-    m_scheduler.LoadState(state.scheduler);
-    m_system.LoadState(state.system);
-    mem.LoadState(state.system);
-    slaveSH2Enabled = state.system.slaveSH2Enabled;
+    m_scheduler.LoadState(Deref(state.scheduler));
+    m_system.LoadState(Deref(state.system));
+    mem.LoadState(Deref(state.system));
+    slaveSH2Enabled = Deref(state.system).slaveSH2Enabled;
     m_msh2SpilloverCycles = state.msh2SpilloverCycles;
     m_ssh2SpilloverCycles = state.ssh2SpilloverCycles;
-    masterSH2.LoadState(state.msh2);
-    slaveSH2.LoadState(state.ssh2);
-    SCU.LoadState(state.scu);
-    SMPC.LoadState(state.smpc);
-    VDP.LoadState(state.vdp);
-    SCSP.LoadState(state.scsp);
-    CDBlock.LoadState(state.cdblock);
+    masterSH2.LoadState(Deref(state.msh2));
+    slaveSH2.LoadState(Deref(state.ssh2));
+    SCU.LoadState(Deref(state.scu));
+    SMPC.LoadState(Deref(state.smpc));
+    VDP.LoadState(Deref(state.vdp));
+    SCSP.LoadState(Deref(state.scsp));
+    CDBlock.LoadState(Deref(state.cdblock));
 
     return true;
 }
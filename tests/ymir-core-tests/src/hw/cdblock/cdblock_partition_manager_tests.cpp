@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/hw/cdblock/cdblock_partition_manager.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace ymir;
+
+namespace cdblock_partition_manager {
+
+// Inserts sectors with the given frame addresses into the partition.
+static void Fill(cdblock::PartitionManager &partMgr, uint8 partitionIndex, uint32 firstFAD, uint32 count) {
+    for (uint32 i = 0; i < count; i++) {
+        cdblock::Buffer buffer{};
+        buffer.size = 2048;
+        buffer.frameAddress = firstFAD + i;
+        buffer.data[0] = static_cast<uint8>(firstFAD + i);
+        partMgr.InsertHead(partitionIndex, buffer);
+    }
+}
+
+// Lists the frame addresses of the sectors in the partition, from oldest to newest.
+static std::vector<uint32> FADs(cdblock::PartitionManager &partMgr, uint8 partitionIndex) {
+    std::vector<uint32> fads{};
+    for (uint32 i = 0; i < partMgr.GetBufferCount(partitionIndex); i++) {
+        const cdblock::Buffer *buffer = partMgr.GetTail(partitionIndex, i);
+        REQUIRE(buffer != nullptr);
+        CHECK(buffer->data[0] == static_cast<uint8>(buffer->frameAddress));
+        fads.push_back(buffer->frameAddress);
+    }
+    return fads;
+}
+
+TEST_CASE("PartitionManager inserts and removes sectors", "[cdblock][partition-manager]") {
+    auto partMgr = std::make_unique<cdblock::PartitionManager>();
+    REQUIRE(partMgr->GetFreeBufferCount() == cdblock::kNumBuffers);
+
+    Fill(*partMgr, 0, 100, 5);
+    CHECK(partMgr->GetBufferCount(0) == 5);
+    CHECK(partMgr->GetFreeBufferCount() == cdblock::kNumBuffers - 5);
+    CHECK(FADs(*partMgr, 0) == std::vector<uint32>{100, 101, 102, 103, 104});
+    CHECK(partMgr->GetTail(0, 5) == nullptr);
+    CHECK(partMgr->CalculateSize(0, 0, 4) == 5 * 2048);
+
+    CHECK(partMgr->RemoveTail(0, 0));
+    CHECK(FADs(*partMgr, 0) == std::vector<uint32>{101, 102, 103, 104});
+    CHECK_FALSE(partMgr->RemoveTail(0, 4));
+
+    CHECK(partMgr->DeleteSectors(0, 1, 2) == 2);
+    CHECK(FADs(*partMgr, 0) == std::vector<uint32>{101, 104});
+
+    partMgr->Clear(0);
+    CHECK(partMgr->GetBufferCount(0) == 0);
+    CHECK(partMgr->GetFreeBufferCount() == cdblock::kNumBuffers);
+}
+
+TEST_CASE("PartitionManager counts sector ranges", "[cdblock][partition-manager]") {
+    auto partMgr = std::make_unique<cdblock::PartitionManager>();
+    Fill(*partMgr, 0, 100, 10);
+
+    CHECK(partMgr->CountSectors(0, 0, 10) == 10);
+    CHECK(partMgr->CountSectors(0, 2, 3) == 3);
+    CHECK(partMgr->CountSectors(0, 8, 5) == 2);
+    CHECK(partMgr->CountSectors(0, 0, 0) == 0);
+    CHECK(partMgr->CountSectors(0, 10, 1) == 0);
+    CHECK(partMgr->CountSectors(0, 4, 0xFFFF) == 6);
+    CHECK(partMgr->CountSectors(0, 0xFFFF, 1) == 1);
+    CHECK(partMgr->CountSectors(0, 0xFFFF, 0xFFFF) == 1);
+    CHECK(partMgr->CountSectors(1, 0, 0xFFFF) == 0);
+}
+
+TEST_CASE("PartitionManager moves sectors between partitions", "[cdblock][partition-manager]") {
+    auto partMgr = std::make_unique<cdblock::PartitionManager>();
+    Fill(*partMgr, 0, 100, 6);
+    Fill(*partMgr, 1, 200, 2);
+
+    SECTION("Explicit range") {
+        CHECK(partMgr->MoveSectors(1, 0, 1, 3) == 3);
+        CHECK(FADs(*partMgr, 0) == std::vector<uint32>{100, 104, 105});
+        CHECK(FADs(*partMgr, 1) == std::vector<uint32>{200, 201, 101, 102, 103});
+    }
+    SECTION("Range past the end is clamped") {
+        CHECK(partMgr->MoveSectors(1, 0, 4, 10) == 2);
+        CHECK(FADs(*partMgr, 0) == std::vector<uint32>{100, 101, 102, 103});
+        CHECK(FADs(*partMgr, 1) == std::vector<uint32>{200, 201, 104, 105});
+    }
+    SECTION("0xFFFF position selects the last sector") {
+        CHECK(partMgr->MoveSectors(1, 0, 0xFFFF, 1) == 1);
+        CHECK(FADs(*partMgr, 0) == std::vector<uint32>{100, 101, 102, 103, 104});
+        CHECK(FADs(*partMgr, 1) == std::vector<uint32>{200, 201, 105});
+    }
+    SECTION("0xFFFF count selects all sectors through the end") {
+        CHECK(partMgr->MoveSectors(1, 0, 2, 0xFFFF) == 4);
+        CHECK(FADs(*partMgr, 0) == std::vector<uint32>{100, 101});
+        CHECK(FADs(*partMgr, 1) == std::vector<uint32>{200, 201, 102, 103, 104, 105});
+    }
+    SECTION("0xFFFF position and count select the last sector") {
+        CHECK(partMgr->MoveSectors(1, 0, 0xFFFF, 0xFFFF) == 1);
+        CHECK(FADs(*partMgr, 0) == std::vector<uint32>{100, 101, 102, 103, 104});
+        CHECK(FADs(*partMgr, 1) == std::vector<uint32>{200, 201, 105});
+    }
+    SECTION("Position out of range moves nothing") {
+        CHECK(partMgr->MoveSectors(1, 0, 6, 1) == 0);
+        CHECK(partMgr->MoveSectors(1, 2, 0xFFFF, 0xFFFF) == 0);
+        CHECK(partMgr->GetBufferCount(0) == 6);
+        CHECK(partMgr->GetBufferCount(1) == 2);
+    }
+
+    // Moving never touches the free buffers
+    CHECK(partMgr->GetFreeBufferCount() == cdblock::kNumBuffers - 8);
+}
+
+TEST_CASE("PartitionManager copies sectors between partitions", "[cdblock][partition-manager]") {
+    auto partMgr = std::make_unique<cdblock::PartitionManager>();
+    Fill(*partMgr, 0, 100, 6);
+
+    SECTION("Explicit range") {
+        CHECK(partMgr->CopySectors(1, 0, 1, 3) == 3);
+        CHECK(FADs(*partMgr, 0) == std::vector<uint32>{100, 101, 102, 103, 104, 105});
+        CHECK(FADs(*partMgr, 1) == std::vector<uint32>{101, 102, 103});
+        CHECK(partMgr->GetFreeBufferCount() == cdblock::kNumBuffers - 9);
+    }
+    SECTION("0xFFFF position selects the last sector") {
+        CHECK(partMgr->CopySectors(1, 0, 0xFFFF, 1) == 1);
+        CHECK(FADs(*partMgr, 1) == std::vector<uint32>{105});
+    }
+    SECTION("0xFFFF count selects all sectors through the end") {
+        CHECK(partMgr->CopySectors(1, 0, 3, 0xFFFF) == 3);
+        CHECK(FADs(*partMgr, 1) == std::vector<uint32>{103, 104, 105});
+    }
+    SECTION("Copying into the same partition") {
+        CHECK(partMgr->CopySectors(0, 0, 0, 0xFFFF) == 6);
+        CHECK(FADs(*partMgr, 0) == std::vector<uint32>{100, 101, 102, 103, 104, 105, 100, 101, 102, 103, 104, 105});
+    }
+    SECTION("Copies are independent of the source") {
+        REQUIRE(partMgr->CopySectors(1, 0, 0, 1) == 1);
+        partMgr->GetTail(0, 0)->frameAddress = 999;
+        CHECK(partMgr->GetTail(1, 0)->frameAddress == 100);
+    }
+    SECTION("Position out of range copies nothing") {
+        CHECK(partMgr->CopySectors(1, 0, 6, 0xFFFF) == 0);
+        CHECK(partMgr->GetBufferCount(1) == 0);
+    }
+    SECTION("Not enough free buffers copies nothing") {
+        Fill(*partMgr, 2, 300, cdblock::kNumBuffers - 6 - 2);
+        REQUIRE(partMgr->GetFreeBufferCount() == 2);
+        CHECK(partMgr->CopySectors(1, 0, 0, 3) == 0);
+        CHECK(partMgr->GetBufferCount(1) == 0);
+        CHECK(partMgr->CopySectors(1, 0, 0xFFFF, 0xFFFF) == 1);
+        CHECK(partMgr->GetFreeBufferCount() == 1);
+    }
+}
+
+} // namespace cdblock_partition_manager
@@ -0,0 +1,148 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/hw/scsp/scsp_resampler.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <numbers>
+#include <vector>
+
+using namespace ymir;
+
+namespace scsp_resampler {
+
+struct Output {
+    std::vector<sint16> left;
+    std::vector<sint16> right;
+};
+
+// Feeds the given number of samples produced by fn(index) into the resampler and collects the output.
+template <typename Fn>
+static Output Run(scsp::Resampler &resampler, size_t count, Fn &&fn) {
+    Output out{};
+    for (size_t i = 0; i < count; ++i) {
+        const sint16 sample = fn(i);
+        resampler.Process(sample, static_cast<sint16>(-sample), [&](sint16 left, sint16 right) {
+            out.left.push_back(left);
+            out.right.push_back(right);
+        });
+    }
+    return out;
+}
+
+TEST_CASE("Resampler produces the expected number of samples", "[scsp][resampler]") {
+    scsp::Resampler resampler{};
+
+    auto check = [&](uint32 inputRate, uint32 outputRate) {
+        resampler.Configure(inputRate, outputRate);
+        const size_t inputCount = inputRate; // one second
+        const Output out = Run(resampler, inputCount, [](size_t) { return sint16{0}; });
+        const double expected = static_cast<double>(inputCount) * outputRate / inputRate;
+        CHECK(std::abs(static_cast<double>(out.left.size()) - expected) <= 2.0);
+        CHECK(out.left.size() == out.right.size());
+    };
+
+    SECTION("Upsampling") {
+        check(44100, 48000);
+        check(44100, 96000);
+    }
+    SECTION("Downsampling") {
+        check(44100, 32000);
+        check(44100, 22050);
+    }
+    SECTION("Same rate") {
+        check(44100, 44100);
+    }
+}
+
+TEST_CASE("Resampler clamps sample rates", "[scsp][resampler]") {
+    scsp::Resampler resampler{};
+
+    resampler.Configure(1000, 1000000);
+    CHECK(resampler.GetInputRate() == scsp::Resampler::kMinSampleRate);
+    CHECK(resampler.GetOutputRate() == scsp::Resampler::kMaxSampleRate);
+}
+
+TEST_CASE("Resampler preserves DC level", "[scsp][resampler]") {
+    scsp::Resampler resampler{};
+    resampler.Configure(44100, 48000);
+
+    const Output out = Run(resampler, 4410, [](size_t) { return sint16{10000}; });
+    REQUIRE(out.left.size() > scsp::Resampler::kTaps * 2);
+
+    // Skip the filter latency
+    for (size_t i = scsp::Resampler::kTaps * 2; i < out.left.size(); ++i) {
+        CHECK(std::abs(out.left[i] - 10000) <= 2);
+        CHECK(std::abs(out.right[i] + 10000) <= 2);
+    }
+}
+
+TEST_CASE("Resampler preserves the amplitude of a sine wave in the passband", "[scsp][resampler]") {
+    scsp::Resampler resampler{};
+    resampler.Configure(44100, 48000);
+
+    static constexpr double kFrequency = 1000.0;
+    static constexpr double kAmplitude = 16000.0;
+    const Output out = Run(resampler, 44100, [](size_t i) {
+        return static_cast<sint16>(std::lround(kAmplitude * std::sin(2.0 * std::numbers::pi * kFrequency * i / 44100)));
+    });
+
+    sint16 peak = 0;
+    for (size_t i = scsp::Resampler::kTaps * 2; i < out.left.size(); ++i) {
+        peak = std::max<sint16>(peak, static_cast<sint16>(std::abs(out.left[i])));
+    }
+    CHECK(std::abs(peak - kAmplitude) <= kAmplitude * 0.01);
+}
+
+TEST_CASE("Resampler rate adjustment", "[scsp][resampler]") {
+    scsp::Resampler resampler{};
+    resampler.Configure(44100, 48000);
+
+    SECTION("Factor is clamped") {
+        resampler.SetRateAdjustment(2.0);
+        CHECK(resampler.GetRateAdjustment() == 1.0 + scsp::Resampler::kMaxRateAdjustment);
+        resampler.SetRateAdjustment(0.5);
+        CHECK(resampler.GetRateAdjustment() == 1.0 - scsp::Resampler::kMaxRateAdjustment);
+    }
+
+    SECTION("Factor scales the output rate") {
+        resampler.SetRateAdjustment(1.0 + scsp::Resampler::kMaxRateAdjustment);
+        const Output faster = Run(resampler, 44100, [](size_t) { return sint16{0}; });
+        resampler.Reset();
+        resampler.SetRateAdjustment(1.0 - scsp::Resampler::kMaxRateAdjustment);
+        const Output slower = Run(resampler, 44100, [](size_t) { return sint16{0}; });
+
+        const double expectedFaster = 48000.0 * (1.0 + scsp::Resampler::kMaxRateAdjustment);
+        const double expectedSlower = 48000.0 * (1.0 - scsp::Resampler::kMaxRateAdjustment);
+        CHECK(std::abs(static_cast<double>(faster.left.size()) - expectedFaster) <= 2.0);
+        CHECK(std::abs(static_cast<double>(slower.left.size()) - expectedSlower) <= 2.0);
+    }
+
+    SECTION("Configure resets the factor") {
+        resampler.SetRateAdjustment(1.001);
+        resampler.Configure(44100, 48000);
+        CHECK(resampler.GetRateAdjustment() == 1.0);
+    }
+}
+
+TEST_CASE("Resampler stream state can be saved and restored", "[scsp][resampler]") {
+    scsp::Resampler resampler{};
+    resampler.Configure(44100, 48000);
+
+    auto signal = [](size_t i) { return static_cast<sint16>((i * 7919) % 20000 - 10000); };
+
+    Run(resampler, 1000, signal);
+    scsp::Resampler::StreamState state{};
+    resampler.SaveStreamState(state);
+    const Output expected = Run(resampler, 1000, [&](size_t i) { return signal(i + 1000); });
+
+    // Disturb the stream, then restore it
+    Run(resampler, 777, [](size_t i) { return static_cast<sint16>(i * 31); });
+    resampler.LoadStreamState(state);
+    const Output actual = Run(resampler, 1000, [&](size_t i) { return signal(i + 1000); });
+
+    CHECK(actual.left == expected.left);
+    CHECK(actual.right == expected.right);
+}
+
+} // namespace scsp_resampler
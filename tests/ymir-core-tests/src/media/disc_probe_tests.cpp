@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/media/disc_probe.hpp>
+
+#include <ymir/util/scope_guard.hpp>
+
+#include "../util/test_disc.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace ymir;
+
+namespace disc_probe {
+
+static void WriteFile(const std::filesystem::path &path, const std::vector<uint8> &data) {
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    out.write(reinterpret_cast<const char *>(data.data()), data.size());
+    REQUIRE(out.good());
+}
+
+TEST_CASE("DiscIndexCache caches failed probes", "[media][probe]") {
+    const std::filesystem::path tempDir = std::filesystem::temp_directory_path();
+    const std::filesystem::path path = tempDir / "ymir-core-tests-disc-probe.iso";
+    const std::filesystem::path indexPath = tempDir / "ymir-core-tests-disc-probe.idx";
+    util::ScopeGuard sgRemoveFiles{[&] {
+        std::error_code err{};
+        std::filesystem::remove(path, err);
+        std::filesystem::remove(indexPath, err);
+    }};
+
+    // Not a multiple of the sector size, so this cannot be an ISO image
+    WriteFile(path, std::vector<uint8>(1000, 0xA5));
+
+    media::DiscIndexCache cache{};
+    media::DiscProbeResult result{};
+    CHECK_FALSE(cache.Probe(path, result));
+    CHECK(result.format == media::DiscFormat::Unknown);
+    CHECK(cache.Size() == 1);
+    CHECK(cache.IsDirty());
+
+    // The failure survives a save and load and is served from the index
+    REQUIRE(cache.Save(indexPath));
+    media::DiscIndexCache loadedCache{};
+    REQUIRE(loadedCache.Load(indexPath));
+    CHECK(loadedCache.Size() == 1);
+    CHECK_FALSE(loadedCache.Probe(path, result));
+    CHECK_FALSE(loadedCache.IsDirty());
+
+    // Replacing the file with a valid image invalidates the entry
+    WriteFile(path, test_util::MakeTestDiscImage());
+    CHECK(loadedCache.Probe(path, result));
+    CHECK(result.format == media::DiscFormat::ISO);
+    CHECK(loadedCache.Size() == 1);
+    CHECK(loadedCache.IsDirty());
+}
+
+} // namespace disc_probe
@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/media/loader/loader_ycd.hpp>
+
+#include <ymir/media/binary_reader/binary_reader_mem.hpp>
+
+#include <ymir/util/scope_guard.hpp>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace ymir;
+
+namespace loader_ycd {
+
+static constexpr uint32 kDataSectors = 20;
+static constexpr uint32 kAudioSectors = 10;
+
+// Builds a disc with a 2048-byte data track followed by an audio track.
+// The second half of each track is filled with zeros so that identical sectors can be deduplicated.
+// The seed changes the contents of the first data sector.
+static media::Disc MakeDisc(uint8 seed) {
+    media::Disc disc{};
+    auto &session = disc.sessions.emplace_back();
+    session.numTracks = 2;
+    session.firstTrackIndex = 0;
+    session.lastTrackIndex = 1;
+    session.startFrameAddress = 0;
+    session.endFrameAddress = 150 + kDataSectors + kAudioSectors;
+
+    std::vector<uint8> data(kDataSectors * 2048);
+    for (uint32 i = 0; i < kDataSectors / 2; i++) {
+        for (uint32 j = 0; j < 2048; j++) {
+            data[i * 2048 + j] = static_cast<uint8>(i * 31 + j * 7 + (i == 0 ? seed : 0));
+        }
+    }
+    auto &dataTrack = session.tracks[0];
+    dataTrack.controlADR = 0x41;
+    dataTrack.SetSectorSize(2048);
+    dataTrack.startFrameAddress = 150;
+    dataTrack.endFrameAddress = 150 + kDataSectors - 1;
+    dataTrack.indices.push_back({dataTrack.startFrameAddress, dataTrack.endFrameAddress});
+    dataTrack.binaryReader = std::make_shared<media::MemoryBinaryReader>(std::move(data));
+
+    std::vector<uint8> audio(kAudioSectors * 2352);
+    for (uint32 i = 0; i < kAudioSectors / 2; i++) {
+        for (uint32 j = 0; j < 2352; j++) {
+            audio[i * 2352 + j] = static_cast<uint8>(i * 13 + j * 3);
+        }
+    }
+    auto &audioTrack = session.tracks[1];
+    audioTrack.controlADR = 0x01;
+    audioTrack.SetSectorSize(2352);
+    audioTrack.startFrameAddress = dataTrack.endFrameAddress + 1;
+    audioTrack.endFrameAddress = audioTrack.startFrameAddress + kAudioSectors - 1;
+    audioTrack.indices.push_back({audioTrack.startFrameAddress, audioTrack.endFrameAddress});
+    audioTrack.binaryReader = std::make_shared<media::MemoryBinaryReader>(std::move(audio));
+
+    session.BuildTOC();
+    session.BuildSectorCaches();
+    return disc;
+}
+
+// Checks that the loaded disc has the same layout and sector contents as the original.
+static void CheckSameDisc(const media::Disc &expected, const media::Disc &actual) {
+    REQUIRE(actual.sessions.size() == expected.sessions.size());
+    for (size_t s = 0; s < expected.sessions.size(); s++) {
+        const auto &expectedSession = expected.sessions[s];
+        const auto &actualSession = actual.sessions[s];
+        CHECK(actualSession.startFrameAddress == expectedSession.startFrameAddress);
+        CHECK(actualSession.endFrameAddress == expectedSession.endFrameAddress);
+        CHECK(actualSession.toc == expectedSession.toc);
+        REQUIRE(actualSession.numTracks == expectedSession.numTracks);
+        REQUIRE(actualSession.firstTrackIndex == expectedSession.firstTrackIndex);
+
+        for (uint32 t = 0; t < expectedSession.numTracks; t++) {
+            const auto &expectedTrack = expectedSession.tracks[expectedSession.firstTrackIndex + t];
+            const auto &actualTrack = actualSession.tracks[actualSession.firstTrackIndex + t];
+            CHECK(actualTrack.controlADR == expectedTrack.controlADR);
+            CHECK(actualTrack.sectorSize == expectedTrack.sectorSize);
+            CHECK(actualTrack.startFrameAddress == expectedTrack.startFrameAddress);
+            CHECK(actualTrack.endFrameAddress == expectedTrack.endFrameAddress);
+            CHECK(actualTrack.indices.size() == expectedTrack.indices.size());
+
+            std::array<uint8, 2352> expectedSector{};
+            std::array<uint8, 2352> actualSector{};
+            for (uint32 fad = expectedTrack.startFrameAddress; fad <= expectedTrack.endFrameAddress; fad++) {
+                REQUIRE(expectedTrack.ReadSector(fad, expectedSector));
+                REQUIRE(actualTrack.ReadSector(fad, actualSector));
+                CHECK(actualSector == expectedSector);
+            }
+        }
+    }
+}
+
+TEST_CASE("YCD files can be written and read back", "[media][ycd]") {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ymir-core-tests-loader-ycd.ycd";
+    util::ScopeGuard sgRemoveFile{[&] {
+        std::error_code err{};
+        std::filesystem::remove(path, err);
+    }};
+
+    const media::Disc disc1 = MakeDisc(0);
+    const media::Disc disc2 = MakeDisc(1);
+    const std::array<const media::Disc *, 2> discs{&disc1, &disc2};
+    static constexpr uint64 kTotalSectors = 2 * (kDataSectors + kAudioSectors);
+
+    SECTION("With deduplication") {
+        media::loader::ycd::WriteOptions options{};
+        options.deduplicate = true;
+        media::loader::ycd::WriteStats stats{};
+        REQUIRE(media::loader::ycd::Write(path, discs, options, &stats));
+
+        // Each disc has half of its sectors zeroed, and the discs only differ in the first data sector
+        CHECK(stats.totalSectors == kTotalSectors);
+        CHECK(stats.uniqueSectors == (kDataSectors / 2 + 1) + (kAudioSectors / 2 + 1) + 1);
+        CHECK(stats.uncompressedSize == (kDataSectors / 2 + 2) * 2048 + (kAudioSectors / 2 + 1) * 2352);
+        CHECK(stats.compressedSize <= stats.uncompressedSize);
+    }
+    SECTION("Without deduplication") {
+        media::loader::ycd::WriteOptions options{};
+        options.deduplicate = false;
+        media::loader::ycd::WriteStats stats{};
+        REQUIRE(media::loader::ycd::Write(path, discs, options, &stats));
+
+        CHECK(stats.totalSectors == kTotalSectors);
+        CHECK(stats.uniqueSectors == kTotalSectors);
+        CHECK(stats.uncompressedSize == 2 * (kDataSectors * 2048 + kAudioSectors * 2352));
+    }
+
+    CHECK(media::loader::ycd::GetDiscCount(path) == 2);
+
+    for (uint32 i = 0; i < discs.size(); i++) {
+        for (bool preload : {false, true}) {
+            media::Disc loaded{};
+            REQUIRE(media::loader::ycd::Load(path, loaded, preload, i));
+            CheckSameDisc(*discs[i], loaded);
+        }
+    }
+
+    media::Disc missing{};
+    CHECK_FALSE(media::loader::ycd::Load(path, missing, false, 2));
+    CHECK(missing.sessions.empty());
+}
+
+TEST_CASE("YCD loader rejects truncated files", "[media][ycd]") {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ymir-core-tests-loader-ycd-trunc.ycd";
+    util::ScopeGuard sgRemoveFile{[&] {
+        std::error_code err{};
+        std::filesystem::remove(path, err);
+    }};
+
+    const media::Disc disc = MakeDisc(0);
+    const std::array<const media::Disc *, 1> discs{&disc};
+    REQUIRE(media::loader::ycd::Write(path, discs));
+
+    // Cut off the end of the disc table
+    const uintmax_t size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 16);
+
+    media::Disc loaded{};
+    CHECK_FALSE(media::loader::ycd::Load(path, loaded, false));
+    CHECK(loaded.sessions.empty());
+
+    // Cut off the header
+    std::filesystem::resize_file(path, 16);
+    CHECK(media::loader::ycd::GetDiscCount(path) == 0);
+    CHECK_FALSE(media::loader::ycd::Load(path, loaded, false));
+}
+
+} // namespace loader_ycd
@@ -0,0 +1,382 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/movie/movie.hpp>
+
+#include <ymir/state/state_binary.hpp>
+#include <ymir/sys/saturn.hpp>
+
+#include <ymir/util/scope_guard.hpp>
+
+#include "../util/test_disc.hpp"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace ymir;
+
+namespace movie_file {
+
+using peripheral::Button;
+using peripheral::PeripheralReport;
+using peripheral::PeripheralType;
+
+static PeripheralReport ControlPad(Button buttons) {
+    PeripheralReport report{};
+    report.type = PeripheralType::ControlPad;
+    report.report.controlPad.buttons = buttons;
+    return report;
+}
+
+static PeripheralReport AnalogPad(Button buttons, uint8 x, uint8 y) {
+    PeripheralReport report{};
+    report.type = PeripheralType::AnalogPad;
+    report.report.analogPad = {.buttons = buttons, .analog = true, .x = x, .y = y, .l = 0, .r = 0xFF};
+    return report;
+}
+
+// Compares the fields of reports that are relevant to their type.
+static bool SameReport(const PeripheralReport &lhs, const PeripheralReport &rhs) {
+    if (lhs.type != rhs.type) {
+        return false;
+    }
+    switch (lhs.type) {
+    case PeripheralType::ControlPad: return lhs.report.controlPad.buttons == rhs.report.controlPad.buttons;
+    case PeripheralType::AnalogPad: //
+    {
+        const auto &l = lhs.report.analogPad;
+        const auto &r = rhs.report.analogPad;
+        return l.buttons == r.buttons && l.analog == r.analog && l.x == r.x && l.y == r.y && l.l == r.l && l.r == r.r;
+    }
+    default: return true;
+    }
+}
+
+static bool SameFrame(const movie::MovieFrame &lhs, const movie::MovieFrame &rhs) {
+    return SameReport(lhs.inputs[0], rhs.inputs[0]) && SameReport(lhs.inputs[1], rhs.inputs[1]) &&
+           lhs.events == rhs.events;
+}
+
+// Creates a Saturn with the test disc loaded, which is required to load save states.
+static std::unique_ptr<Saturn> MakeSaturn() {
+    auto saturn = std::make_unique<Saturn>();
+    saturn->configuration.video.threadedVDP = false;
+    saturn->VDP.SetRenderingEnabled(false);
+    saturn->LoadDisc(test_util::MakeTestDisc());
+    return saturn;
+}
+
+// Saves the state of the Saturn in the binary format.
+static std::vector<uint8> SaveBinaryState(const Saturn &saturn) {
+    auto state = std::make_unique<state::State>();
+    saturn.SaveState(*state);
+    std::vector<uint8> data{};
+    state::WriteBinaryState(*state, data);
+    return data;
+}
+
+TEST_CASE("Movies can be written and read back", "[movie]") {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ymir-core-tests-movie.ymv";
+    util::ScopeGuard sgRemoveFile{[&] {
+        std::error_code err{};
+        std::filesystem::remove(path, err);
+    }};
+
+    movie::MovieInfo info{};
+    info.iplHash[0] = 0x12;
+    info.discHash[15] = 0x34;
+    info.keyframeInterval = 10;
+    info.emulateSH2Cache = true;
+    info.cdReadSpeedFactor = 4;
+    info.externalBackupMemory = true;
+
+    auto state = std::make_unique<state::State>();
+    std::vector<uint8> backupRAM(1024);
+    for (size_t i = 0; i < backupRAM.size(); i++) {
+        backupRAM[i] = i * 7;
+    }
+    const std::vector<uint8> persistentState{1, 2, 3, 4, 5};
+
+    // Frames 0-4 have nothing connected, then a control pad is connected to port 1 whose buttons change every four
+    // frames, producing runs of repeated frames. From frame 25 on, an analog pad on port 2 changes on every frame.
+    std::vector<movie::MovieFrame> frames{};
+    for (uint32 i = 0; i < 40; i++) {
+        movie::MovieFrame &frame = frames.emplace_back();
+        if (i >= 5) {
+            frame.inputs[0] = ControlPad((i / 4) % 2 == 0 ? Button::Default : Button::Default & ~Button::A);
+        }
+        if (i >= 25) {
+            frame.inputs[1] = AnalogPad(Button::Default & ~Button::Start, i * 3, 0xFF - i);
+        }
+        if (i == 13) {
+            frame.events = movie::event::kSoftReset;
+        }
+        if (i == 21) {
+            frame.events = movie::event::kOpenTray | movie::event::kPressResetButton;
+        }
+    }
+
+    // Frame number and spillover cycles used to identify the state of each keyframe
+    std::map<uint64, uint64> keyframes{};
+    keyframes[0] = 0;
+
+    movie::MovieWriter writer{};
+    std::error_code error{};
+    REQUIRE(writer.Open(path, info, *state, backupRAM, persistentState, error));
+    for (uint32 i = 0; i < frames.size(); i++) {
+        // Resync keyframes also restart the keyframe interval
+        const bool resync = i == 17;
+        if (resync || writer.IsKeyframeDue()) {
+            state->msh2SpilloverCycles = i * 100;
+            REQUIRE(writer.WriteKeyframe(*state, backupRAM, resync));
+            keyframes[i] = state->msh2SpilloverCycles;
+        }
+        REQUIRE(writer.WriteFrame(frames[i]));
+    }
+    CHECK(writer.GetFrameCount() == frames.size());
+    writer.Close();
+    CHECK_FALSE(writer.IsOpen());
+
+    movie::MovieReader reader{};
+    REQUIRE(reader.Open(path, error));
+
+    const movie::MovieInfo &readInfo = reader.GetInfo();
+    CHECK(readInfo.iplHash == info.iplHash);
+    CHECK(readInfo.discHash == info.discHash);
+    CHECK(readInfo.keyframeInterval == info.keyframeInterval);
+    CHECK(readInfo.emulateSH2Cache == info.emulateSH2Cache);
+    CHECK(readInfo.cdReadSpeedFactor == info.cdReadSpeedFactor);
+    CHECK(readInfo.cddaBufferLatency == info.cddaBufferLatency);
+    CHECK(readInfo.externalBackupMemory == info.externalBackupMemory);
+
+    REQUIRE(reader.GetFrameCount() == frames.size());
+    for (uint32 i = 0; i < frames.size(); i++) {
+        INFO("frame = " << i);
+        CHECK(SameFrame(reader.GetFrame(i), frames[i]));
+    }
+
+    // Keyframes at 0, 10, 17 (resync), 27 and 37
+    const auto readKeyframes = reader.GetKeyframes();
+    REQUIRE(readKeyframes.size() == 5);
+    REQUIRE(keyframes.size() == readKeyframes.size());
+    size_t index = 0;
+    for (const auto &[frame, spillover] : keyframes) {
+        INFO("keyframe = " << index);
+        CHECK(readKeyframes[index].frame == frame);
+        CHECK(readKeyframes[index].resync == (frame == 0 || frame == 17));
+        CHECK(readKeyframes[index].persistent == (frame == 0));
+
+        std::vector<uint8> binaryState{};
+        std::vector<uint8> readBackupRAM{};
+        std::vector<uint8> readPersistentState{0xFF};
+        REQUIRE(reader.ReadKeyframe(index, binaryState, readBackupRAM, &readPersistentState));
+        auto readState = std::make_unique<state::State>();
+        REQUIRE(state::ReadBinaryState(binaryState, *readState));
+        CHECK(readState->msh2SpilloverCycles == spillover);
+        CHECK(readBackupRAM == backupRAM);
+        if (frame == 0) {
+            CHECK(readPersistentState == persistentState);
+        } else {
+            CHECK(readPersistentState.empty());
+        }
+        ++index;
+    }
+
+    CHECK(reader.FindKeyframe(0) == 0);
+    CHECK(reader.FindKeyframe(9) == 0);
+    CHECK(reader.FindKeyframe(16) == 1);
+    CHECK(reader.FindKeyframe(17) == 2);
+    CHECK(reader.FindKeyframe(1000) == 4);
+
+    std::vector<uint8> binaryState{};
+    std::vector<uint8> readBackupRAM{};
+    CHECK_FALSE(reader.ReadKeyframe(readKeyframes.size(), binaryState, readBackupRAM));
+}
+
+TEST_CASE("Movies store repeated frames compactly", "[movie]") {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ymir-core-tests-movie-repeat.ymv";
+    util::ScopeGuard sgRemoveFile{[&] {
+        std::error_code err{};
+        std::filesystem::remove(path, err);
+    }};
+
+    movie::MovieInfo info{};
+    info.keyframeInterval = 1000000;
+    auto state = std::make_unique<state::State>();
+
+    movie::MovieWriter writer{};
+    std::error_code error{};
+    REQUIRE(writer.Open(path, info, *state, {}, {}, error));
+    writer.Close();
+    const uintmax_t initialSize = std::filesystem::file_size(path);
+
+    const movie::MovieFrame frame{.inputs = {ControlPad(Button::Default & ~Button::Right), {}}};
+    REQUIRE(writer.Open(path, info, *state, {}, {}, error));
+    bool written = true;
+    for (uint32 i = 0; i < 100000; i++) {
+        written = written && writer.WriteFrame(frame);
+    }
+    REQUIRE(written);
+    REQUIRE(writer.WriteFrame({.inputs = frame.inputs, .events = movie::event::kHardReset}));
+    REQUIRE(writer.WriteFrame(frame));
+    writer.Close();
+
+    // One frame record, one repeat record with a three byte count, another frame record with events and a repeat
+    // record for the last frame
+    CHECK(std::filesystem::file_size(path) - initialSize == 5 + 4 + 3 + 2);
+
+    movie::MovieReader reader{};
+    REQUIRE(reader.Open(path, error));
+    REQUIRE(reader.GetFrameCount() == 100002);
+    CHECK(SameFrame(reader.GetFrame(0), frame));
+    CHECK(SameFrame(reader.GetFrame(99999), frame));
+    CHECK(reader.GetFrame(100000).events == movie::event::kHardReset);
+    CHECK(SameFrame(reader.GetFrame(100001), frame));
+}
+
+TEST_CASE("Truncated movies are readable up to the last complete record", "[movie]") {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ymir-core-tests-movie-trunc.ymv";
+    util::ScopeGuard sgRemoveFile{[&] {
+        std::error_code err{};
+        std::filesystem::remove(path, err);
+    }};
+
+    movie::MovieInfo info{};
+    info.keyframeInterval = 20;
+    auto state = std::make_unique<state::State>();
+
+    // 20 frames with different inputs, a keyframe, then 5 repeated frames
+    movie::MovieWriter writer{};
+    std::error_code error{};
+    REQUIRE(writer.Open(path, info, *state, {}, {}, error));
+    for (uint32 i = 0; i < 25; i++) {
+        if (writer.IsKeyframeDue()) {
+            REQUIRE(writer.WriteKeyframe(*state, {}, false));
+        }
+        const Button buttons = i < 20 ? static_cast<Button>(i) : Button::Default;
+        REQUIRE(writer.WriteFrame({.inputs = {ControlPad(buttons), {}}}));
+    }
+    writer.Close();
+
+    movie::MovieReader reader{};
+    REQUIRE(reader.Open(path, error));
+    REQUIRE(reader.GetFrameCount() == 25);
+    REQUIRE(reader.GetKeyframes().size() == 2);
+    const uint64 keyframeOffset = reader.GetKeyframes()[1].offset;
+    const uintmax_t size = std::filesystem::file_size(path);
+
+    SECTION("Cut inside the last record") {
+        std::filesystem::resize_file(path, size - 1);
+        REQUIRE(reader.Open(path, error));
+        CHECK(reader.GetFrameCount() == 21);
+        CHECK(reader.GetKeyframes().size() == 2);
+    }
+    SECTION("Cut inside a keyframe") {
+        std::filesystem::resize_file(path, keyframeOffset + 4);
+        REQUIRE(reader.Open(path, error));
+        CHECK(reader.GetFrameCount() == 20);
+        CHECK(reader.GetKeyframes().size() == 1);
+        CHECK(SameFrame(reader.GetFrame(19), {.inputs = {ControlPad(static_cast<Button>(19)), {}}}));
+    }
+    SECTION("Cut inside the initial keyframe") {
+        std::filesystem::resize_file(path, 60);
+        CHECK_FALSE(reader.Open(path, error));
+        CHECK(error);
+        CHECK(reader.GetFrameCount() == 0);
+    }
+    SECTION("Cut inside the header") {
+        std::filesystem::resize_file(path, 20);
+        CHECK_FALSE(reader.Open(path, error));
+        CHECK(error);
+    }
+}
+
+TEST_CASE("Movies play back deterministically", "[movie]") {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ymir-core-tests-movie-play.ymv";
+    util::ScopeGuard sgRemoveFile{[&] {
+        std::error_code err{};
+        std::filesystem::remove(path, err);
+    }};
+
+    static constexpr uint64 kFrameCount = 30;
+    static constexpr std::array<uint64, 4> kCheckpoints = {5, 13, 21, kFrameCount};
+
+    // Record a session with events; no peripherals are connected
+    auto recorder = MakeSaturn();
+    auto state = std::make_unique<state::State>();
+    recorder->SaveState(*state);
+    movie::MovieInfo info = movie::CaptureMovieInfo(*recorder);
+    info.keyframeInterval = 8;
+
+    movie::MovieWriter writer{};
+    std::error_code error{};
+    REQUIRE(writer.Open(path, info, *state, recorder->mem.GetInternalBackupRAM().ReadAll(), {}, error));
+
+    std::map<uint64, std::vector<uint8>> expected{};
+    for (uint64 i = 0; i < kFrameCount; i++) {
+        movie::MovieFrame frame{};
+        if (i == 10) {
+            frame.events = movie::event::kPressResetButton;
+            recorder->SMPC.SetResetButtonState(true);
+        } else if (i == 12) {
+            frame.events = movie::event::kReleaseResetButton;
+            recorder->SMPC.SetResetButtonState(false);
+        } else if (i == 18) {
+            frame.events = movie::event::kSoftReset;
+            recorder->Reset(false);
+        }
+
+        // Keyframes hold the state after the events of their frame are applied
+        if (writer.IsKeyframeDue()) {
+            recorder->SaveState(*state);
+            REQUIRE(writer.WriteKeyframe(*state, recorder->mem.GetInternalBackupRAM().ReadAll(), false));
+        }
+        REQUIRE(writer.WriteFrame(frame));
+        recorder->RunFrame();
+
+        if (std::ranges::find(kCheckpoints, i + 1) != kCheckpoints.end()) {
+            expected[i + 1] = SaveBinaryState(*recorder);
+        }
+    }
+    writer.Close();
+
+    movie::MovieReader reader{};
+    REQUIRE(reader.Open(path, error));
+    REQUIRE(reader.GetFrameCount() == kFrameCount);
+    REQUIRE(reader.GetKeyframes().size() == 4);
+
+    auto saturn = MakeSaturn();
+    movie::MoviePlayer player{*saturn, reader};
+
+    SECTION("Running every frame") {
+        while (player.RunFrame()) {
+            const uint64 frame = player.GetCurrentFrame();
+            if (expected.contains(frame)) {
+                INFO("frame = " << frame);
+                CHECK(std::ranges::equal(SaveBinaryState(*saturn), expected[frame]));
+            }
+        }
+        CHECK(player.IsFinished());
+        CHECK(player.GetCurrentFrame() == kFrameCount);
+    }
+    SECTION("Seeking") {
+        for (uint64 frame : {13, 5, 30, 21, 13, 21}) {
+            INFO("frame = " << frame);
+            REQUIRE(player.Seek(frame));
+            CHECK(player.GetCurrentFrame() == frame);
+            CHECK(std::ranges::equal(SaveBinaryState(*saturn), expected[frame]));
+        }
+        CHECK_FALSE(saturn->VDP.IsRenderingEnabled());
+
+        // Seeking past the end clamps to the last frame
+        REQUIRE(player.Seek(1000));
+        CHECK(player.GetCurrentFrame() == kFrameCount);
+        CHECK(player.IsFinished());
+        CHECK_FALSE(player.RunFrame());
+    }
+}
+
+} // namespace movie_file
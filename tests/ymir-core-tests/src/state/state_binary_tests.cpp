@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/state/state_binary.hpp>
+#include <ymir/sys/saturn.hpp>
+
+#include "../util/test_disc.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace ymir;
+
+namespace state_binary {
+
+// Creates a Saturn with the test disc loaded, which is required to load save states.
+static std::unique_ptr<Saturn> MakeSaturn() {
+    auto saturn = std::make_unique<Saturn>();
+    saturn->configuration.video.threadedVDP = false;
+    saturn->VDP.SetRenderingEnabled(false);
+    saturn->LoadDisc(test_util::MakeTestDisc());
+    return saturn;
+}
+
+// Saves the state of the Saturn in the binary format.
+static std::vector<uint8> SaveBinaryState(const Saturn &saturn, bool excludeTrackedMemory = false) {
+    auto state = std::make_unique<state::State>();
+    saturn.SaveState(*state);
+    std::vector<uint8> data{};
+    state::WriteBinaryState(*state, data, excludeTrackedMemory);
+    return data;
+}
+
+TEST_CASE("Binary states can be written and read back", "[state][binary]") {
+    auto saturn = MakeSaturn();
+    for (int i = 0; i < 3; i++) {
+        saturn->RunFrame();
+    }
+
+    auto state = std::make_unique<state::State>();
+    saturn->SaveState(*state);
+    std::vector<uint8> data{};
+    state::WriteBinaryState(*state, data);
+    REQUIRE(data.size() >= sizeof(state::BinaryStateHeader));
+
+    SECTION("Reading into a state object") {
+        auto readState = std::make_unique<state::State>();
+        REQUIRE(state::ReadBinaryState(data, *readState));
+
+        std::vector<uint8> rewritten{};
+        state::WriteBinaryState(*readState, rewritten);
+        CHECK(std::ranges::equal(rewritten, data));
+        CHECK(std::ranges::equal(readState->system.WRAMHigh, state->system.WRAMHigh));
+        CHECK(std::ranges::equal(readState->vdp.VRAM2, state->vdp.VRAM2));
+        CHECK(readState->msh2SpilloverCycles == state->msh2SpilloverCycles);
+    }
+
+    SECTION("Trailing bytes are ignored") {
+        data.resize(data.size() + 100, 0xAA);
+        auto readState = std::make_unique<state::State>();
+        CHECK(state::ReadBinaryState(data, *readState));
+    }
+
+    SECTION("Loading into a fresh Saturn") {
+        state::BinaryStateView view{};
+        REQUIRE(state::ParseBinaryState(data, view));
+        CHECK(std::ranges::equal(view.system->WRAMLow, state->system.WRAMLow));
+
+        auto fresh = MakeSaturn();
+        REQUIRE(fresh->LoadState(view));
+        CHECK(std::ranges::equal(SaveBinaryState(*fresh), data));
+
+        // Both instances must stay in sync from here on
+        saturn->RunFrame();
+        fresh->RunFrame();
+        CHECK(std::ranges::equal(SaveBinaryState(*fresh), SaveBinaryState(*saturn)));
+    }
+}
+
+TEST_CASE("Binary states can exclude tracked memory", "[state][binary]") {
+    auto saturn = MakeSaturn();
+    saturn->RunFrame();
+
+    const std::vector<uint8> full = SaveBinaryState(*saturn);
+    const std::vector<uint8> partial = SaveBinaryState(*saturn, true);
+    CHECK(partial.size() < full.size());
+
+    // Reading a state without tracked memory leaves those regions untouched
+    auto readState = std::make_unique<state::State>();
+    readState->system.WRAMLow.fill(0x5A);
+    REQUIRE(state::ReadBinaryState(partial, *readState));
+    CHECK(readState->system.WRAMLow[0] == 0x5A);
+    CHECK(readState->system.WRAMLow[readState->system.WRAMLow.size() - 1] == 0x5A);
+
+    // Views must reference every memory region
+    state::BinaryStateView view{};
+    CHECK_FALSE(state::ParseBinaryState(partial, view));
+}
+
+TEST_CASE("Invalid binary states are rejected", "[state][binary]") {
+    auto saturn = MakeSaturn();
+    std::vector<uint8> data = SaveBinaryState(*saturn);
+    auto readState = std::make_unique<state::State>();
+    state::BinaryStateView view{};
+
+    SECTION("Truncated") {
+        data.resize(data.size() - 1);
+        CHECK_FALSE(state::ReadBinaryState(data, *readState));
+        CHECK_FALSE(state::ParseBinaryState(data, view));
+    }
+    SECTION("Header only") {
+        data.resize(sizeof(state::BinaryStateHeader));
+        CHECK_FALSE(state::ReadBinaryState(data, *readState));
+        CHECK_FALSE(state::ParseBinaryState(data, view));
+    }
+    SECTION("Bad magic") {
+        data[0] ^= 0xFF;
+        CHECK_FALSE(state::ReadBinaryState(data, *readState));
+        CHECK_FALSE(state::ParseBinaryState(data, view));
+    }
+    SECTION("Different layout") {
+        data[offsetof(state::BinaryStateHeader, layoutHash)] ^= 0x01;
+        CHECK_FALSE(state::ReadBinaryState(data, *readState));
+        CHECK_FALSE(state::ParseBinaryState(data, view));
+    }
+}
+
+} // namespace state_binary
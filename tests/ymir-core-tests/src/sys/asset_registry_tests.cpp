@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/sys/asset_registry.hpp>
+
+#include <ymir/util/scope_guard.hpp>
+
+#include "../util/test_disc.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+using namespace ymir;
+
+namespace asset_registry {
+
+static std::shared_ptr<media::IBinaryReader> GetReader(const media::Disc &disc) {
+    return disc.sessions[0].tracks[0].binaryReader;
+}
+
+TEST_CASE("AssetRegistry keeps discs registered while copies are in use", "[sys][assets]") {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ymir-core-tests-asset-registry.iso";
+    util::ScopeGuard sgRemoveFile{[&] {
+        std::error_code err{};
+        std::filesystem::remove(path, err);
+    }};
+    {
+        const std::vector<uint8> image = test_util::MakeTestDiscImage();
+        std::ofstream out{path, std::ios::binary};
+        out.write(reinterpret_cast<const char *>(image.data()), image.size());
+        REQUIRE(out.good());
+    }
+
+    sys::AssetRegistry registry{};
+    std::weak_ptr<media::IBinaryReader> registeredReader{};
+    {
+        media::Disc disc{};
+        REQUIRE(registry.LoadDisc(path, disc, false));
+        REQUIRE(disc.sessions.size() == 1);
+        registeredReader = GetReader(disc);
+
+        // The copy is still alive, so the disc must remain registered and be shared with new requests
+        registry.ReleaseUnused();
+        media::Disc disc2{};
+        REQUIRE(registry.LoadDisc(path, disc2, false));
+        CHECK(GetReader(disc2) == GetReader(disc));
+    }
+    CHECK_FALSE(registeredReader.expired());
+
+    // Every copy is gone; the registry must release its own
+    registry.ReleaseUnused();
+    CHECK(registeredReader.expired());
+
+    // The disc is loaded again from the file
+    media::Disc disc{};
+    REQUIRE(registry.LoadDisc(path, disc, false));
+    registeredReader = GetReader(disc);
+    registry.Clear();
+    CHECK_FALSE(registeredReader.expired());
+}
+
+} // namespace asset_registry
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <ymir/media/binary_reader/binary_reader_mem.hpp>
+#include <ymir/media/disc.hpp>
+
+#include <ymir/util/data_ops.hpp>
+
+#include <ymir/core/types.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace test_util {
+
+namespace detail {
+
+    inline void WriteBoth16(uint8 *dst, uint16 value) {
+        util::WriteLE<uint16>(&dst[0], value);
+        util::WriteBE<uint16>(&dst[2], value);
+    }
+
+    inline void WriteBoth32(uint8 *dst, uint32 value) {
+        util::WriteLE<uint32>(&dst[0], value);
+        util::WriteBE<uint32>(&dst[4], value);
+    }
+
+    // Writes an ISO 9660 directory record and returns its length.
+    inline uint32 WriteDirectoryRecord(uint8 *dst, uint32 lba, uint32 size, std::string_view name, uint8 flags) {
+        const uint32 length = (33 + name.size() + 1) & ~1u;
+        dst[0] = length;
+        WriteBoth32(&dst[2], lba);
+        WriteBoth32(&dst[10], size);
+        dst[25] = flags;
+        WriteBoth16(&dst[28], 1);
+        dst[32] = name.size();
+        std::copy(name.begin(), name.end(), &dst[33]);
+        return length;
+    }
+
+} // namespace detail
+
+inline constexpr uint32 kTestDiscSectorSize = 2048;
+inline constexpr uint32 kTestDiscSectors = 40;
+
+// Builds the image of a minimal data disc with 2048-byte sectors and an ISO 9660 filesystem containing one file.
+inline std::vector<uint8> MakeTestDiscImage() {
+    static constexpr uint32 kSectorSize = kTestDiscSectorSize;
+    static constexpr uint32 kNumSectors = kTestDiscSectors;
+    static constexpr uint32 kPathTableLBA = 18;
+    static constexpr uint32 kRootLBA = 20;
+    static constexpr uint32 kFileLBA = 21;
+    static constexpr std::string_view kFileContents = "hello";
+
+    std::vector<uint8> image(kNumSectors * kSectorSize);
+    auto sector = [&](uint32 lba) { return &image[lba * kSectorSize]; };
+
+    // System area
+    std::copy_n("SEGA SEGASATURN ", 16, sector(0));
+
+    // Primary volume descriptor
+    uint8 *pvd = sector(16);
+    pvd[0] = 1;
+    std::copy_n("CD001", 5, &pvd[1]);
+    pvd[6] = 1;
+    detail::WriteBoth32(&pvd[80], kNumSectors);
+    detail::WriteBoth16(&pvd[120], 1);
+    detail::WriteBoth16(&pvd[124], 1);
+    detail::WriteBoth16(&pvd[128], kSectorSize);
+    detail::WriteBoth32(&pvd[132], 10);
+    util::WriteLE<uint32>(&pvd[140], kPathTableLBA);
+    util::WriteBE<uint32>(&pvd[148], kPathTableLBA + 1);
+    detail::WriteDirectoryRecord(&pvd[156], kRootLBA, kSectorSize, std::string_view{"\0", 1}, 2);
+    pvd[881] = 1;
+
+    // Volume descriptor set terminator
+    uint8 *terminator = sector(17);
+    terminator[0] = 255;
+    std::copy_n("CD001", 5, &terminator[1]);
+    terminator[6] = 1;
+
+    // Path tables with just the root directory, in little-endian and big-endian order
+    sector(kPathTableLBA)[0] = 1;
+    util::WriteLE<uint32>(&sector(kPathTableLBA)[2], kRootLBA);
+    util::WriteLE<uint16>(&sector(kPathTableLBA)[6], 1);
+    sector(kPathTableLBA + 1)[0] = 1;
+    util::WriteBE<uint32>(&sector(kPathTableLBA + 1)[2], kRootLBA);
+    util::WriteBE<uint16>(&sector(kPathTableLBA + 1)[6], 1);
+
+    // Root directory
+    uint8 *root = sector(kRootLBA);
+    root += detail::WriteDirectoryRecord(root, kRootLBA, kSectorSize, std::string_view{"\0", 1}, 2);
+    root += detail::WriteDirectoryRecord(root, kRootLBA, kSectorSize, std::string_view{"\1", 1}, 2);
+    detail::WriteDirectoryRecord(root, kFileLBA, kFileContents.size(), "A.BIN;1", 0);
+    std::copy(kFileContents.begin(), kFileContents.end(), sector(kFileLBA));
+    return image;
+}
+
+// Builds a minimal single-track data disc from the image above.
+// Some components (such as save states) require a disc with a valid filesystem.
+inline ymir::media::Disc MakeTestDisc() {
+    static constexpr uint32 kSectorSize = kTestDiscSectorSize;
+    static constexpr uint32 kNumSectors = kTestDiscSectors;
+
+    std::vector<uint8> image = MakeTestDiscImage();
+
+    ymir::media::Disc disc{};
+    auto &session = disc.sessions.emplace_back();
+    session.numTracks = 1;
+    session.firstTrackIndex = 0;
+    session.lastTrackIndex = 0;
+    session.startFrameAddress = 0;
+    session.endFrameAddress = 150 + kNumSectors - 1;
+
+    auto &track = session.tracks[0];
+    track.SetSectorSize(kSectorSize);
+    track.controlADR = 0x41;
+    track.startFrameAddress = 150;
+    track.endFrameAddress = session.endFrameAddress;
+    track.indices.push_back({track.startFrameAddress, track.endFrameAddress});
+
+    disc.header.ReadFrom(std::span<uint8, 256>{image.data(), 256});
+    track.binaryReader = std::make_shared<ymir::media::MemoryBinaryReader>(std::move(image));
+
+    session.BuildTOC();
+    session.BuildSectorCaches();
+    return disc;
+}
+
+} // namespace test_util
@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <app/rewind_buffer.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace ymir;
+
+namespace rewind_buffer {
+
+using state::MemoryRegion;
+
+static constexpr size_t kTouchedPages = 8;
+
+// The parts of a frame modified by the test.
+struct FrameContents {
+    std::vector<uint8> wramLow;
+    uint64 spillover;
+
+    bool operator==(const FrameContents &) const = default;
+};
+
+static FrameContents Capture(const state::State &state) {
+    FrameContents contents{};
+    contents.wramLow.assign(state.system.WRAMLow.begin(),
+                            state.system.WRAMLow.begin() + kTouchedPages * state::kMemoryPageSize);
+    contents.spillover = state.msh2SpilloverCycles;
+    return contents;
+}
+
+// Records frames into the rewind buffer as the emulator would, modifying a couple of memory pages and a register in
+// each frame. Returns the contents of every frame recorded.
+static std::vector<FrameContents> Record(app::RewindBuffer &buffer, size_t firstFrame, size_t count) {
+    std::vector<FrameContents> frames{};
+    for (size_t i = firstFrame; i < firstFrame + count; i++) {
+        buffer.BeginState();
+        auto &state = buffer.NextState;
+        auto &dirty = buffer.NextDirtyPages;
+        dirty.Clear();
+
+        // Touch one page every frame and another one every few frames
+        const uint16 page = i % kTouchedPages;
+        std::fill_n(state::GetMemoryPage(state, MemoryRegion::WRAMLow, page).begin() + (i % 97), 16,
+                    static_cast<uint8>(i));
+        dirty[MemoryRegion::WRAMLow].push_back(page);
+        if (i % 5 == 0 && page != kTouchedPages - 1) {
+            state::GetMemoryPage(state, MemoryRegion::WRAMLow, kTouchedPages - 1)[i % 251] ^= 0x5A;
+            dirty[MemoryRegion::WRAMLow].push_back(kTouchedPages - 1);
+        }
+        state.msh2SpilloverCycles = i * 3;
+
+        frames.push_back(Capture(state));
+        buffer.ProcessState();
+    }
+    return frames;
+}
+
+// Allocates a rewind buffer starting from a zeroed state.
+static std::unique_ptr<app::RewindBuffer> MakeBuffer() {
+    auto buffer = std::make_unique<app::RewindBuffer>();
+    auto zero = std::make_unique<state::State>();
+    buffer->NextState = *zero;
+    buffer->Start();
+    return buffer;
+}
+
+TEST_CASE("RewindBuffer pops frames in reverse order", "[rewind]") {
+    auto buffer = MakeBuffer();
+    const auto frames = Record(*buffer, 0, 50);
+
+    // The newest frame is the working state, so popping restores the frame before it
+    for (size_t i = frames.size() - 1; i > 0; i--) {
+        REQUIRE(buffer->PopState());
+        CHECK(Capture(buffer->NextState) == frames[i - 1]);
+        CHECK(buffer->GetTotalFrames() == i);
+    }
+}
+
+TEST_CASE("RewindBuffer seeks to any frame", "[rewind]") {
+    auto buffer = MakeBuffer();
+
+    // Spans several keyframes
+    const size_t frameCount = app::RewindBuffer::kKeyframeInterval * 3 + 17;
+    const auto frames = Record(*buffer, 0, frameCount);
+
+    // Seeking waits for the processor thread to store the last frame
+    REQUIRE(buffer->SeekState(frameCount - 1));
+    CHECK(buffer->GetBufferSize() == frameCount);
+    CHECK(buffer->GetCursorPosition() == frameCount - 1);
+    CHECK(Capture(buffer->NextState) == frames.back());
+
+    SECTION("Backward and forward") {
+        for (size_t position : {frameCount - 2, size_t{0}, size_t{1}, app::RewindBuffer::kKeyframeInterval,
+                                app::RewindBuffer::kKeyframeInterval - 1, frameCount - 1, size_t{200}, size_t{5}}) {
+            INFO("position = " << position);
+            REQUIRE(buffer->SeekState(position));
+            CHECK(buffer->GetCursorPosition() == position);
+            CHECK(Capture(buffer->NextState) == frames[position]);
+        }
+    }
+    SECTION("Every frame") {
+        for (size_t position = 0; position < frameCount; position++) {
+            INFO("position = " << position);
+            REQUIRE(buffer->SeekState(position));
+            CHECK(Capture(buffer->NextState) == frames[position]);
+        }
+    }
+    SECTION("Out of range") {
+        CHECK_FALSE(buffer->SeekState(frameCount));
+    }
+    SECTION("Recording after seeking discards newer frames") {
+        const size_t position = app::RewindBuffer::kKeyframeInterval + 30;
+        REQUIRE(buffer->SeekState(position));
+        auto newFrames = Record(*buffer, 1000, 40);
+
+        std::vector<FrameContents> expected{frames.begin(), frames.begin() + position + 1};
+        expected.insert(expected.end(), newFrames.begin(), newFrames.end());
+        REQUIRE(buffer->SeekState(expected.size() - 1));
+        CHECK(buffer->GetBufferSize() == expected.size());
+        CHECK_FALSE(buffer->SeekState(expected.size()));
+        for (size_t i = 0; i < expected.size(); i += 7) {
+            INFO("position = " << i);
+            REQUIRE(buffer->SeekState(i));
+            CHECK(Capture(buffer->NextState) == expected[i]);
+        }
+    }
+}
+
+} // namespace rewind_buffer
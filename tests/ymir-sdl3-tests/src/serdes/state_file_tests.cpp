@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <serdes/state_file.hpp>
+
+#include <ymir/hw/cart/cart_impl_rom.hpp>
+#include <ymir/sys/saturn.hpp>
+
+#include <ymir/util/scope_guard.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace ymir;
+
+namespace state_file {
+
+// Creates a Saturn with a ROM cartridge filled with a recognizable pattern and saves its state.
+static std::unique_ptr<state::State> SaveStateWithROMCart(Saturn &saturn) {
+    std::vector<uint8> rom(cart::kROMCartSize);
+    for (size_t i = 0; i < rom.size(); i++) {
+        rom[i] = (i >> 8u) ^ (i * 13);
+    }
+    saturn.InsertCartridge<cart::ROMCartridge>()->LoadROM(rom);
+
+    auto state = std::make_unique<state::State>();
+    saturn.SaveState(*state);
+    return state;
+}
+
+TEST_CASE("Save state archives preserve ROM cartridges", "[serdes][state]") {
+    auto saturn = std::make_unique<Saturn>();
+    saturn->configuration.video.threadedVDP = false;
+    const auto state = SaveStateWithROMCart(*saturn);
+    REQUIRE(state->scu.cartType == state::SCUState::CartType::ROM);
+    REQUIRE(state->scu.cartData.size() == cart::kROMCartSize);
+
+    const std::vector<uint8> archive = state::WriteStateArchive(*state);
+    CHECK(state->scu.cartData.size() == cart::kROMCartSize);
+
+    auto readState = std::make_unique<state::State>();
+    REQUIRE(state::ReadStateArchive(archive, *readState));
+    CHECK(readState->scu.cartType == state::SCUState::CartType::ROM);
+    CHECK(std::ranges::equal(readState->scu.cartData, state->scu.cartData));
+    CHECK(readState->scu.intrMask == state->scu.intrMask);
+    CHECK(saturn->SCU.ValidateState(readState->scu));
+
+    // Everything after the cartridge data must also survive the round trip
+    CHECK(std::ranges::equal(state::WriteStateArchive(*readState), archive));
+}
+
+TEST_CASE("Save state files preserve ROM cartridges", "[serdes][state]") {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ymir-sdl3-tests-state-file.savestate";
+    util::ScopeGuard sgRemoveFile{[&] {
+        std::error_code err{};
+        std::filesystem::remove(path, err);
+    }};
+
+    auto saturn = std::make_unique<Saturn>();
+    saturn->configuration.video.threadedVDP = false;
+    const auto state = SaveStateWithROMCart(*saturn);
+
+    for (bool compress : {false, true}) {
+        INFO("compress = " << compress);
+        std::error_code error{};
+        REQUIRE(state::WriteStateFile(path, *state, compress, error));
+
+        auto readState = std::make_unique<state::State>();
+        state::ReadStateFile(path, *readState);
+        CHECK(readState->scu.cartType == state::SCUState::CartType::ROM);
+        CHECK(std::ranges::equal(readState->scu.cartData, state->scu.cartData));
+        CHECK(saturn->SCU.ValidateState(readState->scu));
+    }
+}
+
+} // namespace state_file